@@ -11,7 +11,7 @@ LIBNAME = libchild$(LIBEXT)
 OBJECTS = \
  childInterface.$(OBJEXT) erosion.$(OBJEXT) \
  meshElements.$(OBJEXT) mathutil.$(OBJEXT) tIDGenerator.$(OBJEXT) \
- tInputFile.$(OBJEXT) tLNode.$(OBJEXT) tRunTimer.$(OBJEXT) \
+ tInputFile.$(OBJEXT) tLNode.$(OBJEXT) tModelContext.$(OBJEXT) tRunTimer.$(OBJEXT) \
  tStreamMeander.$(OBJEXT) meander.$(OBJEXT) \
  tStorm.$(OBJEXT) tStreamNet.$(OBJEXT) tUplift.$(OBJEXT) errors.$(OBJEXT) \
  tFloodplain.$(OBJEXT) tEolian.$(OBJEXT) globalFns.$(OBJEXT) \
@@ -45,6 +45,9 @@ tInputFile.$(OBJEXT): $(PT)/tInputFile/tInputFile.cpp
 tLNode.$(OBJEXT): $(PT)/tLNode/tLNode.cpp
 	$(CXX) $(CFLAGS) $(PT)/tLNode/tLNode.cpp
 
+tModelContext.$(OBJEXT): $(PT)/tModelContext/tModelContext.cpp
+	$(CXX) $(CFLAGS) $(PT)/tModelContext/tModelContext.cpp
+
 tListInputData.$(OBJEXT): $(PT)/tListInputData/tListInputData.cpp
 	$(CXX) $(CFLAGS) $(PT)/tListInputData/tListInputData.cpp
 
@@ -151,6 +154,7 @@ HFILES = \
 	$(PT)/tMesh/tMesh.h \
 	$(PT)/tMesh/tMesh2.cpp \
 	$(PT)/tMeshList/tMeshList.h \
+	$(PT)/tModelContext/tModelContext.h \
 	$(PT)/tOption/tOption.h \
 	$(PT)/tOutput/tOutput.cpp \
 	$(PT)/tOutput/tOutput.h \
@@ -182,6 +186,7 @@ tEolian.$(OBJEXT): $(HFILES)
 tFloodplain.$(OBJEXT): $(HFILES)
 tInputFile.$(OBJEXT): $(HFILES)
 tLNode.$(OBJEXT): $(HFILES)
+tModelContext.$(OBJEXT): $(HFILES)
 tListInputData.$(OBJEXT): $(HFILES)
 tLithologyManager.$(OBJEXT): $(HFILES)
 tOption.$(OBJEXT): $(HFILES)
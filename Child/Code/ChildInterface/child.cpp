@@ -1,6 +1,6 @@
 #include "child.h"
 
-#define VERBOSE (false)
+#define VERBOSE CHILD_LOG_ENABLED( tLog::kDebug, tLog::kInterface )
 
 void Child::Initialize (std::string argument_string) {
   
@@ -29,6 +29,7 @@ void Child::Initialize (std::string argument_string) {
   
   // Open main input file
   tInputFile inputFile( option.inputFile );
+  tLog::InitializeFromInputFile( inputFile );
   
   // Get various options
   optNoDiffusion = inputFile.ReadBool( "OPTNODIFFUSION", false );
@@ -59,10 +60,14 @@ void Child::Initialize (std::string argument_string) {
   
   // CREATE AND INITIALIZE OBJECTS
   //
+  // Read parameters shared by all nodes of this model's mesh
+  context_.InitializeFromInputFile( inputFile );
+  
   // Create (or read) model mesh
   if( !option.silent_mode )
     std::cout << "Creating mesh...\n";
-  mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency );
+  mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency,
+                            &context_ );
   
   // Initialize the lithology manager
   lithology_manager_.InitializeFromInputFile( inputFile, mesh );
@@ -111,6 +116,8 @@ void Child::Initialize (std::string argument_string) {
       std::cout << "Initializing tectonics/baselevel...\n";
     uplift = new tUplift( inputFile );
   }
+  else
+    uplift = NULL;
   
   // Create and initialize run timer object:
   time = new tRunTimer( inputFile, !option.silent_mode );
@@ -218,6 +225,7 @@ void Child::Run(double run_duration) {
   
   while( !time->IsFinished() )
 		RunOneStorm();
+  ApplyPendingUplift();
 }
 
 
@@ -324,7 +332,7 @@ double Child::RunOneStorm() {
    **      Eolian (loess) deposition (if applicable)
    **      Uplift (or baselevel change)
    **********************************************************************/
-  if(0) //debug
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout << "         " << std::endl;
   time->ReportTimeStatus();
 	
@@ -335,10 +343,10 @@ double Child::RunOneStorm() {
   stormPlusDryDuration = min( storm->getStormDuration() + storm->interstormDur(),
                              time->RemainingTime() );
   
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout << "Remaining time: " << time->RemainingTime() << std::endl;
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout<< "Storm: "<< storm->getRainrate() << " " << storm->getStormDuration() << " "
     << stormDuration << " " << storm->interstormDur() << " " << stormPlusDryDuration 
     << std::endl;
@@ -348,10 +356,9 @@ double Child::RunOneStorm() {
   // calculated:
   if( !optNoFluvial || optLandslides)
     strmNet->UpdateNet( time->getCurrentTime(), *storm );
-  if(0) //DEBUG
-    std::cout << "UpdateNet::Done.." << std::endl;
+  CHILD_LOG( tLog::kDebug, tLog::kStreamNet, "UpdateNet::Done.." );
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -371,9 +378,12 @@ double Child::RunOneStorm() {
 	
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
+  {
+    ApplyPendingUplift();  // the grid follows absolute elevations
     stratGrid->UpdateStratGrid(tStratGrid::k0, time->getCurrentTime());
+  }
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -444,7 +454,8 @@ double Child::RunOneStorm() {
 #undef NEWVEG
   
   //-------------FLUVIAL------------------------------------------
-  if(0) std::cout << "Calculating fluvial erosion and transport ...\n" << std::flush;
+  CHILD_LOG( tLog::kDebug, tLog::kErosion,
+             "Calculating fluvial erosion and transport ..." );
   if( !optNoFluvial )
   {
     if( optDetachLim )
@@ -471,15 +482,14 @@ double Child::RunOneStorm() {
                                  time->getCurrentTime() );
   }
   
-  if(0) //DEBUG
-    std::cout << "Erosion::Done.." << std::flush;
+  CHILD_LOG( tLog::kDebug, tLog::kErosion, "Erosion::Done.." );
 	
   
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
     stratGrid->UpdateStratGrid(tStratGrid::k1,time->getCurrentTime() );
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -502,8 +512,7 @@ double Child::RunOneStorm() {
   if( optMeander )
     strmMeander->Migrate( time->getCurrentTime() );
 	
-  if(0) //DEBUG
-    std::cout << "Meander-Migrate::Done..\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMeander, "Meander-Migrate::Done.." );
 	
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
@@ -512,9 +521,10 @@ double Child::RunOneStorm() {
   //----------------FLOODPLAIN---------------------------------
   if( optFloodplainDep )
   {
+    ApplyPendingUplift();  // overbank deposition uses absolute elevations
     if( floodplain->OptControlMainChan() )
       floodplain->UpdateMainChannelHeight( time->getCurrentTime(), strmNet->getInletNodePtrNC() );
-    std::cout << "UpdateChannelHeight::Done..\n";
+    CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "UpdateChannelHeight::Done.." );
 		
     if( optStratGrid ){
       stratGrid->UpdateStratGrid(tStratGrid::k3,time->getCurrentTime());
@@ -523,7 +533,7 @@ double Child::RunOneStorm() {
     floodplain->DepositOverbank( storm->getRainrate(),
                                 storm->getStormDuration(),
                                 time->getCurrentTime() );
-    std::cout << "tFloodplain::Done..\n";
+    CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "tFloodplain::Done.." );
 		
     if( optStratGrid ){
       stratGrid->UpdateStratGrid(tStratGrid::k4,time->getCurrentTime());
@@ -561,9 +571,16 @@ double Child::RunOneStorm() {
   time->Advance( stormPlusDryDuration );
 	
   if( output > 0 && time->CheckOutputTime() )
+  {
+    ApplyPendingUplift();
     output->WriteOutput( time->getCurrentTime() );
+  }
 	
-  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput();
+  if( output > 0 && output->OptTSOutput() )
+  {
+    ApplyPendingUplift();
+    output->WriteTSOutput();
+  }
   
   return( time->getCurrentTime() );
 }
@@ -581,6 +598,7 @@ double Child::RunOneStorm() {
 */
 /**************************************************************************/
 void Child::MaskNodesBelowElevation(double elev) {
+   ApplyPendingUplift();
    tLNode *current_node;
    tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
    
@@ -596,6 +614,7 @@ void Child::MaskNodesBelowElevation(double elev) {
 
 void Child::CopyNodeElevations (double * const dest)
 {
+  ApplyPendingUplift();
   tLNode *current_node;
   tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
    
@@ -664,6 +683,7 @@ void Child::CopyNodeSedimentFlux (double * const dest)
 }
 
 void Child::SetNodeElevations (const double * elevations) {
+   ApplyPendingUplift();
    tLNode *current_node;
    tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
    
@@ -679,6 +699,7 @@ void Child::SetNodeElevations (const double * elevations) {
 }
 
 void Child::SetNodeUplift (const double * uplift) {
+   ApplyPendingUplift();
    tLNode *current_node;
    tMesh<tLNode>::nodeListIter_t ni (mesh->getNodeList());
    
@@ -693,3 +714,19 @@ void Child::SetNodeUplift (const double * uplift) {
    }
 }
 
+/**************************************************************************/
+/**
+ **  ApplyPendingUplift
+ **
+ **  With lazy uniform uplift (OPT_LAZY_UPLIFT), the node elevations are
+ **  only relative until the datum offset is applied (see
+ **  tUplift::UpliftUniform). As in childInterface, this is called
+ **  wherever absolute elevations are needed.
+ */
+/**************************************************************************/
+
+void Child::ApplyPendingUplift()
+{
+  if( uplift && mesh )
+    uplift->ApplyPendingUplift( mesh );
+}
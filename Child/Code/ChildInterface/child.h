@@ -27,6 +27,7 @@ class Child {
     void CopyNodeSedimentFlux (double * const dest);
     void SetNodeElevations (const double * src);
     void SetNodeUplift (const double * src);
+    void ApplyPendingUplift();  // Bring lazy uniform uplift up to date
   
     bool initialized;      // Flag indicated whether model has been initialized
     bool optNoDiffusion,   // Option to turn off diffusive processes (default to false)
@@ -50,6 +51,7 @@ class Child {
          optPhysicalWeathering; // Option for physical weathering
 
     bool optStreamLineBoundary; // Option for converting streamlines to open boundaries
+         tModelContext context_;  // Per-model parameters shared by all nodes
          tRand *rand;             // -> random number generator
          tMesh<tLNode> *mesh;        // -> mesh object
          tLOutput<tLNode> *output;   // -> output handler
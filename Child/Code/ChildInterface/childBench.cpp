@@ -0,0 +1,468 @@
+/**************************************************************************/
+/**
+**  @file childBench.cpp
+**
+**  @brief Functions for class childBench, which times the main
+**         subsystems on synthetic meshes (see childBench.h).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <time.h>
+#include <unistd.h>
+#include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include "childBench.h"
+
+namespace
+{
+  // Stages timed for each mesh, in the order they are run
+  enum
+  {
+    kMeshStage = 0, kUpdateMeshStage, kCalcSlopesStage, kFlowDirsStage,
+    kFillLakesStage, kDrainAreaStage, kSortStage, kDiffuseStage,
+    kDetachErodeStage, kWriteOutputStage, kNumStages
+  };
+  const char *const stageNames[kNumStages] =
+  {
+    "mesh", "UpdateMesh", "CalcSlopes", "FlowDirs", "FillLakes",
+    "DrainAreaVoronoi", "SortNodesByNetOrder", "Diffuse", "DetachErode",
+    "WriteOutput"
+  };
+
+  const double kSpacing = 100.0;   // node spacing of random and hex meshes
+
+  // Wall time in seconds, from an arbitrary origin
+  double Seconds()
+  {
+    struct timespec t;
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    return t.tv_sec + 1.0e-9*t.tv_nsec;
+  }
+}
+
+childBench::
+childBench() :
+  checkMesh_(true), repeats_(3), timeStep_(1.0), seed_(0)
+{}
+
+/**************************************************************************/
+/**
+**  Initialize
+**
+**  Reads the benchmark keywords and makes the list of meshes to time.
+*/
+/**************************************************************************/
+void childBench::
+Initialize( int argc, char **argv )
+{
+  tOption option( argc, argv );
+  inputFileName_ = option.inputFile;
+  checkMesh_ = option.checkMeshConsistency;
+  tInputFile inputFile( option.inputFile );
+  tLog::InitializeFromInputFile( inputFile );
+
+  outName_ = inputFile.ReadString( "OUTFILENAME" );
+  seed_ = inputFile.ReadLong( "SEED" );
+  repeats_ = inputFile.ReadInt( "BENCH_REPEATS", false );
+  if( repeats_<=0 ) repeats_ = 3;
+  timeStep_ = inputFile.ReadDouble( "BENCH_TIME_STEP", false );
+  if( timeStep_<=0.0 ) timeStep_ = 1.0;
+  if( inputFile.Contain( "BENCH_DEM" ) )
+    demFileName_ = inputFile.ReadString( "BENCH_DEM" );
+
+  std::string sizes = "10000 100000 500000 2000000";
+  if( inputFile.Contain( "BENCH_SIZES" ) )
+    sizes = inputFile.ReadString( "BENCH_SIZES" );
+  std::string types = "random hex dem";
+  if( inputFile.Contain( "BENCH_MESHES" ) )
+    types = inputFile.ReadString( "BENCH_MESHES" );
+
+  std::istringstream typeStream( types );
+  std::string type;
+  while( !(typeStream >> type).fail() )
+  {
+    if( type!="random" && type!="hex" && type!="dem" )
+    {
+      std::cerr << "childBench: unknown mesh type '" << type << "'\n";
+      ReportFatalError( "BENCH_MESHES: mesh types are random, hex and dem." );
+    }
+    std::istringstream sizeStream( sizes );
+    long n;
+    while( !(sizeStream >> n).fail() )
+    {
+      if( n<9 )
+	ReportFatalError( "BENCH_SIZES: meshes need at least 9 nodes." );
+      tCase c;
+      c.type = type;
+      c.requested = n;
+      c.nodes = c.edges = c.triangles = 0;
+      c.times.resize( kNumStages );
+      cases_.push_back( c );
+    }
+    if( !sizeStream.eof() )
+      ReportFatalError( "BENCH_SIZES: expected a list of numbers." );
+  }
+  if( cases_.empty() )
+    ReportFatalError( "childBench: no meshes to time." );
+}
+
+/**************************************************************************/
+/**
+**  Run
+**
+**  Times each mesh in turn, writing the results after each one so that a
+**  long benchmark that is stopped part way still leaves them.
+*/
+/**************************************************************************/
+void childBench::
+Run()
+{
+  for( size_t i=0; i<cases_.size(); ++i )
+  {
+    std::cout << "childBench: " << cases_[i].type << " mesh, "
+	      << cases_[i].requested << " nodes\n";
+    RunCase( cases_[i] );
+    WriteResults();
+  }
+}
+
+/**************************************************************************/
+/**
+**  RunCase
+**
+**  Builds one mesh and the objects that work on it, and times each stage
+**  (see childBench.h).
+*/
+/**************************************************************************/
+void childBench::
+RunCase( tCase &c )
+{
+  tInputFile inputFile( inputFileName_.c_str() );
+  SetMeshKeyWords( inputFile, c );
+  tRand rand( inputFile );
+  tModelContext context;
+  context.InitializeFromInputFile( inputFile );
+
+  double start = Seconds();
+  tMesh<tLNode> mesh( inputFile, checkMesh_, &context );
+  c.times[kMeshStage].push_back( Seconds() - start );
+  c.nodes = mesh.getNodeList()->getSize();
+  c.edges = mesh.getEdgeList()->getSize();
+  c.triangles = mesh.getTriList()->getSize();
+
+  tStorm storm( inputFile, &rand, true );
+  tStreamNet strmNet( mesh, storm, inputFile );
+  tErosion erosion( &mesh, inputFile, true );
+  tLOutput<tLNode> output( &mesh, inputFile, &rand );
+
+  for( int r=0; r<repeats_; ++r )
+  {
+    const double time = r * timeStep_;
+    std::vector< std::vector<double> > &t = c.times;
+
+    start = Seconds();
+    mesh.UpdateMesh( checkMesh_ );
+    t[kUpdateMeshStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    strmNet.CalcSlopes();
+    t[kCalcSlopesStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    strmNet.FlowDirs();
+    t[kFlowDirsStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    strmNet.FillLakes();
+    t[kFillLakesStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    strmNet.DrainAreaVoronoi();
+    t[kDrainAreaStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    strmNet.SortNodesByNetOrder();
+    t[kSortStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    erosion.Diffuse( timeStep_, false, time );
+    t[kDiffuseStage].push_back( Seconds() - start );
+
+    strmNet.MakeFlow( time );   // runoff for DetachErode
+    start = Seconds();
+    erosion.DetachErode( timeStep_, &strmNet, time, 0 );
+    t[kDetachErodeStage].push_back( Seconds() - start );
+
+    start = Seconds();
+    output.WriteOutput( time );
+    t[kWriteOutputStage].push_back( Seconds() - start );
+  }
+}
+
+/**************************************************************************/
+/**
+**  SetMeshKeyWords
+**
+**  Sets the keywords that make the mesh of a case, and the name of the
+**  model's output files.
+*/
+/**************************************************************************/
+void childBench::
+SetMeshKeyWords( tInputFile &inputFile, const tCase &c ) const
+{
+  const std::string benchName = outName_ + "_bench";
+  inputFile.SetValue( "OUTFILENAME", benchName.c_str() );
+
+  std::ostringstream value;
+  value << std::setprecision( 12 );
+  if( c.type=="dem" )
+  {
+    const std::string pointName = benchName + ".pts";
+    WriteDemPoints( pointName, c.requested );
+    inputFile.SetValue( "OPTREADINPUT", "12" );
+    inputFile.SetValue( "POINTFILENAME", pointName.c_str(), true );
+    return;
+  }
+
+  // Square domain holding about the requested number of nodes
+  const double side = sqrt( static_cast<double>( c.requested ) ) * kSpacing;
+  value << side;
+  inputFile.SetValue( "OPTREADINPUT", "10" );
+  inputFile.SetValue( "X_GRID_SIZE", value.str().c_str(), true );
+  inputFile.SetValue( "Y_GRID_SIZE", value.str().c_str(), true );
+  inputFile.SetValue( "TYP_BOUND", "1", true );
+  if( !inputFile.Contain( "MEAN_ELEV" ) )
+    inputFile.SetValue( "MEAN_ELEV", "0", true );
+  if( !inputFile.Contain( "RAND_ELEV" ) )
+    inputFile.SetValue( "RAND_ELEV", "1", true );
+  value.str( "" );
+  if( c.type=="hex" )
+  {
+    value << kSpacing;
+    inputFile.SetValue( "OPT_PT_PLACE", "0", true );
+    inputFile.SetValue( "GRID_SPACING", value.str().c_str(), true );
+  }
+  else
+  {
+    value << c.requested;
+    inputFile.SetValue( "OPT_PT_PLACE", "2", true );
+    inputFile.SetValue( "NUM_PTS", value.str().c_str(), true );
+  }
+}
+
+/**************************************************************************/
+/**
+**  WriteDemPoints
+**
+**  Writes a point file (see tMesh::MakeMeshFromPointsTipper) with about
+**  numNodes points on a regular grid.
+**
+**  If BENCH_DEM is given, the grid covers the DEM, and the elevations are
+**  interpolated bilinearly from it. Points with no data are closed
+**  boundaries, as are the points on the edge of the grid, except for the
+**  lowest of these, which is the outlet.
+**
+**  Otherwise the grid is square, with a node spacing of 100 m, and the
+**  surface is a plane sloping down to the lower side, which is open,
+**  with hills and valleys made of a few waves of random phase.
+*/
+/**************************************************************************/
+void childBench::
+WriteDemPoints( const std::string &fileName, long numNodes ) const
+{
+  std::vector<double> x, y, z;
+  std::vector<int> b;
+
+  if( demFileName_.empty() )
+  {
+    const long n = std::max( 3L, lround( sqrt( double( numNodes ) ) ) );
+    const double side = ( n - 1 ) * kSpacing;
+    const int numWaves = 6;
+    tRand rand( seed_ );
+    double phase[numWaves][2];
+    for( int k=0; k<numWaves; ++k )
+    {
+      phase[k][0] = 2.0 * PI * rand.ran3();
+      phase[k][1] = 2.0 * PI * rand.ran3();
+    }
+    for( long j=0; j<n; ++j )
+      for( long i=0; i<n; ++i )
+      {
+	const double xi = i * kSpacing, yj = j * kSpacing;
+	double zij = 0.01 * yj;
+	for( int k=1; k<=numWaves; ++k )
+	  zij += 0.005 * side / k
+	    * sin( 2.0 * PI * k * xi / side + phase[k-1][0] )
+	    * sin( 2.0 * PI * k * yj / side + phase[k-1][1] );
+	int bij = kNonBoundary;
+	if( j==0 && i>0 && i<n-1 )
+	{
+	  bij = kOpenBoundary;
+	  zij = 0.0;
+	}
+	else if( i==0 || i==n-1 || j==0 || j==n-1 )
+	  bij = kClosedBoundary;
+	x.push_back( xi );
+	y.push_back( yj );
+	z.push_back( zij );
+	b.push_back( bij );
+      }
+  }
+  else
+  {
+    std::ifstream dem( demFileName_.c_str() );
+    if( !dem.good() )
+    {
+      std::cerr << "childBench: unable to open '" << demFileName_ << "'\n";
+      ReportFatalError( "BENCH_DEM: unable to open the DEM." );
+    }
+    std::string key;
+    long ncols, nrows;
+    double xll, yll, cell, nodata;
+    dem >> key >> ncols >> key >> nrows >> key >> xll >> key >> yll
+	>> key >> cell >> key >> nodata;
+    if( dem.fail() || ncols<2 || nrows<2 )
+      ReportFatalError( "BENCH_DEM: unable to read the ArcGrid header." );
+    std::vector<double> elev( ncols*nrows );
+    for( size_t k=0; k<elev.size(); ++k )
+      if( (dem >> elev[k]).fail() )
+	ReportFatalError( "BENCH_DEM: reached the end of the DEM early." );
+
+    // Grid with the aspect ratio of the DEM
+    const double width = ( ncols - 1 ) * cell, height = ( nrows - 1 ) * cell;
+    const long nx =
+      std::max( 3L, lround( sqrt( numNodes * width / height ) ) );
+    const long ny = std::max( 3L, lround( double( numNodes ) / nx ) );
+    double zmin = 0.0;
+    bool haveData = false;
+    for( long j=0; j<ny; ++j )
+      for( long i=0; i<nx; ++i )
+      {
+	// Position in cells from the lower left; rows are stored top down
+	const double u = i * ( ncols - 1.0 ) / ( nx - 1 );
+	const double v = j * ( nrows - 1.0 ) / ( ny - 1 );
+	const long c0 = std::min( long( u ), ncols - 2 );
+	const long r0 = std::min( long( v ), nrows - 2 );
+	const double fu = u - c0, fv = v - r0;
+	const double z00 = elev[( nrows - 1 - r0 ) * ncols + c0],
+	  z10 = elev[( nrows - 1 - r0 ) * ncols + c0 + 1],
+	  z01 = elev[( nrows - 2 - r0 ) * ncols + c0],
+	  z11 = elev[( nrows - 2 - r0 ) * ncols + c0 + 1];
+	double zij = nodata;
+	if( z00!=nodata && z10!=nodata && z01!=nodata && z11!=nodata )
+	{
+	  zij = ( 1.0 - fv ) * ( ( 1.0 - fu ) * z00 + fu * z10 )
+	    + fv * ( ( 1.0 - fu ) * z01 + fu * z11 );
+	  if( !haveData || zij<zmin ) zmin = zij;
+	  haveData = true;
+	}
+	const bool edge = ( i==0 || i==nx-1 || j==0 || j==ny-1 );
+	x.push_back( xll + u * cell );
+	y.push_back( yll + v * cell );
+	z.push_back( zij );
+	b.push_back( ( edge || zij==nodata ) ? kClosedBoundary
+		     : kNonBoundary );
+      }
+    if( !haveData )
+      ReportFatalError( "BENCH_DEM: the DEM has no data." );
+
+    // No-data points are set to the lowest elevation; the lowest point
+    // with data on the edge of the grid becomes the outlet
+    long outlet = -1;
+    for( size_t k=0; k<z.size(); ++k )
+    {
+      if( z[k]==nodata )
+      {
+	z[k] = zmin;
+	continue;
+      }
+      if( b[k]==kClosedBoundary && ( outlet<0 || z[k]<z[outlet] ) )
+	outlet = k;
+    }
+    if( outlet<0 )
+      ReportFatalError( "BENCH_DEM: no point with data on the edge "
+			"of the grid for an outlet." );
+    b[outlet] = kOpenBoundary;
+  }
+
+  std::ofstream points( fileName.c_str() );
+  if( !points.good() )
+    ReportFatalError( "childBench: unable to write the point file." );
+  points << x.size() << '\n' << std::setprecision( 12 );
+  for( size_t k=0; k<x.size(); ++k )
+    points << x[k] << ' ' << y[k] << ' ' << z[k] << ' ' << b[k] << '\n';
+}
+
+/**************************************************************************/
+/**
+**  WriteResults
+**
+**  Writes <OUTFILENAME>.bench.json (see childBench.h) for the meshes
+**  timed so far.
+*/
+/**************************************************************************/
+void childBench::
+WriteResults() const
+{
+  const std::string name = outName_ + ".bench.json";
+  std::ofstream json( name.c_str() );
+  if( !json.good() )
+    ReportFatalError( "childBench: unable to open output file." );
+
+  char host[256] = "";
+  gethostname( host, sizeof(host) - 1 );
+  char date[32] = "";
+  const time_t now = ::time( 0 );
+  strftime( date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime( &now ) );
+
+  json << "{\n"
+       << "  \"input\": \"" << inputFileName_ << "\",\n"
+       << "  \"host\": \"" << host << "\",\n"
+       << "  \"date\": \"" << date << "\",\n"
+       << "  \"repeats\": " << repeats_ << ",\n"
+       << "  \"time_step\": " << timeStep_ << ",\n"
+       << "  \"meshes\": [";
+  bool firstCase = true;
+  for( size_t i=0; i<cases_.size(); ++i )
+  {
+    const tCase &c = cases_[i];
+    if( c.times[kMeshStage].empty() ) continue;  // not timed yet
+    json << ( firstCase ? "\n" : ",\n" )
+	 << "    {\n"
+	 << "      \"type\": \"" << c.type << "\",\n"
+	 << "      \"requested_nodes\": " << c.requested << ",\n"
+	 << "      \"nodes\": " << c.nodes << ",\n"
+	 << "      \"edges\": " << c.edges << ",\n"
+	 << "      \"triangles\": " << c.triangles << ",\n"
+	 << "      \"seconds\": {";
+    firstCase = false;
+    for( int s=0; s<kNumStages; ++s )
+    {
+      std::vector<double> t( c.times[s] );
+      std::sort( t.begin(), t.end() );
+      const size_t n = t.size();
+      double sum = 0.0;
+      for( size_t k=0; k<n; ++k ) sum += t[k];
+      const double median = ( n%2 ) ? t[n/2] : 0.5 * ( t[n/2-1] + t[n/2] );
+      json << ( s==0 ? "\n" : ",\n" )
+	   << "        \"" << stageNames[s] << "\": { "
+	   << std::scientific << std::setprecision( 6 )
+	   << "\"min\": " << t[0]
+	   << ", \"median\": " << median
+	   << ", \"mean\": " << sum / n << " }"
+	   << std::resetiosflags( std::ios::floatfield );
+    }
+    json << "\n      }\n    }";
+  }
+  json << "\n  ]\n}\n";
+}
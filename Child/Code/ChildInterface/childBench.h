@@ -0,0 +1,117 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file childBench.h
+**
+**  @brief Header file for childBench, a driver that times the main
+**         subsystems of the model on synthetic meshes of various sizes.
+**
+**  For each mesh type and size asked for, a childBench builds a mesh and
+**  the objects that work on it (storm, stream network, erosion, output)
+**  from the main input file, and then times each of the following in
+**  isolation, a given number of times:
+**
+**    mesh                  building the mesh (point placement and
+**                          triangulation; timed once)
+**    UpdateMesh            tMesh::UpdateMesh
+**    CalcSlopes            tStreamNet::CalcSlopes
+**    FlowDirs              tStreamNet::FlowDirs
+**    FillLakes             tStreamNet::FillLakes
+**    DrainAreaVoronoi      tStreamNet::DrainAreaVoronoi (drainage area)
+**    SortNodesByNetOrder   tStreamNet::SortNodesByNetOrder
+**    Diffuse               tErosion::Diffuse
+**    DetachErode           tErosion::DetachErode
+**    WriteOutput           tLOutput::WriteOutput
+**
+**  The stages run in the order above, so each sees the state left by
+**  the ones before it, as in a model run (the runoff is computed, untimed,
+**  before DetachErode). The surface changes slightly from one repetition
+**  to the next.
+**
+**  The mesh types are:
+**
+**    random   randomly placed points (OPTREADINPUT 10, OPT_PT_PLACE 2)
+**    hex      staggered uniform points (OPTREADINPUT 10, OPT_PT_PLACE 0)
+**    dem      one point per cell of a DEM, read as a point file
+**             (OPTREADINPUT 12); the DEM is BENCH_DEM resampled to the
+**             requested size, or if there is none, a synthetic surface
+**
+**  Random and hex meshes are square, with a node spacing of 100 m and
+**  one open side (TYP_BOUND 1). Synthetic DEMs are square and drain to
+**  their lower side. All other parameters come from the input file, which
+**  must be a complete CHILD input file.
+**
+**  The following keywords are read from the main input file:
+**
+**    BENCH_SIZES      numbers of nodes (default
+**                     "10000 100000 500000 2000000")
+**    BENCH_MESHES     mesh types (default "random hex dem")
+**    BENCH_REPEATS    times each stage is run (default 3)
+**    BENCH_TIME_STEP  time step (yr) for Diffuse and DetachErode
+**                     (default 1)
+**    BENCH_DEM        ArcGrid ascii file for the dem meshes (optional)
+**
+**  The results go to <OUTFILENAME>.bench.json: for each mesh, its type,
+**  the number of nodes asked for, the numbers of nodes, edges and
+**  triangles actually made, and for each stage the minimum, median and
+**  mean time in seconds. The model's own output files are written under
+**  the name <OUTFILENAME>_bench (and overwritten by each mesh).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef CHILDBENCH_H
+#define CHILDBENCH_H
+
+#include <string>
+#include <vector>
+#include "childInterface.h"
+
+/**************************************************************************/
+/**
+**  Class childBench
+**
+**  Holds the list of meshes to time and the results.
+*/
+/**************************************************************************/
+class childBench
+{
+public:
+  childBench();
+  void Initialize( int argc, char **argv );
+  void Run();
+
+private:
+  // Timings of one mesh
+  struct tCase
+  {
+    std::string type;
+    long requested;
+    long nodes, edges, triangles;
+    std::vector< std::vector<double> > times;  // [stage][repetition]
+  };
+
+  void RunCase( tCase & );
+  void SetMeshKeyWords( tInputFile &, const tCase & ) const;
+  void WriteDemPoints( const std::string &fileName, long numNodes ) const;
+  void WriteResults() const;
+
+  std::string inputFileName_;     // main input file
+  std::string outName_;           // OUTFILENAME from the input file
+  bool checkMesh_;                // false with --no-check
+  int repeats_;
+  double timeStep_;
+  std::string demFileName_;       // BENCH_DEM, or empty
+  long seed_;
+  std::vector<tCase> cases_;
+};
+
+#endif
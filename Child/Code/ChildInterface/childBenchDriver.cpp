@@ -0,0 +1,30 @@
+/**************************************************************************/
+/**
+**  childBenchDriver.cpp: Times the main subsystems of the model on
+**  synthetic meshes and writes the results as JSON (see childBench.h for
+**  the input keywords).
+**
+**  Usage: child_bench [--no-check] <input file>
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include "childBench.h"
+
+int main( int argc, char **argv )
+{
+	childBench myBench;
+
+	myBench.Initialize( argc, argv );
+	myBench.Run();
+
+	return 0;
+}
@@ -0,0 +1,284 @@
+/**************************************************************************/
+/**
+**  @file childBranch.cpp
+**
+**  @brief Functions for class childBranch, which runs a spin-up once and
+**         branches it into scenarios in forked processes (see
+**         childBranch.h).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include "childBranch.h"
+
+childBranch::
+childBranch() :
+  inputFile_(0), branchTime_(0.0), endTime_(0.0), maxProcesses_(1),
+  writeOutput_(true)
+{}
+
+childBranch::
+~childBranch()
+{
+  CleanUp();
+}
+
+/**************************************************************************/
+/**
+**  Initialize
+**
+**  Initializes the model from the command line, and reads the branching
+**  keywords and the scenario file. The scenario file is read here, before
+**  the spin-up, so that mistakes in it show up right away.
+*/
+/**************************************************************************/
+void childBranch::
+Initialize( int argc, char **argv )
+{
+  model_.Initialize( argc, argv );
+
+  tOption option( argc, argv );
+  writeOutput_ = !option.no_write_mode;
+  inputFile_ = new tInputFile( option.inputFile );
+
+  outName_ = inputFile_->ReadString( "OUTFILENAME" );
+  branchTime_ = inputFile_->ReadDouble( "BRANCH_TIME" );
+  endTime_ = model_.GetCurrentTime() + model_.GetRemainingRunTime();
+  if( branchTime_<=0.0 || branchTime_>=model_.GetRemainingRunTime() )
+    ReportFatalError( "BRANCH_TIME must be positive and less than the run duration." );
+  maxProcesses_ = inputFile_->ReadInt( "BRANCH_PROCESSES", false );
+  if( maxProcesses_<=0 )
+  {
+    long ncores = sysconf( _SC_NPROCESSORS_ONLN );
+    maxProcesses_ = ( ncores>0 ) ? static_cast<int>( ncores ) : 1;
+  }
+
+  ReadScenarios( inputFile_->ReadString( "BRANCH_SCENARIOS" ) );
+}
+
+/**************************************************************************/
+/**
+**  ReadScenarios
+**
+**  Reads the scenario file (see childBranch.h for its format).
+*/
+/**************************************************************************/
+void childBranch::
+ReadScenarios( const std::string &fileName )
+{
+  std::ifstream scenarioFile( fileName.c_str() );
+  if( !scenarioFile.good() )
+  {
+    std::cerr << "childBranch: unable to open '" << fileName << "'\n";
+    ReportFatalError( "The scenario file may not exist or may be mis-named." );
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while( std::getline( scenarioFile, line ) )
+  {
+    ++lineNumber;
+    std::istringstream lineStream( line );
+    std::string keyword;
+    if( !( lineStream >> keyword ) || keyword[0]=='#' )
+      continue;
+    bool ok = true;
+    if( keyword=="SCENARIO" )
+    {
+      scenarios_.push_back( tScenario() );
+      ok = !( lineStream >> scenarios_.back().name ).fail();
+    }
+    else if( scenarios_.empty() )
+      ok = false;
+    else if( keyword=="OPTION" )
+    {
+      // the option name may contain blanks; the value is the last word
+      std::vector<std::string> words;
+      std::string word;
+      while( lineStream >> word )
+	words.push_back( word );
+      ok = ( words.size()>=2 );
+      if( ok )
+      {
+	std::string name = words[0];
+	for( size_t i=1; i<words.size()-1; ++i )
+	  name += " " + words[i];
+	std::istringstream valueStream( words.back() );
+	int value;
+	ok = !( valueStream >> value ).fail();
+	scenarios_.back().options.push_back( std::make_pair( name, value ) );
+      }
+    }
+    else if( keyword=="VALUES" )
+    {
+      std::string var, file;
+      ok = !( lineStream >> var >> file ).fail();
+      scenarios_.back().valueFiles.push_back( std::make_pair( var, file ) );
+    }
+    else if( keyword=="SEED" )
+    {
+      ok = !( lineStream >> scenarios_.back().seed ).fail();
+      scenarios_.back().setSeed = true;
+    }
+    else
+      ok = false;
+    if( !ok )
+    {
+      std::cerr << "childBranch: can't make sense of line " << lineNumber
+		<< " of '" << fileName << "':\n" << line << "\n";
+      ReportFatalError( "Error in scenario file." );
+    }
+  }
+  if( scenarios_.empty() )
+    ReportFatalError( "childBranch: the scenario file holds no scenarios." );
+}
+
+/**************************************************************************/
+/**
+**  Run
+**
+**  Runs the spin-up, then forks the scenarios, keeping no more than
+**  maxProcesses_ of them running at once. Returns the number of
+**  scenarios that did not finish normally.
+**
+**  The spin-up's output files are closed before forking: otherwise each
+**  process would inherit (and, on exit, write out again) whatever the
+**  parent still had buffered.
+*/
+/**************************************************************************/
+int childBranch::
+Run()
+{
+  model_.Run( branchTime_ );
+  model_.setWriteOption( false, *inputFile_ );
+  std::cout << "Spin-up done at time " << model_.GetCurrentTime()
+	    << "; branching " << scenarios_.size() << " scenarios\n";
+  std::cout.flush();
+  std::cerr.flush();
+  fflush( NULL );
+
+  std::map<pid_t, size_t> running;  // process ID -> scenario
+  size_t next = 0;
+  int numFailed = 0;
+  while( next<scenarios_.size() || !running.empty() )
+  {
+    if( next<scenarios_.size() &&
+	static_cast<int>( running.size() )<maxProcesses_ )
+    {
+      pid_t pid = fork();
+      if( pid<0 )
+	ReportFatalError( "childBranch: unable to fork a new process." );
+      if( pid==0 )
+	RunScenario( scenarios_[next] );  // never returns
+      running[pid] = next++;
+      continue;
+    }
+
+    int status;
+    pid_t pid = waitpid( -1, &status, 0 );
+    if( pid<0 )
+    {
+      if( errno==EINTR ) continue;
+      ReportFatalError( "childBranch: error waiting for scenarios." );
+    }
+    std::map<pid_t, size_t>::iterator done = running.find( pid );
+    if( done==running.end() ) continue;
+    const std::string &name = scenarios_[done->second].name;
+    if( WIFEXITED( status ) && WEXITSTATUS( status )==0 )
+      std::cout << "Scenario " << name << " finished\n";
+    else
+    {
+      std::cout << "Scenario " << name << " FAILED (see "
+		<< outName_ << "_" << name << ".log)\n";
+      ++numFailed;
+    }
+    std::cout.flush();
+    running.erase( done );
+  }
+  return numFailed;
+}
+
+/**************************************************************************/
+/**
+**  RunScenario
+**
+**  Runs in the forked process: sends the screen output to the scenario's
+**  log file, renames the output files after the scenario, applies the
+**  overrides and runs to the end. Exits rather than returning.
+*/
+/**************************************************************************/
+void childBranch::
+RunScenario( const tScenario &scenario )
+{
+  const std::string name = outName_ + "_" + scenario.name;
+
+  std::string logName = name + ".log";
+  int logFd = open( logName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if( logFd>=0 )
+  {
+    dup2( logFd, 1 );
+    dup2( logFd, 2 );
+    close( logFd );
+  }
+
+  // Output files are named after the scenario
+  tArray< tKeyPair > &keyWords = inputFile_->GetKeyWordTableRef();
+  for( size_t i=0; i<keyWords.getSize(); ++i )
+    if( strcmp( keyWords[i].key(), "OUTFILENAME" )==0 )
+      keyWords[i].setValue( name.c_str() );
+
+  for( size_t i=0; i<scenario.options.size(); ++i )
+    model_.ChangeOption( scenario.options[i].first,
+			 scenario.options[i].second );
+  for( size_t i=0; i<scenario.valueFiles.size(); ++i )
+  {
+    std::ifstream valueFile( scenario.valueFiles[i].second.c_str() );
+    if( !valueFile.good() )
+      ReportFatalError( "childBranch: unable to open a VALUES file." );
+    std::vector<double> values;
+    double value;
+    while( valueFile >> value )
+      values.push_back( value );
+    if( static_cast<long>( values.size() )!=model_.GetNodeCount() )
+      ReportFatalError( "childBranch: a VALUES file must hold one value per node." );
+    model_.SetValueSet( scenario.valueFiles[i].first, values );
+  }
+  if( scenario.setSeed )
+    model_.SetRandomSeed( scenario.seed );
+
+  if( writeOutput_ )
+  {
+    model_.setWriteOption( true, *inputFile_ );
+    model_.WriteChildStyleOutput();  // state at the branch time
+  }
+  model_.Run( endTime_ - model_.GetCurrentTime() );
+  model_.CleanUp();
+
+  std::cout.flush();
+  std::cerr.flush();
+  fflush( NULL );
+  _exit( 0 );
+}
+
+void childBranch::
+CleanUp()
+{
+  model_.CleanUp();
+  delete inputFile_;
+  inputFile_ = 0;
+}
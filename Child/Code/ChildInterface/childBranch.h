@@ -0,0 +1,99 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file childBranch.h
+**
+**  @brief Header file for childBranch, a driver that runs a spin-up once
+**         and then branches it into several scenarios.
+**
+**  A childBranch runs the model (a childInterface) from the initial
+**  condition to the branching time, then forks one process per
+**  scenario. Each forked process starts from the spun-up state (the
+**  operating system shares the parent's memory copy-on-write, so no
+**  re-reading, re-meshing or copying is needed), applies the scenario's
+**  overrides, and runs to the end of the run, writing the usual CHILD
+**  output files under its own name. No more than a given number of
+**  scenarios run at once.
+**
+**  The following keywords are read from the main input file:
+**
+**    BRANCH_TIME          duration of the spin-up (required)
+**    BRANCH_SCENARIOS     name of the scenario file (required)
+**    BRANCH_PROCESSES     maximum number of scenarios running at once
+**                         (default 0 = one per core)
+**
+**  The scenario file holds one block per scenario. Blank lines and lines
+**  starting with '#' are ignored:
+**
+**    SCENARIO <name>              starts a scenario; its output files are
+**                                 named <OUTFILENAME>_<name>
+**    OPTION <option name> <int>   calls ChangeOption( option name, int ),
+**                                 e.g. "OPTION no uplift 1"
+**    VALUES <value set> <file>    calls SetValueSet( value set, values ),
+**                                 with the values read from <file>, one
+**                                 per node in order of permanent ID
+**    SEED <long>                  re-seeds the random number generator
+**
+**  Each scenario's screen output goes to <OUTFILENAME>_<name>.log.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef CHILDBRANCH_H
+#define CHILDBRANCH_H
+
+#include <string>
+#include <vector>
+#include "childInterface.h"
+
+/**************************************************************************/
+/**
+**  Class childBranch
+**
+**  Holds the model that is spun up and the list of scenarios, and runs
+**  the scenarios in a pool of forked processes.
+*/
+/**************************************************************************/
+class childBranch
+{
+public:
+  childBranch();
+  ~childBranch();
+  void Initialize( int argc, char **argv );
+  int Run();   // returns the number of scenarios that failed
+  void CleanUp();
+
+private:
+  // One scenario: a name and the overrides to apply at the branch time
+  struct tScenario
+  {
+    std::string name;
+    std::vector< std::pair<std::string, int> > options;       // ChangeOption
+    std::vector< std::pair<std::string, std::string> > valueFiles; // SetValueSet
+    bool setSeed;
+    long seed;
+    tScenario() : setSeed(false), seed(0) {}
+  };
+
+  void ReadScenarios( const std::string &fileName );
+  void RunScenario( const tScenario & );  // runs in the forked process
+
+  childInterface model_;                // model spun up in the parent
+  tInputFile *inputFile_;               // main input file
+  std::vector<tScenario> scenarios_;
+  std::string outName_;                 // OUTFILENAME from the input file
+  double branchTime_;                   // duration of the spin-up
+  double endTime_;                      // time at which the run ends
+  int maxProcesses_;
+  bool writeOutput_;                    // false with --no-write-mode
+};
+
+#endif
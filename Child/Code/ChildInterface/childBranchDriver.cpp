@@ -0,0 +1,33 @@
+/**************************************************************************/
+/**
+**  childBranchDriver.cpp: Runs a spin-up once, then branches it into
+**  scenarios run in separate processes (see childBranch.h for the input
+**  keywords and the scenario file format).
+**
+**  Usage: childbranch [--silent-mode] <input file>
+**
+**  The exit status is the number of scenarios that failed.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include "childBranch.h"
+
+int main( int argc, char **argv )
+{
+	childBranch myBranch;
+
+	myBranch.Initialize( argc, argv );
+	int numFailed = myBranch.Run();
+	myBranch.CleanUp();
+
+	return numFailed;
+}
@@ -0,0 +1,557 @@
+/**************************************************************************/
+/**
+**  @file childCalibration.cpp
+**
+**  @brief Functions for class childCalibration, which calibrates model
+**         parameters against a target DEM (see childCalibration.h).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include <limits>
+#include <map>
+#include <iomanip>
+#include "childCalibration.h"
+
+// Misfit given to a parameter set whose forward model failed
+static const double kFailedMisfit = std::numeric_limits<double>::max();
+
+childCalibration::
+childCalibration() :
+  numCols_(0), numRows_(0), xllCorner_(0.0), yllCorner_(0.0),
+  cellSize_(0.0), noData_(-9999.0),
+  popSize_(20), numGenerations_(10), generation_(0), mutationSD_(0.1),
+  maxProcesses_(1), rand_(0)
+{}
+
+/**************************************************************************/
+/**
+**  Initialize
+**
+**  Reads the calibration keywords, the parameter file and the target DEM,
+**  and either makes a random first population or, with CALIB_RESTART,
+**  reads the state saved at the end of the last complete generation.
+**
+**  The model itself is not initialized here: each forward model does
+**  that in its own process.
+*/
+/**************************************************************************/
+void childCalibration::
+Initialize( int argc, char **argv )
+{
+  tOption option( argc, argv );
+  inputFileName_ = option.inputFile;
+  tInputFile inputFile( option.inputFile );
+
+  outName_ = inputFile.ReadString( "OUTFILENAME" );
+  popSize_ = inputFile.ReadInt( "CALIB_POPSIZE", false );
+  if( popSize_<=0 ) popSize_ = 20;
+  if( popSize_<2 )
+    ReportFatalError( "CALIB_POPSIZE must be at least 2." );
+  numGenerations_ = inputFile.ReadInt( "CALIB_GENERATIONS", false );
+  if( numGenerations_<=0 ) numGenerations_ = 10;
+  mutationSD_ = inputFile.ReadDouble( "CALIB_MUTATION", false );
+  if( mutationSD_<=0.0 ) mutationSD_ = 0.1;
+  maxProcesses_ = inputFile.ReadInt( "CALIB_PROCESSES", false );
+  if( maxProcesses_<=0 )
+  {
+    long ncores = sysconf( _SC_NPROCESSORS_ONLN );
+    maxProcesses_ = ( ncores>0 ) ? static_cast<int>( ncores ) : 1;
+  }
+  long seed = inputFile.ReadLong( "CALIB_SEED", false );
+  if( seed==0 ) seed = inputFile.ReadLong( "SEED" );
+  rand_.init( seed );
+
+  ReadParameters( inputFile.ReadString( "CALIB_PARAMS" ) );
+  ReadTarget( inputFile.ReadString( "CALIB_TARGET" ) );
+
+  if( inputFile.ReadBool( "CALIB_RESTART", false ) )
+  {
+    ReadCheckpoint();
+    std::cout << "Resuming calibration after generation " << generation_
+	      << "\n";
+  }
+  else
+  {
+    // Random first population, to be evaluated by Run
+    population_.assign( popSize_, std::vector<double>( params_.size() ) );
+    misfit_.assign( popSize_, -1.0 );
+    for( int k=0; k<popSize_; ++k )
+      for( size_t i=0; i<params_.size(); ++i )
+	population_[k][i] = rand_.ran3();
+
+    // Start a fresh table of evaluated parameter sets
+    std::string name = outName_ + ".calib";
+    std::ofstream table( name.c_str() );
+    if( !table.good() )
+      ReportFatalError( "childCalibration: unable to open output file." );
+    table << "# generation member";
+    for( size_t i=0; i<params_.size(); ++i )
+      table << " " << params_[i].keyword;
+    table << " misfit\n";
+  }
+}
+
+/**************************************************************************/
+/**
+**  ReadParameters
+**
+**  Reads the parameter file (see childCalibration.h for its format).
+*/
+/**************************************************************************/
+void childCalibration::
+ReadParameters( const std::string &fileName )
+{
+  std::ifstream paramFile( fileName.c_str() );
+  if( !paramFile.good() )
+  {
+    std::cerr << "childCalibration: unable to open '" << fileName << "'\n";
+    ReportFatalError( "The parameter file may not exist or may be mis-named." );
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while( std::getline( paramFile, line ) )
+  {
+    ++lineNumber;
+    std::istringstream lineStream( line );
+    tParameter param;
+    if( !( lineStream >> param.keyword ) || param.keyword[0]=='#' )
+      continue;
+    std::string scale;
+    bool ok = !( lineStream >> param.minValue >> param.maxValue ).fail();
+    lineStream >> scale;
+    param.logScale = ( scale=="log" );
+    if( ok && !scale.empty() && !param.logScale )
+      ok = false;
+    if( ok && !( param.maxValue>param.minValue ) )
+      ok = false;
+    if( ok && param.logScale && param.minValue<=0.0 )
+      ok = false;
+    if( !ok )
+    {
+      std::cerr << "childCalibration: can't make sense of line " << lineNumber
+		<< " of '" << fileName << "':\n" << line << "\n";
+      ReportFatalError( "Error in parameter file." );
+    }
+    params_.push_back( param );
+  }
+  if( params_.empty() )
+    ReportFatalError( "childCalibration: the parameter file holds no parameters." );
+}
+
+/**************************************************************************/
+/**
+**  ReadTarget
+**
+**  Reads the target DEM from an ESRI ASCII grid: a header of keyword/value
+**  lines (ncols, nrows, xllcorner or xllcenter, yllcorner or yllcenter,
+**  cellsize and, optionally, nodata_value), then the elevations by rows,
+**  starting with the northernmost.
+*/
+/**************************************************************************/
+void childCalibration::
+ReadTarget( const std::string &fileName )
+{
+  std::ifstream targetFile( fileName.c_str() );
+  if( !targetFile.good() )
+  {
+    std::cerr << "childCalibration: unable to open '" << fileName << "'\n";
+    ReportFatalError( "The target DEM may not exist or may be mis-named." );
+  }
+
+  bool xCenter = false, yCenter = false;
+  cellSize_ = 0.0;
+  for(;;)
+  {
+    targetFile >> std::ws;
+    if( !isalpha( targetFile.peek() ) ) break;
+    std::string key;
+    double value;
+    targetFile >> key >> value;
+    for( size_t i=0; i<key.size(); ++i )
+      key[i] = tolower( key[i] );
+    if( key=="ncols" ) numCols_ = static_cast<int>( value );
+    else if( key=="nrows" ) numRows_ = static_cast<int>( value );
+    else if( key=="xllcorner" ) xllCorner_ = value;
+    else if( key=="yllcorner" ) yllCorner_ = value;
+    else if( key=="xllcenter" ) { xllCorner_ = value; xCenter = true; }
+    else if( key=="yllcenter" ) { yllCorner_ = value; yCenter = true; }
+    else if( key=="cellsize" ) cellSize_ = value;
+    else if( key=="nodata_value" ) noData_ = value;
+    else
+    {
+      std::cerr << "childCalibration: unknown item '" << key << "' in '"
+		<< fileName << "'\n";
+      ReportFatalError( "Error in target DEM." );
+    }
+  }
+  if( numCols_<=0 || numRows_<=0 || cellSize_<=0.0 )
+    ReportFatalError( "childCalibration: the target DEM needs ncols, nrows and cellsize." );
+  if( xCenter ) xllCorner_ -= 0.5*cellSize_;
+  if( yCenter ) yllCorner_ -= 0.5*cellSize_;
+
+  targetZ_.resize( static_cast<size_t>( numCols_ )*numRows_ );
+  for( size_t j=0; j<targetZ_.size(); ++j )
+    if( !( targetFile >> targetZ_[j] ) )
+      ReportFatalError( "childCalibration: the target DEM holds too few values." );
+}
+
+// Converts a value scaled to [0,1] to a value of parameter i
+double childCalibration::
+ParameterValue( size_t i, double u ) const
+{
+  const tParameter &p = params_[i];
+  if( p.logScale )
+    return exp( log( p.minValue ) + u*( log( p.maxValue )-log( p.minValue ) ) );
+  return p.minValue + u*( p.maxValue-p.minValue );
+}
+
+/**************************************************************************/
+/**
+**  Run
+**
+**  Runs the genetic algorithm until CALIB_GENERATIONS generations have
+**  been evaluated, writing the results and a checkpoint after each.
+*/
+/**************************************************************************/
+void childCalibration::
+Run()
+{
+  while( generation_<numGenerations_ )
+  {
+    if( generation_>0 )
+      Breed();
+    EvaluatePopulation();
+    ++generation_;
+    WriteResults();
+    WriteCheckpoint();
+    std::cout << "Generation " << generation_ << ": best misfit "
+	      << misfit_[0] << "\n";
+    std::cout.flush();
+  }
+}
+
+/**************************************************************************/
+/**
+**  EvaluatePopulation
+**
+**  Runs a forward model for each member of the population that has not
+**  been evaluated yet (all but the survivor of the last generation), each
+**  in a forked process, keeping no more than maxProcesses_ running at
+**  once. Each process writes its misfit to a pipe as text. A process
+**  that does not finish normally gives kFailedMisfit.
+**
+**  The results do not depend on the order in which the processes finish,
+**  so a calibration is reproducible whatever the number of processes.
+**  Afterwards the best member is moved to the front of the population.
+*/
+/**************************************************************************/
+void childCalibration::
+EvaluatePopulation()
+{
+  std::cout.flush();
+  std::cerr.flush();
+  fflush( NULL );
+
+  std::map< pid_t, std::pair<int, int> > running;  // ID -> member, pipe
+  int next = 0;
+  for(;;)
+  {
+    while( next<popSize_ && misfit_[next]>=0.0 ) ++next;
+    if( next>=popSize_ && running.empty() ) break;
+
+    if( next<popSize_ && static_cast<int>( running.size() )<maxProcesses_ )
+    {
+      int fds[2];
+      if( pipe( fds )!=0 )
+	ReportFatalError( "childCalibration: unable to open a pipe." );
+      pid_t pid = fork();
+      if( pid<0 )
+	ReportFatalError( "childCalibration: unable to fork a new process." );
+      if( pid==0 )
+      {
+	// Forward-model process: the model's screen output is discarded,
+	// but error messages still go to stderr
+	close( fds[0] );
+	int nullFd = open( "/dev/null", O_WRONLY );
+	if( nullFd>=0 )
+	{
+	  dup2( nullFd, 1 );
+	  close( nullFd );
+	}
+	const double misfit = Evaluate( population_[next] );
+	char buf[64];
+	const int len = snprintf( buf, sizeof(buf), "%.17g\n", misfit );
+	const bool ok = ( write( fds[1], buf, len )==len );
+	close( fds[1] );
+	_exit( ok ? 0 : 1 );
+      }
+      close( fds[1] );
+      running[pid] = std::make_pair( next, fds[0] );
+      misfit_[next] = kFailedMisfit;  // until the result comes in
+      continue;
+    }
+
+    int status;
+    pid_t pid = waitpid( -1, &status, 0 );
+    if( pid<0 )
+    {
+      if( errno==EINTR ) continue;
+      ReportFatalError( "childCalibration: error waiting for forward models." );
+    }
+    std::map< pid_t, std::pair<int, int> >::iterator done = running.find( pid );
+    if( done==running.end() ) continue;
+    const int k = done->second.first;
+    const int fd = done->second.second;
+    std::string result;
+    char buf[64];
+    ssize_t len;
+    while( ( len = read( fd, buf, sizeof(buf) ) )>0 )
+      result.append( buf, len );
+    close( fd );
+    running.erase( done );
+
+    double misfit;
+    std::istringstream resultStream( result );
+    if( WIFEXITED( status ) && WEXITSTATUS( status )==0 &&
+	!( resultStream >> misfit ).fail() )
+      misfit_[k] = misfit;
+    else
+      std::cerr << "childCalibration: forward model for member " << k
+		<< " of generation " << generation_+1 << " failed\n";
+  }
+
+  // Put the best member first; ties go to the lower index
+  int best = 0;
+  for( int k=1; k<popSize_; ++k )
+    if( misfit_[k]<misfit_[best] ) best = k;
+  std::swap( population_[0], population_[best] );
+  std::swap( misfit_[0], misfit_[best] );
+}
+
+/**************************************************************************/
+/**
+**  Evaluate
+**
+**  Runs in a forked process: runs the model to the end of the run with
+**  the given (scaled) parameter values and returns the misfit.
+*/
+/**************************************************************************/
+double childCalibration::
+Evaluate( const std::vector<double> &u )
+{
+  childInterface model;
+  for( size_t i=0; i<params_.size(); ++i )
+  {
+    std::ostringstream value;
+    value << std::setprecision( 17 ) << ParameterValue( i, u[i] );
+    model.OverrideInput( params_[i].keyword, value.str() );
+  }
+  model.Initialize( "--silent-mode --no-write-mode " + inputFileName_ );
+  model.Run( 0.0 );
+  return Misfit( model );
+}
+
+/**************************************************************************/
+/**
+**  Misfit
+**
+**  Returns the root-mean-square difference between the target DEM and
+**  the model surface at the centers of the target cells (see
+**  childCalibration.h).
+*/
+/**************************************************************************/
+double childCalibration::
+Misfit( childInterface &model ) const
+{
+  tMesh<tLNode> *mesh = model.GetMeshPointer();
+  double sumSq = 0.0;
+  long count = 0;
+  for( int row=0; row<numRows_; ++row )
+  {
+    const double y = yllCorner_ + ( numRows_-row-0.5 )*cellSize_;
+    for( int col=0; col<numCols_; ++col )
+    {
+      const double z = targetZ_[ static_cast<size_t>( row )*numCols_+col ];
+      if( z==noData_ ) continue;
+      const double x = xllCorner_ + ( col+0.5 )*cellSize_;
+      tTriangle *tri = mesh->LocateTriangle( x, y );
+      if( tri==0 ) continue;
+      const double dz = PlaneFit( x, y, tri ) - z;
+      sumSq += dz*dz;
+      ++count;
+    }
+  }
+  if( count==0 )
+    ReportFatalError( "childCalibration: the target DEM does not overlap the mesh." );
+  return sqrt( sumSq/count );
+}
+
+/**************************************************************************/
+/**
+**  Breed
+**
+**  Replaces the population with the next generation. The best member
+**  (at the front, see EvaluatePopulation) survives unchanged, with its
+**  misfit; each of the others is bred from two parents chosen by
+**  tournament, by blend crossover (BLX-0.5: each value is drawn uniformly
+**  from the parents' interval widened by half its length on each side)
+**  followed by a Gaussian mutation, and kept within [0,1].
+*/
+/**************************************************************************/
+void childCalibration::
+Breed()
+{
+  const double kBlend = 0.5;
+  std::vector< std::vector<double> > offspring( popSize_ );
+  offspring[0] = population_[0];
+  for( int k=1; k<popSize_; ++k )
+  {
+    const std::vector<double> &a = population_[ Tournament() ];
+    const std::vector<double> &b = population_[ Tournament() ];
+    offspring[k].resize( params_.size() );
+    for( size_t i=0; i<params_.size(); ++i )
+    {
+      const double lo = std::min( a[i], b[i] ), hi = std::max( a[i], b[i] );
+      double u = lo - kBlend*( hi-lo ) + rand_.ran3()*( 1.0+2.0*kBlend )*( hi-lo );
+      // Box-Muller transform for the mutation
+      double r1;
+      do r1 = rand_.ran3(); while( r1<=0.0 );
+      const double r2 = rand_.ran3();
+      u += mutationSD_*sqrt( -2.0*log( r1 ) )*cos( 2.0*PI*r2 );
+      if( u<0.0 ) u = 0.0;
+      if( u>1.0 ) u = 1.0;
+      offspring[k][i] = u;
+    }
+  }
+  population_.swap( offspring );
+  for( int k=1; k<popSize_; ++k )
+    misfit_[k] = -1.0;
+}
+
+// Returns the better of two members drawn at random
+int childCalibration::
+Tournament()
+{
+  int a = static_cast<int>( rand_.ran3()*popSize_ );
+  int b = static_cast<int>( rand_.ran3()*popSize_ );
+  if( a>=popSize_ ) a = popSize_-1;
+  if( b>=popSize_ ) b = popSize_-1;
+  return ( misfit_[b]<misfit_[a] ) ? b : a;
+}
+
+/**************************************************************************/
+/**
+**  WriteResults
+**
+**  Adds the generation just evaluated to <OUTFILENAME>.calib and writes
+**  the best parameter set so far to <OUTFILENAME>.calib.best.
+*/
+/**************************************************************************/
+void childCalibration::
+WriteResults() const
+{
+  std::string name = outName_ + ".calib";
+  std::ofstream table( name.c_str(), std::ios::app );
+  if( !table.good() )
+    ReportFatalError( "childCalibration: unable to open output file." );
+  table << std::setprecision( 10 );
+  for( int k=0; k<popSize_; ++k )
+  {
+    table << generation_ << " " << k;
+    for( size_t i=0; i<params_.size(); ++i )
+      table << " " << ParameterValue( i, population_[k][i] );
+    table << " " << misfit_[k] << "\n";
+  }
+
+  name = outName_ + ".calib.best";
+  std::ofstream best( name.c_str() );
+  if( !best.good() )
+    ReportFatalError( "childCalibration: unable to open output file." );
+  best << std::setprecision( 17 );
+  best << "# best parameter set after generation " << generation_
+       << ", misfit " << misfit_[0] << "\n";
+  for( size_t i=0; i<params_.size(); ++i )
+    best << params_[i].keyword << "\n" << ParameterValue( i, population_[0][i] )
+	 << "\n";
+}
+
+/**************************************************************************/
+/**
+**  WriteCheckpoint
+**
+**  Saves everything needed to carry on from the end of this generation:
+**  the number of generations done, the optimizer's random sequence, and
+**  the population with its misfits. The file is written under a
+**  temporary name and then renamed, so that a run killed while writing
+**  it leaves the previous checkpoint intact.
+*/
+/**************************************************************************/
+void childCalibration::
+WriteCheckpoint()
+{
+  const std::string name = outName_ + ".calib.ckpt";
+  const std::string tmpName = name + ".tmp";
+  {
+    std::ofstream ckpt( tmpName.c_str() );
+    if( !ckpt.good() )
+      ReportFatalError( "childCalibration: unable to open checkpoint file." );
+    ckpt << std::setprecision( 17 );
+    ckpt << generation_ << " " << popSize_ << " " << params_.size() << "\n";
+    rand_.dumpToFile( ckpt );
+    for( int k=0; k<popSize_; ++k )
+    {
+      for( size_t i=0; i<params_.size(); ++i )
+	ckpt << population_[k][i] << " ";
+      ckpt << misfit_[k] << "\n";
+    }
+    if( !ckpt.good() )
+      ReportFatalError( "childCalibration: error writing checkpoint file." );
+  }
+  if( rename( tmpName.c_str(), name.c_str() )!=0 )
+    ReportFatalError( "childCalibration: unable to rename checkpoint file." );
+}
+
+void childCalibration::
+ReadCheckpoint()
+{
+  const std::string name = outName_ + ".calib.ckpt";
+  std::ifstream ckpt( name.c_str() );
+  if( !ckpt.good() )
+  {
+    std::cerr << "childCalibration: unable to open '" << name << "'\n";
+    ReportFatalError( "CALIB_RESTART needs the checkpoint of an earlier run." );
+  }
+  int popSize;
+  size_t numParams;
+  ckpt >> generation_ >> popSize >> numParams;
+  if( ckpt.fail() || popSize!=popSize_ || numParams!=params_.size() )
+    ReportFatalError( "childCalibration: the checkpoint does not match CALIB_POPSIZE and the parameter file." );
+  rand_.readFromFile( ckpt );
+  population_.assign( popSize_, std::vector<double>( params_.size() ) );
+  misfit_.assign( popSize_, 0.0 );
+  for( int k=0; k<popSize_; ++k )
+  {
+    for( size_t i=0; i<params_.size(); ++i )
+      ckpt >> population_[k][i];
+    ckpt >> misfit_[k];
+  }
+  if( ckpt.fail() )
+    ReportFatalError( "childCalibration: error reading checkpoint file." );
+}
@@ -0,0 +1,138 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file childCalibration.h
+**
+**  @brief Header file for childCalibration, a driver that calibrates
+**         model parameters against an observed elevation raster.
+**
+**  A childCalibration searches for the parameter values that give the
+**  best fit between the modeled topography at the end of the run and a
+**  target DEM, using a real-coded genetic algorithm: each generation is
+**  a population of parameter sets, which are run as forward models in
+**  separate processes (no more than a given number at once); the next
+**  generation is bred from the better ones by tournament selection,
+**  blend crossover and Gaussian mutation, and the best set so far is
+**  always kept.
+**
+**  Each forward model is a complete CHILD run in --no-write-mode, with
+**  the candidate values in place of those in the input file (see
+**  childInterface::OverrideInput). Running each one in its own process
+**  means that a parameter set that makes the model fail (ReportFatalError
+**  exits the process) only costs that one evaluation, which is given the
+**  largest possible misfit. The misfit is computed in the forward-model
+**  process and sent back through a pipe; no model output is written.
+**
+**  The misfit is the root-mean-square difference between the target and
+**  the model surface, linearly interpolated within the triangle that
+**  holds the center of each target cell. Cells that are NODATA or fall
+**  outside the mesh are skipped.
+**
+**  The following keywords are read from the main input file:
+**
+**    CALIB_PARAMS        name of the parameter file (required)
+**    CALIB_TARGET        target DEM, in ESRI ASCII grid format (required)
+**    CALIB_POPSIZE       number of parameter sets per generation (def. 20)
+**    CALIB_GENERATIONS   number of generations (default 10)
+**    CALIB_MUTATION      standard deviation of mutations, as a fraction
+**                        of each parameter's range (default 0.1)
+**    CALIB_PROCESSES     maximum number of forward models running at
+**                        once (default 0 = one per core)
+**    CALIB_SEED          seed for the optimizer (default SEED)
+**    CALIB_RESTART       1 to resume from the checkpoint file (default 0)
+**
+**  The parameter file holds one line per parameter: an input-file
+**  keyword, its minimum and maximum values, and optionally the word "log"
+**  to search the range on a logarithmic scale. Blank lines and lines
+**  starting with '#' are ignored. For example:
+**
+**    KB   1e-5  1e-3  log
+**    KD   0.001 0.1   log
+**
+**  Output files:
+**
+**    <OUTFILENAME>.calib        every parameter set evaluated: the
+**                               generation, the member, the values and
+**                               the misfit
+**    <OUTFILENAME>.calib.best   the best parameter set found, as input-
+**                               file keyword/value pairs
+**    <OUTFILENAME>.calib.ckpt   optimizer state after the last complete
+**                               generation, read back with CALIB_RESTART
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef CHILDCALIBRATION_H
+#define CHILDCALIBRATION_H
+
+#include <string>
+#include <vector>
+#include "childInterface.h"
+
+/**************************************************************************/
+/**
+**  Class childCalibration
+**
+**  Holds the optimizer state: the parameters being calibrated, the
+**  target DEM, and the current population. Parameter sets are stored
+**  scaled to [0,1] over each parameter's range.
+*/
+/**************************************************************************/
+class childCalibration
+{
+public:
+  childCalibration();
+  void Initialize( int argc, char **argv );
+  void Run();
+
+private:
+  // One parameter to calibrate
+  struct tParameter
+  {
+    std::string keyword;   // keyword in the input file
+    double minValue, maxValue;
+    bool logScale;         // search the range on a log scale
+  };
+
+  void ReadParameters( const std::string &fileName );
+  void ReadTarget( const std::string &fileName );
+  double ParameterValue( size_t i, double u ) const;  // [0,1] -> value
+  void EvaluatePopulation();
+  double Evaluate( const std::vector<double> & );  // in a forked process
+  double Misfit( childInterface & ) const;
+  void Breed();
+  int Tournament();
+  void WriteResults() const;
+  void WriteCheckpoint();
+  void ReadCheckpoint();
+
+  std::string inputFileName_;           // main input file
+  std::string outName_;                 // OUTFILENAME from the input file
+  std::vector<tParameter> params_;
+
+  // Target DEM
+  int numCols_, numRows_;
+  double xllCorner_, yllCorner_, cellSize_;
+  double noData_;
+  std::vector<double> targetZ_;         // by rows, starting at the top
+
+  // Optimizer
+  int popSize_;
+  int numGenerations_;
+  int generation_;                      // number of generations done
+  double mutationSD_;
+  int maxProcesses_;
+  tRand rand_;                          // optimizer's random sequence
+  std::vector< std::vector<double> > population_;  // scaled values
+  std::vector<double> misfit_;          // misfit of each member
+};
+
+#endif
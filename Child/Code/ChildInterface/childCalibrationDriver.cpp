@@ -0,0 +1,30 @@
+/**************************************************************************/
+/**
+**  childCalibrationDriver.cpp: Calibrates model parameters against a
+**  target DEM with a parallel genetic algorithm (see childCalibration.h
+**  for the input keywords and the parameter file format).
+**
+**  Usage: childcalib <input file>
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include "childCalibration.h"
+
+int main( int argc, char **argv )
+{
+	childCalibration myCalibration;
+
+	myCalibration.Initialize( argc, argv );
+	myCalibration.Run();
+
+	return 0;
+}
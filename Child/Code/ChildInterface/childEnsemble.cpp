@@ -0,0 +1,375 @@
+/**************************************************************************/
+/**
+**  @file childEnsemble.cpp
+**
+**  @brief Functions for class childEnsemble, a multithreaded driver for
+**         Monte Carlo ensembles of CHILD runs (see childEnsemble.h).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <unistd.h>
+#include <math.h>
+#include <iomanip>
+#include "childEnsemble.h"
+
+/**************************************************************************/
+/**
+**  Default constructor
+*/
+/**************************************************************************/
+childEnsemble::
+childEnsemble() :
+  numThreads_(1), optAggregate_(false), nextMember_(0)
+{
+  pthread_mutex_init( &queueLock_, NULL );
+  pthread_mutex_init( &aggregateLock_, NULL );
+}
+
+childEnsemble::
+~childEnsemble()
+{
+  CleanUp();
+  pthread_mutex_destroy( &queueLock_ );
+  pthread_mutex_destroy( &aggregateLock_ );
+}
+
+/**************************************************************************/
+/**
+**  Initialize
+**
+**  Initializes the parent model from the command line, reads the
+**  ensemble keywords from the same input file, and makes the members.
+**
+**  The members are made one at a time on the calling thread: reading
+**  input files and copying meshes are not meant to be done concurrently,
+**  and this keeps the parameter draws (and so the whole ensemble)
+**  reproducible regardless of the number of threads.
+*/
+/**************************************************************************/
+void childEnsemble::
+Initialize( int argc, char **argv )
+{
+  // Read, parse and mesh the inputs once
+  base_.Initialize( argc, argv );
+
+  tOption option( argc, argv );
+  tInputFile inputFile( option.inputFile );
+
+  int numMembers = inputFile.ReadInt( "ENSEMBLE_SIZE", false );
+  if( numMembers<=0 ) numMembers = 1;
+  long seed0 = inputFile.ReadLong( "ENSEMBLE_SEED", false );
+  if( seed0==0 ) seed0 = inputFile.ReadLong( "SEED" );
+  numThreads_ = inputFile.ReadInt( "ENSEMBLE_THREADS", false );
+  if( numThreads_<=0 )
+  {
+    long ncores = sysconf( _SC_NPROCESSORS_ONLN );
+    numThreads_ = ( ncores>0 ) ? static_cast<int>( ncores ) : 1;
+  }
+  if( numThreads_>numMembers ) numThreads_ = numMembers;
+  optAggregate_ = inputFile.ReadBool( "ENSEMBLE_AGGREGATE", false );
+  outName_ = inputFile.ReadString( "OUTFILENAME" );
+
+  // Value sets to write, separated by blanks or commas
+  {
+    std::string vars = inputFile.ReadString( "ENSEMBLE_OUTPUTS", false );
+    for( size_t i=0; i<vars.size(); ++i )
+      if( vars[i]==',' ) vars[i] = ' ';
+    std::istringstream varStream( vars );
+    std::string var;
+    while( varStream >> var )
+      outputVars_.push_back( var );
+    if( outputVars_.empty() )
+      outputVars_.push_back( "elevation" );
+  }
+
+  // Output times: every interval from the current time, plus the end
+  {
+    double interval = inputFile.ReadDouble( "ENSEMBLE_OPINTRVL", false );
+    if( interval<=0.0 ) interval = inputFile.ReadDouble( "OPINTRVL" );
+    const double startTime = base_.GetCurrentTime();
+    const double endTime = startTime + base_.GetRemainingRunTime();
+    for( int i=1; startTime+i*interval<endTime; ++i )
+      outputTimes_.push_back( startTime+i*interval );
+    outputTimes_.push_back( endTime );
+  }
+
+  if( optAggregate_ )
+  {
+    const size_t nv = outputVars_.size(), ns = outputTimes_.size();
+    mean_.assign( nv, std::vector< std::vector<double> >( ns ) );
+    m2_.assign( nv, std::vector< std::vector<double> >( ns ) );
+    count_.assign( nv, std::vector<int>( ns, 0 ) );
+  }
+
+  // Parameter variations, if any, are drawn from their own sequence so
+  // that they do not depend on the members' random streams
+  tInputFile *paramFile = 0;
+  {
+    std::string paramFileName =
+      inputFile.ReadString( "ENSEMBLE_PARAMFILE", false );
+    if( !paramFileName.empty() )
+      paramFile = new tInputFile( paramFileName.c_str() );
+  }
+  double delta = inputFile.ReadDouble( "ENSEMBLE_DELTA", false );
+  if( delta<=0.0 ) delta = 1.0;
+  tRand paramRand( seed0 );
+
+  // Make the members
+  std::vector<long> seeds( numMembers );
+  members_.resize( numMembers );
+  memberParams_.resize( numMembers );
+  for( int k=0; k<numMembers; ++k )
+  {
+    members_[k] = new childInterface;
+    members_[k]->Initialize_Copy( base_ );
+    if( paramFile )
+      memberParams_[k] =
+	members_[k]->VaryParameters( *paramFile, delta, paramRand );
+    seeds[k] = seed0 + k;
+    members_[k]->SetRandomStream( seed0, k );
+    std::ostringstream timeFile;
+    timeFile << outName_ << ".m" << k << ".run.time";
+    members_[k]->SetTimeStatusFile( timeFile.str() );
+  }
+  delete paramFile;
+
+  WriteParameterTable( seeds );
+
+  if( !option.silent_mode )
+    std::cout << "Ensemble of " << numMembers << " members on "
+	      << numThreads_ << " threads\n";
+}
+
+/**************************************************************************/
+/**
+**  Run
+**
+**  Runs all members to the end of the run on the thread pool, then
+**  writes the aggregated output (if selected).
+*/
+/**************************************************************************/
+void childEnsemble::
+Run()
+{
+  nextMember_ = 0;
+  std::vector<pthread_t> threads( numThreads_ );
+  for( int i=0; i<numThreads_; ++i )
+    if( pthread_create( &threads[i], NULL, Worker, this )!=0 )
+      ReportFatalError( "childEnsemble: unable to create thread." );
+  for( int i=0; i<numThreads_; ++i )
+    pthread_join( threads[i], NULL );
+
+  if( optAggregate_ )
+    WriteAggregateOutput();
+}
+
+void childEnsemble::
+CleanUp()
+{
+  for( size_t k=0; k<members_.size(); ++k )
+    delete members_[k];
+  members_.clear();
+  base_.CleanUp();
+}
+
+/**************************************************************************/
+/**
+**  Worker
+**
+**  Thread entry point: runs members until there are none left.
+*/
+/**************************************************************************/
+void * childEnsemble::
+Worker( void *ensemble )
+{
+  childEnsemble *ens = static_cast<childEnsemble *>( ensemble );
+  int k;
+  while( (k = ens->NextMember())>=0 )
+    ens->RunMember( k );
+  return NULL;
+}
+
+// Returns the index of the next member to run, or -1 if all are taken
+int childEnsemble::
+NextMember()
+{
+  pthread_mutex_lock( &queueLock_ );
+  int k = -1;
+  if( nextMember_<getSize() )
+    k = nextMember_++;
+  pthread_mutex_unlock( &queueLock_ );
+  return k;
+}
+
+/**************************************************************************/
+/**
+**  RunMember
+**
+**  Runs member k storm by storm, writing the value sets at each output
+**  time. As in CHILD's own output, a storm is not cut short at an output
+**  time; the output is written at the end of the first storm that
+**  reaches it.
+*/
+/**************************************************************************/
+void childEnsemble::
+RunMember( int k )
+{
+  childInterface *member = members_[k];
+
+  std::vector<std::ofstream *> files;
+  if( !optAggregate_ )
+  {
+    for( size_t v=0; v<outputVars_.size(); ++v )
+    {
+      std::ostringstream name;
+      name << outName_ << ".m" << k << "." << outputVars_[v];
+      files.push_back( new std::ofstream( name.str().c_str() ) );
+      if( !files.back()->good() )
+	ReportFatalError( "childEnsemble: unable to open output file." );
+    }
+  }
+
+  int step = 0;
+  const int numSteps = static_cast<int>( outputTimes_.size() );
+  while( member->GetRemainingRunTime()>0.0 )
+  {
+    const double now = member->RunOneStorm();
+    while( step<numSteps-1 && now>=outputTimes_[step] )
+      RecordOutput( k, step++, files );
+  }
+  while( step<numSteps )
+    RecordOutput( k, step++, files );
+
+  for( size_t v=0; v<files.size(); ++v )
+    delete files[v];
+}
+
+/**************************************************************************/
+/**
+**  RecordOutput
+**
+**  Writes member k's value sets for the given output step to its files,
+**  or adds them to the ensemble statistics. The per-member files follow the
+**  layout of CHILD's node output files: the time, the number of values,
+**  then one value per line.
+**
+**  If members end up with different numbers of nodes (e.g., with mesh
+**  densification or meandering), node-by-node statistics are
+**  meaningless, so members that do not match the first one to report are
+**  left out of the statistics with a warning.
+**
+**  The mean and the sum of squared deviations from it are updated one
+**  member at a time (Welford's method), which, unlike accumulating the
+**  sum of squares, does not lose the variance to cancellation when it is
+**  small next to the mean (e.g., for elevations).
+*/
+/**************************************************************************/
+void childEnsemble::
+RecordOutput( int k, int step, std::vector<std::ofstream *> &files )
+{
+  const double now = members_[k]->GetCurrentTime();
+  for( size_t v=0; v<outputVars_.size(); ++v )
+  {
+    std::vector<double> values = members_[k]->GetValueSet( outputVars_[v] );
+    if( !optAggregate_ )
+    {
+      std::ofstream &file = *files[v];
+      file << " " << now << "\n" << values.size() << "\n";
+      for( size_t i=0; i<values.size(); ++i )
+	file << values[i] << "\n";
+      file.flush();
+      continue;
+    }
+    pthread_mutex_lock( &aggregateLock_ );
+    std::vector<double> &mean = mean_[v][step], &m2 = m2_[v][step];
+    if( count_[v][step]==0 )
+    {
+      mean.assign( values.size(), 0.0 );
+      m2.assign( values.size(), 0.0 );
+    }
+    if( values.size()==mean.size() )
+    {
+      const int n = ++count_[v][step];
+      for( size_t i=0; i<values.size(); ++i )
+      {
+	const double d = values[i] - mean[i];
+	mean[i] += d/n;
+	m2[i] += d*( values[i] - mean[i] );
+      }
+    }
+    else
+    {
+      std::cerr << "childEnsemble: member " << k << " has "
+		<< values.size() << " values of " << outputVars_[v]
+		<< " rather than " << mean.size() << "\n";
+      ReportWarning( "member left out of ensemble statistics." );
+    }
+    pthread_mutex_unlock( &aggregateLock_ );
+  }
+}
+
+/**************************************************************************/
+/**
+**  WriteAggregateOutput
+**
+**  Writes, for each value set, a file <OUTFILENAME>.ens.<name> holding,
+**  for each output time, the time, the number of values and the number
+**  of members averaged, then the mean and standard deviation on each
+**  line.
+*/
+/**************************************************************************/
+void childEnsemble::
+WriteAggregateOutput()
+{
+  for( size_t v=0; v<outputVars_.size(); ++v )
+  {
+    std::string name = outName_ + ".ens." + outputVars_[v];
+    std::ofstream file( name.c_str() );
+    if( !file.good() )
+      ReportFatalError( "childEnsemble: unable to open output file." );
+    for( size_t s=0; s<outputTimes_.size(); ++s )
+    {
+      const std::vector<double> &mean = mean_[v][s], &m2 = m2_[v][s];
+      const int n = count_[v][s];
+      file << " " << outputTimes_[s] << "\n" << mean.size() << " " << n
+	   << "\n";
+      for( size_t i=0; i<mean.size(); ++i )
+	file << mean[i] << " " << sqrt( m2[i]/n ) << "\n";
+    }
+  }
+}
+
+/**************************************************************************/
+/**
+**  WriteParameterTable
+**
+**  Writes <OUTFILENAME>.ens.params, with one line per member: the member
+**  number, its random seed (with RAND_GENERATOR 1, member k uses stream k
+**  of ENSEMBLE_SEED instead), and the values of any varied parameters
+**  (in the order used by VaryParameters).
+*/
+/**************************************************************************/
+void childEnsemble::
+WriteParameterTable( const std::vector<long> &seeds )
+{
+  std::string name = outName_ + ".ens.params";
+  std::ofstream file( name.c_str() );
+  if( !file.good() )
+    ReportFatalError( "childEnsemble: unable to open output file." );
+  file << std::setprecision( 10 );
+  for( int k=0; k<getSize(); ++k )
+  {
+    file << k << " " << seeds[k];
+    for( size_t i=0; i<memberParams_[k].size(); ++i )
+      file << " " << memberParams_[k][i];
+    file << "\n";
+  }
+}
@@ -0,0 +1,108 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file childEnsemble.h
+**
+**  @brief Header file for childEnsemble, a multithreaded driver for
+**         Monte Carlo ensembles of CHILD runs.
+**
+**  A childEnsemble reads and meshes the input file once (in a "parent"
+**  childInterface), then makes each ensemble member as a copy of the
+**  parent with childInterface::Initialize_Copy. Each member gets its own
+**  random number seed and, optionally, its own set of parameter values
+**  (see childInterface::VaryParameters). The members are then run
+**  concurrently on a pool of threads, and the selected value sets
+**  (elevation, erosion, discharge, ...) are written either to one file
+**  per member or as an ensemble mean and standard deviation.
+**
+**  The following (optional) keywords are read from the main input file:
+**
+**    ENSEMBLE_SIZE        number of members (default 1)
+**    ENSEMBLE_SEED        seed of member 0; member k uses seed+k, or
+**                         with the Philox generator its own stream of
+**                         this seed (default SEED)
+**    ENSEMBLE_THREADS     number of threads (default 0 = one per core)
+**    ENSEMBLE_OUTPUTS     value sets to write, e.g. "elevation erosion"
+**                         (default elevation)
+**    ENSEMBLE_OPINTRVL    time between outputs (default OPINTRVL)
+**    ENSEMBLE_AGGREGATE   1 = write ensemble mean and standard deviation,
+**                         0 = write one file per member (default 0)
+**    ENSEMBLE_PARAMFILE   input file with the amounts by which to vary
+**                         parameters (see VaryParameters; default none)
+**    ENSEMBLE_DELTA       step size multiplying those amounts (default 1)
+**
+**  Each model keeps its parameters in its own tModelContext, so the
+**  members share no mutable state with one another. Each member reports
+**  its progress to its own <OUTFILENAME>.m<k>.run.time rather than to
+**  run.time. Messages to the screen from different members do
+**  interleave, so it is best to run with --silent-mode.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef CHILDENSEMBLE_H
+#define CHILDENSEMBLE_H
+
+#include <pthread.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "childInterface.h"
+
+/**************************************************************************/
+/**
+**  Class childEnsemble
+**
+**  Holds the parent model and the ensemble members, and runs the members
+**  on a pool of threads. Each thread repeatedly takes the next member
+**  that has not yet been run and runs it to the end, so the threads stay
+**  busy even when members differ in run time.
+*/
+/**************************************************************************/
+class childEnsemble
+{
+public:
+  childEnsemble();
+  ~childEnsemble();
+  void Initialize( int argc, char **argv );
+  void Run();
+  void CleanUp();
+  int getSize() const { return static_cast<int>( members_.size() ); }
+  childInterface * getMember( int k ) { return members_[k]; }
+
+private:
+  static void * Worker( void * );   // thread entry point
+  int NextMember();                 // hands out members to the threads
+  void RunMember( int k );
+  void RecordOutput( int k, int step, std::vector<std::ofstream *> &files );
+  void WriteAggregateOutput();
+  void WriteParameterTable( const std::vector<long> &seeds );
+
+  childInterface base_;                      // parsed and meshed "parent"
+  std::vector<childInterface *> members_;    // copies of the parent
+  std::vector< std::vector<double> > memberParams_; // varied parameters
+  std::vector<std::string> outputVars_;      // value sets to write
+  std::vector<double> outputTimes_;          // times at which to write
+  std::string outName_;                      // base name for output files
+  int numThreads_;
+  bool optAggregate_;
+
+  // Running means and sums of squared deviations (Welford) for
+  // aggregated output, indexed [variable][output step]
+  std::vector< std::vector< std::vector<double> > > mean_, m2_;
+  std::vector< std::vector<int> > count_;
+
+  int nextMember_;                 // next member to hand out
+  pthread_mutex_t queueLock_;      // protects nextMember_
+  pthread_mutex_t aggregateLock_;  // protects the running statistics
+};
+
+#endif
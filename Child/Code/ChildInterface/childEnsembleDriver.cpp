@@ -0,0 +1,30 @@
+/**************************************************************************/
+/**
+**  childEnsembleDriver.cpp: Runs a Monte Carlo ensemble of CHILD models
+**  on a pool of threads (see childEnsemble.h for the input keywords).
+**
+**  Usage: childensemble [--silent-mode] <input file>
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include "childEnsemble.h"
+
+int main( int argc, char **argv )
+{
+	childEnsemble myEnsemble;
+
+	myEnsemble.Initialize( argc, argv );
+	myEnsemble.Run();
+	myEnsemble.CleanUp();
+
+	return 0;
+}
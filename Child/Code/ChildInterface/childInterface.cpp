@@ -21,8 +21,6 @@
 
 using namespace std;
 
-Predicates predicate;
-
 /**************************************************************************/
 /**
  **  Default constructor for childInterface
@@ -31,7 +29,13 @@ Predicates predicate;
  */
 /**************************************************************************/
 childInterface::
-childInterface() : element_set_id("CHILD_node_element_set"), 
+childInterface() :
+floodplainTask_( this, &childInterface::FloodplainStage ),
+exposureTask_( this, &childInterface::ExposureStage ),
+loessTask_( this, &childInterface::LoessStage ),
+upliftTask_( this, &childInterface::UpliftStage ),
+trackerTask_( this, &childInterface::TrackerStage ),
+element_set_id("CHILD_node_element_set"), 
 element_set_description( "Element set interface for CHILD's voronoi nodes" ),
 version(0)
 {
@@ -39,6 +43,12 @@ version(0)
 	
 	rand = NULL;
 	mesh  = NULL;
+	initialMesh_ = NULL;
+	profiling_ = false;
+	memoryReport_ = NULL;
+	stateHashFile_ = NULL;
+	monitor_ = NULL;
+	stormPlusDryDuration_ = 0.;
 	output = NULL;
 	storm = NULL;
 	strmNet = NULL;
@@ -50,6 +60,7 @@ version(0)
 	stratGrid = NULL;
 	loess = NULL;
 	strmMeander = NULL;
+	equilibCheck = NULL;
 }
 
 
@@ -146,8 +157,11 @@ void childInterface::Initialize_Copy( const childInterface& orig )
   
   if( orig.rand )
     rand = new tRand( *orig.rand );
+  context_ = orig.context_;
+  context_.trackVolume = false;  // (the copy has no steady-state test)
+  context_.vegetation = 0;       // (set when the vegetation is copied)
   if( orig.mesh )
-    mesh  = new tMesh<tLNode>( orig.mesh );
+    mesh  = new tMesh<tLNode>( orig.mesh, &context_ );
   // copying output objects too problematic:
   output = 0;
   //   if( orig.output )
@@ -177,6 +191,7 @@ void childInterface::Initialize_Copy( const childInterface& orig )
   if( orig.vegetation )
   {
     vegetation = new tVegetation( *orig.vegetation );
+    vegetation->AttachToMesh( mesh );
     if( vegetation->FirePtr() )
       vegetation->FirePtr()->setTimePtr( time );
     if( vegetation->ForestPtr() )
@@ -206,6 +221,8 @@ void childInterface::Initialize_Copy( const childInterface& orig )
     strmMeander->setRandPtr( rand );
   }
   
+  stormTasks_.SetThreads( orig.stormTasks_.getThreads() );
+  
   element_set_id = orig.element_set_id;
   element_set_description = orig.element_set_description;
   version = orig.version;
@@ -250,6 +267,37 @@ Initialize( std::string argument_string )
   
   // Open main input file
   tInputFile inputFile( option.inputFile );
+  for( size_t i=0; i<inputOverrides_.size(); ++i )
+    inputFile.SetValue( inputOverrides_[i].first.c_str(),
+                        inputOverrides_[i].second.c_str() );
+  if( !inputOverrides_.empty() && !option.no_write_mode )
+    inputFile.writeLogFile();  // record the values actually used
+  tLog::InitializeFromInputFile( inputFile );
+  if( option.profile )
+    profiling_ = tProfiler::Start( inputFile.ReadString( "OUTFILENAME" ),
+                                   option.profile_trace );
+  // Memory report at output times and at the end (see tMemoryAccount)
+  if( inputFile.ReadBool( "OPT_MEMORY_REPORT", false )
+      && !option.no_write_mode )
+  {
+    const string name = inputFile.ReadString( "OUTFILENAME" ) + ".memory";
+    memoryReport_ = new std::ofstream( name.c_str() );
+    if( !memoryReport_->good() )
+      ReportFatalError( "Unable to open the memory report file." );
+  }
+  // State hash at output times, for checking runs match (see tStateHash)
+  if( inputFile.ReadBool( "OPT_STATE_HASH", false )
+      && !option.no_write_mode )
+  {
+    const string name = inputFile.ReadString( "OUTFILENAME" ) + ".hash";
+    stateHashFile_ = new std::ofstream( name.c_str() );
+    if( !stateHashFile_->good() )
+      ReportFatalError( "Unable to open the state hash file." );
+    stateHashFile_->precision( 15 );
+  }
+  // Live state for viewers in other processes (see tSharedMonitor)
+  if( inputFile.ReadBool( "OPT_SHARED_MONITOR", false ) )
+    monitor_ = new tSharedMonitor( inputFile );
   
   // Get various options
   optNoDiffusion = inputFile.ReadBool( "OPTNODIFFUSION", false );
@@ -280,10 +328,17 @@ Initialize( std::string argument_string )
   
   // CREATE AND INITIALIZE OBJECTS
   //
+  // Read parameters shared by all nodes of this model's mesh
+  context_.InitializeFromInputFile( inputFile );
+  
   // Create (or read) model mesh
   if( !option.silent_mode )
     std::cout << "Creating mesh...\n";
-  mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency );
+  if( initialMesh_ )
+    mesh = new tMesh<tLNode>( initialMesh_, &context_ );
+  else
+    mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency,
+                              &context_ );
   
   // Initialize the lithology manager
   lithology_manager_.InitializeFromInputFile( inputFile, mesh );
@@ -397,11 +452,27 @@ Initialize( std::string argument_string )
     erosion->ActivateSedVolumeTracking( &water_sed_tracker_ );
   }
   
+  // If applicable, set up the test for ending the run at steady state
+  if( inputFile.ReadBool( "OPTEQUILIBSTOP", false ) )
+  {
+    if( !inputFile.Contain( "EQUILIB_TOLERANCE" ) )
+      ReportFatalError( "OPTEQUILIBSTOP requires EQUILIB_TOLERANCE." );
+    equilibCheck = new tEquilibCheck( *mesh, *time, inputFile );
+  }
+  
+  // Threads for the closing stages of each storm (see BuildStormTasks)
+  if( inputFile.Contain( "STORM_THREADS" ) )
+    stormTasks_.SetThreads( inputFile.ReadInt( "STORM_THREADS" ) );
+  
   // Write output for time zero
   if( !option.silent_mode )
     std::cout << "Writing data for time zero...\n";
   if( output )
     output->WriteOutput( 0. );
+  WriteMemoryReport();
+  WriteStateHash();
+  if( monitor_ )
+    monitor_->Publish( mesh, 0. );
   
   // Finish up initialization
   initialized = true;
@@ -600,6 +671,7 @@ VaryParameters( const tInputFile &optFile, const double &delta,
 double childInterface::
 RunOneStorm()
 {
+  tProfileScope scope( "Storm" );
   double stormDuration, stormPlusDryDuration;
 	
   /**************** Run 1 storm ****************************************\
@@ -618,21 +690,23 @@ RunOneStorm()
    **      Eolian (loess) deposition (if applicable)
    **      Uplift (or baselevel change)
    **********************************************************************/
-  if(0) //debug
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout << "         " << std::endl;
   time->ReportTimeStatus();
 	
-  // Do storm...
+  // Do storm... (storms that give no runoff may be merged into this one,
+  // up to the next output time; see tStorm::GenerateStorm)
   storm->GenerateStorm( time->getCurrentTime(),
-                       strmNet->getInfilt(), strmNet->getSoilStore() );
+                       strmNet->getInfilt(), strmNet->getSoilStore(),
+                       time->getNextOutputTime() );
   stormDuration = min( storm->getStormDuration(), time->RemainingTime() );
   stormPlusDryDuration = min( storm->getStormDuration() + storm->interstormDur(),
                              time->RemainingTime() );
   
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout << "Remaining time: " << time->RemainingTime() << std::endl;
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout<< "Storm: "<< storm->getRainrate() << " " << storm->getStormDuration() << " "
     << stormDuration << " " << storm->interstormDur() << " " << stormPlusDryDuration 
     << std::endl;
@@ -642,10 +716,9 @@ RunOneStorm()
   // calculated:
   if( !optNoFluvial || optLandslides)
     strmNet->UpdateNet( time->getCurrentTime(), *storm );
-  if(0) //DEBUG
-    std::cout << "UpdateNet::Done.." << std::endl;
+  CHILD_LOG( tLog::kDebug, tLog::kStreamNet, "UpdateNet::Done.." );
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -665,9 +738,12 @@ RunOneStorm()
 	
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
+  {
+    ApplyPendingUplift();  // the grid follows absolute elevations
     stratGrid->UpdateStratGrid(tStratGrid::k0, time->getCurrentTime());
+  }
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -743,7 +819,8 @@ RunOneStorm()
 #undef NEWVEG
   
   //-------------FLUVIAL------------------------------------------
-  if(0) std::cout << "Calculating fluvial erosion and transport ...\n" << std::flush;
+  CHILD_LOG( tLog::kDebug, tLog::kErosion,
+             "Calculating fluvial erosion and transport ..." );
   if( !optNoFluvial )
   {
     if( optDetachLim )
@@ -770,15 +847,14 @@ RunOneStorm()
                                  time->getCurrentTime() );
   }
   
-  if(0) //DEBUG
-    std::cout << "Erosion::Done.." << std::flush;
+  CHILD_LOG( tLog::kDebug, tLog::kErosion, "Erosion::Done.." );
 	
   
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
     stratGrid->UpdateStratGrid(tStratGrid::k1,time->getCurrentTime() );
 	
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -801,72 +877,266 @@ RunOneStorm()
   if( optMeander )
     strmMeander->Migrate( time->getCurrentTime() );
 	
-  if(0) //DEBUG
-    std::cout << "Meander-Migrate::Done..\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMeander, "Meander-Migrate::Done.." );
 	
   // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
   if( optStratGrid )
     stratGrid->UpdateStratGrid(tStratGrid::k2,time->getCurrentTime());
 	
-  //----------------FLOODPLAIN---------------------------------
-  if( optFloodplainDep )
-  {
-    if( floodplain->OptControlMainChan() )
-      floodplain->UpdateMainChannelHeight( time->getCurrentTime(), strmNet->getInletNodePtrNC() );
-    std::cout << "UpdateChannelHeight::Done..\n";
-		
-    if( optStratGrid ){
-      stratGrid->UpdateStratGrid(tStratGrid::k3,time->getCurrentTime());
-    }
-		
-    floodplain->DepositOverbank( storm->getRainrate(),
-                                storm->getStormDuration(),
-                                time->getCurrentTime() );
-    std::cout << "tFloodplain::Done..\n";
-		
-    if( optStratGrid ){
-      stratGrid->UpdateStratGrid(tStratGrid::k4,time->getCurrentTime());
-    }
-		
-  } // end of floodplain stuff
-	
-	
-  // Do interstorm...
-  //Diffusion has now been moved to before fluvial erosion NMG 07/05
-  // erosion.Diffuse( storm.getStormDuration() + storm.interstormDur(),
-  // 		       optDiffuseDepo );
+  //----------------FLOODPLAIN AND INTERSTORM------------------
+  // Floodplain deposition, exposure history, eolian deposition, uplift
+  // and the water/sediment time series, overlapped where they touch
+  // different parts of the model (see BuildStormTasks)
+  stormPlusDryDuration_ = stormPlusDryDuration;
+  BuildStormTasks();
+  stormTasks_.Run();
+  
+  time->Advance( stormPlusDryDuration );
 	
-  erosion->UpdateExposureTime( stormPlusDryDuration );
+  bool wroteOutput = false;
+  if( output > 0 && time->CheckOutputTime() )
+  {
+    ApplyPendingUplift();
+    output->WriteOutput( time->getCurrentTime() );
+    WriteMemoryReport();
+    WriteStateHash();
+    wroteOutput = true;
+  }
 	
-  //----------------EOLIAN------------------------------------
+  if( output > 0 && output->OptTSOutput() )
+  {
+    ApplyPendingUplift();
+    output->WriteTSOutput();
+  }
+  
+  if( monitor_ && monitor_->Due( time->getCurrentTime() ) )
+  {
+    ApplyPendingUplift();
+    monitor_->Publish( mesh, time->getCurrentTime() );
+  }
+  
+  //----------------STEADY STATE------------------------------
+  // With OPTEQUILIBSTOP, end the run (with a last output) once the mean
+  // elevation has stopped changing (see tEquilibCheck)
+  if( equilibCheck && equilibCheck->CheckSteadyState() )
+  {
+    CHILD_LOG( tLog::kInfo, tLog::kGeneral,
+               "Steady state reached at time " << time->getCurrentTime()
+               << " (relative rate of change "
+               << equilibCheck->getRelativeLongRate()
+               << "/yr); ending the run." );
+    if( output && !wroteOutput )
+    {
+      ApplyPendingUplift();
+      output->WriteOutput( time->getCurrentTime() );
+      WriteMemoryReport();
+      WriteStateHash();
+    }
+    time->Start( time->getCurrentTime(), time->getCurrentTime() );
+  }
+  
+  return( time->getCurrentTime() );
+}
+
+
+
+/**************************************************************************/
+/**
+ **  BuildStormTasks
+ **
+ **  Sets up the stages of the current storm that follow erosion and
+ **  meandering (floodplain deposition and the interstorm processes) as a
+ **  task graph, each with the parts of the model it reads and writes, so
+ **  that stages that do not conflict can run at the same time when
+ **  STORM_THREADS is above 1 (the default is 1: the stages run in turn,
+ **  in the order added). Stages that are switched off are left out, so
+ **  that they do not hold up the others. In practice, the exposure-time
+ **  update, uplift (for the types that do not move nodes or alter
+ **  layers) and the water/sediment time series can overlap; floodplain
+ **  and eolian deposition change both elevations and layers and run on
+ **  their own.
+ */
+/**************************************************************************/
+
+void childInterface::
+BuildStormTasks()
+{
+  stormTasks_.Clear();
+  
+  if( optFloodplainDep )
+    stormTasks_.Add( "Floodplain", &floodplainTask_,
+                    kMeshField | kFlowField | kElevationField | kLayerField
+                    | kStratGridField,
+                    kElevationField | kLayerField | kStratGridField );
+  
+  stormTasks_.Add( "ExposureTime", &exposureTask_,
+                  kMeshField, kLayerField );
+  
   if( optLoessDep )
-    loess->DepositLoess( mesh,
-                        stormPlusDryDuration,
-                        time->getCurrentTime() );
-	
-  //----------------TECTONICS---------------------------------
-  if( !optNoUplift )
+    stormTasks_.Add( "Loess", &loessTask_,
+                    kMeshField | kElevationField | kLayerField,
+                    kElevationField | kLayerField );
+  
+  if( !optNoUplift && time->getCurrentTime() < uplift->getDuration() )
   {
-    if( time->getCurrentTime() < uplift->getDuration() )
-      uplift->DoUplift( mesh,
-                       stormPlusDryDuration, 
-                       time->getCurrentTime() );
+    tTaskGraph::tFieldSet writes = kElevationField | kUpliftField;
+    if( uplift->MovesNodes() )
+      writes |= kMeshField;
+    if( uplift->ChangesLayers() )
+      writes |= kLayerField;
+    stormTasks_.Add( "Uplift", &upliftTask_,
+                    kMeshField | kElevationField, writes );
   }
   
   if( optTrackWaterSedTimeSeries && water_sed_tracker_.IsActive() )
-    water_sed_tracker_.WriteAndResetWaterSedTimeseriesData( time->getCurrentTime(),
-                                                           stormPlusDryDuration );
+    stormTasks_.Add( "WaterSedTracker", &trackerTask_,
+                    kMeshField | kFlowField, kTrackerField );
+}
+
+/**************************************************************************/
+/**
+ **  Storm stages
+ **
+ **  The work of each task set up by BuildStormTasks. They use the storm
+ **  and time of the current step, which do not change while they run.
+ */
+/**************************************************************************/
+
+void childInterface::
+FloodplainStage()
+{
+  ApplyPendingUplift();  // overbank deposition uses absolute elevations
+  if( floodplain->OptControlMainChan() )
+    floodplain->UpdateMainChannelHeight( time->getCurrentTime(), strmNet->getInletNodePtrNC() );
+  CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "UpdateChannelHeight::Done.." );
   
-  time->Advance( stormPlusDryDuration );
-	
-  if( output > 0 && time->CheckOutputTime() )
-    output->WriteOutput( time->getCurrentTime() );
-	
-  if( output > 0 && output->OptTSOutput() ) output->WriteTSOutput();
+  if( optStratGrid ){
+    stratGrid->UpdateStratGrid(tStratGrid::k3,time->getCurrentTime());
+  }
   
-  return( time->getCurrentTime() );
+  floodplain->DepositOverbank( storm->getRainrate(),
+                              storm->getStormDuration(),
+                              time->getCurrentTime() );
+  CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "tFloodplain::Done.." );
+  
+  if( optStratGrid ){
+    stratGrid->UpdateStratGrid(tStratGrid::k4,time->getCurrentTime());
+  }
 }
 
+void childInterface::
+ExposureStage()
+{
+  erosion->UpdateExposureTime( stormPlusDryDuration_ );
+}
+
+void childInterface::
+LoessStage()
+{
+  loess->DepositLoess( mesh,
+                      stormPlusDryDuration_,
+                      time->getCurrentTime() );
+}
+
+void childInterface::
+UpliftStage()
+{
+  uplift->DoUplift( mesh,
+                   stormPlusDryDuration_, 
+                   time->getCurrentTime() );
+}
+
+void childInterface::
+TrackerStage()
+{
+  water_sed_tracker_.WriteAndResetWaterSedTimeseriesData( time->getCurrentTime(),
+                                                         stormPlusDryDuration_ );
+}
+
+
+/**************************************************************************/
+/**
+ **  ApplyPendingUplift
+ **
+ **  With lazy uniform uplift (OPT_LAZY_UPLIFT), uplift of the interior is
+ **  kept as a datum offset and the node elevations are only relative (see
+ **  tUplift::UpliftUniform). This brings them up to date; it is called
+ **  wherever absolute elevations are needed: output, floodplain
+ **  deposition, the stratigraphy grid, the end of Run, and the functions
+ **  that give elevations to (or take them from) a calling program.
+ */
+/**************************************************************************/
+
+void childInterface::
+ApplyPendingUplift()
+{
+  if( uplift && mesh )
+    uplift->ApplyPendingUplift( mesh );
+}
+
+
+/**************************************************************************/
+/**
+ **  WriteMemoryReport
+ **
+ **  With OPT_MEMORY_REPORT, adds the object counts and projected footprint
+ **  per node (see tMemoryAccount) to <OUTFILENAME>.memory; called at each
+ **  output time and from CleanUp. The counts are for the whole process,
+ **  so they include any other models running in it.
+ */
+/**************************************************************************/
+
+void childInterface::
+WriteMemoryReport()
+{
+  if( memoryReport_ )
+    tMemoryAccount::WriteReport( *memoryReport_,
+                                 time ? time->getCurrentTime() : 0. );
+}
+
+
+/**************************************************************************/
+/**
+ **  GetStateHash
+ **
+ **  Returns a 64-bit hash of the model state: node positions, elevations
+ **  and layer stacks, the random number generator and the time (see
+ **  tStateHash). Two runs that agree to the last bit have the same hash,
+ **  whatever the number of threads used to compute it.
+ */
+/**************************************************************************/
+
+uint64_t childInterface::
+GetStateHash()
+{
+	if( initialized==false )
+		ReportFatalError( "childInterface must be initialized (with Initialize() method) before GetStateHash() method is called." );
+  return tStateHash::HashModel( mesh, rand, time->getCurrentTime() );
+}
+
+
+/**************************************************************************/
+/**
+ **  WriteStateHash
+ **
+ **  With OPT_STATE_HASH, adds a line "time hash" to <OUTFILENAME>.hash;
+ **  called at each output time. Comparing these files is a quick check
+ **  that two runs (e.g., with different NUM_THREADS) are identical.
+ */
+/**************************************************************************/
+
+void childInterface::
+WriteStateHash()
+{
+  if( !stateHashFile_ )
+    return;
+  const double now = time->getCurrentTime();
+  const string hash =
+    tStateHash::Format( tStateHash::HashModel( mesh, rand, now ) );
+  *stateHashFile_ << now << ' ' << hash << std::endl;
+  CHILD_LOG( tLog::kInfo, tLog::kGeneral,
+             "State hash at time " << now << ": " << hash );
+}
 
 
 /**************************************************************************/
@@ -890,7 +1160,7 @@ Run( double run_duration )
   
   while( !time->IsFinished() )
 		RunOneStorm();
-  
+  ApplyPendingUplift();
 }
 
 
@@ -907,10 +1177,35 @@ Run( double run_duration )
 void childInterface::
 CleanUp()
 {
+	if( profiling_ ) {
+		tProfiler::Stop();
+		profiling_ = false;
+	}
+	if( memoryReport_ ) {  // last report, with the model still in memory
+		WriteMemoryReport();
+		delete memoryReport_;
+		memoryReport_ = NULL;
+	}
+	if( stateHashFile_ ) {
+		delete stateHashFile_;
+		stateHashFile_ = NULL;
+	}
+	if( monitor_ ) {  // last state, before the mesh goes
+		if( mesh && time ) {
+			ApplyPendingUplift();
+			monitor_->Finish( mesh, time->getCurrentTime() );
+		}
+		delete monitor_;
+		monitor_ = NULL;
+	}
 	if( rand ) {
 		delete rand;
 		rand = NULL;
 	}
+	if( equilibCheck ) {  // before the mesh, whose context it uses
+		delete equilibCheck;
+		equilibCheck = NULL;
+	}
 	if( mesh ) {
 		delete mesh;
 		mesh = NULL;
@@ -997,13 +1292,7 @@ childInterface::
 
 void childInterface::ExternalErosionAndDeposition( vector<double> dz )
 {
-  tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
-  tLNode * cn;
-  for( cn=mli.FirstP(); mli.IsActive(); cn=mli.NextP() )
-  {
-    int current_id = cn->getPermID();
-    cn->EroDep( dz[current_id] );
-  }
+  tNodeFields::ErodeDeposit( mesh, &dz[0] );
 }
 
 
@@ -1029,6 +1318,7 @@ void childInterface::ExternalErosionAndDeposition( vector<double> dz )
 
 void childInterface::ExternalErodeAndDepositToElevation( vector<double> z )
 {
+  ApplyPendingUplift();
   tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
   tLNode * cn;
   for( cn=mli.FirstP(); mli.IsActive(); cn=mli.NextP() )
@@ -1229,6 +1519,8 @@ GetZCoordinate( int element_index, int vertex_index )
   tNode * triangle_vertex_node;
   tArray<double> zs;
   
+  ApplyPendingUplift();
+
   // Get the node
   my_node = ni.GetPByPermID( element_index );
   if( my_node<=0 ) return( -9999 );   // Temporary hacked NODATA code
@@ -1302,6 +1594,7 @@ long childInterface::GetNodeCount()
 /**************************************************************************/
 std::vector<double> childInterface::GetNodeCoords()
 {
+  ApplyPendingUplift();
   tLNode *current_node;
   tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
   std::vector<double> coords( 3*mesh->getNodeList()->getSize() );
@@ -1311,7 +1604,7 @@ std::vector<double> childInterface::GetNodeCoords()
     coords[3*current_node->getPermID()+0] = current_node->getX();
     coords[3*current_node->getPermID()+1] = current_node->getY();
     coords[3*current_node->getPermID()+2] = current_node->getZ();
-    if(0) std::cout << "Node " << current_node->getPermID()
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kInterface ) ) std::cout << "Node " << current_node->getPermID()
       << " x=" << current_node->getX()
       << " y=" << current_node->getY()
       << " z=" << current_node->getZ() << std::endl;
@@ -1415,51 +1708,56 @@ GetRemainingRunTime()
 std::vector<double> childInterface::
 GetValueSet( string var_name )
 {
-  if(1) std::cout << "childInterface::GetValueSet() here with request '"
-		<< var_name << "'\n";
+  CHILD_LOG( tLog::kDetail, tLog::kInterface,
+             "childInterface::GetValueSet() here with request '"
+             << var_name << "'" );
   if( var_name.compare( 0,4,"elev" )==0 )
   {
-    if(1) std::cout << "request for elevs\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request for elevs" );
     return GetNodeElevationVector();
   }
   if( var_name.compare( 0,1,"x" )==0 || var_name.compare( 0,5,"nodex" )==0)
   {
-    if(1) std::cout << "request for node x coordinates\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface,
+               "request for node x coordinates" );
     return GetNodeXCoords();
   }
   if( var_name.compare( 0,1,"y" )==0 || var_name.compare( 0,5,"nodey" )==0)
   {
-    if(1) std::cout << "request for node y coordinates\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface,
+               "request for node y coordinates" );
     return GetNodeYCoords();
   }
   else if( var_name.compare( 0,2,"dz" )==0 || var_name.compare( 0,3,"ero" )==0 )
   {
-    if(1) std::cout << "request for dz\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request for dz" );
     return GetNodeErosionVector();
   }
   else if( var_name.compare( 0,5,"disch" )==0 || var_name.compare( 0,5,"water" )==0 )
   {
-    if(1) std::cout << "request for Q\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request for Q" );
     return GetNodeDischargeVector();
   }
   else if( var_name.compare( 0,3,"sed" )==0 )
   {
-    if(1) std::cout << "request for Qs\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request for Qs" );
     return GetNodeSedimentFluxVector();
   }
   else if( var_name.compare( 0,4,"land" )==0 )
 	{
-		if(1) std::cout << "request for landslides\n";
+		CHILD_LOG( tLog::kDetail, tLog::kInterface,
+		           "request for landslides" );
 		return GetLandslideAreasVector();
 	}
   else if( var_name.compare( 0,4,"load" )==0 )
 	{
-		if(1) std::cout << "request for loads\n";
+		CHILD_LOG( tLog::kDetail, tLog::kInterface,
+		           "request for loads" );
 		return GetLoads();
 	}
   else
   {
-    if(1) std::cout << "request for NOTHING!\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request for NOTHING!" );
     std::vector<double> empty_vector;
     return empty_vector;
   };
@@ -1480,17 +1778,9 @@ GetValueSet( string var_name )
 std::vector<double> childInterface::
 GetNodeElevationVector()
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  std::vector<double> elevations( mesh->getNodeList()->getSize() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    if(1) std::cout << "node " << current_node->getPermID()
-      << " z=" << current_node->getZ() << std::endl;
-    elevations[current_node->getPermID()] = current_node->getZ();
-  }
-  
+  ApplyPendingUplift();
+  std::vector<double> elevations( tNodeFields::Size( mesh ) );
+  tNodeFields::Get( mesh, tNodeFields::kElevation, &elevations[0] );
   return elevations;
   
 }
@@ -1509,16 +1799,8 @@ GetNodeElevationVector()
 std::vector<double> childInterface::
 GetNodeErosionVector()
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  std::vector<double> dz( mesh->getNodeList()->getSize() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    dz[current_node->getPermID()] = current_node->getCumulativeEroDep();
-    current_node->ResetCumulativeEroDep();
-  }
-  
+  std::vector<double> dz( tNodeFields::Size( mesh ) );
+  tNodeFields::Get( mesh, tNodeFields::kErosion, &dz[0] );
   return dz;
   
 }
@@ -1539,17 +1821,8 @@ GetNodeErosionVector()
 std::vector<double> childInterface::
 GetNodeDischargeVector()
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  std::vector<double> discharge( mesh->getNodeList()->getSize() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    if(1) std::cout << "NOde " << current_node->getPermID()
-      << " Q=" << current_node->getQ() << std::endl;
-    discharge[current_node->getPermID()] = current_node->getQ();
-  }
-  
+  std::vector<double> discharge( tNodeFields::Size( mesh ) );
+  tNodeFields::Get( mesh, tNodeFields::kDischarge, &discharge[0] );
   return discharge;
   
 }
@@ -1570,17 +1843,8 @@ GetNodeDischargeVector()
 std::vector<double> childInterface::
 GetNodeSedimentFluxVector()
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  std::vector<double> sedflux( mesh->getNodeList()->getSize() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    if(1) std::cout << "noDE " << current_node->getPermID()
-      << " Qs=" << current_node->getQs() << std::endl;
-    sedflux[current_node->getPermID()] = current_node->getQs();
-  }
-  
+  std::vector<double> sedflux( tNodeFields::Size( mesh ) );
+  tNodeFields::Get( mesh, tNodeFields::kSedimentFlux, &sedflux[0] );
   return sedflux;
   
 }
@@ -1627,22 +1891,24 @@ std::vector<double> childInterface::GetLandslideAreasVector()
 void childInterface::
 SetValueSet( string var_name, std::vector<double> value_set )
 {
-  if(1) std::cout << "childInterface::SetValueSet() here with request '"
-    << var_name << "'\n";
+  CHILD_LOG( tLog::kDetail, tLog::kInterface,
+             "childInterface::SetValueSet() here with request '"
+             << var_name << "'" );
   if( var_name.compare( 0,4,"elev" )==0 )
   {
-    if(1) std::cout << "request to set elevs\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request to set elevs" );
     SetNodeElevations( value_set );
   }
   else if( var_name.compare( 0,2,"kr")==0 || var_name.compare( 0,2,"KR" )==0 )
   {
-    if(1) std::cout << "request to set KR\n";
+    CHILD_LOG( tLog::kDetail, tLog::kInterface, "request to set KR" );
     lithology_manager_.SetRockErodibilityValuesAtAllDepths( value_set );
   }
   else
   {
-    std::cout << "Warning: unrecognized value set '" << var_name << "'\n";
-    std::cout << "Request to set values ignored\n";
+    CHILD_LOG( tLog::kWarning, tLog::kInterface,
+               "Warning: unrecognized value set '" << var_name << "'\n"
+               << "Request to set values ignored" );
   }
 }
 
@@ -1710,10 +1976,101 @@ void childInterface::setWriteOption( bool write_mode, tInputFile& inputFile )
 
 void childInterface::WriteChildStyleOutput()
 {
+  ApplyPendingUplift();
   if( output )
     output->WriteOutput( time->getCurrentTime() );
 }
 
+/**************************************************************************/
+/**
+ **  childInterface::SetRandomSeed
+ **
+ **  Re-seeds the model's random number generator. Because the storm
+ **  generator and the meander module hold pointers to this generator
+ **  (and not copies of it), all of them switch to the new sequence. This
+ **  is used to give each "daughter" made with Initialize_Copy its own
+ **  random stream, e.g., for an ensemble (see childEnsemble).
+ */
+/**************************************************************************/
+void childInterface::SetRandomSeed( long seed )
+{
+  if( rand==0 )
+    ReportFatalError( "childInterface must be initialized before SetRandomSeed() is called." );
+  rand->init( seed );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::SetRandomStream
+ **
+ **  Like SetRandomSeed, but for one of a set of models (e.g., ensemble
+ **  member "member"): with the Philox generator (RAND_GENERATOR 1), the
+ **  model switches to its own keyed stream of the given seed; with ran3,
+ **  which has a single sequence per seed, it is re-seeded with
+ **  seed+member.
+ */
+/**************************************************************************/
+void childInterface::SetRandomStream( long seed, unsigned long member )
+{
+  if( rand==0 )
+    ReportFatalError( "childInterface must be initialized before SetRandomStream() is called." );
+  if( rand->getGenerator()==tRand::kPhilox )
+    rand->initStream( seed, tRand::kMemberStream, member );
+  else
+    rand->init( seed + static_cast<long>( member ) );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::SetTimeStatusFile
+ **
+ **  Sets the file to which the model's run timer reports the current time
+ **  (by default, "run.time"), so that models sharing a directory (e.g.,
+ **  ensemble members) don't overwrite each other's.
+ */
+/**************************************************************************/
+void childInterface::SetTimeStatusFile( string name )
+{
+  if( time==0 )
+    ReportFatalError( "childInterface must be initialized before SetTimeStatusFile() is called." );
+  time->setTimeStatusFile( name );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::OverrideInput
+ **
+ **  Sets a value that the next call to Initialize uses in place of the one
+ **  in the input file, for any keyword that appears in the file. This
+ **  lets a driver try out parameter values (e.g., during calibration; see
+ **  childCalibration) without writing a new input file for each one.
+ */
+/**************************************************************************/
+void childInterface::OverrideInput( string keyword, string value )
+{
+  if( initialized )
+    ReportFatalError( "childInterface::OverrideInput() must be called before Initialize()." );
+  inputOverrides_.push_back( std::make_pair( keyword, value ) );
+}
+
+/**************************************************************************/
+/**
+ **  childInterface::UseInitialMesh
+ **
+ **  Makes the next call to Initialize start from a copy of the given mesh
+ **  instead of building (or reading) one as the input file says. The
+ **  mesh must be one built from the same mesh parameters, and not yet
+ **  modified by a model run (e.g., one held in childSweep's mesh cache);
+ **  it must still exist when Initialize is called.
+ */
+/**************************************************************************/
+void childInterface::UseInitialMesh( const tMesh<tLNode> *initialMesh )
+{
+  if( initialized )
+    ReportFatalError( "childInterface::UseInitialMesh() must be called before Initialize()." );
+  initialMesh_ = initialMesh;
+}
+
 /**************************************************************************/
 /**
  **  childInterface::ChangeOption
@@ -1782,17 +2139,8 @@ void childInterface::ChangeOption( string option, int val )
 void childInterface::
 SetNodeElevations( std::vector<double> elevations )
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    if(1) std::cout << "node " << current_node->getPermID()
-      << " changing z from " << current_node->getZ() 
-      << " to " << elevations[current_node->getPermID()] << std::endl;
-    current_node->setZ( elevations[current_node->getPermID()] );
-  }
-  
+  ApplyPendingUplift();
+  tNodeFields::SetElevations( mesh, &elevations[0] );
 }
 
 
@@ -1814,19 +2162,7 @@ SetNodeElevations( std::vector<double> elevations )
 void childInterface::
 AdjustElevations( std::vector<double> dz )
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  
-  for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
-  {
-    if(0) std::cout << "Adjust elevations: node " << current_node->getPermID()
-      << " changing z from " << current_node->getZ() 
-      << " to " 
-      << current_node->getZ() + dz[current_node->getPermID()] 
-      << std::endl;
-    current_node->ChangeZ( dz[current_node->getPermID()] );
-  }
-  
+  tNodeFields::AdjustElevations( mesh, &dz[0], false );
 }
 
 /**************************************************************************/
@@ -1848,20 +2184,7 @@ AdjustElevations( std::vector<double> dz )
 void childInterface::
 AdjustInteriorElevations( std::vector<double> dz )
 {
-  tLNode *current_node;
-  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
-  
-  for( current_node=ni.FirstP(); ni.IsActive(); current_node=ni.NextP() )
-  {
-    if(1) std::cout << "AdjustInteriorElevations: node " 
-      << current_node->getPermID()
-      << " changing z from " << current_node->getZ() 
-      << " to " 
-      << current_node->getZ() + dz[current_node->getPermID()] 
-      << std::endl;
-    current_node->ChangeZ( dz[current_node->getPermID()] );
-  }
-  
+  tNodeFields::AdjustElevations( mesh, &dz[0], true );
 }
 
 
@@ -1924,7 +2247,7 @@ GetLoads()
 	for( current_node=ni.FirstP(); ni.IsActive(); current_node=ni.NextP() )
 	{
 		int node_id = current_node->getPermID();
-		if(0) std::cout << "Getting load for node " << node_id << std::endl;
+		if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kInterface ) ) std::cout << "Getting load for node " << node_id << std::endl;
 	  double load = 0.0;
 		double varea = current_node->getVArea();
 		tListIter<tLayer> li( current_node->getLayersRefNC() );
@@ -2010,7 +2333,8 @@ GetNodeXCoords()
 	for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
 	{
 		int node_id = current_node->getPermID();
-		if(1) std::cout << "  In GetNodeXCoords, node " << node_id << " has X coord " << current_node->getX() << std::endl;
+		CHILD_LOG( tLog::kDebug, tLog::kInterface,
+		           "  In GetNodeXCoords, node " << node_id << " has X coord " << current_node->getX() );
 		x[node_id] = current_node->getX();
 	}
 	return x;
@@ -2034,7 +2358,8 @@ GetNodeYCoords()
 	for( current_node=ni.FirstP(); !ni.AtEnd(); current_node=ni.NextP() )
 	{
 		int node_id = current_node->getPermID();
-		if(1) std::cout << "  In GetNodeYCoords, node " << node_id << " has Y coord " << current_node->getY() << std::endl;
+		CHILD_LOG( tLog::kDebug, tLog::kInterface,
+		           "  In GetNodeYCoords, node " << node_id << " has Y coord " << current_node->getY() );
 		y[node_id] = current_node->getY();
 	}
 	return y;
@@ -27,6 +27,7 @@
 #define CHILDINTERFACE_H
 
 #include <string>
+#include <fstream>
 #include <sstream>
 #include <vector>
 #include "../trapfpe.h"
@@ -38,6 +39,11 @@
 #include "../tWaterSedTracker/tWaterSedTracker.h"
 #include "../tMeshList/tMeshList.h"
 #include "../tLithologyManager/tLithologyManager.h"
+#include "../tTaskGraph/tTaskGraph.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
+#include "../tSharedMonitor/tSharedMonitor.h"
+#include "../tStateHash/tStateHash.h"
+#include "../tNodeFields/tNodeFields.h"
 
 using namespace std;
 
@@ -142,6 +148,11 @@ public:
   void setWriteOption( bool, tInputFile& );
   void WriteChildStyleOutput();
   void ChangeOption( string option, int val );
+  void SetRandomSeed( long seed );  // restarts the model's random sequence
+  void SetRandomStream( long seed, unsigned long member );  // ditto, per member
+  void SetTimeStatusFile( string name );  // in place of "run.time"
+  void OverrideInput( string keyword, string value );  // used by Initialize
+  void UseInitialMesh( const tMesh<tLNode> * );  // used by Initialize
 
   // Additional custom functions to accompany IElement interface
   bool IsInteriorNode( int element_index );
@@ -157,6 +168,7 @@ public:
 	void GetNodeYCoords( std::vector<double> & y );  // returns node y coordinates
 	std::vector<double> GetNodeXCoords();  // returns node x coordinates
 	std::vector<double> GetNodeYCoords();  // returns node y coordinates
+  uint64_t GetStateHash();  // 64-bit hash of the model state (tStateHash)
 	
   // Interface functions used (at the moment) only for development and testing
   tMesh<tLNode> * GetMeshPointer() { return mesh; }
@@ -170,6 +182,31 @@ private:
   std::vector<double> GetNodeSedimentFluxVector();  // Creates and returns vector of Qs
   void SetNodeElevations( std::vector<double> elevations );
   std::vector<double> GetLandslideAreasVector(); // Creates and returns vector of landslides
+  // Stages of RunOneStorm after erosion and meandering, run through
+  // stormTasks_
+  void BuildStormTasks();
+  void FloodplainStage();
+  void ExposureStage();
+  void LoessStage();
+  void UpliftStage();
+  void TrackerStage();
+  // Brings elevations up to date with lazy uniform uplift (see tUplift)
+  void ApplyPendingUplift();
+  // Adds the current tMemoryAccount table to the memory report, if any
+  void WriteMemoryReport();
+  // Adds the time and state hash to <OUTFILENAME>.hash, if written
+  void WriteStateHash();
+  // Parts of the model state read or written by the stages
+  enum
+  {
+    kMeshField = 1,        // node list, positions and connectivity
+    kElevationField = 2,   // node elevations
+    kLayerField = 4,       // layer stacks (incl. exposure times)
+    kUpliftField = 8,      // uplift rates at nodes
+    kFlowField = 16,       // flow directions and discharge
+    kStratGridField = 32,  // stratigraphy grid
+    kTrackerField = 64     // tracked sediment volumes and their files
+  };
   
   // Private data
   bool initialized;      // Flag indicated whether model has been initialized
@@ -193,6 +230,7 @@ private:
     optChemicalWeathering, // Option for chemical weathering
     optPhysicalWeathering; // Option for physical weathering
   bool optStreamLineBoundary; // Option for converting streamlines to open boundaries
+  tModelContext context_;  // Per-model parameters shared by all nodes
   tRand *rand;             // -> random number generator
   tMesh<tLNode> *mesh;        // -> mesh object
   tLOutput<tLNode> *output;   // -> output handler
@@ -208,6 +246,19 @@ private:
   tStratGrid *stratGrid;     // -> Stratigraphy Grid object
   tEolian *loess;           // -> eolian deposition object
   tStreamMeander *strmMeander; // -> stream meander object
+  tEquilibCheck *equilibCheck; // -> steady-state test (OPTEQUILIBSTOP;
+                               //    not carried over by Initialize_Copy)
+  std::vector< std::pair<string, string> > inputOverrides_; // see OverrideInput
+  const tMesh<tLNode> *initialMesh_;  // see UseInitialMesh
+  bool profiling_;          // this model started the profiler (--profile)
+  std::ofstream *memoryReport_;  // <OUTFILENAME>.memory (OPT_MEMORY_REPORT)
+  std::ofstream *stateHashFile_;  // <OUTFILENAME>.hash (OPT_STATE_HASH)
+  tSharedMonitor *monitor_;  // live state in shared memory
+                             //    (OPT_SHARED_MONITOR; not copied)
+  tTaskGraph stormTasks_;   // stages run by BuildStormTasks
+  tMemberTask<childInterface> floodplainTask_, exposureTask_, loessTask_,
+    upliftTask_, trackerTask_;
+  double stormPlusDryDuration_;  // duration of the current storm + interstorm
   //Predicates predicate;   // Math-related stuff
 	
   // Private data for implementing OpenMI IElement interface
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/**
+**  childMonitorDriver.cpp: Follows a running model through its
+**  shared-memory monitor (OPT_SHARED_MONITOR; see tSharedMonitor.h) and
+**  prints a line of summary statistics for each new state: time, number
+**  of nodes, minimum, mean and maximum elevation and mean erosion rate
+**  of the interior nodes, and the largest discharge.
+**
+**  Usage: childmonitor [--once] [--poll <seconds>] [<name>]
+**
+**  <name> defaults to /child_monitor. The program waits for the model to
+**  start, and stops when the run ends (or, with --once, after the first
+**  state).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../tSharedMonitor/tSharedMonitor.h"
+
+namespace
+{
+  void Usage()
+  {
+    std::cerr << "Usage: childmonitor [--once] [--poll <seconds>] [<name>]\n";
+    exit( 1 );
+  }
+
+  void Summarize( const tSharedMonitorHeader &header,
+		  const std::vector< double > fields[] )
+  {
+    const std::vector< double > &z = fields[tSharedMonitor::kElevation],
+      &q = fields[tSharedMonitor::kDischarge],
+      &dzdt = fields[tSharedMonitor::kErosionRate],
+      &boundary = fields[tSharedMonitor::kBoundary];
+    double zmin = 0., zmax = 0., zsum = 0., dzdtsum = 0., qmax = 0.;
+    long numInterior = 0;
+    for( size_t i=0; i<z.size(); ++i )
+    {
+      if( q[i]>qmax ) qmax = q[i];
+      if( boundary[i]!=0. )  // kNonBoundary
+	continue;
+      if( numInterior==0 || z[i]<zmin ) zmin = z[i];
+      if( numInterior==0 || z[i]>zmax ) zmax = z[i];
+      zsum += z[i];
+      dzdtsum += dzdt[i];
+      ++numInterior;
+    }
+    const double n = numInterior>0 ? numInterior : 1;
+    std::cout << "time " << header.time << "  nodes " << header.numNodes
+	      << "  z " << zmin << " / " << zsum/n << " / " << zmax
+	      << "  dz/dt " << dzdtsum/n << "  Qmax " << qmax
+	      << ( header.finished ? "  (finished)" : "" ) << std::endl;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  std::string name = "/child_monitor";
+  bool once = false;
+  double poll = 1.;
+  for( int i=1; i<argc; ++i )
+  {
+    if( strcmp( argv[i], "--once" )==0 )
+      once = true;
+    else if( strcmp( argv[i], "--poll" )==0 && i+1<argc )
+      poll = atof( argv[++i] );
+    else if( argv[i][0]=='-' )
+      Usage();
+    else
+      name = argv[i];
+  }
+  if( poll<=0. )
+    Usage();
+
+  tSharedMonitorReader reader;
+  tSharedMonitorHeader header;
+  memset( &header, 0, sizeof(header) );
+  std::vector< double > fields[tSharedMonitor::kNumFields];
+  uint64_t lastSeen = 0;
+  for(;;)
+  {
+    if( !reader.IsAttached() && !reader.Attach( name ) )
+    {
+      usleep( static_cast<useconds_t>( poll*1.0e6 ) );
+      continue;
+    }
+    if( reader.Read( header, fields ) && header.numPublished!=lastSeen )
+    {
+      lastSeen = header.numPublished;
+      Summarize( header, fields );
+      if( once || header.finished )
+	break;
+    }
+    usleep( static_cast<useconds_t>( poll*1.0e6 ) );
+  }
+  return 0;
+}
@@ -0,0 +1,477 @@
+/**************************************************************************/
+/**
+**  @file childSweep.cpp
+**
+**  @brief Functions for class childSweep, which runs a parameter sweep
+**         (see childSweep.h).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <math.h>
+#include <map>
+#include <iomanip>
+#include "childSweep.h"
+
+childSweep::
+childSweep() :
+  checkMesh_(true), writeOutput_(true), maxProcesses_(1)
+{}
+
+childSweep::
+~childSweep()
+{
+  CleanUp();
+}
+
+/**************************************************************************/
+/**
+**  Initialize
+**
+**  Reads the sweep keywords and the sweep file, and makes the list of
+**  runs. The model itself is initialized in each run's process.
+*/
+/**************************************************************************/
+void childSweep::
+Initialize( int argc, char **argv )
+{
+  tOption option( argc, argv );
+  inputFileName_ = option.inputFile;
+  checkMesh_ = option.checkMeshConsistency;
+  writeOutput_ = !option.no_write_mode;
+  tInputFile inputFile( option.inputFile );
+
+  outName_ = inputFile.ReadString( "OUTFILENAME" );
+  maxProcesses_ = inputFile.ReadInt( "SWEEP_PROCESSES", false );
+  if( maxProcesses_<=0 )
+  {
+    long ncores = sysconf( _SC_NPROCESSORS_ONLN );
+    maxProcesses_ = ( ncores>0 ) ? static_cast<int>( ncores ) : 1;
+  }
+  long seed = inputFile.ReadLong( "SWEEP_SEED", false );
+  if( seed==0 ) seed = inputFile.ReadLong( "SEED" );
+
+  ReadSpec( inputFile.ReadString( "SWEEP_SPEC" ), seed );
+
+  // Check the swept keywords now, rather than in every run
+  for( size_t k=0; k<keys_.size(); ++k )
+    if( !inputFile.Contain( keys_[k].c_str() ) )
+    {
+      std::cerr << "childSweep: '" << keys_[k]
+		<< "' is not in the input file\n";
+      ReportFatalError( "Swept keywords must be in the main input file." );
+    }
+
+  std::cout << "Sweep of " << runValues_.size() << " runs over "
+	    << keys_.size() << " keywords\n";
+}
+
+/**************************************************************************/
+/**
+**  ReadSpec
+**
+**  Reads the sweep file (see childSweep.h for its format) and fills in
+**  the values of each keyword for each run.
+*/
+/**************************************************************************/
+void childSweep::
+ReadSpec( const std::string &fileName, long seed )
+{
+  std::ifstream specFile( fileName.c_str() );
+  if( !specFile.good() )
+  {
+    std::cerr << "childSweep: unable to open '" << fileName << "'\n";
+    ReportFatalError( "The sweep file may not exist or may be mis-named." );
+  }
+
+  std::string mode;
+  int numSamples = 0;
+  std::vector< std::vector<std::string> > values;  // [keyword][value]
+  std::string line;
+  int lineNumber = 0;
+  while( std::getline( specFile, line ) )
+  {
+    ++lineNumber;
+    std::istringstream lineStream( line );
+    std::string keyword;
+    if( !( lineStream >> keyword ) || keyword[0]=='#' )
+      continue;
+    bool ok = true;
+    if( keyword=="MODE" )
+    {
+      ok = mode.empty() && !( lineStream >> mode ).fail();
+      if( ok && mode=="lhs" )
+	ok = !( lineStream >> numSamples ).fail() && numSamples>0;
+      else if( ok )
+	ok = ( mode=="grid" || mode=="list" );
+    }
+    else
+    {
+      keys_.push_back( keyword );
+      values.push_back( std::vector<std::string>() );
+      std::string value;
+      while( lineStream >> value )
+	values.back().push_back( value );
+      ok = !mode.empty() && !values.back().empty();
+      if( ok && mode=="lhs" )
+      {
+	// min max [log]
+	const std::vector<std::string> &v = values.back();
+	double minValue, maxValue;
+	ok = ( v.size()==2 || ( v.size()==3 && v[2]=="log" ) ) &&
+	  !( std::istringstream( v[0] ) >> minValue ).fail() &&
+	  !( std::istringstream( v[1] ) >> maxValue ).fail() &&
+	  maxValue>minValue && ( v.size()==2 || minValue>0.0 );
+      }
+    }
+    if( !ok )
+    {
+      std::cerr << "childSweep: can't make sense of line " << lineNumber
+		<< " of '" << fileName << "':\n" << line << "\n";
+      ReportFatalError( "Error in sweep file (is MODE given first?)." );
+    }
+  }
+  if( keys_.empty() )
+    ReportFatalError( "childSweep: the sweep file holds no keywords." );
+
+  const size_t numKeys = keys_.size();
+  if( mode=="grid" )
+  {
+    size_t numRuns = 1;
+    for( size_t k=0; k<numKeys; ++k )
+      numRuns *= values[k].size();
+    runValues_.assign( numRuns, std::vector<std::string>( numKeys ) );
+    for( size_t r=0; r<numRuns; ++r )
+    {
+      size_t index = r;
+      for( size_t k=numKeys; k-->0; )
+      {
+	runValues_[r][k] = values[k][ index % values[k].size() ];
+	index /= values[k].size();
+      }
+    }
+  }
+  else if( mode=="list" )
+  {
+    const size_t numRuns = values[0].size();
+    for( size_t k=1; k<numKeys; ++k )
+      if( values[k].size()!=numRuns )
+	ReportFatalError( "childSweep: with MODE list, all keywords need the same number of values." );
+    runValues_.assign( numRuns, std::vector<std::string>( numKeys ) );
+    for( size_t r=0; r<numRuns; ++r )
+      for( size_t k=0; k<numKeys; ++k )
+	runValues_[r][k] = values[k][r];
+  }
+  else
+  {
+    // Latin hypercube: each keyword's range is cut into numSamples equal
+    // strata (on a log scale if asked), and each stratum is sampled once,
+    // in an order shuffled independently for each keyword
+    tRand rand( seed );
+    runValues_.assign( numSamples, std::vector<std::string>( numKeys ) );
+    for( size_t k=0; k<numKeys; ++k )
+    {
+      double minValue, maxValue;
+      std::istringstream( values[k][0] ) >> minValue;
+      std::istringstream( values[k][1] ) >> maxValue;
+      const bool logScale = ( values[k].size()==3 );
+      if( logScale )
+      {
+	minValue = log( minValue );
+	maxValue = log( maxValue );
+      }
+      std::vector<int> strata( numSamples );
+      for( int i=0; i<numSamples; ++i )
+	strata[i] = i;
+      for( int i=numSamples-1; i>0; --i )
+      {
+	int j = static_cast<int>( rand.ran3()*( i+1 ) );
+	if( j>i ) j = i;
+	std::swap( strata[i], strata[j] );
+      }
+      for( int r=0; r<numSamples; ++r )
+      {
+	double value = minValue + ( maxValue-minValue )*
+	  ( strata[r]+rand.ran3() )/numSamples;
+	if( logScale ) value = exp( value );
+	std::ostringstream valueStream;
+	valueStream << std::setprecision( 10 ) << value;
+	runValues_[r][k] = valueStream.str();
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/**
+**  Run
+**
+**  Forks the runs, keeping no more than maxProcesses_ of them going at
+**  once, then writes the summary table. Each run's summary comes back
+**  through a pipe. Returns the number of runs that did not finish
+**  normally.
+*/
+/**************************************************************************/
+int childSweep::
+Run()
+{
+  const size_t numRuns = runValues_.size();
+  results_.assign( numRuns, std::vector<double>() );
+
+  std::map< pid_t, std::pair<size_t, int> > running;  // ID -> run, pipe
+  size_t next = 0;
+  int numFailed = 0;
+  while( next<numRuns || !running.empty() )
+  {
+    if( next<numRuns && static_cast<int>( running.size() )<maxProcesses_ )
+    {
+      const tMesh<tLNode> *initialMesh = InitialMesh( next );
+      std::cout.flush();
+      std::cerr.flush();
+      fflush( NULL );
+      int fds[2];
+      if( pipe( fds )!=0 )
+	ReportFatalError( "childSweep: unable to open a pipe." );
+      pid_t pid = fork();
+      if( pid<0 )
+	ReportFatalError( "childSweep: unable to fork a new process." );
+      if( pid==0 )
+      {
+	close( fds[0] );
+	RunOne( next, initialMesh, fds[1] );  // never returns
+      }
+      close( fds[1] );
+      running[pid] = std::make_pair( next++, fds[0] );
+      continue;
+    }
+
+    int status;
+    pid_t pid = waitpid( -1, &status, 0 );
+    if( pid<0 )
+    {
+      if( errno==EINTR ) continue;
+      ReportFatalError( "childSweep: error waiting for runs." );
+    }
+    std::map< pid_t, std::pair<size_t, int> >::iterator done =
+      running.find( pid );
+    if( done==running.end() ) continue;
+    const size_t r = done->second.first;
+    const int fd = done->second.second;
+    std::string result;
+    char buf[256];
+    ssize_t len;
+    while( ( len = read( fd, buf, sizeof(buf) ) )>0 )
+      result.append( buf, len );
+    close( fd );
+    running.erase( done );
+
+    if( WIFEXITED( status ) && WEXITSTATUS( status )==0 )
+    {
+      std::istringstream resultStream( result );
+      double value;
+      while( resultStream >> value )
+	results_[r].push_back( value );
+    }
+    if( results_[r].empty() )
+    {
+      std::cout << "Run " << r << " FAILED (see " << outName_ << "_" << r
+		<< ".log)\n";
+      ++numFailed;
+    }
+    else
+      std::cout << "Run " << r << " finished\n";
+    std::cout.flush();
+  }
+
+  WriteSummary();
+  std::cout << meshCache_.size() << " initial mesh"
+	    << ( meshCache_.size()==1 ? "" : "es" ) << " built for "
+	    << numRuns << " runs\n";
+  return numFailed;
+}
+
+/**************************************************************************/
+/**
+**  InitialMesh
+**
+**  Returns the initial mesh for a run: a cached one, if one was built for
+**  the same values of every swept keyword that its build looked up, or
+**  else a new one, which is added to the cache. As in
+**  childInterface::Initialize, the mesh is built after the model context
+**  (which the nodes refer to), so the keywords the context reads count
+**  too.
+*/
+/**************************************************************************/
+const tMesh<tLNode> * childSweep::
+InitialMesh( size_t run )
+{
+  for( size_t c=0; c<meshCache_.size(); ++c )
+  {
+    const tCachedMesh &cached = meshCache_[c];
+    bool same = true;
+    for( size_t k=0; k<keys_.size() && same; ++k )
+    {
+      if( runValues_[run][k]==runValues_[cached.run][k] ) continue;
+      // A keyword looked up as a prefix of the swept one also matches it
+      // (see tInputFile::findKeyWord)
+      std::set<std::string>::const_iterator i;
+      for( i=cached.keyWords.begin(); i!=cached.keyWords.end(); ++i )
+	if( keys_[k].compare( 0, i->size(), *i )==0 )
+	{
+	  same = false;
+	  break;
+	}
+    }
+    if( same )
+      return cached.mesh;
+  }
+
+  std::cout << "Building initial mesh for run " << run << "\n";
+  meshCache_.push_back( tCachedMesh() );
+  tCachedMesh &cached = meshCache_.back();
+  cached.run = run;
+  tInputFile inputFile( inputFileName_.c_str() );
+  for( size_t k=0; k<keys_.size(); ++k )
+    inputFile.SetValue( keys_[k].c_str(), runValues_[run][k].c_str() );
+  inputFile.RecordKeyWords( &cached.keyWords );
+  cached.context = new tModelContext;
+  cached.context->InitializeFromInputFile( inputFile );
+  cached.mesh = new tMesh<tLNode>( inputFile, checkMesh_, cached.context );
+  inputFile.RecordKeyWords( 0 );
+  return cached.mesh;
+}
+
+/**************************************************************************/
+/**
+**  RunOne
+**
+**  Runs in the forked process: sends the screen output to the run's log
+**  file, runs the model to the end with the run's values and initial
+**  mesh, and writes the summary numbers to the pipe. Exits rather than
+**  returning.
+*/
+/**************************************************************************/
+void childSweep::
+RunOne( size_t run, const tMesh<tLNode> *initialMesh, int fd )
+{
+  std::ostringstream nameStream;
+  nameStream << outName_ << "_" << run;
+  const std::string name = nameStream.str();
+
+  std::string logName = name + ".log";
+  int logFd = open( logName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if( logFd>=0 )
+  {
+    dup2( logFd, 1 );
+    dup2( logFd, 2 );
+    close( logFd );
+  }
+
+  struct timeval start, end;
+  gettimeofday( &start, NULL );
+
+  childInterface model;
+  model.OverrideInput( "OUTFILENAME", name );
+  for( size_t k=0; k<keys_.size(); ++k )
+    model.OverrideInput( keys_[k], runValues_[run][k] );
+  model.UseInitialMesh( initialMesh );
+  std::string arguments = "--silent-mode ";
+  if( !writeOutput_ ) arguments += "--no-write-mode ";
+  if( !checkMesh_ ) arguments += "--no-check ";
+  model.Initialize( arguments + inputFileName_ );
+  model.Run( 0.0 );
+
+  // Summary of the final state
+  tMesh<tLNode> *mesh = model.GetMeshPointer();
+  tMesh<tLNode>::nodeListIter_t ni( mesh->getNodeList() );
+  double sumZA = 0.0, sumA = 0.0, maxZ = 0.0, minZ = 0.0;
+  bool first = true;
+  for( tLNode *cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
+  {
+    sumZA += cn->getZ()*cn->getVArea();
+    sumA += cn->getVArea();
+    if( first || cn->getZ()>maxZ ) maxZ = cn->getZ();
+    first = false;
+  }
+  first = true;
+  for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+  {
+    if( first || cn->getZ()<minZ ) minZ = cn->getZ();
+    first = false;
+  }
+  gettimeofday( &end, NULL );
+
+  std::ostringstream result;
+  result << std::setprecision( 10 ) << model.GetCurrentTime() << " "
+	 << model.GetNodeCount() << " "
+	 << ( sumA>0.0 ? sumZA/sumA : 0.0 ) << " " << maxZ << " "
+	 << maxZ-minZ << " "
+	 << ( end.tv_sec-start.tv_sec ) + 1e-6*( end.tv_usec-start.tv_usec )
+	 << "\n";
+  const std::string text = result.str();
+  const bool ok =
+    ( write( fd, text.c_str(), text.size() )==static_cast<ssize_t>( text.size() ) );
+  close( fd );
+  model.CleanUp();
+  std::cout.flush();
+  std::cerr.flush();
+  fflush( NULL );
+  _exit( ok ? 0 : 1 );
+}
+
+/**************************************************************************/
+/**
+**  WriteSummary
+**
+**  Writes <OUTFILENAME>.sweep (see childSweep.h).
+*/
+/**************************************************************************/
+void childSweep::
+WriteSummary() const
+{
+  std::string name = outName_ + ".sweep";
+  std::ofstream table( name.c_str() );
+  if( !table.good() )
+    ReportFatalError( "childSweep: unable to open output file." );
+  table << "# run";
+  for( size_t k=0; k<keys_.size(); ++k )
+    table << " " << keys_[k];
+  table << " time nodes mean_elev max_elev relief seconds\n";
+  table << std::setprecision( 10 );
+  for( size_t r=0; r<runValues_.size(); ++r )
+  {
+    table << r;
+    for( size_t k=0; k<keys_.size(); ++k )
+      table << " " << runValues_[r][k];
+    if( results_[r].empty() )
+      table << " failed";
+    for( size_t i=0; i<results_[r].size(); ++i )
+      table << " " << results_[r][i];
+    table << "\n";
+  }
+}
+
+void childSweep::
+CleanUp()
+{
+  for( size_t c=0; c<meshCache_.size(); ++c )
+  {
+    delete meshCache_[c].mesh;
+    delete meshCache_[c].context;
+  }
+  meshCache_.clear();
+}
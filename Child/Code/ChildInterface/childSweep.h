@@ -0,0 +1,116 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file childSweep.h
+**
+**  @brief Header file for childSweep, a driver that runs a parameter
+**         sweep described in a sweep file.
+**
+**  A childSweep runs the model once for each combination of parameter
+**  values given by a sweep file, each run in its own process with the
+**  swept values in place of those in the main input file (see
+**  childInterface::OverrideInput). No more than a given number of runs
+**  go at once. At the end, a summary of each run is collected in one
+**  table.
+**
+**  Initial meshes are cached: the mesh for a run is built in the driver
+**  process (while the input file records which keywords the build looks
+**  up; see tInputFile::RecordKeyWords), and any later run whose values
+**  agree on all of those keywords starts from a copy of it instead of
+**  building its own (see childInterface::UseInitialMesh). So a sweep of,
+**  say, erodibility builds one mesh, while a sweep of grid spacing builds
+**  one per spacing.
+**
+**  The following keywords are read from the main input file:
+**
+**    SWEEP_SPEC         name of the sweep file (required)
+**    SWEEP_PROCESSES    maximum number of runs going at once
+**                       (default 0 = one per core)
+**    SWEEP_SEED         seed for Latin hypercube sampling (default SEED)
+**
+**  The sweep file starts with a MODE line, followed by one line per swept
+**  keyword. Blank lines and lines starting with '#' are ignored.
+**
+**    MODE grid          one run for each combination of the values
+**    MODE list          run i takes the i-th value of each keyword (all
+**                       keywords must have the same number of values)
+**    MODE lhs <n>       n runs by Latin hypercube sampling of the ranges
+**
+**    <keyword> <value> <value> ...        (grid and list)
+**    <keyword> <min> <max> [log]          (lhs)
+**
+**  With grid, the first keyword varies the slowest. Grid and list values
+**  are passed to the model as written, so they need not be numbers.
+**
+**  Run k (counting from 0) writes the usual CHILD output files under the
+**  name <OUTFILENAME>_<k> (unless --no-write-mode is given), and its
+**  screen output to <OUTFILENAME>_<k>.log. The summary table,
+**  <OUTFILENAME>.sweep, holds one line per run: the run number, the
+**  swept values, and the time reached, the number of nodes, the
+**  area-weighted mean and the maximum elevation of the interior nodes,
+**  the relief (highest interior minus lowest node), and the run time in
+**  seconds (or "failed").
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef CHILDSWEEP_H
+#define CHILDSWEEP_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include "childInterface.h"
+
+/**************************************************************************/
+/**
+**  Class childSweep
+**
+**  Holds the list of runs (the values of the swept keywords for each),
+**  the mesh cache, and the results.
+*/
+/**************************************************************************/
+class childSweep
+{
+public:
+  childSweep();
+  ~childSweep();
+  void Initialize( int argc, char **argv );
+  int Run();   // returns the number of runs that failed
+  void CleanUp();
+
+private:
+  // An initial mesh, with the context its nodes were built with
+  struct tCachedMesh
+  {
+    size_t run;                        // run it was built for
+    std::set< std::string > keyWords;  // keywords looked up to build it
+    tModelContext *context;
+    tMesh<tLNode> *mesh;
+  };
+
+  void ReadSpec( const std::string &fileName, long seed );
+  const tMesh<tLNode> *InitialMesh( size_t run );
+  void RunOne( size_t run, const tMesh<tLNode> *, int fd );  // forked
+  void WriteSummary() const;
+
+  std::string inputFileName_;           // main input file
+  std::string outName_;                 // OUTFILENAME from the input file
+  bool checkMesh_;                      // false with --no-check
+  bool writeOutput_;                    // false with --no-write-mode
+  int maxProcesses_;
+  std::vector<std::string> keys_;       // swept keywords
+  std::vector< std::vector<std::string> > runValues_;  // [run][keyword]
+  std::vector<tCachedMesh> meshCache_;
+  std::vector< std::vector<double> > results_;  // [run], empty if failed
+};
+
+#endif
@@ -0,0 +1,32 @@
+/**************************************************************************/
+/**
+**  childSweepDriver.cpp: Runs a parameter sweep on the local cores (see
+**  childSweep.h for the input keywords and the sweep file format).
+**
+**  Usage: childsweep [--no-write-mode] [--no-check] <input file>
+**
+**  The exit status is the number of runs that failed.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include "childSweep.h"
+
+int main( int argc, char **argv )
+{
+	childSweep mySweep;
+
+	mySweep.Initialize( argc, argv );
+	int numFailed = mySweep.Run();
+	mySweep.CleanUp();
+
+	return numFailed;
+}
@@ -0,0 +1,200 @@
+/**************************************************************************/
+/**
+**  partition_test.cpp: Checks tPartition and tDomainComm on the mesh of
+**  an input file.
+**
+**  Usage: partition_test <input file>
+**
+**  The mesh is split into 1, 2, 3 and 7 parts, and for each partition
+**  the test checks that:
+**
+**    - every node is owned by one part, and the parts have the same
+**      number of nodes to within one;
+**    - the ghosts of a part are exactly the other parts' nodes joined by
+**      an edge to one of its own;
+**    - a part's neighbours are the owners of its ghosts, and the send
+**      list of one part for a neighbour is the neighbour's receive list
+**      for it.
+**
+**  It then splits the mesh into one part per process (one without MPI),
+**  has each process send the IDs on its send lists to its neighbours
+**  with tDomainComm::Exchange, and checks that what arrives is its
+**  receive lists; and checks Sum, Min and Max over the ranks.
+**
+**  The exit status is 0 if every check passes, 1 otherwise. Under MPI
+**  (CMake option CHILD_MPI) it is run on several processes.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "../../Inclusions.h"
+#include "../../tModelContext/tModelContext.h"
+#include "../../tPartition/tPartition.h"
+#include "../../tDomainComm/tDomainComm.h"
+
+static int failures = 0;
+
+static void
+check (bool ok, const char *what, int numParts, int part)
+{
+  if (!ok) {
+    fprintf (stderr, "partition_test: %d parts, part %d: %s\n",
+             numParts, part, what);
+    ++failures;
+  }
+}
+
+/* Checks a partition of the mesh against the rules in the header. */
+static void
+check_partition (tMesh<tLNode> &mesh, const tPartition &partition)
+{
+  const int numParts = partition.getNumParts ();
+  const long numNodes = partition.getNumNodes ();
+  check (numNodes==mesh.getNodeList ()->getSize (), "number of nodes",
+         numParts, -1);
+
+  // Ownership and balance
+  std::vector<int> owners (numNodes, 0);
+  long minOwned = numNodes, maxOwned = 0;
+  for (int p=0; p<numParts; ++p) {
+    const std::vector<int> &owned = partition.getOwned (p);
+    minOwned = std::min (minOwned, static_cast<long>(owned.size ()));
+    maxOwned = std::max (maxOwned, static_cast<long>(owned.size ()));
+    for (size_t i=0; i<owned.size (); ++i) {
+      ++owners[owned[i]];
+      check (partition.getOwner (owned[i])==p, "owner of an owned node",
+             numParts, p);
+    }
+  }
+  for (long i=0; i<numNodes; ++i)
+    check (owners[i]==1, "node not owned by exactly one part", numParts, -1);
+  check (maxOwned-minOwned<=1, "parts differ by more than one node",
+         numParts, -1);
+
+  // Ghosts, by walking the spokes of each part's nodes
+  std::vector< std::vector<int> > ghosts (numParts);
+  tMesh< tLNode >::nodeListIter_t ni (mesh.getNodeList ());
+  for (tLNode *cn = ni.FirstP (); !ni.AtEnd (); cn = ni.NextP ()) {
+    const int p = partition.getOwner (cn->getID ());
+    tEdge *first = cn->getEdg ();
+    if (first==0) continue;
+    tEdge *ce = first;
+    do {
+      const int nbr = ce->getDestinationPtr ()->getID ();
+      if (partition.getOwner (nbr)!=p)
+        ghosts[p].push_back (nbr);
+    } while ((ce = ce->getCCWEdg ())!=first);
+  }
+  for (int p=0; p<numParts; ++p) {
+    std::sort (ghosts[p].begin (), ghosts[p].end ());
+    ghosts[p].erase (std::unique (ghosts[p].begin (), ghosts[p].end ()),
+                     ghosts[p].end ());
+    check (ghosts[p]==partition.getGhosts (p), "ghosts", numParts, p);
+  }
+
+  // Neighbours, and send and receive lists
+  for (int p=0; p<numParts; ++p) {
+    const std::vector<int> &nbrs = partition.getNeighbours (p);
+    std::vector<int> expected;
+    for (size_t i=0; i<ghosts[p].size (); ++i)
+      expected.push_back (partition.getOwner (ghosts[p][i]));
+    std::sort (expected.begin (), expected.end ());
+    expected.erase (std::unique (expected.begin (), expected.end ()),
+                    expected.end ());
+    check (nbrs==expected, "neighbours", numParts, p);
+
+    for (size_t k=0; k<nbrs.size (); ++k) {
+      const int q = nbrs[k];
+      const std::vector<int> &qnbrs = partition.getNeighbours (q);
+      const size_t kq =
+        std::find (qnbrs.begin (), qnbrs.end (), p) - qnbrs.begin ();
+      if (kq==qnbrs.size ()) {
+        check (false, "neighbours not symmetric", numParts, p);
+        continue;
+      }
+      const std::vector<int> &send = partition.getSendList (p, k);
+      check (send==partition.getRecvList (q, kq),
+             "send list differs from the neighbour's receive list",
+             numParts, p);
+      for (size_t i=0; i<send.size (); ++i)
+        check (partition.getOwner (send[i])==p, "send list node not owned",
+               numParts, p);
+      const std::vector<int> &recv = partition.getRecvList (p, k);
+      for (size_t i=0; i<recv.size (); ++i)
+        check (partition.getOwner (recv[i])==q,
+               "receive list node not owned by the neighbour", numParts, p);
+    }
+  }
+}
+
+/* Exchanges the send lists of a one-part-per-process partition. */
+static void
+check_exchange (const tPartition &partition, const tDomainComm &world)
+{
+  const int rank = world.getRank ();
+  const std::vector<int> &nbrs = partition.getNeighbours (rank);
+  std::vector< std::vector<double> > send (nbrs.size ()), recv;
+  for (size_t k=0; k<nbrs.size (); ++k) {
+    const std::vector<int> &ids = partition.getSendList (rank, k);
+    send[k].assign (ids.begin (), ids.end ());
+  }
+  if (!nbrs.empty ())
+    world.Exchange (nbrs, send, recv);
+  for (size_t k=0; k<nbrs.size (); ++k) {
+    const std::vector<int> &ids = partition.getRecvList (rank, k);
+    check (recv[k]==std::vector<double> (ids.begin (), ids.end ()),
+           "exchanged list", partition.getNumParts (), rank);
+  }
+
+  const int size = world.getSize ();
+  check (world.Sum (rank)==0.5*size*(size-1), "Sum", size, rank);
+  check (world.Min (rank)==0., "Min", size, rank);
+  check (world.Max (rank)==size-1, "Max", size, rank);
+}
+
+int
+main (int argc, char *argv[])
+{
+  tDomainComm::Initialize (&argc, &argv);
+  if (argc!=2) {
+    fprintf (stderr, "Usage: partition_test <input file>\n");
+    exit (EXIT_FAILURE);
+  }
+
+  const tDomainComm world (tDomainComm::kWorld);
+  {
+    tInputFile inputFile (argv[1]);
+    tModelContext context;
+    context.InitializeFromInputFile (inputFile);
+    tMesh<tLNode> mesh (inputFile, true, &context);
+
+    const int numParts[] = { 1, 2, 3, 7 };
+    for (size_t i=0; i<sizeof (numParts)/sizeof (numParts[0]); ++i)
+      check_partition (mesh, tPartition (&mesh, numParts[i]));
+
+    const tPartition partition (&mesh, world.getSize ());
+    check_partition (mesh, partition);
+    check_exchange (partition, world);
+  }
+
+  const double allFailures = world.Sum (failures);
+  if (world.getRank ()==0)
+    fprintf (stdout, "partition_test: %s (%d process%s)\n",
+             allFailures==0. ? "PASS" : "FAIL", world.getSize (),
+             world.getSize ()==1 ? "" : "es");
+  tDomainComm::Finalize ();
+  return allFailures==0. ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,341 @@
+/**************************************************************************/
+/**
+**  regression_test.cpp: Runs one of the cases under Tests/ with the child
+**  executable, compares the output fields at the last output time with a
+**  stored reference, and checks the wall time against a baseline.
+**
+**  Usage: regression_test [options]
+**
+**    --child <exe>          child executable
+**    --case-dir <dir>       directory holding the case's input file
+**    --input <file>         input file, relative to the case directory
+**    --work-dir <dir>       directory to run in (it must exist)
+**    --reference <file>     reference fields
+**    --set <KEY>=<value>    overrides a keyword of the input file (may be
+**                           repeated); used to bring old inputs up to
+**                           date or to shorten a run
+**    --fields <list>        output fields to compare, separated by commas
+**                           (default z,slp,area)
+**    --rtol <x>, --atol <x> a value passes if |new-ref| <= atol +
+**                           rtol*max(|new|,|ref|) (defaults 1e-6, 1e-9)
+**    --slowdown <f>         fail if the wall time exceeds f times the
+**                           baseline (default 1.5; 0 for no check)
+**    --min-time <s>         baseline wall times below this are taken as
+**                           this, so that short runs do not fail on
+**                           timing noise (default 2)
+**
+**  The input file is copied to the work directory, with the overridden
+**  keywords put first (where they take precedence), and the model is run
+**  there, its screen output going to <case>.log. The wall time and the
+**  peak resident set size of the run are appended to history.txt in the
+**  work directory.
+**
+**  The baseline wall time is kept in baseline.txt in the work directory:
+**  the first run on a machine sets it, and deleting the file resets it.
+**  If the environment variable CHILD_REGRESSION_UPDATE is set, the run
+**  rewrites the reference file and the baseline instead of checking them
+**  (e.g., "CHILD_REGRESSION_UPDATE=1 ctest -L regression" after a change
+**  that is meant to alter the results).
+**
+**  The exit status is 0 if the case passes, 1 otherwise.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+**
+*/
+/**************************************************************************/
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+typedef std::map< std::string, std::vector<double> > tFields;
+
+static void
+fail_usage (const char *message)
+{
+  fprintf (stderr, "regression_test: %s\n", message);
+  exit (EXIT_FAILURE);
+}
+
+/* Reads OUTFILENAME from an input file: the first line starting with the
+   keyword, followed by the first line after it that is not a comment. */
+static std::string
+read_out_name (const std::string &input)
+{
+  std::ifstream in (input.c_str ());
+  std::string line;
+  while (std::getline (in, line))
+    if (line.compare (0, 11, "OUTFILENAME")==0)
+      while (std::getline (in, line))
+        if (!line.empty () && line[0]!='#') {
+          std::istringstream value (line);
+          std::string name;
+          value >> name;
+          return name;
+        }
+  fail_usage ("no OUTFILENAME in the input file");
+  return "";
+}
+
+/* Reads the last block (time, number of values, values) of a CHILD output
+   file. Returns false if the file is missing or malformed. */
+static bool
+read_last_block (const std::string &file, std::vector<double> &values)
+{
+  std::ifstream in (file.c_str ());
+  if (!in.good ())
+    return false;
+  double time;
+  long n;
+  bool found = false;
+  while (!(in >> time >> n).fail ()) {
+    if (n<0)
+      return false;
+    values.resize (n);
+    for (long i=0; i<n; ++i)
+      if ((in >> values[i]).fail ())
+        return false;
+    found = true;
+  }
+  return found && in.eof ();
+}
+
+/* Reference file: for each field, a line "field <name> <n>" followed by
+   n values, one per line. */
+static bool
+read_reference (const std::string &file, tFields &fields)
+{
+  std::ifstream in (file.c_str ());
+  std::string word, name;
+  long n;
+  while (!(in >> word).fail ()) {
+    if (word[0]=='#') {
+      std::getline (in, word);
+      continue;
+    }
+    if (word!="field" || (in >> name >> n).fail () || n<0)
+      return false;
+    std::vector<double> &values = fields[name];
+    values.resize (n);
+    for (long i=0; i<n; ++i)
+      if ((in >> values[i]).fail ())
+        return false;
+  }
+  return !fields.empty ();
+}
+
+static void
+write_reference (const std::string &file, const std::string &input,
+                 const tFields &fields)
+{
+  FILE *out = fopen (file.c_str (), "w");
+  if (out==NULL)
+    fail_usage ("unable to write the reference file");
+  fprintf (out, "# CHILD regression reference: fields at the last output "
+           "time of %s\n", input.c_str ());
+  for (tFields::const_iterator f=fields.begin (); f!=fields.end (); ++f) {
+    fprintf (out, "field %s %lu\n", f->first.c_str (),
+             (unsigned long) f->second.size ());
+    for (size_t i=0; i<f->second.size (); ++i)
+      fprintf (out, "%.10g\n", f->second[i]);
+  }
+  fclose (out);
+}
+
+static double
+now (void)
+{
+  struct timespec t;
+  clock_gettime (CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1.0e-9*t.tv_nsec;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string child, case_dir, input, work_dir, reference;
+  std::string field_list = "z,slp,area";
+  std::vector<std::string> overrides;
+  double rtol = 1.0e-6, atol = 1.0e-9, slowdown = 1.5, min_time = 2.0;
+
+  for (int i=1; i<argc; ++i) {
+    const std::string option = argv[i];
+    if (i+1>=argc)
+      fail_usage ("missing value after an option");
+    const char *value = argv[++i];
+    if (option=="--child") child = value;
+    else if (option=="--case-dir") case_dir = value;
+    else if (option=="--input") input = value;
+    else if (option=="--work-dir") work_dir = value;
+    else if (option=="--reference") reference = value;
+    else if (option=="--set") overrides.push_back (value);
+    else if (option=="--fields") field_list = value;
+    else if (option=="--rtol") rtol = atof (value);
+    else if (option=="--atol") atol = atof (value);
+    else if (option=="--slowdown") slowdown = atof (value);
+    else if (option=="--min-time") min_time = atof (value);
+    else fail_usage ("unknown option");
+  }
+  if (child.empty () || case_dir.empty () || input.empty ()
+      || work_dir.empty () || reference.empty ())
+    fail_usage ("--child, --case-dir, --input, --work-dir and --reference "
+                "are required");
+  const bool update = getenv ("CHILD_REGRESSION_UPDATE")!=NULL;
+
+  /* Write the input file, overrides first */
+  const std::string case_name =
+    input.substr (0, input.rfind ('.')).substr (input.rfind ('/')+1);
+  const std::string run_input = work_dir + "/" + case_name + ".in";
+  {
+    std::ifstream original ((case_dir + "/" + input).c_str ());
+    std::ofstream patched (run_input.c_str ());
+    if (!original.good () || !patched.good ())
+      fail_usage ("unable to copy the input file");
+    for (size_t k=0; k<overrides.size (); ++k) {
+      const std::string::size_type eq = overrides[k].find ('=');
+      if (eq==std::string::npos)
+        fail_usage ("--set expects KEY=value");
+      patched << overrides[k].substr (0, eq) << ": set by regression_test\n"
+              << overrides[k].substr (eq+1) << "\n";
+    }
+    patched << original.rdbuf ();
+  }
+  const std::string out_name = read_out_name (run_input);
+
+  /* Run the model */
+  const double start = now ();
+  pid_t pid = fork ();
+  if (pid<0)
+    fail_usage ("fork failed");
+  if (pid==0) {
+    const std::string log = case_name + ".log";
+    if (chdir (work_dir.c_str ())!=0)
+      _exit (127);
+    int fd = open (log.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd>=0) {
+      dup2 (fd, 1);
+      dup2 (fd, 2);
+      close (fd);
+    }
+    const std::string in_name = case_name + ".in";
+    execl (child.c_str (), child.c_str (), "--silent-mode", in_name.c_str (),
+           (char *) NULL);
+    _exit (127);
+  }
+  int status;
+  struct rusage usage;
+  if (wait4 (pid, &status, 0, &usage)<0)
+    fail_usage ("wait failed");
+  const double wall = now () - start;
+  const long rss_kb = usage.ru_maxrss;
+  bool pass = WIFEXITED (status) && WEXITSTATUS (status)==0;
+  printf ("%s: wall time %.2f s, peak RSS %ld kB\n", case_name.c_str (),
+          wall, rss_kb);
+  if (!pass)
+    printf ("FAIL: the model did not finish (see %s/%s.log)\n",
+            work_dir.c_str (), case_name.c_str ());
+
+  /* Compare the fields */
+  tFields fields;
+  if (pass) {
+    std::stringstream names (field_list);
+    std::string name;
+    while (std::getline (names, name, ','))
+      if (!read_last_block (work_dir + "/" + out_name + "." + name,
+                            fields[name])) {
+        printf ("FAIL: no output for field '%s'\n", name.c_str ());
+        pass = false;
+      }
+  }
+  if (pass && update) {
+    write_reference (reference, input, fields);
+    printf ("Reference written to %s\n", reference.c_str ());
+  }
+  else if (pass) {
+    tFields ref;
+    if (!read_reference (reference, ref)) {
+      printf ("FAIL: unable to read the reference %s\n", reference.c_str ());
+      pass = false;
+    }
+    for (tFields::const_iterator f=fields.begin (); pass && f!=fields.end ();
+         ++f) {
+      const std::vector<double> &a = f->second;
+      if (ref.find (f->first)==ref.end ()
+          || ref[f->first].size ()!=a.size ()) {
+        printf ("FAIL: %s: not in the reference, or of a different size\n",
+                f->first.c_str ());
+        pass = false;
+        continue;
+      }
+      const std::vector<double> &b = ref[f->first];
+      double max_diff = 0.;
+      long num_bad = 0;
+      for (size_t i=0; i<a.size (); ++i) {
+        const double diff = fabs (a[i]-b[i]);
+        if (diff>max_diff) max_diff = diff;
+        if (!(diff<=atol+rtol*fmax (fabs (a[i]), fabs (b[i])))) ++num_bad;
+      }
+      printf ("%s: %lu values, max difference %g, %ld out of tolerance\n",
+              f->first.c_str (), (unsigned long) a.size (), max_diff,
+              num_bad);
+      if (num_bad>0) pass = false;
+    }
+    if (!pass)
+      printf ("FAIL: results differ from the reference\n");
+  }
+
+  /* Check the time against the baseline */
+  const std::string baseline_file = work_dir + "/baseline.txt";
+  double baseline = 0.;
+  {
+    std::ifstream in (baseline_file.c_str ());
+    if (!(in >> baseline).fail () && !update && pass && slowdown>0.) {
+      const double limit = slowdown * fmax (baseline, min_time);
+      printf ("baseline %.2f s, limit %.2f s\n", baseline, limit);
+      if (wall>limit) {
+        printf ("FAIL: slower than %.2f times the baseline\n", slowdown);
+        pass = false;
+      }
+    }
+    else if (pass) {
+      std::ofstream out (baseline_file.c_str ());
+      out << wall << "\n";
+      printf ("baseline set to %.2f s\n", wall);
+    }
+  }
+
+  /* Record the run */
+  {
+    char date[32] = "";
+    const time_t t = time (NULL);
+    strftime (date, sizeof (date), "%Y-%m-%dT%H:%M:%SZ", gmtime (&t));
+    FILE *history = fopen ((work_dir + "/history.txt").c_str (), "a");
+    if (history!=NULL) {
+      fprintf (history, "%s %s wall_s %.3f rss_kb %ld %s\n", date,
+               case_name.c_str (), wall, rss_kb,
+               update ? "update" : (pass ? "pass" : "fail"));
+      fclose (history);
+    }
+  }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
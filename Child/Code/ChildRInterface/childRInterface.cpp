@@ -18,8 +18,6 @@
 
 #include "childRInterface.h"
 
-Predicates predicate;
-
 /**************************************************************************/
 /**
 **  Default constructor for childInterface
@@ -88,9 +86,13 @@ Initialize( int argc, char **argv )
    // Create a random number generator for the simulation itself
    rand = new tRand( inputFile );
 
+   // Read parameters shared by all nodes of the mesh
+   context_.InitializeFromInputFile( inputFile );
+
    // Create and initialize objects:
    std::cout << "Creating mesh...\n";
-   mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency );
+   mesh = new tMesh<tLNode>( inputFile, option.checkMeshConsistency,
+                             &context_ );
 
    std::cout << "Creating output files...\n";
    output = new tLOutput<tLNode>( mesh, inputFile, rand );
@@ -174,7 +176,10 @@ RunOneStorm()
 	
 	// Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
 	if( optStratGrid )
+	{
+		uplift->ApplyPendingUplift( mesh );  // the grid follows absolute elevations
 		stratGrid->UpdateStratGrid(tStratGrid::k0, time->getCurrentTime());
+	}
 	
 	//Diffusion is now before fluvial erosion in case the tools
 	//detachment laws are being used.
@@ -227,9 +232,16 @@ RunOneStorm()
 	time->Advance( storm->getStormDuration() + storm->interstormDur() );
 	
 	if( time->CheckOutputTime() )
+	{
+		uplift->ApplyPendingUplift( mesh );
 		output->WriteOutput( time->getCurrentTime() );
+	}
 	
-	if( output->OptTSOutput() ) output->WriteTSOutput();
+	if( output->OptTSOutput() )
+	{
+		uplift->ApplyPendingUplift( mesh );
+		output->WriteTSOutput();
+	}
 		
 	return( time->getCurrentTime() );
 }
@@ -257,6 +269,7 @@ Run( double run_duration )
 
    while( !time->IsFinished() )
 		RunOneStorm();
+   uplift->ApplyPendingUplift( mesh );
 
 }
 
@@ -344,12 +357,203 @@ childRInterface::
 
 void childRInterface::ExternalErosionAndDeposition( vector<double> dz )
 {
-  tMesh< tLNode >::nodeListIter_t mli( mesh->getNodeList() );  // gets nodes from the list
-  tLNode * cn;
-  for( cn=mli.FirstP(); mli.IsActive(); cn=mli.NextP() )
+  uplift->ApplyPendingUplift( mesh );
+  tNodeFields::ErodeDeposit( mesh, &dz[0] );
+}
+
+
+/**************************************************************************/
+/**
+**  childRInterface::GetNodeCount
+**
+**  Returns the number of nodes, which is the length of every field.
+*/
+/**************************************************************************/
+
+long childRInterface::GetNodeCount()
+{
+  if( initialized==false )
+    ReportFatalError( "childRInterface must be initialized (with Initialize() method) before GetNodeCount() method is called." );
+  return tNodeFields::Size( mesh );
+}
+
+
+/**************************************************************************/
+/**
+**  childRInterface::GetValues
+**
+**  Copies a field ("elev", "x", "y", "dz", "discharge" or "sedflux"; see
+**  tNodeFields::Find) into values, which must hold n = GetNodeCount()
+**  values, in order of permanent node ID. Reading "dz" resets the
+**  cumulative erosion/deposition, as in childInterface. Returns false,
+**  leaving values alone, if the field is unknown or n is wrong.
+*/
+/**************************************************************************/
+
+bool childRInterface::GetValues( const string &var_name, double *values,
+                                 long n )
+{
+  const tNodeFields::tField field = tNodeFields::Find( var_name );
+  if( field==tNodeFields::kUnknown || n!=GetNodeCount() )
+    return false;
+  if( field==tNodeFields::kElevation )
+    uplift->ApplyPendingUplift( mesh );
+  tNodeFields::Get( mesh, field, values );
+  return true;
+}
+
+
+/**************************************************************************/
+/**
+**  childRInterface::SetValues
+**
+**  Applies a whole field at once: "elev" sets the elevations of all
+**  nodes, "dz" (or "erodep") erodes or deposits at the interior nodes,
+**  and "uplift" changes the elevations of the interior nodes without
+**  changing their layers. values holds n = GetNodeCount() values, in
+**  order of permanent node ID. Returns false, changing nothing, if the
+**  field cannot be set or n is wrong.
+*/
+/**************************************************************************/
+
+bool childRInterface::SetValues( const string &var_name,
+                                 const double *values, long n )
+{
+  if( n!=GetNodeCount() )
+    return false;
+  uplift->ApplyPendingUplift( mesh );
+  if( var_name.compare( 0,4,"elev" )==0 )
+    tNodeFields::SetElevations( mesh, values );
+  else if( var_name.compare( 0,2,"dz" )==0 || var_name.compare( 0,3,"ero" )==0 )
+    tNodeFields::ErodeDeposit( mesh, values );
+  else if( var_name.compare( 0,6,"uplift" )==0 )
+    tNodeFields::AdjustElevations( mesh, values, true );
+  else
+    return false;
+  return true;
+}
+
+
+/**************************************************************************/
+/**
+**  Entry points for R (see childRInterface.h)
+*/
+/**************************************************************************/
+
+namespace
+{
+  childRInterface *rModel = NULL;  // the R session's model
+
+  // Thrown by the fatal error handler while an entry point runs
+  struct tRError {};
+
+  void ThrowRError( const char * )
+  {
+    throw tRError();
+  }
+
+  // Installs ThrowRError for the lifetime of an entry point call
+  class tRErrorScope
+  {
+  public:
+    tRErrorScope() : previous_( SetFatalErrorHandler( ThrowRError ) ) {}
+    ~tRErrorScope() { SetFatalErrorHandler( previous_ ); }
+  private:
+    tFatalErrorHandler previous_;
+  };
+
+  childRInterface &RModel()
+  {
+    if( rModel==NULL )
+      ReportFatalError( "childr_initialize must be called first." );
+    return *rModel;
+  }
+}
+
+void childr_initialize( char **input_file, int *status )
+{
+  childr_cleanup();
+  *status = 1;
+  char exeName[] = "childr";
+  char silent[] = "--silent-mode";
+  char *argv[] = { exeName, silent, input_file[0], NULL };
+  tRErrorScope scope;
+  try
+  {
+    rModel = new childRInterface;
+    rModel->Initialize( 3, argv );
+    *status = 0;
+  }
+  catch( const tRError & )
+  {
+    childr_cleanup();
+  }
+}
+
+void childr_run_one_storm( double *time, int *status )
+{
+  *status = 1;
+  tRErrorScope scope;
+  try
+  {
+    *time = RModel().RunOneStorm();
+    *status = 0;
+  }
+  catch( const tRError & ) {}
+}
+
+void childr_run( double *duration, int *status )
+{
+  *status = 1;
+  tRErrorScope scope;
+  try
   {
-    int current_id = cn->getPermID();
-    cn->EroDep( dz[current_id] );
+    RModel().Run( *duration );
+    *status = 0;
   }
+  catch( const tRError & ) {}
 }
 
+void childr_node_count( int *n, int *status )
+{
+  *status = 1;
+  tRErrorScope scope;
+  try
+  {
+    *n = static_cast<int>( RModel().GetNodeCount() );
+    *status = 0;
+  }
+  catch( const tRError & ) {}
+}
+
+void childr_get_values( char **var_name, double *values, int *n,
+                        int *status )
+{
+  *status = 1;
+  tRErrorScope scope;
+  try
+  {
+    if( RModel().GetValues( var_name[0], values, *n ) )
+      *status = 0;
+  }
+  catch( const tRError & ) {}
+}
+
+void childr_set_values( char **var_name, double *values, int *n,
+                        int *status )
+{
+  *status = 1;
+  tRErrorScope scope;
+  try
+  {
+    if( RModel().SetValues( var_name[0], values, *n ) )
+      *status = 0;
+  }
+  catch( const tRError & ) {}
+}
+
+void childr_cleanup()
+{
+  delete rModel;
+  rModel = NULL;
+}
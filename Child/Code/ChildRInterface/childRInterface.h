@@ -32,6 +32,7 @@
 #include "../tStratGrid/tStratGrid.h"
 #include "../tEolian/tEolian.h"
 #include "../tOption/tOption.h"
+#include "../tNodeFields/tNodeFields.h"
 
 #include "../tMeshList/tMeshList.h"
 
@@ -59,6 +60,11 @@ public:
 	void CleanUp();
 	~childRInterface();
   void ExternalErosionAndDeposition( vector< double > dz );
+  // Whole fields in order of permanent node ID, copied to or from an
+  // array of GetNodeCount() values owned by the caller (see tNodeFields)
+  long GetNodeCount();
+  bool GetValues( const string &var_name, double *values, long n );
+  bool SetValues( const string &var_name, const double *values, long n );
 	
 private:
 	// Private data
@@ -70,6 +76,7 @@ private:
         optDiffuseDepo,    // Option for deposition / no deposition by diff'n
         optStratGrid,      // Option to enable stratigraphy grid
 		optNonlinearDiffusion; // Option for nonlinear creep transport
+	tModelContext context_;  // Per-model parameters shared by all nodes
 	tRand *rand;             // -> random number generator
 	tMesh<tLNode> *mesh;        // -> mesh object
 	tLOutput<tLNode> *output;   // -> output handler
@@ -86,4 +93,49 @@ private:
 };
 
 
+/**************************************************************************/
+/**
+**  Entry points for R
+**
+**  One model per R session, driven through R's .C interface, e.g.:
+**
+**    dyn.load( "childr.so" )
+**    .C( "childr_initialize", "run.in", status=0L )
+**    n <- .C( "childr_node_count", n=0L, status=0L )$n
+**    z <- numeric( n )
+**    t <- .C( "childr_run_one_storm", t=0, status=0L )$t
+**    z <- .C( "childr_get_values", "elev", z=z, n, status=0L )$z
+**
+**  .C copies every argument into a new block before the call and copies
+**  it back into a new R vector afterwards, so fetching a field of n
+**  nodes costs, besides the pass over the nodes, two copies of n doubles
+**  and two allocations; for a field fetched every storm this is about
+**  3 x 8n bytes of memory traffic. The fields themselves are copied
+**  whole (see tNodeFields), not node by node. Code using .Call can avoid
+**  the extra copies by passing REAL( x ) of a preallocated numeric
+**  vector to childRInterface::GetValues.
+**
+**  Each entry point sets status to 0 on success and to 1 on failure
+**  (no model, a bad input file or argument, or a fatal error inside the
+**  model), rather than halting R: the model's fatal errors are caught
+**  while an entry point runs (see SetFatalErrorHandler). After a failed
+**  initialization there is no model; after a failure during a run the
+**  model's state may be inconsistent and it should be initialized
+**  again. Fatal errors raised on the thread pool's worker threads still
+**  end the process.
+*/
+/**************************************************************************/
+extern "C"
+{
+  void childr_initialize( char **input_file, int *status );
+  void childr_run_one_storm( double *time, int *status );
+  void childr_run( double *duration, int *status );
+  void childr_node_count( int *n, int *status );
+  void childr_get_values( char **var_name, double *values, int *n,
+                          int *status );
+  void childr_set_values( char **var_name, double *values, int *n,
+                          int *status );
+  void childr_cleanup();
+}
+
 #endif
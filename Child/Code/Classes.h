@@ -42,5 +42,6 @@ class tStreamNet;
 class tStreamMeander;
 class tStorm;
 class tRunTimer;
+class tModelContext;
 
 #endif
@@ -91,6 +91,8 @@
 using namespace std;   // also added for DiffuseNonlinear() to use vector class from STL
 //#include <string>
 #include "erosion.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
 
 // Here follows a table for transport, detachment, and physical and chemical
 // weathering laws, which are chosen at run time via "X()" trick in 
@@ -310,7 +312,9 @@ meshPtr(0),
 timePtr(0),
 longTime(0.),
 massList(),
-longRate(0.), shortRate(0.)
+longRate(0.), shortRate(0.), meanElev(0.),
+checkInterval(0.), tolerance(0.), window(0.),
+startTime(0.), nextCheckTime(0.), steadySince(-1.)
 {}
 
 tEquilibCheck::tEquilibCheck( tMesh< tLNode > &meshRef, tRunTimer &timeRef )
@@ -319,8 +323,16 @@ meshPtr(&meshRef),
 timePtr(&timeRef),
 longTime(0.),
 massList(),
-longRate(0.), shortRate(0.)
+longRate(0.), shortRate(0.), meanElev(0.),
+checkInterval(0.), tolerance(0.), window(0.),
+startTime(timeRef.getCurrentTime()), nextCheckTime(startTime),
+steadySince(-1.)
 {
+  if( meshPtr->getContext() )
+  {
+    meshPtr->getContext()->trackVolume = true;
+    meshPtr->getContext()->volumeValid = false;
+  }
   FindIterChngRate();
 }
 
@@ -331,14 +343,31 @@ meshPtr(&meshRef),
 timePtr(&timeRef),
 longTime(0.),
 massList(),
-longRate(0.), shortRate(0.)
+longRate(0.), shortRate(0.), meanElev(0.),
+checkInterval(0.), tolerance(0.), window(0.),
+startTime(timeRef.getCurrentTime()), nextCheckTime(startTime),
+steadySince(-1.)
 {
   longTime = fileRef.ReadItem( longTime, "EQUITIME" );
+  // parameters of the steady-state test (optional; see erosion.h)
+  checkInterval = fileRef.ReadDouble( "EQUILIB_INTERVAL", false );
+  tolerance = fileRef.ReadDouble( "EQUILIB_TOLERANCE", false );
+  window = fileRef.ReadDouble( "EQUILIB_WINDOW", false );
+  if( checkInterval<0.0 || tolerance<0.0 || window<0.0 )
+    ReportFatalError( "EQUILIB_INTERVAL, EQUILIB_TOLERANCE and "
+                      "EQUILIB_WINDOW must not be negative." );
+  if( meshPtr->getContext() )
+  {
+    meshPtr->getContext()->trackVolume = true;
+    meshPtr->getContext()->volumeValid = false;
+  }
   FindIterChngRate();
 }
 
 tEquilibCheck::~tEquilibCheck()
 {
+  if( meshPtr!=0 && meshPtr->getContext() )
+    meshPtr->getContext()->trackVolume = false;
   meshPtr = 0;
   timePtr = 0;
 }
@@ -376,6 +405,47 @@ double tEquilibCheck::getLongRate() const {return longRate;}
 
 double tEquilibCheck::getShortRate() const {return shortRate;}
 
+double tEquilibCheck::getMeanElev() const {return meanElev;}
+
+double tEquilibCheck::getRelativeLongRate() const
+{
+  return ( meanElev != 0.0 ) ? fabs( longRate / meanElev ) : fabs( longRate );
+}
+
+
+/***************************************************************************\
+ **  tEquilibCheck::FindMeanElev()
+ **
+ **  Mean elevation of the interior nodes, weighted by Voronoi area. Taken
+ **  from the running volume total of the model context when it is valid;
+ **  otherwise found by a pass over the mesh, which also resets the total.
+ **  Includes any uplift still held in the context's datum offset.
+ \***************************************************************************/
+double tEquilibCheck::FindMeanElev()
+{
+  tModelContext *context = meshPtr->getContext();
+  const double datum = ( context!=0 ) ? context->zDatum : 0.0;
+  if( context!=0 && context->trackVolume && context->volumeValid )
+    return context->volume / context->volumeArea + datum;
+
+  tMesh< tLNode >::nodeListIter_t nI( meshPtr->getNodeList() );
+  tLNode *cn;
+  double mass = 0.0;
+  double area = 0.0;
+  for( cn = nI.FirstP(); nI.IsActive(); cn = nI.NextP() )
+  {
+    mass += cn->getZ() * cn->getVArea();
+    area += cn->getVArea();
+  }
+  if( context!=0 && context->trackVolume )
+  {
+    context->volume = mass;
+    context->volumeArea = area;
+    context->volumeValid = true;
+  }
+  return mass / area + datum;
+}
+
 
 /***************************************************************************\
  **  tEquilibCheck::FindIterChngRate()
@@ -389,19 +459,8 @@ double tEquilibCheck::FindIterChngRate()
 {
   assert( timePtr != 0 && meshPtr != 0 );
   
-  double ma;
-  {
-    tMesh< tLNode >::nodeListIter_t nI( meshPtr->getNodeList() );
-    tLNode *cn;
-    double mass = 0.0;
-    double area = 0.0;
-    for( cn = nI.FirstP(); nI.IsActive(); cn = nI.NextP() )
-    {
-      mass += cn->getZ() * cn->getVArea();
-      area += cn->getVArea();
-    }
-    ma = mass / area;
-  }
+  const double ma = FindMeanElev();
+  meanElev = ma;
   const tArray2< double > tmp( timePtr->getCurrentTime(), ma);
   
   tListIter< tArray2< double > > mI( massList );
@@ -415,8 +474,8 @@ double tEquilibCheck::FindIterChngRate()
   else
   {
     //cout << "tEquilibCheck::FindIterChngRate(), Warning: empty massList\n";
-    assert( tmp.at(0) > 0 );
-    shortRate = tmp.at(1) / tmp.at(0);
+    // (no rate yet if this is time zero)
+    shortRate = ( tmp.at(0) > 0 ) ? tmp.at(1) / tmp.at(0) : 0.0;
   }
   massList.insertAtBack( tmp );
   return shortRate;
@@ -441,16 +500,22 @@ double tEquilibCheck::FindLongTermChngRate()
   if( longTime == 0.0 || mI.FirstP() == mI.LastP() ) longRate = shortRate;
   else
   {
+    int numOlder = 0;
     ca = mI.FirstP();
     na = mI.NextP();
     while( (*na).at(0) < targetTime && !(mI.AtEnd()) )
     {
       ca = na;
       na = mI.NextP();
+      ++numOlder;
     }
     dt = (*last).at(0) - (*ca).at(0);
     assert( dt > 0 );
     longRate = ((*last).at(1) - (*ca).at(1)) / dt;
+    // drop the records before ca, which later calls will not need
+    tArray2< double > dropped;
+    while( numOlder-- > 0 )
+      massList.removeFromFront( dropped );
   }
   return longRate;
 }
@@ -468,6 +533,34 @@ double tEquilibCheck::FindLongTermChngRate( double newtime )
 }
 
 
+/***************************************************************************\
+ **  tEquilibCheck::CheckSteadyState()
+ **
+ **  Meant to be called after each time step. If a check is due, finds the
+ **  long-term rate and updates the time since which the relative rate has
+ **  stayed below the tolerance. Returns true once that span reaches the
+ **  window (see erosion.h).
+ \***************************************************************************/
+bool tEquilibCheck::CheckSteadyState()
+{
+  const double now = timePtr->getCurrentTime();
+  if( now < nextCheckTime || now <= startTime )
+    return false;
+  nextCheckTime = now + checkInterval;
+  FindLongTermChngRate();
+  if( now - startTime < longTime )
+    return false;
+
+  if( getRelativeLongRate() < tolerance )
+  {
+    if( steadySince < 0.0 ) steadySince = now;
+  }
+  else
+    steadySince = -1.0;
+  return steadySince >= 0.0 && now - steadySince >= window;
+}
+
+
 
 /***************************************************************************\
  **  FUNCTIONS FOR CLASS tBedErodePwrLaw
@@ -587,6 +680,7 @@ double tBedErodePwrLaw::DetachCapacity( tLNode * n, double dt )
     ReportFatalError("neg. slope in tBedErodePwrLaw::DetachCapacity(tLNode*,double)");
   const double tau =  kt*pow( n->getQ() / n->getHydrWidth(), mb ) * pow( slp, nb );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double tauex = tau - n->getTauCrit();
   tauex = (tauex>0.0) ? tauex : 0.0;
   return( n->getLayerErody(0)*pow(tauex,pb)*dt );
@@ -619,7 +713,7 @@ double tBedErodePwrLaw::DetachCapacity( tLNode * n, double dt )
  \***************************************************************************/
 double tBedErodePwrLaw::DetachCapacity( tLNode * n )
 {
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout<<"in detach capacity "<<std::endl;
   assert( n->getQ()>=0.0 );
   
@@ -632,8 +726,9 @@ double tBedErodePwrLaw::DetachCapacity( tLNode * n )
   assert( n->getQ()>=0.0 );
   assert( n->getDrArea()>=0.0 );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double erorate = tau - n->getTauCrit();
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "tau " << tau;
     std::cout << " tauc " << n->getTauCrit() << std::endl;
   }
@@ -678,8 +773,9 @@ double tBedErodePwrLaw::DetachCapacity( tLNode * n, int i )
     ReportFatalError("neg. slope in tBedErodePwrLaw::DetachCapacity(tLNode*)");
   const double tau = kt*pow( n->getQ() / n->getHydrWidth(), mb )*pow( slp, nb );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double erorate = tau - n->getTauCrit();
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "erorate: " << erorate << std::endl;
   erorate = (erorate>0.0) ? erorate : 0.0;
   erorate = n->getLayerErody(i)*pow( erorate, pb );
@@ -808,8 +904,9 @@ double tBedErodePwrLaw2::DetachCapacity( tLNode * n, double dt )
     ReportFatalError("neg. slope in tBedErodePwrLaw2::DetachCapacity(tLNode*,double)");
   const double tau =  kt*pow( n->getQ() / n->getHydrWidth(), mb ) * pow( slp, nb );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double tauexpb = pow( tau, pb ) - pow( n->getTauCrit(), pb );
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "tauexpb: " << tauexpb << std::endl;
   tauexpb = (tauexpb>0.0) ? tauexpb : 0.0;
   return( n->getLayerErody(0)*tauexpb*dt );
@@ -830,7 +927,7 @@ double tBedErodePwrLaw2::DetachCapacity( tLNode * n, double dt )
  \***************************************************************************/
 double tBedErodePwrLaw2::DetachCapacity( tLNode * n )
 {
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout<<"in detach capacity "<<std::endl;
   assert( n->getQ()>=0.0 );
   
@@ -843,8 +940,9 @@ double tBedErodePwrLaw2::DetachCapacity( tLNode * n )
   assert( n->getQ()>=0.0 );
   assert( n->getDrArea()>=0.0 );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double erorate = pow( tau, pb ) - pow( n->getTauCrit(), pb );
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "tau " << tau;
     std::cout << " tauc " << n->getTauCrit() << std::endl;
   }
@@ -880,8 +978,9 @@ double tBedErodePwrLaw2::DetachCapacity( tLNode * n, int i )
     ReportFatalError("neg. slope in tBedErodePwrLaw2::DetachCapacity(tLNode*)");
   const double tau = kt*pow( n->getQ() / n->getHydrWidth(), mb )*pow( slp, nb );
   n->setTau( tau );
+  n->RegrowVegCover();  // lazy regrowth of the cover (see tVegetation.h)
   double erorate = pow( tau, pb ) - pow( n->getTauCrit(), pb );
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "erorate: " << erorate << std::endl;
   erorate = (erorate>0.0) ? erorate : 0.0;
   erorate = n->getLayerErody(i)*erorate;
@@ -1445,7 +1544,7 @@ double tSedTransPwrLaw::TransCapacity( tLNode *node )
   {
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
       << node->getHydrWidth() << " S=" << node->calcSlope() << std::endl;
     tauex = tau - tauc;
@@ -1482,7 +1581,7 @@ double tSedTransPwrLaw::TransCapacity( tLNode *node, int lyr, double weight )
   {
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
       << node->getHydrWidth() << " S=" << node->calcSlope()
       << " tau=" << tau << std::endl;
@@ -1565,7 +1664,7 @@ double tSedTransPwrLaw2::TransCapacity( tLNode *node )
   {
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
       << node->getHydrWidth() << " S=" << node->calcSlope() << std::endl;
     tauexpf = pow( tau, pf ) - pow( tauc, pf );
@@ -1599,7 +1698,7 @@ double tSedTransPwrLaw2::TransCapacity( tLNode *node, int lyr, double weight )
   {
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
       << node->getHydrWidth() << " S=" << node->calcSlope()
       << " tau=" << tau << std::endl;
@@ -1670,7 +1769,7 @@ double tSedTransPwrLawSimp::TransCapacity( tLNode *node )
   {
     tau = kf * pow( node->getQ(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kf=" << kf << " Q=" << node->getQ() << 
       " S=" << node->calcSlope() << std::endl;
   }
@@ -1707,7 +1806,7 @@ double tSedTransPwrLawSimp::TransCapacity( tLNode *node, int lyr, double weight
     node->setTau( tau );
     // if((node->getVArea() < 2460 && node->getVArea() > 2459)  ||
     //   (node->getDrArea() < 5461 && node->getDrArea() > 5460) ){ //DEBUG
-    if(0){ 
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ){ 
       std::cout << "kf=" << kf << " Q=" << node->getQ() << 
       " S=" << node->calcSlope() << " tau=" << tau <<
       " A = "<<node->getDrArea()<<" VA= "<<node->getVArea()<<std::endl;
@@ -1799,7 +1898,7 @@ double tSedTransBridgeDom::TransCapacity( tLNode *node )
   {
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
     node->setTau( tau );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
       << node->getHydrWidth() << " S=" << node->calcSlope() << std::endl;
     tauex = ( tau > tauc ) ? (tau - tauc) : 0.0;
@@ -1891,7 +1990,7 @@ tSedTransPwrLawMulti::tSedTransPwrLawMulti( const tInputFile &infile )
     tagline[9] = digit;
     mdGrndiam[i] = infile.ReadItem( mdGrndiam[i], tagline );
     mdTauc[i] = thetac * (sig-rho) * g * mdGrndiam[i];
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "Diam " << i << " = " << mdGrndiam[i] << " tauc = "
       << mdTauc[i] << std::endl;
   }
@@ -1958,18 +2057,18 @@ double tSedTransPwrLawMulti::TransCapacity( tLNode *node, int lyr, double weight
     frac[i] = node->getLayerDgrade(lyr,i) / node->getLayerDepth(lyr);
     assert( frac[i]>=0.0 );
     d50 += frac[i] * mdGrndiam[i];
-    if( 0 )
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     {
       std::cout << "uh oh2: " << node->getLayerDgrade(lyr,0) << " "
       << node->getLayerDgrade(lyr,1) << std::endl;
       std::cout << frac[0] << " " << frac[1] << std::endl;
     }
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "frac " << i << " = " << frac[i] << std::endl;
   }
   assert( d50>=0.0 );
   assert( d50<1e10 );
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "D50 = " << d50 << std::endl;
   
   // Compute shear stress
@@ -1980,7 +2079,7 @@ double tSedTransPwrLawMulti::TransCapacity( tLNode *node, int lyr, double weight
     tau = kt * pow( node->getQ()/node->getHydrWidth(), mf ) * pow( slp, nf );
   }
   node->setTau( tau );
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "kt=" << kt << " Q=" << node->getQ() << " W="
     << node->getHydrWidth() << " S=" << node->calcSlope()
     << " tau=" << tau << std::endl;
@@ -1991,7 +2090,7 @@ double tSedTransPwrLawMulti::TransCapacity( tLNode *node, int lyr, double weight
   for( i=0; i<miNumgrnsizes; i++ )
   {
     tauc = mdTauc[i] * pow( mdGrndiam[i] / d50, -mdHidingexp );
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       std::cout << "tauc " << i << " = " << tauc << std::endl;
     tauex = tau - tauc;
     tauex = (tauex>0.0) ? tauex : 0.0;
@@ -2024,7 +2123,7 @@ double tSedTransPwrLawMulti::TransCapacity( tLNode * /* node */ )
 tSedTransWilcock::tSedTransWilcock( const tInputFile &infile )
 : grade(2)
 {
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "tSedTransWilcock(infile)\n" << std::endl;
   //strcpy( add, "1" );  // GT changed from add = '1' to prevent glitch
   /*for(i=0; i<=1; i++){
@@ -2121,7 +2220,7 @@ double tSedTransWilcock::TransCapacity( tLNode *nd )
   //tau = taudim*pow(nd->getHydrRough()*nd->getQ()/nd->getHydrWidth(), 0.6)*pow( nd->calcSlope(), 0.7);
   tau = taudim*pow(0.03, 0.6)*pow(nd->getQ()/SECPERYEAR, 0.3)*pow( nd->calcSlope(), 0.7);
   
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "hydrrough is " << nd->getChanRough() << std::endl;
     std::cout << "q is " << nd->getQ() << std::endl;
     std::cout << "slope is " << nd->calcSlope() << std::endl;
@@ -2186,7 +2285,7 @@ double tSedTransWilcock::TransCapacity( tLNode *nd )
  \***********************************************************************/
 double tSedTransWilcock::TransCapacity( tLNode *nd, int i, double weight )
 {
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "tSedTransWilcock::TransCapacity(tLNode,int,double)\n";
   
   if( nd->calcSlope() < 0 ){
@@ -2207,7 +2306,7 @@ double tSedTransWilcock::TransCapacity( tLNode *nd, int i, double weight )
   //tau = taudim*pow(nd->getHydrRough()*nd->getQ()/nd->getHydrWidth(), 0.6)*pow( nd->calcSlope(), 0.7);
   tau = taudim*pow(0.03, 0.6)*pow(nd->getQ()/SECPERYEAR, 0.3)*pow( nd->calcSlope(), 0.7);
   
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "channel rough is " << nd->getChanRough() << std::endl;
     std::cout << "channel width is " << nd->getChanWidth() << std::endl;
     std::cout << "q in secs is " << nd->getQ()/SECPERYEAR << std::endl;
@@ -2275,7 +2374,7 @@ tSedTransMineTailings::tSedTransMineTailings( const tInputFile &infile )
   char add[2], name[20];
   double help;
   
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "tSedTransMineTailings(infile)\n" << std::endl;
   strcpy( add, "1" );  // GT changed from add = '1' to prevent glitch
   for(i=0; i<=1; i++){
@@ -2371,7 +2470,7 @@ double tSedTransMineTailings::TransCapacity( tLNode *nd )
   //tau = taudim*pow(nd->getHydrRough()*nd->getQ()/SECPERYEAR/nd->getHydrWidth(), 0.6)*pow( nd->calcSlope(), 0.7);
   tau = taudim*pow(0.03, 0.6)*pow(nd->getQ()/SECPERYEAR, 0.3)*pow( nd->calcSlope(), 0.7);
   
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "hydrrough is " << nd->getChanRough() << std::endl;
     std::cout << "q is " << nd->getQ() << std::endl;
     std::cout << "slope is " << nd->calcSlope() << std::endl;
@@ -2438,7 +2537,7 @@ double tSedTransMineTailings::TransCapacity( tLNode *nd )
  \***********************************************************************/
 double tSedTransMineTailings::TransCapacity( tLNode *nd, int i, double weight )
 {
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout << "tSedTransMineTailings::TransCapacity(tLNode,int,double)\n";
   
   if( nd->calcSlope() < 0 ){
@@ -2459,7 +2558,7 @@ double tSedTransMineTailings::TransCapacity( tLNode *nd, int i, double weight )
   //NIC check to see what taudim is -> probably right but U R anal
   tau = taudim*pow(0.03, 0.6)*pow(nd->getQ()/SECPERYEAR, 0.3)*pow( nd->calcSlope(), 0.7);
   
-  if(0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
     std::cout << "Q is " << nd->getQ() << std::endl;
     std::cout << "slope is " << nd->calcSlope() << std::endl;
     std::cout << "taudim is " << taudim << std::endl;
@@ -3349,7 +3448,8 @@ void tDebrisFlow::RunScourDeposit()
         }
       }
       // instantiate scourZoneMesh from the scour zone coordinates:
-      scourZoneMesh = new tMesh<tLNode>( zoneX, zoneY, zoneZ );
+      scourZoneMesh = new tMesh<tLNode>( zoneX, zoneY, zoneZ,
+                                         atPtr->getContext() );
       // instantiate scourCluster:
       scourCluster = new tPtrList<tLNode>();
       // start potential cluster with node downstream of orgPtr 
@@ -3391,7 +3491,8 @@ void tDebrisFlow::RunScourDeposit()
         }
       }
       // instantiate depositZoneMesh from the deposit zone coordinates:
-      depositZoneMesh = new tMesh<tLNode>( zoneX, zoneY, zoneZ );
+      depositZoneMesh = new tMesh<tLNode>( zoneX, zoneY, zoneZ,
+                                           atPtr->getContext() );
       // instantiate depositCluster:
       depositCluster = new tPtrList<tLNode>();
       // note that, here, scourCluster and depositCluster ARE mutually
@@ -4048,7 +4149,8 @@ void tErosion::TurnOffOutput()
 void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet,
                               tVegetation * /*pVegetation*/ )
 {
-  if(0) //DEBUG
+  tProfileScope scope( "tErosion::ErodeDetachLim" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     std::cout<<"ErodeDetachLim...";
   double dt,
   dtmax; // time increment
@@ -4132,6 +4234,7 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet,
  \*****************************************************************************/
 void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet, tUplift const *UPtr )
 {
+  tProfileScope scope( "tErosion::ErodeDetachLim" );
   double dt,
   dtmax; // time increment
   double frac = 0.1; //fraction of time to zero slope
@@ -4184,7 +4287,7 @@ void tErosion::ErodeDetachLim( double dtg, tStreamNet *strmNet, tUplift const *U
 	      else
         {
           dtmax = dtmin;
-          if(0) //DEBUG
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
             std::cout << "time step too small because of node at x,y,z "
             << cn->getX() << " " << cn->getY() << " " << cn->getZ()
             << std::endl;
@@ -4764,6 +4867,7 @@ void tErosion::StreamErodeMulti( double dtg, tStreamNet *strmNet, double time )
 void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
                            tVegetation * /*pVegetation*/ )
 {
+  tProfileScope scope( "tErosion::DetachErode" );
     //Added 4/00, if there is no runoff, this would crash, so check
   if(strmNet->getRainRate()-strmNet->getInfilt()>0){
     
@@ -4795,7 +4899,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
     double inletSlope;	
 	    
     //DEBUGGING 
-    if(0) {
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
       std::cout<<"inletSlope = "<< inletSlope <<std::endl;
       for( size_t i=0; i<cn->getNumg(); i++ )
         std::cout<<"sedfrac "<<i<<"="<<inletBedSizeFraction[i]<<std::endl;
@@ -4816,7 +4920,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
     // is used up
     do
     {
-      if(0) std::cout << "DetachErode: top of do loop\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "DetachErode: top of do loop\n" << std::flush;
       
       // Zero out sed influx of all sizes
       for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
@@ -4838,16 +4942,16 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
           // Also set the grain-size distribution in the upper layers to the values specified in the input 		// file by INSED1, 2, etc. Variable inletBedSizeFraction contains INSED1, 2, etc, which are
           // assumed to be fractions that sum to 1.0 (the user can screw this up ... it isn't checked!)	
         double inletSlope = strmNet->getInletSlope( time );
-		    if(0) {
+		    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
                 std::cout<<"inletSlope = "<< inletSlope <<std::endl;
                    }
 		  size_t numLayersInlet = cn->getNumLayer();
-          if(0) std::cout<<numLayersInlet<<" lay inlt\n";
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout<<numLayersInlet<<" lay inlt\n";
           for( size_t i=0; i<numLayersInlet; i++ ) {
             cn->setLayerErody( i, 0.0 );
             double layThick = cn->getLayerDepth(i);
             for( size_t j=0; j<cn->getNumg(); j++ ) {
-              if(0) 
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) 
                 std::cout<<"set lay "<<i<<", with thickness " << layThick 
                 <<", size "<<j
                 <<" to "<< layThick*inletBedSizeFraction[j] << std::endl;
@@ -4870,13 +4974,13 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
           
           // Next, we call TransCapacity, which automatically sets Qs in each size class
           insedloadtotal = sedTrans->TransCapacity( cn, 0, 1.0 );
-          if(0) std::cout<<"inlet capacity="<<insedloadtotal<<std::endl;
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout<<"inlet capacity="<<insedloadtotal<<std::endl;
           
           // Store Qs for each size class in the "insed" array so we can 
           // assign these to Qsin
           for( size_t i=0; i<cn->getNumg(); i++ ) {
             insed[i] = cn->getQs(i);   // Capacity for i-th size fraction
-            if(0) std::cout<<" insed["<<i<<"]="<<insed[i]<<std::endl;
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout<<" insed["<<i<<"]="<<insed[i]<<std::endl;
           }
           
           // Now, we set the influxes at the inlet node, both total and per-size, 
@@ -4915,7 +5019,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       // NOTE - in this first loop we are only dealing with
       // totals for time-step calculations, however transport
       // rates for each size are also set within the function call.
-      if(0) std::cout << "DetachErode: estimating rates\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "DetachErode: estimating rates\n" << std::flush;
       for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
       {
         depck=0.;
@@ -4991,7 +5095,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       }//ends for( cn = ni.FirstP...
       
       //Find local time-step based on dzdt
-      if(0) std::cout << "DetachErode: finding time step size\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "DetachErode: finding time step size\n" << std::flush;
       dtmax = dtg/frac;
       for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
       {
@@ -5005,7 +5109,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
         else
 	      {
           cn->setQsin( insed );
-          if(0) {
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
             std::cout<<"Inlet qsin set to:\n";
             for( size_t i=0; i<cn->getNumg(); i++ )
               std::cout<< " "<<i<<"="<<insed[i]<<std::endl;
@@ -5027,7 +5131,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
             assert( dtmax > 0.0 );
             if( dtmax < 0.0001 && dtmax < dtg )
             {
-              if(0) { // debug
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
                 std::cout << "Very small dtmax " << dtmax <<  std::endl;
                 std::cout << "rate dif is " << ratediff << std::endl;
                 std::cout << "elev dif is " << cn->getZ()-dn->getZ() << std::endl;
@@ -5049,7 +5153,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       //At this point: we have drdt and qs for each node, plus dtmax
       
       // Do erosion/deposition
-      if(0) std::cout << "DetachErode: eroding\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "DetachErode: eroding\n" << std::flush;
       for( cn = ni.FirstP(); ni.IsActive(); cn = ni.NextP() )
       {
         //need to recalculate cause qsin may change due to time step calc
@@ -5212,11 +5316,11 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
       
       if( track_sed_flux_at_nodes_ )
       {
-        if(0) std::cout << "WE'RE GOIN ALL THE WAY" << endl;
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "WE'RE GOIN ALL THE WAY" << endl;
         water_sed_tracker_ptr_->AddSedVolumesAtTrackingNodes( dtmax );
       }
       else
-        if(0) std::cout << "NO WAY JOSE!" << endl;
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "NO WAY JOSE!" << endl;
       
       // Erode vegetation
 #if 0
@@ -5240,7 +5344,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
   }//end if rainrate-infilt>0
   
   
-  if(0) std::cout<<"ending detach erode\n"<<std::flush;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout<<"ending detach erode\n"<<std::flush;
   
 }// End erosion algorithm
 
@@ -5267,6 +5371,7 @@ void tErosion::DetachErode(double dtg, tStreamNet *strmNet, double time,
 void tErosion::DetachErode2(double dtg, tStreamNet *strmNet, double time,
                             tVegetation * /*pVegetation*/ )
 {
+  tProfileScope scope( "tErosion::DetachErode2" );
   
   //std::cout<<"welcome to detacherode2"<<endl;
   
@@ -5420,7 +5525,7 @@ void tErosion::DetachErode2(double dtg, tStreamNet *strmNet, double time,
             assert( dtmax > 0.0 );
             if( dtmax < 0.0001 && dtmax < dtg )
             {
-              if(0) { // debug
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
                 std::cout << "Very small dtmax " << dtmax <<  std::endl;
                 std::cout << "rate dif is " << ratediff << std::endl;
                 std::cout << "elev dif is " << cn->getZ()-dn->getZ() << std::endl;
@@ -5636,6 +5741,7 @@ void tErosion::DetachErode2(double dtg, tStreamNet *strmNet, double time,
 #define kEpsOver2 0.1
 void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
 {
+  tProfileScope scope( "tErosion::Diffuse" );
   tLNode * cn;
   tEdge * ce;
   double volout,  // Sediment volume output from a node (neg=input)
@@ -5646,14 +5752,15 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
   
   // Fix for "diffusion doesn't update layers" bug GT 11/12. We assume
   // that for multi-sizes, we'll call DiffuseMultiSize instead
-  static tArray<double> deposition_depth( 1 );
+  // (Not static: several models may diffuse at once on separate threads.)
+  tArray<double> deposition_depth( 1 );
   
 #ifdef TRACKFNS
   std::cout << "tErosion::Diffuse()" << std::endl;
 #endif
 	
   kd = kd_ts.calc( time );
-  if(0) std::cout << "kd = " << kd << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "kd = " << kd << std::endl;
   
   if( kd==0 ) return;
   //initialize Qsd, which will record the total amount of diffused material
@@ -5667,12 +5774,12 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
   // (Note: for a fixed mesh, this calculation only needs to be done once;
   // performance could be improved by having this block only called if
   // mesh has changed since last time through)
-  if(0) std::cout << "About to enter edge loop...\n" << std::flush;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "About to enter edge loop...\n" << std::flush;
   dtmax = rt;  // Initialize dtmax to total time rt
   for( ce=edgIter.FirstP(); edgIter.IsActive(); ce=edgIter.NextP() )
   {
     assert( ce!=0 );
-    if( 0 ) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     {
       std::cout << "In Diffuse(), large vedglen detected: " << ce->getVEdgLen() << std::endl;
       ce->TellCoords();
@@ -5684,7 +5791,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
     if( delt < dtmax )
     {
       dtmax = delt;
-      if(0) { //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
         std::cout << "TIME STEP CONSTRAINED TO " << dtmax << " AT EDGE:\n";
         ce->TellCoords(); }
     }
@@ -5711,7 +5818,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
       cn = static_cast<tLNode *>(ce->getDestinationPtrNC());
       cn->addQsin( volout );
       
-      if( 0 ) { //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
         std::cout << volout << " mass exch. from " << ce->getOriginPtr()->getID()
         << " to "
         << ce->getDestinationPtr()->getID()
@@ -5730,7 +5837,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
     // Compute erosion/deposition for each node
     for( cn=nodIter.FirstP(); nodIter.IsActive(); cn=nodIter.NextP() )
     {
-      if( 0 ) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
         std::cout << "Node " << cn->getID() << " Qsin: " << cn->getQsin()
         << " dz: " << cn->getQsin() / cn->getVArea() << std::endl;
       if( noDepoFlag && cn->getQsin() > 0.0 )
@@ -5743,7 +5850,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
       cn->getDownstrmNbr()->addQsdin(-1 * cn->getQsin()/dtmax);  
       //this won't work if time steps are varying, because you are adding fluxes
       
-      if( 0 ) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
         std::cout<<cn->getZ()<<" Q: "<<cn->getQ()
         <<" dz "<<cn->getQsin() / cn->getVArea()
         <<" dt "<<dtmax<<std::endl;
@@ -5755,7 +5862,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
     rt -= dtmax;
     if( dtmax>rt ) dtmax=rt;
     
-    if(0) std::cout << "bottom of do loop in Diffuse()\n" << std::flush;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "bottom of do loop in Diffuse()\n" << std::flush;
     
   } while( rt>0.0 );
   
@@ -5768,6 +5875,7 @@ void tErosion::Diffuse( double rt, bool noDepoFlag, double time )
 #define kEpsOver2 0.1
 void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
 {
+  tProfileScope scope( "tErosion::DiffuseMultiSize" );
   tLNode * cn;
   tLNode * dn;
   tLNode * hn;
@@ -5781,14 +5889,15 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
   int i;
   
   // Here we create arrays to handle flux and deposition in the 
-  // various size classes
-  static tArray<double> deposition_depth( num_grain_sizes_ );
-  static tArray<double> volout_by_size( num_grain_sizes_ );
+  // various size classes (not static: they are sized for this model, and
+  // several models may diffuse at once on separate threads)
+  tArray<double> deposition_depth( num_grain_sizes_ );
+  tArray<double> volout_by_size( num_grain_sizes_ );
   
-  if (0) std::cout << "tErosion::DiffuseMultiSize()" << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "tErosion::DiffuseMultiSize()" << std::endl;
 	
   kd = kd_ts.calc( time );
-  if(0) std::cout << "kd = " << kd << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "kd = " << kd << std::endl;
   
   if( kd==0 ) return;
   //initialize Qsd, which will record the total amount of diffused material
@@ -5802,12 +5911,12 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
   // (Note: for a fixed mesh, this calculation only needs to be done once;
   // performance could be improved by having this block only called if
   // mesh has changed since last time through)
-  if(0) std::cout << "About to enter edge loop...\n" << std::flush;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "About to enter edge loop...\n" << std::flush;
   dtmax = rt;  // Initialize dtmax to total time rt
   for( ce=edgIter.FirstP(); edgIter.IsActive(); ce=edgIter.NextP() )
   {
     assert( ce!=0 );
-    if( 0 ) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
     {
       std::cout << "In Diffuse(), large vedglen detected: " << ce->getVEdgLen() << std::endl;
       ce->TellCoords();
@@ -5819,7 +5928,7 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
     if( delt < dtmax )
     {
       dtmax = delt;
-      if(0) { //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
         std::cout << "TIME STEP CONSTRAINED TO " << dtmax << " AT EDGE:\n";
         ce->TellCoords(); }
     }
@@ -5848,7 +5957,7 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
 		hn = dn;
 		
 		//DEBUG
-		if (0){
+		if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ){
 		std::cout << " Height cn: " << cn->getZ() << " Height dn: " << dn->getZ() << " Height hn: " << hn->getZ() << std::endl;
 		}
 		
@@ -5867,13 +5976,13 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
 			dn->addQsin( g, volout_by_size[g] );
 			
 		 }
-		 	if (0){
+		 	if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ){
 			std::cout  << " Regolith Depth hn: " << hn->getRegolithDepth() << std::endl;
 			}
 			
 		 //DEBUG
 		
-		if( 0 ) { //DEBUG
+		if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
         std::cout << volout << " mass exch. from " << ce->getOriginPtr()->getID()
         << " to "
         << ce->getDestinationPtr()->getID()
@@ -5912,7 +6021,7 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
 	  cn->getDownstrmNbr()->addQsdin(-1 * cn->getQsin()/dtmax);  //what does this do? removed or added in, can't see diff
 	  
 	  
-	  if( 0 ) //DEBUG
+	  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
 	   {
         std::cout << "Node " << cn->getID() << " Qsin: " << cn->getQsin()
         << " dz: " << cn->getQsin() / cn->getVArea() << std::endl;
@@ -5932,7 +6041,7 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
     rt -= dtmax;
     if( dtmax>rt ) dtmax=rt;
     
-    if(0) std::cout << "bottom of do loop in Diffuse()\n" << std::flush;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) std::cout << "bottom of do loop in Diffuse()\n" << std::flush;
     
   } while( rt>0.0 );
   
@@ -5993,6 +6102,7 @@ void tErosion::DiffuseMultiSize( double rt, bool noDepoFlag, double time )
 #define kBeta 0.999    // Dz/Sc isn't allowed to go higher than this
 void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
 {
+  tProfileScope scope( "tErosion::DiffuseNonlinear" );
   tLNode * cn;
   tEdge * ce;
   double volout,  // Sediment volume output from a node (neg=input)
@@ -6033,7 +6143,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
     k=0;
     for( ce=edgIter.FirstP(); edgIter.IsActive(); ce=edgIter.NextP() )
     {
-      if( 0 ) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
       {
         std::cout << "In Diffuse(), large vedglen detected: " << ce->getVEdgLen() << std::endl;
         ce->TellCoords();
@@ -6048,7 +6158,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
       if( delt < dtmax )
       {
         dtmax = delt;  // remember the smallest delt
-        if(0) { //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
           std::cout << "TIME STEP CONSTRAINED TO " << dtmax << " AT EDGE:\n";
           ce->TellCoords(); }
       }
@@ -6075,7 +6185,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
       cn = static_cast<tLNode *>(ce->getDestinationPtrNC());
       cn->addQsin( volout );
       
-      if( 0 ) { //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) ) {
         std::cout << volout << " mass exch. from " << ce->getOriginPtr()->getID()
         << " to "
         << ce->getDestinationPtr()->getID()
@@ -6096,7 +6206,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
     // Compute erosion/deposition for each node
     for( cn=nodIter.FirstP(); nodIter.IsActive(); cn=nodIter.NextP() )
     {
-      if( 0 ) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
         std::cout << "Node " << cn->getID() << " Qsin: " << cn->getQsin()
         << " dz: " << cn->getQsin() / cn->getVArea() << std::endl;
       if( noDepoFlag && cn->getQsin() > 0.0 )
@@ -6105,7 +6215,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
       cn->getDownstrmNbr()->addQsdin(-1 * cn->getQsin()/dtmax);
       //this won't work if time steps are varying, because you are adding fluxes
       
-      if( 0 ) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
         std::cout<<cn->getZ()<<" Q: "<<cn->getQ()
         <<" dz "<<cn->getQsin() / cn->getVArea()
         <<" dt "<<dtmax<<std::endl;
@@ -6176,6 +6286,7 @@ void tErosion::DiffuseNonlinear( double rt, bool noDepoFlag, double time )
 #define kBeta 0.999    // Dz/Sc isn't allowed to go higher than this
 void tErosion::DiffuseNonlinearDepthDep( double rt, double time )
 {
+  tProfileScope scope( "tErosion::DiffuseNonlinearDepthDep" );
 #ifdef TRACKFNS
   std::cout << "tErosion::DiffuseNonlinear()" << std::endl;
 #endif
@@ -6397,6 +6508,7 @@ void tErosion::DiffuseNonlinearDepthDep( double rt, double time )
  \***************************************************************************/
 void tErosion::ProduceRegolith( double dtg, double time )
 {
+  tProfileScope scope( "tErosion::ProduceRegolith" );
   tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() ); // node iter.
   // do physical weathering for each active node:
   for( tLNode* n = ni.FirstP(); ni.IsActive(); n = ni.NextP() )
@@ -6501,6 +6613,7 @@ void tErosion::ProduceRegolith( double dtg, double time )
  \***************************************************************************/
 void tErosion::WeatherBedrock( double dtg )
 {
+  tProfileScope scope( "tErosion::WeatherBedrock" );
   tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() ); // node iter.
   // do chemical weathering for each active node:
   double totalFlux=0.0;
@@ -6566,6 +6679,7 @@ void tErosion::WeatherBedrock( double dtg )
 void tErosion::LandslideClusters( double rainrate, 
                                  double time )
 {
+  tProfileScope scope( "tErosion::LandslideClusters" );
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   tMesh< tLNode >::edgeListIter_t edgIter( meshPtr->getEdgeList() );
   int numActiveEdges = meshPtr->getEdgeList()->getActiveSize();
@@ -6712,7 +6826,7 @@ void tErosion::LandslideClusters( double rainrate,
       // find net downhill force for each node.
       nodeNetForce[i] = 
 	nodeDrivingForce[i] - nodeLatCohesion[i] - nodeBasalStrength[i];
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kErosion ) )
 	cout << cn->getSubSurfaceDischarge() << " " << cn->getDrArea() 
 	     << " " << slope << "\n ";
       // record forces for nodes:
@@ -6912,6 +7026,7 @@ void tErosion::LandslideClusters( double rainrate,
 void tErosion::LandslideClusters3D( double rainrate, 
 				  double time )
 {
+  tProfileScope scope( "tErosion::LandslideClusters3D" );
   // initialize nodeList and edgeList iterators:
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   tMesh< tLNode >::edgeListIter_t edgIter( meshPtr->getEdgeList() );
@@ -7591,6 +7706,7 @@ void tErosion::LandslideClusters3D( double rainrate,
  **********************************************************************/
 void tErosion::UpdateExposureTime( double dtg)
 {
+  tProfileScope scope( "tErosion::UpdateExposureTime" );
   tLNode * cn;
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   
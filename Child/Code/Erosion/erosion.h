@@ -89,6 +89,20 @@
  **
  **  Needs to look at the mesh; can either make it a template or just use
  **  the mesh of tLNodes. Do the latter...
+ **
+ **  The mean elevation comes from the running volume total of the mesh's
+ **  model context, which a tEquilibCheck turns on for its lifetime (see
+ **  tModelContext.h), so that a check costs a pass over the mesh only
+ **  after the mesh itself has changed. Records older than the long-term
+ **  interval are dropped.
+ **
+ **  CheckSteadyState is the test used to end a run at steady state (see
+ **  OPTEQUILIBSTOP in childInterface). Every EQUILIB_INTERVAL years it
+ **  finds the long-term rate, and the run is taken to be at steady state
+ **  once the relative rate (the rate of change of mean elevation divided
+ **  by the mean elevation, in 1/yr) has stayed below EQUILIB_TOLERANCE
+ **  at every check for EQUILIB_WINDOW years. Checks made less than
+ **  EQUITIME years after the start do not count.
  */
 /***************************************************************************/
 class tEquilibCheck
@@ -112,10 +126,14 @@ public:
   void setTimePtr( tRunTimer * );
   double getLongRate() const;
   double getShortRate() const;
+  double getMeanElev() const; //mean elevation at the last call
+  double getRelativeLongRate() const; //|long-term rate| / |mean elevation|
   double FindIterChngRate(); //find the change rate since last call
   double FindLongTermChngRate(); //find change rate over pre-set interval
   double FindLongTermChngRate( double ); //find rate over given interval
+  bool CheckSteadyState(); //has the run reached steady state? (see above)
 private:
+  double FindMeanElev(); //mean elevation of the interior nodes
   tMesh< tLNode > *meshPtr; //ptr to tMesh
   tRunTimer *timePtr; //ptr to tRunTimer
   double longTime; //'long' time interval
@@ -123,6 +141,13 @@ private:
   //'mass' is misnomer--actually mean elev.
   double longRate;
   double shortRate;
+  double meanElev;
+  double checkInterval; //time between steady-state checks
+  double tolerance; //relative rate below which the run may be steady
+  double window; //time the rate must stay below tolerance
+  double startTime; //time at construction
+  double nextCheckTime; //time of the next steady-state check
+  double steadySince; //time of first check of current run below tol., or -1
 };
 
 /***************************************************************************/
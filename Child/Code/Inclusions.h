@@ -16,6 +16,8 @@
 #include "Definitions.h"
 #include "Classes.h"
 #include "errors/errors.h"
+#include "tLog/tLog.h"
+#include "tProfiler/tProfiler.h"
 #include "Mathutil/mathutil.h"
 #include "tArray/tArray.h"
 #include "tPtrList/tPtrList.h"
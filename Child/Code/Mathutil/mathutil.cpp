@@ -16,53 +16,164 @@
 
 #include "../tInputFile/tInputFile.h"
 #include "../tListInputData/tListInputData.h"
+#include "../errors/errors.h"
 
-/*********************************************************\
-**  ran3
-**
-**  Random number generator from Numerical Recipes.
-**  Returns a uniform random number between 0.0 and 1.0.
-**  Set idum to any negative value to initialize or
-**  reinitialize the sequence.
-**
-**  Parameters: idum - random seed
-**
-\*********************************************************/
-
-tRand::tRand(long seed)
+tRand::tRand(long seed, tGenerator generator_)
+  : generator(generator_)
 {
   init(seed);
 }
 
 tRand::tRand( tRand const &orig )
-  : inext(orig.inext), inextp(orig.inextp)
+  : generator(orig.generator), seed_(orig.seed_),
+    inext(orig.inext), inextp(orig.inextp), blockIndex(orig.blockIndex)
 {
   for( int i=1;i<=55;i++)
     ma[i] = orig.ma[i];
+  for( int i=0; i<4; ++i ) {
+    counter[i] = orig.counter[i];
+    block[i] = orig.block[i];
+  }
+  key[0] = orig.key[0];
+  key[1] = orig.key[1];
+}
+
+tRand& tRand::operator=( tRand const &orig )
+{
+  if( &orig != this ) {
+    generator = orig.generator;
+    seed_ = orig.seed_;
+    for( int i=1;i<=55;i++)
+      ma[i] = orig.ma[i];
+    inext = orig.inext;
+    inextp = orig.inextp;
+    for( int i=0; i<4; ++i ) {
+      counter[i] = orig.counter[i];
+      block[i] = orig.block[i];
+    }
+    key[0] = orig.key[0];
+    key[1] = orig.key[1];
+    blockIndex = orig.blockIndex;
+  }
+  return *this;
 }
-tRand::tRand( tInputFile const &infile )
+
+// With ran3, every subsystem starts from SEED, as in earlier versions;
+// with Philox, each subsystem other than the main one gets its own stream.
+tRand::tRand( tInputFile const &infile, tStreamSubsystem subsystem )
 {
-  initFromFile( infile );
+  initFromFile( infile, subsystem );
   // read previous state if necessary
   int opt;
   if ( (opt = infile.ReadItem( opt, "OPTREADINPUT" )) == OPTREADINPUT_PREVIOUS)
     tListInputDataRand( infile, *this );
 }
 
-void tRand::initFromFile( tInputFile const &infile )
+void tRand::initFromFile( tInputFile const &infile,
+			  tStreamSubsystem subsystem )
 {
   int seed;
   seed = infile.ReadItem( seed, "SEED" );
-  init(seed);
+  const int gen = infile.ReadInt( "RAND_GENERATOR", false );
+  if( gen != kRan3 && gen != kPhilox )
+    ReportFatalError( "RAND_GENERATOR must be 0 (ran3) or 1 (Philox)." );
+  generator = static_cast<tGenerator>( gen );
+  if( generator == kPhilox && subsystem != kMainStream )
+    initStream( seed, subsystem, 0 );
+  else
+    init(seed);
 }
 
+/*********************************************************\
+**  initStream
+**
+**  Starts stream "index" of the given subsystem for this
+**  seed. Philox streams differ only in the upper half of
+**  the counter (subsystem in the top 8 bits, then the
+**  index), so they never overlap unless a stream draws
+**  more than 2^66 numbers. With ran3, a new sequence is
+**  seeded from a mix of the three numbers; such sequences
+**  are not guaranteed to be independent.
+\*********************************************************/
+void tRand::initStream( long seed, tStreamSubsystem subsystem,
+			unsigned long index )
+{
+  if( generator == kRan3 ) {
+    const unsigned long mix = static_cast<unsigned long>( seed )
+      ^ ( 0x9E3779B1UL * ( static_cast<unsigned long>( subsystem ) + 1 ) )
+      ^ ( 0x85EBCA77UL * index );
+    init( static_cast<long>( mix % 1000000000UL ) );
+    return;
+  }
+  seed_ = seed;
+  const uint64_t seed64 = static_cast<uint64_t>( seed );
+  const uint64_t index64 = static_cast<uint64_t>( index );
+  key[0] = static_cast<uint32_t>( seed64 );
+  key[1] = static_cast<uint32_t>( seed64 >> 32 );
+  counter[0] = counter[1] = 0;
+  counter[2] = static_cast<uint32_t>( index64 );
+  counter[3] = ( static_cast<uint32_t>( subsystem ) << 24 )
+    ^ static_cast<uint32_t>( ( index64 >> 32 ) & 0xFFFFFF );
+  blockIndex = 4;  // no block computed yet
+}
+
+// Returns a new generator on stream "index" of the given subsystem, for
+// the seed this one was started with
+tRand tRand::Stream( tStreamSubsystem subsystem, unsigned long index ) const
+{
+  tRand stream( *this );
+  stream.initStream( seed_, subsystem, index );
+  return stream;
+}
+
+// The state is written one number per line; the number of lines is given
+// by numberRecords (ran3: the 55-element table, inext and inextp; Philox:
+// key, counter and block index).
 void tRand::dumpToFile( std::ofstream& outFile ){
+  if( generator == kPhilox ) {
+    outFile << key[0] << '\n' << key[1] << '\n';
+    for( int i=0; i<4; ++i )
+      outFile << counter[i] << '\n';
+    outFile << blockIndex << '\n';
+    return;
+  }
   for(size_t i=1; i<sizeof(ma)/sizeof(ma[0]); ++i)
     outFile << ma[i] << '\n';
   outFile << inext << '\n' << inextp << '\n';
 }
 
+void tRand::getState( std::vector<uint64_t> &words ) const {
+  words.clear();
+  words.push_back( static_cast<uint64_t>( generator ) );
+  if( generator == kPhilox ) {
+    words.push_back( key[0] );
+    words.push_back( key[1] );
+    for( int i=0; i<4; ++i )
+      words.push_back( counter[i] );
+    words.push_back( static_cast<uint64_t>( blockIndex ) );
+    return;
+  }
+  for(size_t i=1; i<sizeof(ma)/sizeof(ma[0]); ++i)
+    words.push_back( static_cast<uint64_t>( ma[i] ) );
+  words.push_back( static_cast<uint64_t>( inext ) );
+  words.push_back( static_cast<uint64_t>( inextp ) );
+}
+
 void tRand::readFromFile( std::ifstream& inFile ){
+  if( generator == kPhilox ) {
+    inFile >> key[0] >> key[1];
+    for( int i=0; i<4; ++i )
+      inFile >> counter[i];
+    inFile >> blockIndex;
+    seed_ = static_cast<long>( key[0] | ( static_cast<uint64_t>( key[1] ) << 32 ) );
+    if( blockIndex < 4 ) {
+      // recompute the block in use, whose counter is one less
+      uint32_t current[4] = { counter[0], counter[1], counter[2], counter[3] };
+      if( current[0]-- == 0 ) current[1]--;
+      PhiloxBlock( current, block );
+    }
+    return;
+  }
   for(size_t i=1; i<sizeof(ma)/sizeof(ma[0]); ++i)
     inFile >> ma[i];
   inFile >> inext;
@@ -70,6 +181,8 @@ void tRand::readFromFile( std::ifstream& inFile ){
 }
 
 int tRand::numberRecords() const {
+  if( generator == kPhilox )
+    return 2+4+1;
   return sizeof(ma)/sizeof(ma[0])-1+2;
 }
 
@@ -80,6 +193,16 @@ int tRand::numberRecords() const {
 
 void tRand::init(long seed)
 {
+  if( generator == kPhilox ) {
+    initStream( seed, kMainStream, 0 );
+    return;
+  }
+  seed_ = seed;
+  key[0] = key[1] = 0;  // Philox state, unused
+  for( int j=0; j<4; ++j )
+    counter[j] = block[j] = 0;
+  blockIndex = 4;
+
   int i,ii,k;
 
   long mj=MSEED-(seed < 0 ? -seed : seed);
@@ -103,7 +226,19 @@ void tRand::init(long seed)
 }
 
 
-double tRand::ran3()
+/*********************************************************\
+**  ran3NR
+**
+**  Random number generator from Numerical Recipes.
+**  Returns a uniform random number between 0.0 and 1.0.
+**  Set idum to any negative value to initialize or
+**  reinitialize the sequence.
+**
+**  Parameters: idum - random seed
+**
+\*********************************************************/
+
+double tRand::ran3NR()
 {
   if (++inext == 56) inext=1;
   if (++inextp == 56) inextp=1;
@@ -117,6 +252,59 @@ double tRand::ran3()
 #undef MZ
 #undef FAC
 
+/*********************************************************\
+**  PhiloxBlock
+**
+**  Philox4x32-10 (Salmon, Moraes, Dror and Shaw, 2011,
+**  "Parallel random numbers: as easy as 1, 2, 3", SC11):
+**  ten rounds of multiply-and-mix of the counter, with the
+**  key bumped by Weyl constants between rounds. Returns
+**  four 32-bit numbers.
+\*********************************************************/
+void tRand::PhiloxBlock( const uint32_t ctr[4], uint32_t out[4] ) const
+{
+  const uint32_t M0 = 0xD2511F53U, M1 = 0xCD9E8D57U;
+  const uint32_t W0 = 0x9E3779B9U, W1 = 0xBB67AE85U;
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for( int round=0; round<10; ++round ) {
+    const uint64_t p0 = static_cast<uint64_t>( M0 ) * c0;
+    const uint64_t p1 = static_cast<uint64_t>( M1 ) * c2;
+    const uint32_t hi0 = static_cast<uint32_t>( p0 >> 32 );
+    const uint32_t lo0 = static_cast<uint32_t>( p0 );
+    const uint32_t hi1 = static_cast<uint32_t>( p1 >> 32 );
+    const uint32_t lo1 = static_cast<uint32_t>( p1 );
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+    k0 += W0;
+    k1 += W1;
+  }
+  out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+/*********************************************************\
+**  ran3
+**
+**  Returns the next number of the sequence, uniform in
+**  [0,1), from the selected generator. For Philox, each
+**  block of four numbers comes from the current counter,
+**  which is then incremented (the lower 64 bits only; the
+**  upper half identifies the stream).
+\*********************************************************/
+double tRand::ran3()
+{
+  if( generator == kRan3 )
+    return ran3NR();
+  if( blockIndex == 4 ) {
+    PhiloxBlock( counter, block );
+    if( ++counter[0] == 0 ) ++counter[1];
+    blockIndex = 0;
+  }
+  return block[blockIndex++] * ( 1.0/4294967296.0 );
+}
+
 double tRand::ExpDev()
 {
   double dum;
@@ -32,31 +32,79 @@ double genrand_res53(void);
 // forward declaration
 class tInputFile;
 #include <iosfwd>
+#include <vector>
 #include <math.h>
+#include <stdint.h>
 
 /** @class tRand
 **
 **  A simple class that generates a random sequence
+**
+**  Two generators are available, chosen with the RAND_GENERATOR keyword:
+**
+**    0  ran3, the lagged-Fibonacci generator from Numerical Recipes
+**       (default; gives the same sequences as earlier versions of CHILD)
+**    1  Philox4x32-10 (Salmon et al., 2011), a counter-based generator:
+**       each number is a fixed function of a key (the seed) and of its
+**       position in the sequence, so a sequence can be split into keyed,
+**       independent streams (see Stream) without any shared state, and
+**       streams give the same numbers however work is spread over
+**       threads or processes.
+**
+**  Whichever generator is selected, ran3() returns the next number,
+**  uniform in [0,1).
+**
+**  A Philox stream is identified by a subsystem (one of the
+**  tStreamSubsystem values) and an index within it (e.g., a thread,
+**  basin or ensemble member number; see childInterface::SetRandomSeed).
+**  With ran3 there is only one sequence per seed, so Stream() and
+**  initStream() fall back on seeding a new ran3 sequence from the seed,
+**  subsystem and index.
 */
 class tRand
 {
 public:
+  enum tGenerator { kRan3 = 0, kPhilox = 1 };
+  enum tStreamSubsystem {
+    kMainStream = 0,  // the model's own sequence (storms, meandering, ...)
+    kMeshStream,      // mesh generation
+    kMemberStream,    // ensemble members, scenarios and the like
+    kThreadStream,    // work done in parallel
+    kLandslideStream  // stochastic landsliding
+  };
+
   tRand(tRand const &);
   tRand& operator=(tRand const &);
   tRand();
-  tRand(long);
-  tRand(tInputFile const &);
+  tRand(long, tGenerator = kRan3);
+  tRand(tInputFile const &, tStreamSubsystem = kMainStream);
   void init(long);
+  void initStream(long, tStreamSubsystem, unsigned long);
+  tRand Stream(tStreamSubsystem, unsigned long) const;
+  tGenerator getGenerator() const {return generator;}
   double ran3();
   double ExpDev();
   void dumpToFile( std::ofstream&  );
   void readFromFile( std::ifstream& );
   int numberRecords() const;
+  // The generator and its state (what dumpToFile writes), as words
+  void getState( std::vector<uint64_t> & ) const;
 private:
-  void initFromFile(tInputFile const &);
+  void initFromFile(tInputFile const &, tStreamSubsystem);
+  double ran3NR();
+  void PhiloxBlock( const uint32_t counter[4], uint32_t out[4] ) const;
+
+  tGenerator generator;
+  long seed_;          // seed of the current sequence (for Stream)
   // state of ran3()
   long ma[56];
   int inext, inextp;
+  // state of Philox: key, counter of the next block, last block computed
+  // and how much of it has been used
+  uint32_t key[2];
+  uint32_t counter[4];
+  uint32_t block[4];
+  int blockIndex;
 };
 
 
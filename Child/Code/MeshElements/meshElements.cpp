@@ -24,6 +24,7 @@
 #include <assert.h>
 #include "meshElements.h"
 #include "../globalFns.h" // For PlaneFit; this could go in geometry; TODO
+#include "../tLog/tLog.h"
 
 /**  GLOBAL FUNCTIONS  ****************************************************/
 
@@ -93,9 +94,6 @@ tArray2< double > FindIntersectionCoords( tArray2< double > const &xy1,
    return intxy;
 }
 
-// set static boolean for tNode:
-bool tNode::freezeElevations = false;
-
 /*****************************************************************************\
 **
 **  tNode::Dist
@@ -210,7 +208,7 @@ double tNode::ComputeVoronoiArea()
     {
       assert( ce!=0 );
       vedgList.insertAtBack( ce );
-      if (0) {//DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
 	tArray2< double > const &xy1 = ce->getRVtx();
 	tArray2< double > const &xy2 =
 	  vedgList.getLast()->getPtr()->getRVtx();
@@ -435,6 +433,7 @@ double tNode::ComputeVoronoiArea()
       }
     }
   varea = area;
+  if( context_!=0 ) context_->volumeValid = false;
   if( varea<=0.0 ) { // debug
     std::cout << "Error: zero or negative varea = " << varea << std::endl;
     std::cout << "Node: " << id << " " << x << " " << y << " "
@@ -544,7 +543,7 @@ void tNode::getVoronoiVertexXYZList( tList<Point3D> * vertexList )
 	PlaneFit(vtxarr.at(0), vtxarr.at(1), this->get2DCoords(),
 		 n1->get2DCoords(), n2->get2DCoords(), zvals );
       const Point3D vtx(vtxarr.at(0), vtxarr.at(1), zz);
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout << "ADDING TO LIST: x " << vtx.x << " y " << vtx.y << " z " << vtx.z << std::endl;
       vertexList->insertAtBack( vtx );
    }
@@ -58,10 +58,12 @@
 #include "../Definitions.h"
 #include "../tList/tList.h"
 #include "../tPtrList/tPtrList.h"
+#include "../tModelContext/tModelContext.h"
 #include "../tArray/tArray.h"
 #include "../tArray/tArray2.h"
 #include "../Geometry/geometry.h"   // for Point2D definitions & fns
 #include "../tInputFile/tInputFile.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
 
 using namespace std;
 
@@ -108,7 +110,7 @@ public:
 
   tNode();                                   // default constructor
   tNode( const tNode & );                    // copy constructor
-  tNode( const tInputFile & );
+  tNode( const tInputFile &, tModelContext * );
   virtual ~tNode() { edg = 0; }
 
   const tNode &operator=( const tNode & );   // assignment operator
@@ -144,6 +146,8 @@ public:
   void set3DCoords( double, double, double ); // sets x, y, and z values
   void setBoundaryFlag( tBoundary_t );    // sets boundary status flag
   void setEdg( tEdge * );         // sets ptr to one spoke
+  tModelContext *getContext() const { return context_; } // per-model params
+  void setContext( tModelContext *c ) { context_ = c; }
 
   double Dist( tNode const *, tNode const * ) const; // distance from node to line (node1,node2)
   tEdge *EdgToNod( tNode const * );// finds spoke connected to given node
@@ -172,10 +176,8 @@ public:
    void TellAll() const;  // Debugging routine that outputs node data
 #endif
 
-private:
-  static bool freezeElevations; // option for running model without 
-                                // changing elevations
 protected:
+  tModelContext *context_; // -> per-model parameters (see tModelContext.h)
   tListable        listObj;
   int id;           // ID number
   int permid;       // Permanent ID number (no renumbering!)
@@ -225,7 +227,7 @@ public:
 **   - added compedg pointer and corresponding get and set functions, 4/00 SL
 **
 \***************************************************************************/
-class tEdge
+class tEdge : private tCounted< tEdge, tMemoryAccount::kEdge >
 {
 public:
   typedef enum {
@@ -350,7 +352,7 @@ private:
 **
 */
 /**************************************************************************/
-class tTriangle
+class tTriangle : private tCounted< tTriangle, tMemoryAccount::kTriangle >
 {
 public:
   tTriangle();                    // default constructor
@@ -467,6 +469,7 @@ private:
 
 //default constructor
 inline tNode::tNode() :
+  context_(0),
   listObj(),
   id(0),
   x(0.), y(0.), z(0.),
@@ -477,6 +480,7 @@ inline tNode::tNode() :
 
 //copy constructor
 inline tNode::tNode( const tNode &original ) :
+  context_(original.context_),
   listObj(original.listObj),
   id(original.id), permid(original.id),
   x(original.x), y(original.y), z(original.z),
@@ -485,17 +489,18 @@ inline tNode::tNode( const tNode &original ) :
   public1(original.public1)
 {}
 
-inline tNode::tNode( const tInputFile & infile )
+// OPT_FREEZE_ELEVATIONS, formerly read here into a static member, is now
+// read once into the model context
+inline tNode::tNode( const tInputFile &, tModelContext *context )
 :
+  context_(context),
   listObj(),
   id(0),
   x(0.), y(0.), z(0.),
   varea(0.), varea_rcp(0.),
   boundary(kNonBoundary), edg(0),
   public1(-1)
-{ // static boolean to enable running model without changing elevations:
-  freezeElevations = infile.ReadBool( "OPT_FREEZE_ELEVATIONS", false );
-}
+{}
 
 /*X tNode::~tNode()
 {
@@ -522,6 +527,8 @@ inline const tNode &tNode::operator=( const tNode &right )
 {
    if( &right != this )
    {
+      context_ = right.context_;
+      if( context_!=0 ) context_->volumeValid = false;
       listObj = right.listObj,
       id = right.id;
 	  permid = right.permid;
@@ -645,11 +652,17 @@ inline void tNode::setID( int val ) {id = val;}
 inline void tNode::setPermID( int val ) {permid = val;}
 inline void tNode::setX( double val ) {x = val;}
 inline void tNode::setY( double val ) {y = val;}
-inline void tNode::setZ( double val ) {z = val;}
+inline void tNode::setZ( double val )
+{
+  if( context_!=0 && context_->trackVolume && boundary==kNonBoundary )
+    context_->volume += ( val - z ) * varea;
+  z = val;
+}
 
 inline void tNode::setVArea( double val )
 {
   assert( val>=0.0 );
+  if( context_!=0 ) context_->volumeValid = false;
   varea = val;
   /*varea = ( val >= 0.0 ) ? val : 0.0;*/
 }
@@ -663,6 +676,7 @@ inline void tNode::setVArea_Rcp( double val )
 
 inline void tNode::setBoundaryFlag( tBoundary_t val )
 {
+  if( context_!=0 ) context_->volumeValid = false;
   boundary = val;
 }
 
@@ -690,11 +704,21 @@ inline void tNode::setEdg( tEdge * theEdg )
 
 /***********************************************************************\
 **
-**  tNode::ChangeZ:  Adds delz to current z value
+**  tNode::ChangeZ:  Adds delz to current z value, unless the model
+**                  context says elevations are frozen
+**
+**  Like setZ, keeps the context's running volume total up to date when
+**  it is tracked (see tModelContext.h).
 **
 \***********************************************************************/
 inline void tNode::ChangeZ( double delz ) 
-{ if( !freezeElevations ) z += delz; }
+{
+  if( context_==0 ) { z += delz; return; }
+  if( context_->freezeElevations ) return;
+  if( context_->trackVolume && boundary==kNonBoundary )
+    context_->volume += delz * varea;
+  z += delz;
+}
 
 /*******************************************************************\
 **
@@ -743,14 +767,14 @@ inline tArray< double > tNode::FuturePosn() {return get2DCoords();}
 
 /*******************************************************************\
   tNode::getEdgePtrIndices() virtual function; here, returns 
-  one-member array with edg ID
+  one-member array with edg ID (-1 if there is no edge)
 
   10/10 SL
 \*******************************************************************/
 inline tArray< int > tNode::getEdgePtrIndices() 
 {
   tArray<int> ar(1);
-  ar[0] = edg->getID();
+  ar[0] = edg ? edg->getID() : -1;
   return ar;
 }
 
@@ -796,6 +820,7 @@ inline tEdge::tEdge() :
 
 //copy constructor
 inline tEdge::tEdge( const tEdge &original ) :
+  tCounted< tEdge, tMemoryAccount::kEdge >(),
   listObj(original.listObj),
   id(original.id), flowAllowed(original.flowAllowed),
   len(original.len), slope(original.slope),
@@ -1213,6 +1238,7 @@ inline tTriangle::tTriangle() :
 
 //copy constructor
 inline tTriangle::tTriangle( const tTriangle &init ) :
+  tCounted< tTriangle, tMemoryAccount::kTriangle >(),
   listObj(init.listObj),
   id(init.id)
 {
@@ -208,6 +208,12 @@ public:
 # define SET_DOUBLE_PRECISION_MODE
 #endif
 
+// The one predicates object shared by every mesh (and every model) in the
+// process. It holds only the round-off error bounds computed by
+// exactinit(), which are never changed after construction, so it is safe
+// to share between models, including models running on separate threads.
+Predicates predicate;
+
 // constructor; just calls exactinit() (SL, 10/98):
 Predicates::Predicates() 
 {
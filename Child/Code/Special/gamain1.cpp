@@ -28,8 +28,6 @@
 
 
 
-Predicates predicate;
-
 
 main( int argc, char **argv )
 {
@@ -79,9 +77,12 @@ main( int argc, char **argv )
    // Open main input file
    tInputFile inputFile( argv[1] );
 
+   // Read parameters shared by all nodes of the mesh
+   tModelContext context;
+   context.InitializeFromInputFile( inputFile );
    // Create and initialize objects:
    cout << "Creating mesh...\n";
-   tMesh<tLNode> mesh( inputFile );
+   tMesh<tLNode> mesh( inputFile, false, &context );
    cout << "Creating output files...\n";
    tLOutput<tLNode> output( &mesh, inputFile );
    tStorm storm( inputFile );
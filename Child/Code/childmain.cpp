@@ -46,8 +46,6 @@
 
 #include "tMeshList/tMeshList.h"
 
-Predicates predicate;
-
 int main( int argc, char **argv )
 {
    bool optDetachLim,      // Option for detachment-limited erosion only
@@ -89,13 +87,18 @@ int main( int argc, char **argv )
 
    // Open main input file
    tInputFile inputFile( option.inputFile );
+   tLog::InitializeFromInputFile( inputFile );
 
    // Create a random number generator for the simulation itself
    tRand rand( inputFile );
 
+   // Read parameters shared by all nodes of the mesh
+   tModelContext context;
+   context.InitializeFromInputFile( inputFile );
+
    // Create and initialize objects:
    std::cout << "Creating mesh...\n";
-   tMesh<tLNode> mesh( inputFile, option.checkMeshConsistency );
+   tMesh<tLNode> mesh( inputFile, option.checkMeshConsistency, &context );
 
    std::cout << "Creating output files...\n";
    tLOutput<tLNode> output( &mesh, inputFile, &rand );
@@ -186,22 +189,21 @@ OptTSOutput." );
    **********************************************************************/
    while( !time.IsFinished() )
    {
-      if(0) //debug
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
       	std::cout << "         " << std::endl;
       time.ReportTimeStatus();
 
       // Do storm...
       storm.GenerateStorm( time.getCurrentTime(),
                            strmNet.getInfilt(), strmNet.getSoilStore() );
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
 	     std::cout<< "Storm: "<< storm.getRainrate() << " " << storm.getStormDuration() << " "
 	          << storm.interstormDur() << std::endl;
 
       strmNet.UpdateNet( time.getCurrentTime(), storm );
-      if(0) //DEBUG
-	     std::cout << "UpdateNet::Done.." << std::endl;
+      CHILD_LOG( tLog::kDebug, tLog::kStreamNet, "UpdateNet::Done.." );
 
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
 	  {
          tMesh< tLNode >::nodeListIter_t mli( mesh.getNodeList() );  // gets nodes from the list
 		 tLNode * cn;
@@ -220,9 +222,12 @@ OptTSOutput." );
 
       // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
       if( optStratGrid )
+      {
+          uplift.ApplyPendingUplift( &mesh );  // the grid follows absolute elevations
       	  stratGrid->UpdateStratGrid(tStratGrid::k0, time.getCurrentTime());
+      }
 
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
 	  {
          tMesh< tLNode >::nodeListIter_t mli( mesh.getNodeList() );  // gets nodes from the list
 		 tLNode * cn;
@@ -261,14 +266,13 @@ OptTSOutput." );
       }
       
 
-      if(0) //DEBUG
-	     std::cout << "Erosion::Done.." << std::endl;
+      CHILD_LOG( tLog::kDebug, tLog::kErosion, "Erosion::Done.." );
 
       // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
       if( optStratGrid )
 	     stratGrid->UpdateStratGrid(tStratGrid::k1,time.getCurrentTime() );
 
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
 	  {
          tMesh< tLNode >::nodeListIter_t mli( mesh.getNodeList() );  // gets nodes from the list
 		 tLNode * cn;
@@ -288,8 +292,7 @@ OptTSOutput." );
       if( optMeander )
 	     strmMeander->Migrate( time.getCurrentTime() );
 
-      if(0) //DEBUG
-	     std::cout << "Meander-Migrate::Done..\n";
+      CHILD_LOG( tLog::kDebug, tLog::kMeander, "Meander-Migrate::Done.." );
 
       // Link tLNodes to StratNodes, adjust elevation StratNode to surrounding tLNodes
       if( optStratGrid )
@@ -298,10 +301,11 @@ OptTSOutput." );
       //----------------FLOODPLAIN---------------------------------
       if( optFloodplainDep )
 	  {
+	     uplift.ApplyPendingUplift( &mesh );  // overbank deposition uses absolute elevations
 	     if( floodplain->OptControlMainChan() )
 	        floodplain->UpdateMainChannelHeight( time.getCurrentTime(),
 						 strmNet.getInletNodePtrNC() );
-	        std::cout << "UpdateChannelHeight::Done..\n";
+	        CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "UpdateChannelHeight::Done.." );
 
 	     if( optStratGrid ){
 	        stratGrid->UpdateStratGrid(tStratGrid::k3,time.getCurrentTime());
@@ -310,7 +314,7 @@ OptTSOutput." );
 	  floodplain->DepositOverbank( storm.getRainrate(),
 				       storm.getStormDuration(),
 				       time.getCurrentTime() );
-	  std::cout << "tFloodplain::Done..\n";
+	  CHILD_LOG( tLog::kDetail, tLog::kFloodplain, "tFloodplain::Done.." );
 
 	  if( optStratGrid ){
 	    stratGrid->UpdateStratGrid(tStratGrid::k4,time.getCurrentTime());
@@ -349,10 +353,19 @@ OptTSOutput." );
 
       time.Advance( storm.getStormDuration() + storm.interstormDur() );
 
+      // With OPT_LAZY_UPLIFT, absolute elevations are behind by the datum
+      // offset until the pending uplift is applied (see tUplift)
       if( time.CheckOutputTime() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
           output.WriteOutput( time.getCurrentTime() );
+      }
 
-      if( output.OptTSOutput() ) output.WriteTSOutput();
+      if( output.OptTSOutput() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
+          output.WriteTSOutput();
+      }
 
       /* IN PROGRESS
       switch( optTSOutput ){
@@ -42,8 +42,6 @@
 
 #include "tMeshList/tMeshList.h"
 
-Predicates predicate;
-
 int main( int argc, char **argv )
 {
    bool optDetachLim,      // Option for detachment-limited erosion only
@@ -79,9 +77,13 @@ int main( int argc, char **argv )
    // Create a random number generator for the simulation itself
    tRand rand( inputFile );
 
+   // Read parameters shared by all nodes of the mesh
+   tModelContext context;
+   context.InitializeFromInputFile( inputFile );
+
    // Create and initialize objects:
    std::cout << "Creating mesh...\n";
-   tMesh<tLNode> mesh( inputFile, option.checkMeshConsistency );
+   tMesh<tLNode> mesh( inputFile, option.checkMeshConsistency, &context );
 
    std::cout << "Creating output files...\n";
    tLOutput<tLNode> output( &mesh, inputFile, &rand );
@@ -153,10 +155,19 @@ int main( int argc, char **argv )
 
       time.Advance( storm.getStormDuration() + storm.interstormDur() );
 
+      // With OPT_LAZY_UPLIFT, absolute elevations are behind by the datum
+      // offset until the pending uplift is applied (see tUplift)
       if( time.CheckOutputTime() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
           output.WriteOutput( time.getCurrentTime() );
+      }
 
-      if( output.OptTSOutput() ) output.WriteTSOutput();
+      if( output.OptTSOutput() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
+          output.WriteTSOutput();
+      }
 
    } // end of main loop
 
@@ -16,10 +16,13 @@
 #define CHILD_ABORT_ON_ERROR "CHILD_ABORT_ON_ERROR"
 #define CHILD_ABORT_ON_WARNING "CHILD_ABORT_ON_WARNING"
 
+static tFatalErrorHandler fatalErrorHandler = NULL;
+
 /*****************************************************************************\
 **
 **  ReportFatalError:  This is an error-handling routine that prints the
-**                     message errMsg then halts the program.
+**                     message errMsg then halts the program, or
+**                     calls the handler set by SetFatalErrorHandler.
 **
 **      Parameters:     errMsg -- error message
 **      Called by:
@@ -29,6 +32,8 @@
 void ReportFatalError( const char *errMsg )
 {
   std::cout << errMsg <<std::endl;
+  if( fatalErrorHandler!=NULL )
+    fatalErrorHandler( errMsg );
   std::cout << "That was a fatal error, my friend!" <<std::endl;
   if (getenv(CHILD_ABORT_ON_ERROR) != NULL)
     abort();
@@ -39,6 +44,26 @@ void ReportFatalError( const char *errMsg )
 
 
 
+/*****************************************************************************\
+**
+**  SetFatalErrorHandler:  Sets the function that ReportFatalError calls in
+**                     place of halting the program, so that a host (e.g.,
+**                     the R interface) can turn fatal errors into a
+**                     status. Returns the previous handler.
+**
+**      Parameters:     handler -- new handler, or NULL for the default
+**      Called by:      childRInterface entry points
+**
+\*****************************************************************************/
+tFatalErrorHandler SetFatalErrorHandler( tFatalErrorHandler handler )
+{
+  tFatalErrorHandler previous = fatalErrorHandler;
+  fatalErrorHandler = handler;
+  return previous;
+}
+
+
+
 /*****************************************************************************\
 **
 **  ReportWarning:  This is an error-handling routine that prints the
@@ -17,6 +17,12 @@
 
 void ReportFatalError( const char *errStr ) ATTRIBUTE_NORETURN;
 
+// Function called by ReportFatalError, after printing the message, in
+// place of halting the program; it should not return (e.g., it throws).
+// Returns the previous handler. NULL restores the default.
+typedef void (*tFatalErrorHandler)( const char *errStr );
+tFatalErrorHandler SetFatalErrorHandler( tFatalErrorHandler );
+
 void ReportWarning( const char *errstr );
 
 #endif
@@ -9,6 +9,7 @@
 /**************************************************************************/
 
 #include "globalFns.h"
+#include "tLog/tLog.h"
 #include <iostream>
 #include <algorithm>  // added Oct 09 to replace max and min macros
   using std::max;  // ditto
@@ -99,7 +100,7 @@ int TriPasses( tArray< double > const &ptest,
                tArray< double > const &p1,
                tArray< double > const &p2 )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
      std::cout << "TriPasses?\n";
 #if 1
    double ans = predicate.incircle( p0.getArrayPtr(), p1.getArrayPtr(),
@@ -161,7 +162,7 @@ bool PointsCCW( tArray< double > const &p0,
 		tArray< double > const &p1,
 		tArray< double > const &p2 )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
      std::cout << "PointsCCW? 1";
 
    if( p0 == p1 || p0 == p2 || p1 == p2 )
@@ -179,7 +180,7 @@ bool PointsCCW( tArray2< double > const &p0,
 		tArray2< double > const &p1,
 		tArray2< double > const &p2 )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
      std::cout << "PointsCCW? 2";
 
    if( p0 == p1 || p0 == p2 || p1 == p2 )
@@ -247,7 +248,7 @@ int NewTriCCW( tTriangle const *ct )
   
    if( PointsCCW( p0, p1, p2 ) ) return 1;
    else {
-     if( 0 ) {
+     if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) ) {
        std::cout << "Tri " << ct->getID() << std::endl;
          std::cout << "p0=" << p0[0] << "," << p0[1] << " ";
          std::cout << "p1=" << p1[0] << "," << p1[1] << " ";
@@ -311,7 +312,7 @@ int InNewTri( tArray< double > const &xy, tTriangle const *ct )
 /*****************************************************************************/
 int Intersect( tEdge * ae, tEdge * be )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
      std::cout << "Intersect(...)..." << std::endl;
    tLNode * lnode;
    
@@ -501,7 +502,7 @@ int Intersect( tEdge * ae, tEdge * be )
 /*****************************************************************************/
 tEdge* IntersectsAnyEdgeInList( tEdge* edge, tPtrList< tEdge >& edglistRef )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
      std::cout << "IntersectsAnyEdge( tEdge * edge )..." << std::endl;
    tEdge * ce;
    tPtrListIter< tEdge > edgIter( edglistRef );
@@ -41,7 +41,7 @@ class tLNode;
 #define min(a, b)               ((a) > (b) ? (b) : (a))*/ // commented out Oct 09 to avoid macro conflict with <vector>
 
 
-extern Predicates predicate; // object should be declared elsewhere, e.g. main
+extern Predicates predicate; // shared, read-only; defined in predicates.cpp
 
 /******** Global Function Declarations **************************************/
 tArray< double > UnitVector( tEdge const * );
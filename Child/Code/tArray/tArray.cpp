@@ -32,7 +32,7 @@ tArray( size_t number ) :
   avalue(0), npts(number)
 {
   assert( number > 0 );
-  avalue = new T [npts];
+  avalue = Allocate( npts );
   for( size_t i=0; i<npts; i++ )
     avalue[i] = 0;
 }
@@ -43,7 +43,7 @@ tArray( size_t number, const T &init) :
   avalue(0), npts(number)
 {
   assert( number > 0 );
-  avalue = new T [npts];
+  avalue = Allocate( npts );
   for( size_t i=0; i<npts; i++ )
     avalue[i] = init;
 }
@@ -56,7 +56,7 @@ tArray( const tArray< T > &original ) :
 {
   assert( npts > 0 );
 
-  avalue = new T[npts];
+  avalue = Allocate( npts );
   for( size_t i = 0; i < npts; i++ )
     avalue[i] = original.avalue[i];
 }
@@ -85,12 +85,12 @@ const tArray< T > &tArray< T >::operator=( const tArray< T > &right )
   if( &right != this )
     {
       if (npts != right.npts) { // delete and reallocate
-	delete [] avalue; avalue = 0;
+	Free( avalue, npts ); avalue = 0;
 	npts = right.npts;
 	if( npts>0 )
 	{
 	  assert( right.avalue != 0 );
-	  avalue = new T [npts];
+	  avalue = Allocate( npts );
 	}
       }
       if( npts>0 )
@@ -150,8 +150,8 @@ std::ostream &operator<<( std::ostream &output, const tArray< T > &a )
 template< class T >
 void tArray<T>::setSize( size_t size )
 {
-  delete [] avalue;
+  Free( avalue, npts );
   npts = size;
-  avalue = new T [npts];
+  avalue = Allocate( npts );
   for( size_t i=0; i<npts; i++ ) avalue[i] = 0;
 }
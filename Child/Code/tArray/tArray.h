@@ -22,6 +22,7 @@
 
 #include <iosfwd>
 #include "../errors/errors.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
 
 /***************************************************************************/
 /**
@@ -61,6 +62,10 @@ public:
   // to fortran.
   inline const T *getArrayPtr() const; // returns the actual array
 private:
+  // new [] and delete [] of the elements, counted by tMemoryAccount
+  static inline T *Allocate( size_t );
+  static inline void Free( T *, size_t );
+
   T * avalue; // the array itself
   size_t npts;   // size of array
 };
@@ -86,7 +91,7 @@ inline tArray< T >::
 tArray() :
   avalue(0), npts(1)
 {
-  avalue = new T [1];
+  avalue = Allocate( 1 );
   avalue[0] = 0;
 }
 
@@ -96,7 +101,7 @@ inline tArray< T >::
 tArray( const T& e1, const T& e2 ) :
   avalue(0), npts(2)
 {
-  avalue = new T [2];
+  avalue = Allocate( 2 );
   avalue[0] = e1;
   avalue[1] = e2;
 }
@@ -106,7 +111,7 @@ inline tArray< T >::
 tArray( const T& e1, const T& e2, const T& e3 ) :
   avalue(0), npts(3)
 {
-  avalue = new T [3];
+  avalue = Allocate( 3 );
   avalue[0] = e1;
   avalue[1] = e2;
   avalue[2] = e3;
@@ -116,7 +121,24 @@ template< class T >
 inline tArray< T >::
 ~tArray()
 {
-  delete [] avalue;
+  Free( avalue, npts );
+}
+
+template< class T >
+inline T *tArray< T >::Allocate( size_t n )
+{
+  tMemoryAccount::Add( tMemoryAccount::kArrayPayload, 1,
+		       static_cast<long>(n*sizeof(T)) );
+  return new T [n];
+}
+
+template< class T >
+inline void tArray< T >::Free( T *p, size_t n )
+{
+  if( p==0 ) return;
+  tMemoryAccount::Add( tMemoryAccount::kArrayPayload, -1,
+		       -static_cast<long>(n*sizeof(T)) );
+  delete [] p;
 }
 
 /**************************************************************************\
@@ -0,0 +1,130 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tDomainComm.cpp
+**
+**  @brief Functions for tDomainComm. See tDomainComm.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tDomainComm.h"
+#include "../errors/errors.h"
+
+#if CHILD_USE_MPI
+// Only the C interface is used
+# define OMPI_SKIP_MPICXX 1
+# define MPICH_SKIP_MPICXX 1
+# include <mpi.h>
+
+namespace
+{
+  inline MPI_Comm Comm( tDomainComm::tScope scope )
+  {
+    return ( scope==tDomainComm::kWorld ) ? MPI_COMM_WORLD : MPI_COMM_SELF;
+  }
+
+  double Reduce( tDomainComm::tScope scope, double value, MPI_Op op )
+  {
+    double result;
+    MPI_Allreduce( &value, &result, 1, MPI_DOUBLE, op, Comm( scope ) );
+    return result;
+  }
+}
+#endif
+
+tDomainComm::tDomainComm( tScope scope ) :
+  scope_(scope), rank_(0), size_(1)
+{
+#if CHILD_USE_MPI
+  MPI_Comm_rank( Comm( scope_ ), &rank_ );
+  MPI_Comm_size( Comm( scope_ ), &size_ );
+#endif
+}
+
+void tDomainComm::Initialize( int *argc, char ***argv )
+{
+#if CHILD_USE_MPI
+  MPI_Init( argc, argv );
+#else
+  (void)argc; (void)argv;
+#endif
+}
+
+void tDomainComm::Finalize()
+{
+#if CHILD_USE_MPI
+  MPI_Finalize();
+#endif
+}
+
+/**************************************************************************/
+/**
+**  tDomainComm::Exchange
+**
+**  Sends send[k] to ranks[k] and receives recv[k] from it: first the
+**  sizes, then the data, all with non-blocking calls so that the order
+**  of the list does not matter.
+*/
+/**************************************************************************/
+void tDomainComm::Exchange( const std::vector<int> &ranks,
+			    const std::vector< std::vector<double> > &send,
+			    std::vector< std::vector<double> > &recv ) const
+{
+  const size_t n = ranks.size();
+  recv.resize( n );
+  if( n==0 )
+    return;
+#if CHILD_USE_MPI
+  const MPI_Comm comm = Comm( scope_ );
+  enum { kSizeTag = 101, kDataTag = 102 };
+  std::vector<long> sendSizes( n ), recvSizes( n );
+  std::vector<MPI_Request> requests( 2*n );
+  for( size_t k=0; k<n; ++k )
+  {
+    sendSizes[k] = static_cast<long>(send[k].size());
+    MPI_Irecv( &recvSizes[k], 1, MPI_LONG, ranks[k], kSizeTag, comm,
+	       &requests[k] );
+    MPI_Isend( &sendSizes[k], 1, MPI_LONG, ranks[k], kSizeTag, comm,
+	       &requests[n+k] );
+  }
+  MPI_Waitall( static_cast<int>(2*n), &requests[0], MPI_STATUSES_IGNORE );
+
+  static double none = 0.;
+  for( size_t k=0; k<n; ++k )
+  {
+    recv[k].resize( recvSizes[k] );
+    MPI_Irecv( recv[k].empty() ? &none : &recv[k][0],
+	       static_cast<int>(recvSizes[k]), MPI_DOUBLE, ranks[k],
+	       kDataTag, comm, &requests[k] );
+    MPI_Isend( const_cast<double *>( send[k].empty() ? &none : &send[k][0] ),
+	       static_cast<int>(sendSizes[k]), MPI_DOUBLE, ranks[k],
+	       kDataTag, comm, &requests[n+k] );
+  }
+  MPI_Waitall( static_cast<int>(2*n), &requests[0], MPI_STATUSES_IGNORE );
+#else
+  (void)send;
+  ReportFatalError( "tDomainComm: no other processes without MPI." );
+#endif
+}
+
+#if CHILD_USE_MPI
+double tDomainComm::Sum( double value ) const
+{ return Reduce( scope_, value, MPI_SUM ); }
+double tDomainComm::Min( double value ) const
+{ return Reduce( scope_, value, MPI_MIN ); }
+double tDomainComm::Max( double value ) const
+{ return Reduce( scope_, value, MPI_MAX ); }
+#else
+double tDomainComm::Sum( double value ) const { return value; }
+double tDomainComm::Min( double value ) const { return value; }
+double tDomainComm::Max( double value ) const { return value; }
+#endif
@@ -0,0 +1,74 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tDomainComm.h
+**
+**  @brief Header file for tDomainComm, the messages between the
+**         processes of a run in parts (see tPartition).
+**
+**  When CHILD is built with MPI (CMake option CHILD_MPI, which defines
+**  CHILD_USE_MPI), a tDomainComm of scope kWorld is MPI_COMM_WORLD, and
+**  one of scope kSelf is the calling process alone. Without MPI both are
+**  the calling process alone, and a run has one part.
+**
+**  Exchange sends one buffer of doubles to each of a list of processes
+**  and receives one from each of them; the buffers may have any size,
+**  and each process must list the other. Sum, Min and Max combine one
+**  value over all the processes; like Exchange, every process in the
+**  communicator must call them, in the same order.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TDOMAINCOMM_H
+#define TDOMAINCOMM_H
+
+#include <stddef.h>
+#include <vector>
+
+#ifndef CHILD_USE_MPI
+#define CHILD_USE_MPI 0
+#endif
+
+/**************************************************************************/
+/**
+**  Class tDomainComm
+*/
+/**************************************************************************/
+class tDomainComm
+{
+public:
+  enum tScope { kWorld, kSelf };
+
+  explicit tDomainComm( tScope scope = kWorld );
+
+  int getRank() const { return rank_; }
+  int getSize() const { return size_; }
+
+  void Exchange( const std::vector<int> &ranks,
+		 const std::vector< std::vector<double> > &send,
+		 std::vector< std::vector<double> > &recv ) const;
+  double Sum( double ) const;
+  double Min( double ) const;
+  double Max( double ) const;
+
+  // Start and end of the run's use of MPI (nothing without it)
+  static void Initialize( int *argc, char ***argv );
+  static void Finalize();
+  // Whether this build can run on more than one process
+  static bool HaveMPI() { return CHILD_USE_MPI!=0; }
+
+private:
+  tScope scope_;
+  int rank_, size_;
+};
+
+#endif
@@ -10,6 +10,7 @@
 /**************************************************************************/
 
 #include "tEolian.h"
+#include "../tProfiler/tProfiler.h"
 
 /**************************************************************************\
 **
@@ -53,6 +54,7 @@ tEolian::tEolian( const tInputFile &infile )
 \**************************************************************************/
 void tEolian::DepositLoess( tMesh<tLNode> *mp, double delt, double ctime )
 {
+  tProfileScope scope( "tEolian::DepositLoess" );
    tMesh< tLNode >::nodeListIter_t ni( mp->getNodeList() ); // iterator for nodes
    tLNode *cn;
 
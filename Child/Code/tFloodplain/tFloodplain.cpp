@@ -68,6 +68,9 @@
 
 #include "tFloodplain.h"
 #include "../tListInputData/tListInputData.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
+#include "../tMesh/tMeshRange.h"
 
 /**************************************************************************\
 **
@@ -130,6 +133,95 @@ tFloodplain::~tFloodplain()
   delete chanDriver;
 }
 
+/**************************************************************************\
+**
+**  tOverbankBody
+**
+**  The first, parallel, part of tFloodplain::DepositOverbank: for each
+**  node of a chunk, the nearest flood node and the flood depth, then
+**  (in a separate loop over the chunk) the distance decay
+**  exp( -minDist/fplamda ), and from it the depth of the deposit. The
+**  results go to the node's slots in a tOverbankDeposits, one array per
+**  quantity. Nothing in the mesh is changed.
+**
+\**************************************************************************/
+namespace
+{
+  struct tOverbankDeposits
+  {
+    explicit tOverbankDeposits( long n ) :
+      flooded( n, 0 ), minDist( n, 0. ), floodDepth( n, 0. ), depth( n, 0. )
+    {}
+    std::vector< char > flooded;     // below WSH at nearest flood node
+    std::vector< double > minDist,   // distance to nearest flood node
+      floodDepth,                    // local flood depth
+      depth;                         // depth of deposit
+  };
+
+  class tOverbankBody
+  {
+  public:
+    tOverbankBody( const tFloodplain &fp, const tMeshRange< tLNode > &nodes,
+		   const tKdTree &floodTree,
+		   const std::vector< double > &floodWSH, double maxWSH,
+		   double fpmu, double delt, tOverbankDeposits &deposits ) :
+      fp_(fp), nodes_(nodes), floodTree_(floodTree), floodWSH_(floodWSH),
+      maxWSH_(maxWSH), fpmu_(fpmu), delt_(delt), deposits_(deposits)
+    {}
+    void operator()( long begin, long end ) const
+    {
+      std::vector< char > &flooded = deposits_.flooded;
+      std::vector< double > &minDist = deposits_.minDist;
+      std::vector< double > &floodDepth = deposits_.floodDepth;
+      std::vector< double > &depth = deposits_.depth;
+      const double drareaMin = fp_.getDrAreaMin();
+      const double fplamda = fp_.getLamda();
+
+      for( long i=begin; i<end; ++i )
+      {
+	const tLNode *cn = nodes_[i];
+	// No deposition within the main channel (Jan 05), and none on
+	// nodes above the maximum flood height
+	if( cn->getDrArea() >= drareaMin || cn->getZ() >= maxWSH_ )
+	  continue;
+	const long nearest =
+	  floodTree_.Nearest( cn->getX(), cn->getY(), minDist[i] );
+	assert( nearest>=0 ); // (should always find one)
+	const double wsh = floodWSH_[nearest];
+	assert( wsh>0 );   // should always find a closest node & set wsh
+	floodDepth[i] = wsh - cn->getZ();
+	flooded[i] = ( floodDepth[i] > 0.0 );
+      }
+
+      // Depth of deposit on the floodplain: suspension concentration
+      // based (Gross and Small, 1998), or geometrical (Howard, 1996).
+      //   NOTE: when delt > 1/mu exp( minDist/fplamda ), the solution
+      // is invalid because deposition occurs above the water surface!
+      if( fp_.getMode()==2 )
+      {
+	for( long i=begin; i<end; ++i )
+	  if( flooded[i] )
+	    depth[i] = fp_.FloodplainDh2( minDist[i], floodDepth[i], delt_,
+					  fplamda );
+      }
+      else
+      {
+	for( long i=begin; i<end; ++i )
+	  depth[i] = exp( -minDist[i]/fplamda );
+	for( long i=begin; i<end; ++i )
+	  depth[i] = flooded[i] ? floodDepth[i]*fpmu_*depth[i]*delt_ : 0.;
+      }
+    }
+  private:
+    const tFloodplain &fp_;
+    const tMeshRange< tLNode > &nodes_;
+    const tKdTree &floodTree_;
+    const std::vector< double > &floodWSH_;
+    const double maxWSH_, fpmu_, delt_;
+    tOverbankDeposits &deposits_;
+  };
+}
+
 /**************************************************************************\
 **
 **  tFloodplain::DepositOverbank
@@ -140,11 +232,14 @@ tFloodplain::~tFloodplain()
 **  IF precip > event_min (ie, overbank flood event)
 **    Create "flood list" of all flood nodes, computing WSH for each and
 **         recording the maximum WSH
-**    FOR each landscape node
+**    Index the flood nodes by position in a k-d tree
+**    FOR each landscape node (in parallel)
 **      IF node elevation is below maximum WSH
-**        Find the closest flood node
+**        Find the closest flood node (in the k-d tree)
 **        IF node elevation < WSH at closest flood node
-**          Calculate total deposition depth and update node elevation
+**          Calculate total deposition depth
+**    FOR each landscape node with a deposit (in list order)
+**      Update node elevation and layers
 **
 **  Modifications:
 **   - hydraulic geometry parameters should be interpreted for discharge
@@ -160,6 +255,13 @@ tFloodplain::~tFloodplain()
 **     in-channel deposition even under "detachment limited" conditions,
 **     and is a useful approximation for large-scale floodplain sim's.
 **     GT 6/99.
+**   - the closest flood node is found with a k-d tree (tKdTree) built
+**     for each event, rather than by sweeping the whole flood list for
+**     every node. The tree gives the same node and distance as the
+**     sweep, ties included.
+**   - deposits are worked out in parallel on the model's thread pool
+**     (tOverbankBody), then added to the nodes one by one, so results do
+**     not depend on the number of threads.
 **
 **    Parameters:
 **      precip -- precipitation rate for current storm event
@@ -170,19 +272,14 @@ tFloodplain::~tFloodplain()
 \**************************************************************************/
 void tFloodplain::DepositOverbank( double precip, double delt, double ctime )
 {
+  tProfileScope scope( "tFloodplain::DepositOverbank" );
    if( precip < event_min ) return;
 
    tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() ); // iterator for nodes
    tList<tFloodNode> floodList;    // list of "flood nodes"
    tFloodNode *fn;       // ptr to current flood node
-   tLNode *cn,           // current landscape node
-       *closestNode;     // closest flood node
+   tLNode *cn;           // current landscape node
    double maxWSH = 0.0,  // maximum water surface height at any flood node
-       minDist,          // minimum distance to a flood node
-       dist,             // distance to flood node
-       floodDepth,       // local flood depth
-       dx,dy,            // x and y distance to flood node
-       wsh=0.0,          // water surface height
        drarea;           // drainage area at flood node
 
    //std::cout << "tFloodplain\n";
@@ -196,7 +293,7 @@ void tFloodplain::DepositOverbank( double precip, double delt, double ctime )
       {
 
       	 // Debug:
-	     if (0) //DEBUG
+	     if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
 	        std::cout<< "Flood Nodes " <<cn->getX()<< ' ' << cn->getY()<<' '<<cn->getZ()
 	           <<" Slp= "<<cn->calcSlope()<<" Q= "<<cn->getQ()
 	           <<" W= "<<cn->getChanWidth()<< " MStatus="<<cn->Meanders()<<std::endl;
@@ -205,7 +302,7 @@ void tFloodplain::DepositOverbank( double precip, double delt, double ctime )
 			      kdb*pow( drarea, mqbmqs )
 			      *pow( cn->getQ()/SECPERYEAR, mqs )
 			      + cn->getZ() );
-	     if (0) //DEBUG
+	     if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
 	        std::cout << "flood depth at " << cn->getX() << ' ' << cn->getY()
 		       <<' '<< cn->getZ() << " = " << floodNode.wsh-cn->getZ() << std::endl;
          if( floodNode.wsh > maxWSH )
@@ -217,116 +314,54 @@ void tFloodplain::DepositOverbank( double precip, double delt, double ctime )
    // Just in case there are no flood nodes, stop here
    if( floodList.isEmpty() ) return;
 
-   // For each node, find the nearest flood node and if it's WSH is above
-   // the local elevation, deposit stuff
-   
-   double fpmu = fpmuVariation.calc(ctime);
-   
-   for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
+   // Index the flood nodes by position, in list order, for the
+   // closest-node search
+   std::vector< double > floodWSH;
+   tKdTree floodTree;
+   floodWSH.reserve( floodList.getSize() );
+   floodTree.Reserve( floodList.getSize() );
+   for( fn=floodList.FirstP(); fn!=0; fn=floodList.NextP() )
    {
-#define NOMAINCHANDEP 1 //Jan 05: try dis-allowing deposition within the main channel
-#if NOMAINCHANDEP
-      if( cn->getDrArea() < drarea_min ) {
-#endif
-      closestNode = 0;
-      minDist = kVeryFar;
-      if( cn->getZ() < maxWSH ) // don't bother if node is above max flood ht
-      {
-         // Sweep through the flood node list to find the closest flood node,
-         // recording its distance and wsh
-         for( fn=floodList.FirstP(); fn!=0; fn=floodList.NextP() )
-         {
-            //std::cout << "  check fn " << fn->nodePtr->getID() << std::endl << flush;
-            dx = cn->getX() - fn->nodePtr->getX();
-            dy = cn->getY() - fn->nodePtr->getY();
-            dist = sqrt( dx*dx + dy*dy );
-            if( dist<minDist )
-            {
-               minDist = dist;
-               closestNode = fn->nodePtr;
-               wsh = fn->wsh;
-            }
-
-         }
-         assert( closestNode!=0 ); // (should always find one)
-	     assert( wsh>0 );   // should always find a closest node & set wsh
-         /*std::cout << " got it: " << closestNode->getID() << " dist=" << minDist
-           << std::endl << flush;*/
-
-         // If current node is below flood level, do some deposition
-         // (note: deposit is assumed to consist of 100% of the finest
-         // grain size fraction, which is assumed to be the first fraction.
-         // All other entries in deparr are zero)
-         //   NOTE: when delt > 1/mu exp( minDist/fplamda ), the solution
-         // is invalid because deposition occurs above the water surface!
-         // An analytical solution znew = z + D0(1-exp(-fx delt)) could
-         // be used in these cases (ie, when delt is large to speed up
-         // computation)
-         if( ( floodDepth = wsh - cn->getZ() ) > 0.0 )
-         {
-            // Depth of deposition: if in a main channel, use 20% of
-            // dep rate as the bedload contribution, assuming that susp load
-            // is not deposited in main channel (obviously an approximation!);
-            // otherwise, use Howard formula
-
-#if !NOMAINCHANDEP
-            // In the channel..
-            if( minDist==0.0  ){
-
-              if (fpmode==2) {	               // Suspension concentration based
-            	deparrRect[0] = 0.0;
-            	deparrRect[1] = 0.0;
-            	deparr[0]     = 0.0;
-              } 
-			  else {                         // Howard, allows some sedimentation into the channel
-                deparrRect[0] = 0.001*floodDepth*fpmu*delt;      // coarse
-                deparrRect[1] = 0.0;                             // fine
-                deparr[0]=0.001*floodDepth*fpmu*delt;           // coarse
-              }
-	          if (0) //DEBUG
-		         std::cout<<"FP-Channel: wsh= "<< wsh <<" flooddepth= "<<floodDepth
-		            <<" dh_channel= "<<deparrRect[0] << '\n';
-            }
-            // On the floodplain...
-            else {
-#endif
-               if (fpmode ==2) {                // Suspension concentration based, Gross and Small, 1998
-		          //std::cout<<"Calling FloodplainDh"<<std::endl;
-		          deparrRect[0] = 0.0;
-		          deparrRect[1] = FloodplainDh2(minDist,floodDepth,delt,fplamda);
-               } 
-			   else {                         // Geometrical, Howard, 1996
-		          deparrRect[0] = 0.0;                         // coarse
-		          deparrRect[1] = floodDepth*fpmu*exp( -minDist/fplamda )*delt;
-		          deparr[0]= floodDepth*fpmu*exp( -minDist/fplamda )*delt;
-		          //double suspensiontest = FloodplainDh2(minDist,floodDepth,delt,fplamda);
-		          //std::cout<<"At dist "<<minDist<<" FP_1= "<<deparrRect[1]<<", FP_2= "<<suspensiontest<<std::endl;
-               }
-
-	           //if(minDist <=100.){
-	           //  std::cout<<"FP-Overbank at: " <<minDist<<" wsh=" << wsh
-	           //      <<" flooddepth= "<<floodDepth <<" dh_overbank= "<<deparrRect[1] << '\n';
-	           //}
-
-#if !NOMAINCHANDEP
-	        }
-#endif
-
-            if( deparr[0]>floodDepth)
-	           std::cout << " *WARNING, deposit thicker than flood depth\n";
-
-	        // Modify heights and communicate to stratigraphy tStratGrid
-	        cn->IncrementAccummulatedDh(deparrRect);           // new version, recieves 2d arry
-	        cn->EroDep( 0, deparr, ctime );                    // this one recieves 1 value
-         }
-      }
-#if NOMAINCHANDEP
-      }
-#endif
-#undef NOMAINCHANDEP
+      floodWSH.push_back( fn->wsh );
+      floodTree.Add( fn->nodePtr->getX(), fn->nodePtr->getY() );
+   }
+   floodTree.Build();
+
+   // For each node, find the nearest flood node and if its WSH is above
+   // the local elevation, work out the deposit (in parallel; see
+   // tOverbankBody), then add the deposits to the nodes (in list order,
+   // since EroDep updates the model's volume tally and layer ages)
+   const double fpmu = fpmuVariation.calc(ctime);
+   tMeshRange< tLNode > nodes( meshPtr->getNodeList() );
+   tOverbankDeposits deposits( nodes.size() );
+   ThreadPoolOf( meshPtr ).ParallelFor(
+     nodes.size(),
+     tOverbankBody( *this, nodes, floodTree, floodWSH, maxWSH, fpmu, delt,
+		    deposits ) );
+
+   for( long i=0; i<nodes.size(); ++i )
+   {
+      if( !deposits.flooded[i] )
+	 continue;
+      cn = nodes[i];
+
+      // Deposit is assumed to consist of 100% of the finest grain size
+      // fraction, which is assumed to be the first fraction. All other
+      // entries in deparr are zero.
+      deparrRect[0] = 0.0;                         // coarse
+      deparrRect[1] = deposits.depth[i];           // fine
+      if( fpmode!=2 )
+	 deparr[0] = deposits.depth[i];
+
+      if( deparr[0]>deposits.floodDepth[i] )
+	 std::cout << " *WARNING, deposit thicker than flood depth\n";
+
+      // Modify heights and communicate to stratigraphy tStratGrid
+      cn->IncrementAccummulatedDh(deparrRect);           // new version, recieves 2d arry
+      cn->EroDep( 0, deparr, ctime );                    // this one recieves 1 value
    }
 
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
      std::cout << "Floodplain:: done Overbanks...\n";
 }
 
@@ -342,7 +377,7 @@ double tFloodplain::FloodplainDh(double minDist, double flooddepth,
   double dh = ConcentrationToHeight(flooddepth,fpnode,C);
 
   //DEBUG, what does it produce
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
     std::cout<<"For node" <<fpnode->getX()<<","<<fpnode->getY()
 	<<" at dist "<<minDist
 	<<", with flooddepth "
@@ -558,12 +593,13 @@ bool tFloodplain::OptControlMainChan() const { return optControlMainChan; }
 \**************************************************************************/
 void tFloodplain::UpdateMainChannelHeight( double tm, tLNode * inletNode )
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tFloodplain::UpdateMainChannelHeight" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
     std::cout << "Floodplain:: start Updating Main Channel..."<<std::endl;
 
   chanDriver->UpdateMainChannelElevation( tm, inletNode );
 
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
     std::cout << "Floodplain:: Updated Main Channel..."<<std::endl;
 }
 
@@ -682,7 +718,7 @@ void tMainChannelDriver::UpdateMainChannelElevation( double tm,
 
       cn = cn->getDownstrmNbr();
       assert( cn );
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
 	std::cout<< "Meander Nodes " << cn->getID() << ' ' << cn->getX()<< ' ' << cn->getY()<<' '<<cn->getZ()
 	    <<" Q= "<<cn->getQ()<<" W= "<<cn->getChanWidth()
 	    << " MStatus="<<cn->Meanders()<<std::endl;
@@ -779,7 +815,7 @@ void tMainChannelDriver::UpdateMainChannelElevation( double tm,
 
       //std::cout <<" Channeldriver "<< cn->getX() << ' '<< cn->getY()<<"dh0= "<< delzRect[0] << " dh1= " <<delzRect[1] << '\n';
 
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
 	     if( cn->getID()==8121 || cn->getID()==8122 )
 		    std::cout<<"UpdateMCE: "<<cn->getID()<<" z before "<<cn->getZ()
 			      <<" flowedg len "<<cn->getFlowEdg()->getLength()<<" elev "<<elev<<" dz "<<elev-cn->getZ()
@@ -788,7 +824,7 @@ void tMainChannelDriver::UpdateMainChannelElevation( double tm,
       cn->IncrementAccummulatedDh(delzRect);
       cn->EroDep( 0, delz, tm );
 
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kFloodplain ) )
 	     if( cn->getID()==8121 || cn->getID()==8122 )
 		    std::cout<<"UpdateMCE: "<<cn->getID()<<" z after "<<cn->getZ()
 			      <<" flowedg len "<<cn->getFlowEdg()->getLength()<<" elev "<<elev<<" dz "<<elev-cn->getZ()
@@ -30,6 +30,7 @@
 #include "../tLNode/tLNode.h"
 #include "../tInputFile/tInputFile.h"
 #include "../tTimeSeries/tTimeSeries.h"
+#include "../tKdTree/tKdTree.h"
 
 #define kVeryFar 1.0e12
 
@@ -116,6 +117,9 @@ public:
   double getSuspendedConcentration(double) const;
   double ConcentrationToHeight(double, tLNode *, double ) const;
   void setMeshPtr( tMesh<tLNode> *ptr ) {meshPtr = ptr;}
+  int getMode() const { return fpmode; }
+  double getLamda() const { return fplamda; }
+  double getDrAreaMin() const { return drarea_min; }
 
 private:
   tTimeSeries fpmuVariation;   // "mu" parameter of Howard model, value dependent of time
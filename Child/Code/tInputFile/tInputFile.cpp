@@ -234,7 +234,8 @@ void readInputFile(std::ifstream& infile, tList< tKeyPair > &KeyWordList){
 **    - rewritten 11/07/2003 AD
 **
 \****************************************************************************/
-tInputFile::tInputFile( const char *filename )
+tInputFile::tInputFile( const char *filename ) :
+  keyWordLog_(0)
 {
    std::ifstream infile;     // the input file
 
@@ -314,6 +315,8 @@ int tInputFile::findKeyWord( const char *key ) const
   assert(key != NULL);
   const int len = KeyWordTable.getSize();
   const size_t sizeKey = strlen(key);
+  if( keyWordLog_ )
+    keyWordLog_->insert( key );
 
   for(int i=0; i < len; ++i){
     const char * const thisKey = KeyWordTable[i].key();
@@ -487,6 +490,49 @@ tArray< tKeyPair > & tInputFile::GetKeyWordTableRef()
   return KeyWordTable;
 }
 
+/****************************************************************************\
+**
+**  tInputFile::SetValue
+**
+**  Replaces the value of a keyword, so that later reads return the new
+**  value (e.g., to try out parameter values without editing the file).
+**  The keyword must already be in the file, unless add is true, in which
+**  case a missing keyword is added. The .inputs log file is not
+**  rewritten (see writeLogFile).
+\****************************************************************************/
+void tInputFile::SetValue( const char *itemCode, const char *value,
+			   bool add )
+{
+  const int i = findKeyWord( itemCode );
+  if (i != notFound){
+    KeyWordTable[i].setValue( value );
+    return;
+  }
+  if (!add)
+    ReportNonExistingKeyWord( itemCode, true );
+  const size_t n = KeyWordTable.getSize();
+  tArray< tKeyPair > table( n+1 );
+  for( size_t j=0; j<n; ++j )
+    table[j] = KeyWordTable[j];
+  table[n].setKey( itemCode );
+  table[n].setValue( value );
+  KeyWordTable = table;
+}
+
+/****************************************************************************\
+**
+**  tInputFile::RecordKeyWords
+**
+**  Until called again with a null pointer, adds each keyword looked up
+**  (whether or not it is found) to the given set. This tells a driver
+**  which parameters a piece of the initialization depends on (e.g., the
+**  mesh cache in childSweep).
+\****************************************************************************/
+void tInputFile::RecordKeyWords( std::set< std::string > *keyWordLog )
+{
+  keyWordLog_ = keyWordLog;
+}
+
 
 //****************************************************************
 // Designed and implemented:
@@ -53,6 +53,7 @@
 #include "../Definitions.h"
 #include <stddef.h>
 #include <string>
+#include <set>
 
 using namespace std;
 
@@ -108,12 +109,16 @@ public:
   // similar overrides could be added for other data types
 
   tArray< tKeyPair > & GetKeyWordTableRef();  // Returns a reference to the keyword table
+  void SetValue( const char *, const char *,    // replaces a keyword's value
+                 bool add = false );            // (or adds it)
+  void RecordKeyWords( std::set< std::string > * );  // logs keywords read
+  void writeLogFile() const;  // writes <OUTFILENAME>.inputs
 
 private:
   tArray< tKeyPair > KeyWordTable; // hold key/value pair
   enum { notFound = -1 }; // must be strictly negative
   int findKeyWord(const char*) const; // find index of keyword
-  void writeLogFile() const;
+  std::set< std::string > *keyWordLog_; // see RecordKeyWords
 
   tInputFile(tInputFile const&);
   tInputFile& operator=(tInputFile const&);
@@ -0,0 +1,134 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tKdTree.cpp
+**
+**  @brief Functions for tKdTree. See tKdTree.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tKdTree.h"
+#include <math.h>
+#include <algorithm>
+
+namespace
+{
+  // Relative margin on the pruning test, far above the round-off of a
+  // computed distance (a few units in the last place)
+  const double kPruneMargin = 1.0 + 1.0e-9;
+}
+
+void tKdTree::Add( double x, double y )
+{
+  tPoint p;
+  p.x = x;
+  p.y = y;
+  p.index = static_cast<long>(points_.size());
+  p.axis = 0;
+  points_.push_back( p );
+}
+
+void tKdTree::Build()
+{
+  Build( 0, size() );
+}
+
+/**************************************************************************/
+/**
+**  tKdTree::Build( begin, end )
+**
+**  Splits [begin,end) at its median along the wider of its x and y
+**  extents, and builds the two halves.
+*/
+/**************************************************************************/
+void tKdTree::Build( long begin, long end )
+{
+  if( end-begin<=1 )
+    return;
+  double xmin = points_[begin].x, xmax = xmin,
+    ymin = points_[begin].y, ymax = ymin;
+  for( long i=begin+1; i<end; ++i )
+  {
+    const tPoint &p = points_[i];
+    if( p.x<xmin ) xmin = p.x;
+    if( p.x>xmax ) xmax = p.x;
+    if( p.y<ymin ) ymin = p.y;
+    if( p.y>ymax ) ymax = p.y;
+  }
+  const long mid = begin + ( end-begin ) / 2;
+  const int axis = ( ymax-ymin > xmax-xmin ) ? 1 : 0;
+  if( axis==0 )
+    std::nth_element( points_.begin()+begin, points_.begin()+mid,
+		      points_.begin()+end, tLessX() );
+  else
+    std::nth_element( points_.begin()+begin, points_.begin()+mid,
+		      points_.begin()+end, tLessY() );
+  points_[mid].axis = axis;
+  Build( begin, mid );
+  Build( mid+1, end );
+}
+
+long tKdTree::Nearest( double x, double y, double &dist ) const
+{
+  long best = -1;
+  double bestDist = 0.;
+  Search( 0, size(), x, y, best, bestDist );
+  if( best>=0 )
+  {
+    dist = bestDist;
+    return points_[best].index;
+  }
+  return -1;
+}
+
+/**************************************************************************/
+/**
+**  tKdTree::Search
+**
+**  Checks the root of [begin,end) against the best point so far (best is
+**  a position in points_, or -1), then the half on the side of (x,y),
+**  then the other half unless its splitting line is out of reach.
+*/
+/**************************************************************************/
+void tKdTree::Search( long begin, long end, double x, double y,
+		      long &best, double &bestDist ) const
+{
+  if( begin>=end )
+    return;
+  const long mid = begin + ( end-begin ) / 2;
+  const tPoint &p = points_[mid];
+  const double dx = x - p.x;
+  const double dy = y - p.y;
+  const double d = sqrt( dx*dx + dy*dy );
+  if( best<0 || d<bestDist
+      || ( d==bestDist && p.index<points_[best].index ) )
+  {
+    best = mid;
+    bestDist = d;
+  }
+  if( end-begin==1 )
+    return;
+
+  const double offset = ( p.axis==0 ) ? dx : dy;
+  if( offset<0. )
+  {
+    Search( begin, mid, x, y, best, bestDist );
+    if( -offset<=bestDist*kPruneMargin )
+      Search( mid+1, end, x, y, best, bestDist );
+  }
+  else
+  {
+    Search( mid+1, end, x, y, best, bestDist );
+    if( offset<=bestDist*kPruneMargin )
+      Search( begin, mid, x, y, best, bestDist );
+  }
+}
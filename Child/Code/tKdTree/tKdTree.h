@@ -0,0 +1,91 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tKdTree.h
+**
+**  @brief Header file for tKdTree, a 2-D k-d tree for nearest-point
+**         searches.
+**
+**  Points are added with Add (the first gets index 0, the next 1, and
+**  so on), the tree is built once with Build, and Nearest then finds
+**  the point closest to (x,y) in O(log n) time on average, instead of
+**  a sweep through all the points.
+**
+**  Nearest gives exactly the answer of such a sweep,
+**
+**    for each point i, in order of index:
+**      d = sqrt( dx*dx + dy*dy ), with dx = x - xi, dy = y - yi
+**      if d < minDist, then minDist = d and nearest = i
+**
+**  including its distance to the last bit and its handling of ties (the
+**  lowest index at the minimum distance wins), so it can replace one
+**  without changing model results. A subtree is skipped only if its
+**  splitting line is farther away than the best distance so far, with
+**  a margin larger than the round-off in a computed distance.
+**
+**  Used by tFloodplain to find the nearest flood node.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TKDTREE_H
+#define TKDTREE_H
+
+#include <vector>
+
+/**************************************************************************/
+/**
+**  Class tKdTree
+*/
+/**************************************************************************/
+class tKdTree
+{
+public:
+  tKdTree() {}
+
+  void Clear() { points_.clear(); }
+  void Reserve( long n ) { points_.reserve( n ); }
+  void Add( double x, double y );
+  void Build();
+  long size() const { return static_cast<long>(points_.size()); }
+
+  // Index of the point nearest to (x,y), and its distance, or -1 if
+  // there are no points
+  long Nearest( double x, double y, double &dist ) const;
+
+private:
+  struct tPoint
+  {
+    double x, y;
+    long index;   // order of addition
+    int axis;     // 0: splits on x, 1: splits on y
+  };
+  struct tLessX
+  {
+    bool operator()( const tPoint &a, const tPoint &b ) const
+    { return a.x<b.x; }
+  };
+  struct tLessY
+  {
+    bool operator()( const tPoint &a, const tPoint &b ) const
+    { return a.y<b.y; }
+  };
+
+  void Build( long begin, long end );
+  void Search( long begin, long end, double x, double y,
+	       long &best, double &bestDist ) const;
+
+  // Points in tree order: the root of [begin,end) is at the middle,
+  // with its left and right subtrees on either side
+  std::vector< tPoint > points_;
+};
+
+#endif
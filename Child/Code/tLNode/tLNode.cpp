@@ -21,6 +21,7 @@
 #include <math.h>
 #include "../errors/errors.h"
 #include "tLNode.h"
+#include "../tLog/tLog.h"
 //#define kBugTime 5000000
 
 #include "../tStratGrid/tStratGrid.h"
@@ -75,7 +76,7 @@ xyzd(4),
 reachmember(false),
 meander(false)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tMeander()" << std::endl;
 }
 
@@ -88,7 +89,7 @@ xyzd( orig.xyzd ),
 reachmember(orig.reachmember),
 meander(orig.meander)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tMeander( orig )" << std::endl;
 }
 
@@ -100,13 +101,13 @@ xyzd(4),
 reachmember(false),
 meander(state)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tMeander( state, x, y )" << std::endl;
 }
 
 tMeander::~tMeander()                                             //tMeander
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tMeander()" << std::endl;
 }
 
@@ -133,7 +134,7 @@ tBedrock::tBedrock()                                             //tBedrock
   :
 erodibility(0.)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tBedrock()" << std::endl;
 }
 
@@ -141,13 +142,13 @@ tBedrock::tBedrock( const tBedrock &orig )                       //tBedrock
   :
 erodibility(orig.erodibility)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tBedrock( orig )" << std::endl;
 }
 
 tBedrock::~tBedrock()                                            //tBedrock
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tBedrock()" << std::endl;
 }
 
@@ -180,7 +181,7 @@ tRegolith::tRegolith()                                          //tRegolith
 thickness(0.),
 dgrade()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tRegolith()" << std::endl;
 }
 
@@ -189,14 +190,14 @@ tRegolith::tRegolith( const tRegolith &orig )                   //tRegolith
 thickness(orig.thickness),
 dgrade( orig.dgrade )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tRegolith( orig ) " << thickness << std::endl;
 }
 
 
 tRegolith::~tRegolith()                                         //tRegolith
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tRegolith()" << std::endl;
 }
 
@@ -222,7 +223,7 @@ chanslope(0.),hydrslope(0.),
 diam(kVeryHigh),
 migration()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tChannel()" << std::endl;
 }
 
@@ -237,13 +238,13 @@ chanslope(orig.chanslope),hydrslope(orig.hydrslope),
 diam(orig.diam),
 migration( orig.migration )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  tChannel( orig )" << std::endl;
 }
 
 tChannel::~tChannel()                                            //tChannel
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tChannel()" << std::endl;
 }
 //assignment
@@ -295,16 +296,14 @@ const tChannel &tChannel::operator=( const tChannel &right )     //tChannel
  **       static bool tNode::freezeElevations, which is referenced within
  **       tNode::ChangeZ(dz); if freezeElevations = true, ChangeZ will do
  **       nothing. (SL, 11/2010)
+ **     - Moved the former static members numg, grade, maxregdep, KRnew
+ **       and new_sed_bulk_density_ (and tNode::freezeElevations) into a
+ **       per-model tModelContext, pointed to by every node, so that
+ **       several models can coexist in one process. tLNode(infile,
+ **       context) no longer reads them.
  **
 \**************************************************************************/
 
-// initialize static members numg and grade
-size_t tLNode::numg = 0;
-tArray<double> tLNode::grade = 1;
-double tLNode::maxregdep = 1;
-double tLNode::KRnew = 1.0;
-double tLNode::new_sed_bulk_density_ = kDefaultSoilBulkDensity;
-
 tLNode::tLNode()                                                   //tLNode
   :
 tNode(), vegCover(), rock(), reg(), chan(),
@@ -321,16 +320,18 @@ stratNode(0),
 qsubsurf(0.),
 is_masked_(false),
 netDownslopeForce(0.),
+cumulative_ero_dep_(0.),
+cumulative_sed_xport_volume_(0.),
 is_moving_(false),
 public1(-1)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "=>tLNode()" << std::endl;
 }
 
-tLNode::tLNode( const tInputFile &infile )
+tLNode::tLNode( const tInputFile &infile, tModelContext *context )
 :
-tNode( infile ), vegCover(), rock(), reg(), chan(),
+tNode( infile, context ), vegCover(), rock(), reg(), chan(),
 flood(kNotFlooded), flowedge(0), tracer(0),
 dzdt(0.), drdt(0.), tau(0.), taucb(0.), taucr(0.), qs(0.),
 qsm(),
@@ -344,6 +345,8 @@ stratNode(0),
 qsubsurf(0.),
 is_masked_(false),
 netDownslopeForce(0.),
+cumulative_ero_dep_(0.),
+cumulative_sed_xport_volume_(0.),
 is_moving_(false),
 public1(-1)
 {
@@ -353,45 +356,20 @@ public1(-1)
   tArray<double> dgradehelp;
   tArray<double> dgradebrhelp;
   
-  if (0) //DEBUG
-    std::cout << "=>tLNode( infile )" << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
+    std::cout << "=>tLNode( infile, context )" << std::endl;
 	
   // Modified to read TAUC for both bedrock, TAUCB, and regolith, TAUCR
   taucb = infile.ReadItem( taucb, "TAUCB" );
   taucr = infile.ReadItem( taucr, "TAUCR" );
   
-  {
-    int tmp_;
-    tmp_ = infile.ReadItem( tmp_, "NUMGRNSIZE" );
-    assert(tmp_ >= 0);
-    numg = tmp_;
-  }
-  grade.setSize( numg );
-  maxregdep = infile.ReadItem( maxregdep, "MAXREGDEPTH" );
-  KRnew = infile.ReadItem( KRnew, "KR" );
-  if( KRnew<0.0 )
-    ReportFatalError( "Erodibility factor KR must be positive." );
-  new_sed_bulk_density_ = infile.ReadDouble( "SOILBULKDENSITY", false );
-  if( new_sed_bulk_density_<=0.0 ) new_sed_bulk_density_ = kDefaultSoilBulkDensity;
+  // Grain-size and layering parameters (NUMGRNSIZE, GRAINDIAMi,
+  // MAXREGDEPTH, KR, SOILBULKDENSITY) are read once per model by
+  // tModelContext::InitializeFromInputFile.
+  assert( context_!=0 );
   
-  {
-    size_t i = 0;
-    add[0]='1';
-    add[1]='\0';
-    
-    while ( i<numg ){
-      // Reading in grain size diameter info
-      strcpy( name, "GRAINDIAM");
-      strcat( name, add );
-      help = infile.ReadItem( help, name);
-      grade[i] = help;
-      i++;
-      add[0]++;
-    }
-  }
-  
-  qsm.setSize( numg );
-  qsinm.setSize( numg );
+  qsm.setSize( context_->numg );
+  qsinm.setSize( context_->numg );
   
   accumdh.setSize(2);
   accumdh[0]=0.0;
@@ -401,14 +379,15 @@ public1(-1)
   
   if(!optReadLayer){
     
-    dgradehelp.setSize( numg );
-    dgradebrhelp.setSize( numg );
+    dgradehelp.setSize( context_->numg );
+    dgradebrhelp.setSize( context_->numg );
     sum = 0;
     sumbr = 0;
     size_t i=0;
     add[0]='1';
+    add[1]='\0';
     
-    while ( i<numg ){
+    while ( i<context_->numg ){
       // Reading in proportions for intital regolith and bedrock
       strcpy( name, "REGPROPORTION");
       strcat( name, add );
@@ -452,21 +431,21 @@ public1(-1)
       // in the regolith layer dgrade is saving
       // the proportion of grain size available from the bedrock
       
-      layhelp.setDgradesize(numg);
+      layhelp.setDgradesize(context_->numg);
       i=0;
       help = infile.ReadItem( help, "BEDROCKDEPTH");
-      while(i<numg){
+      while(i<context_->numg){
         layhelp.setDgrade(i, help*dgradebrhelp[i]);
         i++;
       }
       
       layerlist.insertAtBack( layhelp );
       
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       {
         std::cout<<"Just made BR layer thick=" << layhelp.getDepth()
         << " and dgrades:\n";
-        for( i=0; i<numg; i++ )
+        for( i=0; i<context_->numg; i++ )
           std::cout << i << "=" << layhelp.getDgrade(i) << std::endl;
       }
       
@@ -480,13 +459,13 @@ public1(-1)
       if( help<=0.0 ) help = kDefaultSoilBulkDensity;
       layhelp.setBulkDensity( help );
       help = infile.ReadItem( help, "REGINIT");
-      if(help > maxregdep){
+      if(help > context_->maxregdep){
         // too much regolith, create two layers the bottom layer is made here
-        const double extra = help - maxregdep;
+        const double extra = help - context_->maxregdep;
         //layhelp.setDepth(extra);
         //layhelp.setDgradesize(numg);
         i=0;
-        while(i<numg){
+        while(i<context_->numg){
           layhelp.setDgrade(i, extra*dgradehelp[i]);
           i++;
         }
@@ -494,28 +473,28 @@ public1(-1)
           layhelp.setRtime(-1.);
         layerlist.insertAtFront( layhelp );
         
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
         {
           std::cout<<"1Just made ALLUV layer thick=" << layhelp.getDepth()
           << " and dgrades:\n";
-          for( i=0; i<numg; i++ )
+          for( i=0; i<context_->numg; i++ )
             std::cout << i << "=" << layhelp.getDgrade(i) << std::endl;
         }
         
         // the top regolith layer is now made
         layhelp.setRtime(0.);
         i=0;
-        while(i<numg){
-          layhelp.setDgrade(i, maxregdep*dgradehelp[i]);
+        while(i<context_->numg){
+          layhelp.setDgrade(i, context_->maxregdep*dgradehelp[i]);
           i++;
         }
         layerlist.insertAtFront( layhelp );
         
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
         {
           std::cout<<"2Just made ALLUV layer thick=" << layhelp.getDepth()
           << " and dgrades:\n";
-          for( i=0; i<numg; i++ )
+          for( i=0; i<context_->numg; i++ )
             std::cout << i << "=" << layhelp.getDgrade(i) << std::endl;
         }
         
@@ -523,18 +502,18 @@ public1(-1)
       else{
         // create only one regolith layer
         i=0;
-        while(i<numg){
+        while(i<context_->numg){
           layhelp.setDgrade(i, help*dgradehelp[i]);
           i++;
         }
         
         layerlist.insertAtFront( layhelp );
         
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
         {
           std::cout<<"3Just made ALLUV layer thick=" << layhelp.getDepth()
           << " and dgrades:\n";
-          for( i=0; i<numg; i++ )
+          for( i=0; i<context_->numg; i++ )
             std::cout << i << "=" << layhelp.getDgrade(i) << std::endl;
         }
         
@@ -552,17 +531,17 @@ public1(-1)
       help = infile.ReadDouble( "ROCKDENSITYINIT", false );
       if( help<=0.0 ) help = kDefaultRockBulkDensity;
       layhelp.setBulkDensity(help);
-      layhelp.setDgradesize(numg);
+      layhelp.setDgradesize(context_->numg);
       size_t i=0;
       help = infile.ReadItem( help, "BEDROCKDEPTH");
-      while(i<numg){
+      while(i<context_->numg){
         layhelp.setDgrade(i, help*dgradebrhelp[i]);
         i++;
       }
       layerlist.insertAtBack( layhelp );
     }
     
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       std::cout << layerlist.getSize() << " layers created " << std::endl;
   }
   
@@ -570,6 +549,7 @@ public1(-1)
 
 tLNode::tLNode( const tLNode &orig )                               //tLNode
   : tNode( orig ), 
+    tCounted< tLNode, tMemoryAccount::kLNode >(),
     vegCover( orig.vegCover ), 
     rock( orig.rock ),
     reg( orig.reg ), 
@@ -610,13 +590,13 @@ tLNode::tLNode( const tLNode &orig )                               //tLNode
   //properly copy the layerlist
 
   layerlist = orig.layerlist;
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "=>tLNode( orig )" << std::endl;
 }
 
 tLNode::~tLNode()                                                  //tLNode
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tLNode()" << std::endl;
   flowedge = 0;
   stratNode = 0;
@@ -668,8 +648,8 @@ const tLNode &tLNode::operator=( const tLNode &right )                  //tNode
 //NG changed getDiam 02/1999
 double tLNode::getDiam() const {
   double di = 0;
-  for(size_t i=0; i<numg; i++){
-    di+=grade[i]*getLayerDgrade(0,i)/getLayerDepth(0);
+  for(size_t i=0; i<context_->numg; i++){
+    di+=context_->grade[i]*getLayerDgrade(0,i)/getLayerDepth(0);
   }
   return di;
 }
@@ -1080,13 +1060,13 @@ void tLNode::TellAll() const
 	   << nbr->getY() << "," << nbr->getZ() << ")\n    with vedglen "
 	   << flowedge->getVEdgLen() << std::endl;
       flowedge->TellCoords();
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout<<"  ccwedge of flowedge is "<<flowedge->getCCWEdg()->getID()
 	    <<" originates at "<<flowedge->getCCWEdg()->getOriginPtrNC()->getID()
 	    <<std::endl;
       std::cout << "  qs: " << qs << "  qsin: " << qsin << "  slp: "
 	   << flowedge->getSlope() << "  reg: " << reg.thickness << std::endl;
-      for(size_t i=0; i<numg; i++)
+      for(size_t i=0; i<context_->numg; i++)
 	std::cout<<"  qsi "<<i<<" "<<qsm[i];
       std::cout<<std::endl;
       //for(i=0; i<numg; i++)
@@ -1096,7 +1076,7 @@ void tLNode::TellAll() const
       std::cout<<"numlayers is "<<getNumLayer()<<std::endl;
       int j;
       for( j=0; j<getNumLayer(); j++ )
-	for( size_t i=0; i<numg; i++)
+	for( size_t i=0; i<context_->numg; i++)
 	  std::cout<<"  dgrade "<<i<<" "<<getLayerDgrade(j,i);
       std::cout << "  dzdt: " << dzdt << "  drdt: " << drdt;
       std::cout<<" meanders "<< Meanders()<<std::endl;
@@ -1137,7 +1117,7 @@ void tLNode::EroDep( double dz )
   ChangeZ( dz );
 
   cumulative_ero_dep_ += dz;
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "  eroding " << id << " by " << dz << std::endl;
 
   reg.thickness += dz;
@@ -1158,7 +1138,7 @@ void tLNode::InsertLayerBack( tLayer const & lyr )
 
 void tLNode::setQsinErrorHandler( size_t i ) const
 {
-  if(i>=numg)
+  if(i>=context_->numg)
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   if(i>=qsinm.getSize()){
     std::cout<<"trying to set index "<<i<<" but size of array is "
@@ -1182,7 +1162,7 @@ void tLNode::addQsin( tArray< double > const &val )
 
 void tLNode::setQsdinErrorHandler( size_t i ) const
 {
-  if(i>=numg)
+  if(i>=context_->numg)
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   if(i>=qsdinm.getSize()){
     std::cout<<"trying to set index "<<i<<" but size of array is "
@@ -1264,9 +1244,9 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 {
   assert(tri!=0);
 
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<std::endl<<"tLNode::LayerInterpolation....";
-  if (0) {//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     std::cout<<" current x = "<<x<<" current y = "<<y;
     std::cout<<" newx= "<<tx<<" newy= "<<ty<<std::endl;
   }
@@ -1281,7 +1261,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       numnodes++;
     }
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"numnodes = "<<numnodes<<" newx= "<<tx<<" newy= "<<ty<<std::endl;
 
   tList< tLayer > helplist; //Make the layer list first.  When
@@ -1313,7 +1293,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       layindex[i]=0;//Initialize layindex
     }
 
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       std::cout<<"Current age is "<<CA<<std::endl;
     //CA now contains the youngest surface layer time of the three nodes.
     //Remember that LayerRtime is the most recent time visited, which
@@ -1324,7 +1304,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     double newdep; //interpolated depth value
     double newetime; //interpolated exposure time
     tLayer layhelp; //set values in this layer then insert in back of layerlist
-    layhelp.setDgradesize(numg);
+    layhelp.setDgradesize(context_->numg);
     layhelp.setCtime(time);
 
     do
@@ -1359,7 +1339,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 	  }
 	  else{
 	    dep[i]=0;
-	    if (0) //DEBUG
+	    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	      std::cout<<"not in correct range, dep set to 0"<<std::endl;
 	  }
 	}
@@ -1371,14 +1351,14 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 
 	newdep=PlaneFit(tx, ty, lnds[0]->get2DCoords(), lnds[1]->get2DCoords(),
 			lnds[2]->get2DCoords(), dep);
-	if(newdep>grade[0]){
+	if(newdep>context_->grade[0]){
 	  newtex=newtex/sum;
 	  layhelp.setDepth(newdep);
 	  layhelp.setDgrade(0,newtex*newdep);
 	  layhelp.setErody(newerody/sum);
 	  layhelp.setEtime(newetime/sum);
 	  layhelp.setRtime(CA);
-	  if(numg>1)
+	  if(context_->numg>1)
 	    layhelp.setDgrade(1,(1-newtex)*newdep);
 	  helplist.insertAtBack( layhelp );
 	}
@@ -1388,7 +1368,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 	    CA=age[i];
 	  }
 	}
-	if (0) //DEBUG
+	if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	  std::cout<<std::endl<<"after iter, current age is set to "<<CA<<std::endl;
 
       }while(CA>kAncient);
@@ -1413,7 +1393,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 		      lnds[2]->get2DCoords(), dep);
       layhelp.setDepth(newdep);
       layhelp.setDgrade(0,newtex*newdep);
-      if(numg>1)
+      if(context_->numg>1)
 	layhelp.setDgrade(1,(1-newtex)*newdep);
       layhelp.setSed(tLayer::kSed);
       layhelp.setErody(newerody/sum);
@@ -1430,7 +1410,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     for(i=0; i<=2; i++){
       //NOTE - This only works for two sizes right now.
       //debugging routine
-      if (0) { //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
 	if(lnds[i]->getNumLayer()<=layindex[i]){
 	  lnds[i]->TellAll();
 	  for(int j=0; j<lnds[i]->getNumLayer(); j++){
@@ -1456,7 +1436,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 		    lnds[2]->get2DCoords(), dep);
     layhelp.setDepth(newdep);
     layhelp.setDgrade(0,newtex*newdep);
-    if(numg>1)
+    if(context_->numg>1)
       layhelp.setDgrade(1,(1-newtex)*newdep);
     layhelp.setSed(tLayer::kBedRock);
     layhelp.setErody(newerody/sum);
@@ -1531,7 +1511,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     double newetime; //exposure time of new layer
     double newdep; //interpolated depth value
     tLayer layhelp; //set values in this layer then insert in back of layerlist
-    layhelp.setDgradesize(numg);
+    layhelp.setDgradesize(context_->numg);
     layhelp.setCtime(time);
 
     do
@@ -1571,14 +1551,14 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 	//then insert the new layer.
 
 
-	if(newdep>grade[0]){
+	if(newdep>context_->grade[0]){
 	  newtex=newtex/sum;
 	  layhelp.setDepth(newdep);
 	  layhelp.setDgrade(0,newtex*newdep);
 	  layhelp.setErody(newerody/sum);
 	  layhelp.setEtime(newetime/sum);
 	  layhelp.setRtime(CA);
-	  if(numg>1)
+	  if(context_->numg>1)
 	    layhelp.setDgrade(1,(1-newtex)*newdep);
 	  helplist.insertAtBack( layhelp );
 	}
@@ -1608,7 +1588,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       newtex=newtex/sum;
       layhelp.setDepth(newdep);
       layhelp.setDgrade(0,newtex*newdep);
-      if(numg>1)
+      if(context_->numg>1)
 	layhelp.setDgrade(1,(1-newtex)*newdep);
       layhelp.setSed(tLayer::kSed);
       layhelp.setErody(newerody/sum);
@@ -1634,7 +1614,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     newtex=newtex/sum;
     layhelp.setDepth(newdep);
     layhelp.setDgrade(0,newtex*newdep);
-    if(numg>1)
+    if(context_->numg>1)
       layhelp.setDgrade(1,(1-newtex)*newdep);
     layhelp.setSed(tLayer::kSed);
     layhelp.setErody(newerody/sum);
@@ -1668,13 +1648,13 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     //check done w/assertion at beginning
     //just set layerlist = to layerlist of non-boundary node
     tLayer layhelp; //set values in this layer then insert in back of layerlist
-    layhelp.setDgradesize(numg);
+    layhelp.setDgradesize(context_->numg);
     layhelp.setCtime(time);
 
     for(i=0; i<lnds[0]->getNumLayer(); i++){
       layhelp.setDepth(lnds[0]->getLayerDepth(i));
       layhelp.setDgrade(0,lnds[0]->getLayerDgrade(i,0));
-      if(numg>1)
+      if(context_->numg>1)
 	layhelp.setDgrade(1,lnds[0]->getLayerDgrade(i,1));
       layhelp.setSed(lnds[0]->getLayerSed(i));
       layhelp.setErody(lnds[0]->getLayerErody(i));
@@ -1701,7 +1681,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     }
   }
 
-  if(maxregdep-helplist.FirstP()->getDepth()>0.001 &&
+  if(context_->maxregdep-helplist.FirstP()->getDepth()>0.001 &&
      helplist.getIthDataRef(1).getSed()>0){
     //top layer is too small, want to maintain maxregdep for erosion reasons
     //Because NG doesn't really know how to manipulate lists,
@@ -1709,7 +1689,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     //top layer from list, update it, then add it back to front of list.
     tLayer firstlay;
     helplist.removeFromFront(firstlay);
-    double diff=maxregdep-firstlay.getDepth();
+    double diff=context_->maxregdep-firstlay.getDepth();
     double newerody=firstlay.getErody()*firstlay.getDepth();
     double newetime=firstlay.getEtime()*firstlay.getDepth();
     double newrtime=firstlay.getRtime()*firstlay.getDepth();
@@ -1717,7 +1697,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       tLayer * nextlay=helplist.FirstP();
       if(nextlay->getDepth()<diff){
 	//add entire contents of layer below to top layer
-	for(size_t i=0; i<numg; i++)
+	for(size_t i=0; i<context_->numg; i++)
 	  firstlay.addDgrade(i,nextlay->getDgrade(i));
 	newerody+=nextlay->getErody()*nextlay->getDepth();
 	newetime+=nextlay->getEtime()*nextlay->getDepth();
@@ -1728,7 +1708,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       else{
 	//don't remove entire layer below, only take some material
 	double prevdep = nextlay->getDepth();
-	for(size_t i=0; i<numg; i++){
+	for(size_t i=0; i<context_->numg; i++){
 	  double moving = diff*nextlay->getDgrade(i)/prevdep;
 	  firstlay.addDgrade(i,moving);
 	  nextlay->addDgrade(i,-1*moving);
@@ -1755,11 +1735,11 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
     layhelp.setEtime(0.);
     layhelp.setCtime(time);
     layhelp.setRtime(0.);
-    layhelp.setDgrade(0,maxregdep*helplist.FirstP()->getDgrade(0)/helplist.FirstP()->getDepth());
-    if(numg>1)
-      layhelp.setDgrade(1,maxregdep*helplist.FirstP()->getDgrade(1)/helplist.FirstP()->getDepth());
+    layhelp.setDgrade(0,context_->maxregdep*helplist.FirstP()->getDgrade(0)/helplist.FirstP()->getDepth());
+    if(context_->numg>1)
+      layhelp.setDgrade(1,context_->maxregdep*helplist.FirstP()->getDgrade(1)/helplist.FirstP()->getDepth());
     layhelp.setErody(helplist.FirstP()->getErody());
-    helplist.FirstP()->setDepth( helplist.FirstP()->getDepth()-maxregdep);
+    helplist.FirstP()->setDepth( helplist.FirstP()->getDepth()-context_->maxregdep);
     helplist.insertAtFront( layhelp );
 
   }
@@ -1783,7 +1763,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
       std::cout << " " << getLayerErody(i);
       std::cout << " " << getLayerSed(i) << std::endl;
       std::cout << getLayerDgrade(i,0) ;
-      if( numg>1 ) std::cout << " " << getLayerDgrade(i,1);
+      if( context_->numg>1 ) std::cout << " " << getLayerDgrade(i,1);
       i++;
       std::cout<<std::endl;
     }
@@ -1804,7 +1784,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 	std::cout << " " << nicn->getLayerErody(i);
 	std::cout << " " << nicn->getLayerSed(i) << std::endl;
 	std::cout << nicn->getLayerDgrade(i,0);
-	if( numg>1 ) std::cout << " " << nicn->getLayerDgrade(i,1) << std::endl;
+	if( context_->numg>1 ) std::cout << " " << nicn->getLayerDgrade(i,1) << std::endl;
 	i++;
       }
     }
@@ -1829,7 +1809,7 @@ void tLNode::LayerInterpolation( tTriangle const* tri, double tx, double ty, dou
 \*******************************************************************/
 void tLNode::WarnSpokeLeaving(tEdge * edglvingptr)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"tLNode::WarnSpokeLeaving..... node #"<<id<<std::endl;
 
   //Make sure that edg pointer in tNode won't be affected
@@ -1878,15 +1858,15 @@ void tLNode::InitializeNode()
     }
 
   // Set size of sediment influx and outflux arrays to number of grain sizes
-  if( qsm.getSize()!=numg ) {
-    qsm.setSize( numg );
-    qsinm.setSize( numg );
-    qsdinm.setSize( numg );
+  if( qsm.getSize()!=context_->numg ) {
+    qsm.setSize( context_->numg );
+    qsinm.setSize( context_->numg );
+    qsdinm.setSize( context_->numg );
   }
 
   accumdh.setSize(2);
 
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"tLNode::InitializeNode node "<< getID()
 	<<" flow edge "<<flowedge->getID()<<std::endl;
 }
@@ -1916,7 +1896,7 @@ tNode *tLNode::splitFlowEdge() {
   const tArray< double > zeroArr(4);
   tLNode *nPtr = this->getDownstrmNbr();
 
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "tLNode::splitFlowEdge(): split flowedge between node "
 	 << this->getID() << " and node "
 	 << nPtr->getID() << "." << std::endl;
@@ -2021,8 +2001,8 @@ tLNode* tLNode::getUpstrmNbr()
 tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 {
   double amt, val, olddep;
-  tArray<double> update(numg);
-  tArray<double> hupdate(numg);
+  tArray<double> update(context_->numg);
+  tArray<double> hupdate(context_->numg);
   
   //NIC these are for testing
   //Xbefore=getLayerDepth(i);
@@ -2046,7 +2026,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
   double max, min;
   max = -10000.;
   min = 10000.;
-  while(g<numg){
+  while(g<context_->numg){
     if(-1*valgrd[g]>getLayerDgrade(i,g))
       valgrd[g]=-1*getLayerDgrade(i,g);
     // Checking to see that there is enough stuff
@@ -2073,7 +2053,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
   {
     // CASE OF EROSION IN ALL SIZE CLASSES
     if(getLayerSed(i) != tLayer::kBedRock &&
-	     getLayerSed(i) == getLayerSed(i+1) && getLayerDepth(i)+val<=maxregdep)
+	     getLayerSed(i) == getLayerSed(i+1) && getLayerDepth(i)+val<=context_->maxregdep)
 	  {
 	     // Updating will also be done if entering this statement
 	     // No updating of Bedrock layers.
@@ -2088,7 +2068,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 	        hupdate = addtoLayer(i+1, val);//remove stuff from lower layer
 	        size_t g=0;
 	        sumd=0;
-	        while(g<numg)
+	        while(g<context_->numg)
           {
             sumd-=hupdate[g];
             val-=hupdate[g];//hupdate stores texture of material that will
@@ -2100,7 +2080,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 	        sume+=sumd*olde;
        }
        size_t g=0;
-       while(g<numg){
+       while(g<context_->numg){
          addtoLayer(i, g, valgrd[g], -1.); // Erosion
          addtoLayer(i,g,-1*update[g],-1.);//Updating with material from below
            g++;
@@ -2113,7 +2093,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 	     //Do this if you have only bedrock below, or if layer you are eroding
 	     //from is >maxregdepth-val (could be if lots of deposition)
 	     size_t g=0;
-	     while(g<numg){
+	     while(g<context_->numg){
          addtoLayer(i, g, valgrd[g], -1.); // Erosion done on this line
          g++;
 	     }
@@ -2133,24 +2113,24 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
     // Also, no test done to make sure that you are depositing the right
     // material into the layer, would need to pass the flag for this.
     // For now assume that the test will be done in another place.
-    if(getLayerSed(i) != tLayer::kBedRock && val < maxregdep){
+    if(getLayerSed(i) != tLayer::kBedRock && val < context_->maxregdep){
       // top layer is sediment, so no issues
       // depositing less than an entire layer of stuff
       olde=getLayerEtime(i);
-      if(getLayerDepth(i)+val>maxregdep){
+      if(getLayerDepth(i)+val>context_->maxregdep){
         // Need to move stuff out of top layer to make room for deposited material
-        if(getLayerSed(i) == getLayerSed(i+1) && getLayerDepth(i+1)+val<maxregdep)
+        if(getLayerSed(i) == getLayerSed(i+1) && getLayerDepth(i+1)+val<context_->maxregdep)
         {
           // The layer below is of the appropriate material and has space
-          amt = getLayerDepth(i)+val-maxregdep;//how much to move out
+          amt = getLayerDepth(i)+val-context_->maxregdep;//how much to move out
           setLayerEtime(i+1, (1/(getLayerDepth(i+1)+amt))*
                         (olde*amt + getLayerDepth(i+1)*getLayerEtime(i+1)));//lower layer's etime is now properly set.
-            setLayerEtime(i, (1/maxregdep)*(olde*(getLayerDepth(i)-amt)));
+            setLayerEtime(i, (1/context_->maxregdep)*(olde*(getLayerDepth(i)-amt)));
             //now etime is set in the layer you are depositing into
             //note deposited material has an etime of 0
             olddep = getLayerDepth(i);
             size_t g=0;
-            while(g<numg){
+            while(g<context_->numg){
               addtoLayer(i+1,g,amt*getLayerDgrade(i,g)/olddep, -1.);
               // putting material from top layer to layer below
               // nic, at this point you have decided not to change
@@ -2166,15 +2146,15 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
         else
         {
           // Need to create new layer
-          amt = getLayerDepth(i)+val-maxregdep;
+          amt = getLayerDepth(i)+val-context_->maxregdep;
           assert( amt>=0.0 ); //GT
-          setLayerEtime(i, (1/maxregdep)*(olde*(getLayerDepth(i)-amt)));
+          setLayerEtime(i, (1/context_->maxregdep)*(olde*(getLayerDepth(i)-amt)));
           //now etime is set in the layer you are depositing into
           //note deposited material has an etime of 0
           olddep = getLayerDepth(i);
           assert( olddep>0.0 ); // if not true, we get div by zero
           size_t g=0;
-          while(g<numg){
+          while(g<context_->numg){
             update[g]=amt*getLayerDgrade(i,g)/olddep;
             // material which will be moved from top layer
             assert( update[g]>=0.0 ); //GT
@@ -2198,7 +2178,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
         setLayerEtime(i, (1/(getLayerDepth(i)+val))*olde*getLayerDepth(i));
         //set top layers etime
         size_t g=0;
-        while(g<numg){
+        while(g<context_->numg){
           addtoLayer(i,g,valgrd[g],tt);
           g++;
         }
@@ -2211,8 +2191,8 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
       // value read in at begining
       // Also use this if the amount of material deposited is
       // greater than maxregdep
-      makeNewLayerBelow(-1, tLayer::kSed, KRnew, valgrd, tt, 
-                        new_sed_bulk_density_ );
+      makeNewLayerBelow(-1, tLayer::kSed, context_->KRnew, valgrd, tt, 
+                        context_->new_sed_bulk_density_ );
     }
   }
   else if(max>0.0000000001 && min<-0.0000000001)
@@ -2243,7 +2223,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
                                            //refil the top layer
             size_t g=0;
             sumd=0;
-            while(g<numg)
+            while(g<context_->numg)
             {
               sumd-=hupdate[g];
               val-=hupdate[g];
@@ -2253,7 +2233,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
             sume+=sumd*olde;
           }
           size_t g=0;
-          while(g<numg){
+          while(g<context_->numg){
             addtoLayer(i, g, valgrd[g], tt); // Erosion and deposition
             addtoLayer(i,g,-1*update[g], tt);//Updating with material from below
                                              //Set layer recent time because some deposition was done
@@ -2268,7 +2248,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
           //deposited material into the surface layer
           size_t g=0;
           sumd=0;
-          while(g<numg){
+          while(g<context_->numg){
             if(valgrd[g]>0)
               sumd+=valgrd[g];
             addtoLayer(i, g, valgrd[g], tt); // Erosion/Deposition
@@ -2285,7 +2265,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 	      //Layer is bedrock
 	      //First remove material from bedrock, then create a new layer
 	      //for the deposited material.
-	      for(size_t g=0; g<numg; g++){
+	      for(size_t g=0; g<context_->numg; g++){
           update[g]=valgrd[g];//update stores the composition of new layer
           if(valgrd[g]<0){
             addtoLayer(i, g, valgrd[g], -1.);
@@ -2293,8 +2273,8 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
           }
 	      }
 	      assert( getLayerDepth(i)>0.0 );
-	      makeNewLayerBelow(i-1, tLayer::kSed, KRnew, update, tt, 
-                          new_sed_bulk_density_);
+	      makeNewLayerBelow(i-1, tLayer::kSed, context_->KRnew, update, tt, 
+                          context_->new_sed_bulk_density_);
 	      //New layer made with deposited material
 	    }
       assert( getLayerDepth(i) > -1e-7 ); // can't be much < 0
@@ -2309,7 +2289,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
       // if deposition, add it to val, which at the end of the loop
       // will record the total depth to be deposited.
       val=0; //val will now contain total amt to deposit
-      for(size_t g=0; g<numg; g++) {
+      for(size_t g=0; g<context_->numg; g++) {
         if(valgrd[g]<0) {
           // Here, we erode material in size fraction g
           update[g]=0;//If new layer needs to be made on top of BR
@@ -2330,27 +2310,27 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
       // below) GT 8/02
       if( getLayerDepth(i)<1e-7 ) removeLayer(i);
       assert( getLayerDepth(i)>0.0 );  // replacement should be ok
-      if(getLayerSed(i) != tLayer::kBedRock && val<maxregdep) {
+      if(getLayerSed(i) != tLayer::kBedRock && val<context_->maxregdep) {
         // Case in which top layer is "sediment" and depth to be
         // deposited is less than nominal layer thickness.
         // top layer is sediment, so no issues
-        amt = (getLayerDepth(i)+val)-maxregdep; // excess (if pos)
+        amt = (getLayerDepth(i)+val)-context_->maxregdep; // excess (if pos)
                                                 //if((getLayerDepth(i)+val)>maxregdep){
         if( amt>0.0 ){
           // Need to move stuff out of top layer to make room for deposited mat
           //if(getLayerSed(i) == getLayerSed(i+1) && getLayerDepth(i+1)+val<maxregdep)
-          if(getLayerSed(i) == getLayerSed(i+1) && (getLayerDepth(i+1)+amt)<maxregdep)
+          if(getLayerSed(i) == getLayerSed(i+1) && (getLayerDepth(i+1)+amt)<context_->maxregdep)
           {
             // The layer below is of the appropriate material and has space
             //amt = getLayerDepth(i)+val-maxregdep;//how much to move out
             olddep = getLayerDepth(i);
             olde=getLayerEtime(i);
-            setLayerEtime(i, (1/maxregdep)*olde*(getLayerDepth(i)-amt));
+            setLayerEtime(i, (1/context_->maxregdep)*olde*(getLayerDepth(i)-amt));
             //exposure time of layer which is getting ero'd/dep'd is set
             setLayerEtime(i+1, (1/(amt+getLayerDepth(i+1)))*
                           (amt*olde+getLayerDepth(i+1)*getLayerEtime(i+1)));//now exposure time of lower layer is set
               size_t g=0;
-              while(g<numg){
+              while(g<context_->numg){
                 addtoLayer(i+1,g,amt*getLayerDgrade(i,g)/olddep, -1.);
                 // putting material from top layer to layer below
                 // nic, at this point you have decided not to change
@@ -2370,9 +2350,9 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
             olddep = getLayerDepth(i);
             assert( olddep>0.0 ); // otherwise div by zero below
             olde=getLayerEtime(i);
-            setLayerEtime(i, (1/maxregdep)*olde*(getLayerDepth(i)-amt));
+            setLayerEtime(i, (1/context_->maxregdep)*olde*(getLayerDepth(i)-amt));
             size_t g=0;
-            while(g<numg){
+            while(g<context_->numg){
               update[g]=amt*(getLayerDgrade(i,g)/olddep);
               // update = material which will be moved from top layer
               assert( update[g]>=0.0 );
@@ -2400,7 +2380,7 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
                         getLayerEtime(i));
           //now exposure time of top layer is properly set
           size_t g=0;
-          while(g<numg){
+          while(g<context_->numg){
             if(valgrd[g]>0)
               addtoLayer(i,g,valgrd[g],tt);
             g++;
@@ -2412,23 +2392,23 @@ tArray<double> tLNode::EroDep( int i, tArray<double> valgrd, double tt)
 	    {
 	      //Layer is bedrock, so make a new layer on top to deposit into
 	      //or, depositing more than maxregdep
-	      makeNewLayerBelow(i-1, tLayer::kSed, KRnew, update, tt, 
-                          new_sed_bulk_density_);
+	      makeNewLayerBelow(i-1, tLayer::kSed, context_->KRnew, update, tt, 
+                          context_->new_sed_bulk_density_);
 	    }
       }
     }
   
   //Check to make sure that top layer is not too deep
-  if(getLayerDepth(i)>1.1*maxregdep && getLayerSed(i) != tLayer::kBedRock ){
+  if(getLayerDepth(i)>1.1*context_->maxregdep && getLayerSed(i) != tLayer::kBedRock ){
     //Make a top layer that is maxregdep deep so that further erosion
     //is not screwed up
-    hupdate = addtoLayer(i, -1*maxregdep);
-    for(size_t g=0; g<numg; g++) {
+    hupdate = addtoLayer(i, -1*context_->maxregdep);
+    for(size_t g=0; g<context_->numg; g++) {
       hupdate[g]=-1* hupdate[g];
       assert( hupdate[g]>=0.0 ); //GT
     }
     makeNewLayerBelow(-1, tLayer::kSed, getLayerErody(i), hupdate, tt, 
-                      new_sed_bulk_density_);
+                      context_->new_sed_bulk_density_);
     setLayerRtime(i,0.);
   }
   
@@ -2493,7 +2473,7 @@ tArray<double> tLNode::addtoLayer(int i, double val)
 {
   assert( val<0.0 ); // Function should only be called for erosion
 
-  tArray<double> ret(numg);
+  tArray<double> ret(context_->numg);
 
   tLayer *hlp = layerlist.getIthDataPtrNC( i );
 
@@ -2502,7 +2482,7 @@ tArray<double> tLNode::addtoLayer(int i, double val)
       // have enough material in this layer to fufill all erosion needs
       const double amt=hlp->getDepth();
       size_t n=0;
-      while(n<numg)
+      while(n<context_->numg)
 	{
 	  ret[n]=hlp->getDgrade(n)*val/amt;
 	  hlp->addDgrade(n,hlp->getDgrade(n)*val/amt);
@@ -2514,7 +2494,7 @@ tArray<double> tLNode::addtoLayer(int i, double val)
     {
       // need to remove entire layer
       size_t n=0;
-      while(n<numg)
+      while(n<context_->numg)
 	{
 	  ret[n]=-1*hlp->getDgrade(n);
 	  n++;
@@ -2617,8 +2597,8 @@ void tLNode::makeNewLayerBelow(int i, tLayer::tSed_t sd, double erd,
   hlp.setEtime(0.);
   hlp.setBulkDensity(bulk_density);
   n=0;
-  hlp.setDgradesize(numg);
-  while(n<numg){
+  hlp.setDgradesize(context_->numg);
+  while(n<context_->numg){
     assert( sz[n]>=0.0 );
     hlp.setDgrade(n, sz[n]);
     n++;
@@ -43,6 +43,7 @@
 #include "../tInputFile/tInputFile.h"
 #include "../globalFns.h"
 #include "../tVegetation/tVegetation.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
 
 class tStratNode;
 class tStratGrid;
@@ -55,7 +56,7 @@ class tStratGrid;
 /** @class tLayer
     Layer records */
 
-class tLayer
+class tLayer : private tCounted< tLayer, tMemoryAccount::kLayer >
 {
 public:
   // 0 = bedrock; 1 = some mixture of sediments so there
@@ -151,6 +152,7 @@ inline tLayer::tLayer ( size_t num ) :
 
 //copy constructor
 inline tLayer::tLayer( const tLayer &orig ) :                        //tLayer
+  tCounted< tLayer, tMemoryAccount::kLayer >(),
   layerID(orig.layerID), ctime(orig.ctime), rtime(orig.rtime), etime(orig.etime),
   depth(orig.depth), erody(orig.erody), sed(orig.sed),
   dgrade( orig.dgrade ), paleocurrent(orig.paleocurrent), 
@@ -441,7 +443,8 @@ private:
 
 /** @class tLNode
  */
-class tLNode : public tNode
+class tLNode : public tNode,
+  private tCounted< tLNode, tMemoryAccount::kLNode >
 {
 public:
   typedef enum {
@@ -466,13 +469,14 @@ public:
   }
 
   tLNode();
-  tLNode( const tInputFile &infile );
+  tLNode( const tInputFile &infile, tModelContext *context );
   tLNode( const tLNode & );
   //Syntax for calling copy constructor
   //tLNode *newnode = new tLNode( *oldtLNode );
   ~tLNode();
   const tLNode &operator=( const tLNode & );
   inline tVegCover &getVegCover();
+  inline void RegrowVegCover();  // applies lazy regrowth (see below)
   inline const tBedrock &getRock() const;
   inline const tRegolith &getReg() const;
   inline const tChannel &getChan() const;
@@ -739,15 +743,9 @@ protected:
   tList< tLayer > layerlist;        /* list of the different layers */
   tStratNode *stratNode;            /* Pointer to rectangular grid node. */
   tArray< double > accumdh;         /* temp inremental record of dh-fine and dh-coarse, used for projection on the tStratGrid */
-  static size_t numg;
-  // number of grain sizes recognized NIC should be the same for all
-  // nodes, maybe put this somewhere else when you figure out what is going on
-  static tArray< double > grade;
-  // size of each grain size class, NIC again, you may
-  // want to put this somewhere else
-  static double maxregdep;
-  static double KRnew;
-  static double new_sed_bulk_density_;
+  // Number of grain sizes, grain diameters, active layer depth, and
+  // erodibility and bulk density of new sediment are the same for all
+  // nodes of a model; they live in the model's tModelContext (context_).
   double qsubsurf;   // Subsurface discharge
   double netDownslopeForce; // force from landslide calculation
   double cumulative_ero_dep_;    // Keeps track of ero/dep since last update (for external reporting)
@@ -986,7 +984,7 @@ inline void tLNode::setQs( double val ) {qs = val;}
 
 inline void tLNode::setQs( size_t i, double val )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   qsm[i] = val;
   qs += val;
@@ -996,7 +994,7 @@ inline double tLNode::getQs() const {return qs;}
 
 inline double tLNode::getQs( size_t i )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   return qsm[i];
 }
@@ -1014,7 +1012,7 @@ inline void tLNode::addQs( double val )
 
 inline void tLNode::addQs( size_t i, double val )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   qsm[i] += val;
   qs += val;
@@ -1025,12 +1023,12 @@ inline void tLNode::setQsin( double val ) {qsin = val;}
 
 inline void tLNode::setQsin( size_t i, double val )
 {
-  if(unlikely( (i>=numg) || (i>=qsinm.getSize()) )) {
+  if(unlikely( (i>=context_->numg) || (i>=qsinm.getSize()) )) {
     setQsinErrorHandler( i );
   }
   qsinm[i]=val;
   double tot=0.;
-  for(size_t j=0; j<numg; j++)
+  for(size_t j=0; j<context_->numg; j++)
     tot+=qsinm[j];
   qsin=tot;
 }
@@ -1040,7 +1038,7 @@ inline void tLNode::setQsin( tArray< double > const & q_ )
   assert( qsinm.getSize() == q_.getSize() );
 
   double tot = 0.;
-  for(size_t j=0; j<numg; j++) {
+  for(size_t j=0; j<context_->numg; j++) {
     qsinm[j] = q_[j];
     tot += q_[j];
   }
@@ -1051,12 +1049,12 @@ inline void tLNode::setQsdin( double val ) {qsdin = val;}
 
 inline void tLNode::setQsdin( size_t i, double val )
 {
-  if(unlikely( (i>=numg) || (i>=qsdinm.getSize()) )) {
+  if(unlikely( (i>=context_->numg) || (i>=qsdinm.getSize()) )) {
     setQsdinErrorHandler( i );
   }
   qsdinm[i]=val;
   double tot=0.;
-  for(size_t j=0; j<numg; j++)
+  for(size_t j=0; j<context_->numg; j++)
     tot+=qsdinm[j];
   qsdin=tot;
 }
@@ -1066,7 +1064,7 @@ inline void tLNode::setQsdin( tArray< double > const & q_ )
   assert( qsdinm.getSize() == q_.getSize() );
 
   double tot = 0.;
-  for(size_t j=0; j<numg; j++) {
+  for(size_t j=0; j<context_->numg; j++) {
     qsdinm[j] = q_[j];
     tot += q_[j];
   }
@@ -1080,7 +1078,7 @@ inline void tLNode::addQsin( double val )
 
 inline void tLNode::addQsin( size_t i, double val )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   qsinm[i] += val;
   qsin += val;
@@ -1094,7 +1092,7 @@ inline void tLNode::addQsdin( double val )
 
 inline void tLNode::addQsdin( size_t i, double val )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   qsdinm[i] += val;
   qsdin += val;
@@ -1105,7 +1103,7 @@ inline double tLNode::getQsin() const {return qsin;}
 
 inline double tLNode::getQsin( size_t i )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   return qsinm[i];
 }
@@ -1120,7 +1118,7 @@ inline double tLNode::getQsdin() const {return qsdin;}
 
 inline double tLNode::getQsdin( size_t i )
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError( "Trying to index sediment sizes that don't exist ");
   return qsdinm[i];
 }
@@ -1133,20 +1131,20 @@ tLNode::getQsdinm( ) const
 
 inline void tLNode::setGrade( size_t i, double size ) const
 {
-  if(unlikely(i>=numg))
+  if(unlikely(i>=context_->numg))
     ReportFatalError("Trying to set a grain size for an index which is too large");
-  grade[i] = size;
+  context_->grade[i] = size;
 }
 
 double tLNode::getGrade( size_t i ) const
 {
-  return grade[i];
+  return context_->grade[i];
 }
 
 tArray< double > const &
 tLNode::getGrade( ) const
 {
-  return grade;
+  return context_->grade;
 }
 
 inline void tLNode::setXYZD( tArray< double > const &arr )
@@ -1207,7 +1205,7 @@ double tLNode::getUplift() const {return uplift;}
 
 inline size_t tLNode::getNumg() const
 {
-  return numg;
+  return context_->numg;
 }
 
 double tLNode::getNetDownslopeForce() const {return netDownslopeForce;}
@@ -1217,12 +1215,12 @@ void tLNode::setNetDownslopeForce( double val ) {netDownslopeForce = val;}
 
 inline void tLNode::setNumg( size_t size ) const
 {
-  numg = size;
+  context_->numg = size;
 }
 
 inline double tLNode::getMaxregdep() const
 {
-  return maxregdep;
+  return context_->maxregdep;
 }
 
 inline double tLNode::getLayerCtime( int i ) const
@@ -1335,6 +1333,20 @@ inline tVegCover & tLNode::getVegCover()
   return vegCover;
 }
 
+// Brings the simple vegetation cover of an interior node, and with it the
+// critical shear stress, up to date with the regrowth of the model's
+// tVegetation, which is applied lazily (see tVegetation.h). getVegCover
+// and getTauCrit give the values as last brought up to date, so whatever
+// needs the current ones (erosion, output) calls this first.
+inline void tLNode::RegrowVegCover()
+{
+  if( context_==0 || context_->vegetation==0
+      || getBoundaryFlag()!=kNonBoundary )
+    return;
+  if( context_->vegetation->RegrowCover( vegCover ) )
+    setTauCrit( context_->vegetation->TauCrit( vegCover.getVeg() ) );
+}
+
 inline void tLNode::setVegCover( const tLNode *node )
 {
   vegCover = node->vegCover;
@@ -1498,15 +1510,15 @@ inline void tLNode::ChangeZ( double val )
 
 /*******************************************************************\
   tNode::getEdgePtrIndices() virtual function; here, returns 
-  one-member array with edg ID
+  two-member array with edg and flow edge IDs (-1 if not set)
 
   10/10 SL
 \*******************************************************************/
 inline tArray< int > tLNode::getEdgePtrIndices() 
 {
   tArray<int> ar(2);
-  ar[0] = getEdg()->getID();
-  ar[1] = flowedge->getID();
+  ar[0] = getEdg() ? getEdg()->getID() : -1;
+  ar[1] = flowedge ? flowedge->getID() : -1;
   return ar;
 }
 
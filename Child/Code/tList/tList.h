@@ -626,7 +626,6 @@ tList( const tList< NodeType, ListNodeType > &original ) :
 {
   int i;
 
-  assert( original != 0 );
   ListNodeType * current = original.first;
   for( i=0; i<original.nNodes; ++i )
     {
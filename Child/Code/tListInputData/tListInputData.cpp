@@ -24,6 +24,7 @@
 #include <iostream>
 
 #include "../Mathutil/mathutil.h"
+#include "../tLog/tLog.h"
 
 void tListInputDataBase::
 ReportIOError(IOErrorType t, const char *filename,
@@ -100,14 +101,14 @@ findRightTime( std::ifstream &infile, int &nn, double intime,
       infile >> time;
       if (infile.fail())
 	ReportIOError(IOTime, basename, ext);
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout << "Read time: " << time << std::endl;
       if( time < intime )
 	{
 	  infile >> nn;
 	  if (infile.fail())
 	    ReportIOError(IOSize, basename, ext);
-	  if (0) //DEBUG
+	  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	    std::cout << "nn (" << typefile << ")= " << nn << std::endl;
 	  int i;
 	  for( i=1; i<=nn+1; i++ ) {
@@ -115,7 +116,7 @@ findRightTime( std::ifstream &infile, int &nn, double intime,
 	  }
 	}
       else righttime = true;
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout << " NOW are we at eof? " << infile.eof() << std::endl;
     }
   if( !( infile.eof() ) ) {
@@ -150,7 +151,7 @@ tListInputDataRand( const tInputFile &inputfile, tRand &rand )
 
   // Find out which time slice we want to extract
   intime = inputfile.ReadItem( intime, "INPUTTIME" );
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kGeneral ) )
     std::cout << "intime = " << intime << std::endl;
 
   // Find specified input times in input data files and read # items.
@@ -187,7 +188,7 @@ tListInputDataVegetation( const tInputFile &inputfile )
 
   // Find out which time slice we want to extract
   intime = inputfile.ReadItem( intime, "INPUTTIME" );
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kVegetation ) )
     std::cout << "intime = " << intime << std::endl;
 
   // Find specified input times in input data files and read # items.
@@ -224,7 +225,7 @@ tListInputDataForest( const tInputFile &inputfile )
 
   // Find out which time slice we want to extract
   intime = inputfile.ReadItem( intime, "INPUTTIME" );
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kVegetation ) )
     std::cout << "intime = " << intime << std::endl;
 
   // Find specified input times in input data files and read # items.
@@ -30,6 +30,7 @@
 #include "../errors/errors.h"
 #include "../tArray/tArray.h"
 #include "../tInputFile/tInputFile.h"
+#include "../tLog/tLog.h"
 
 class tRand;
 
@@ -273,9 +274,9 @@ tListInputDataMesh( const tInputFile &infile )
 
   // Find out which time slice we want to extract
   intime = infile.ReadItem( intime, "INPUTTIME" );
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "intime = " << intime << std::endl;
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "Is node input file ok? " << nodeinfile.good()
 	      << " Are we at eof? " << nodeinfile.eof() << std::endl;
 
@@ -19,6 +19,7 @@
 #include <vector>
 #include <sstream>
 #include "tLithologyManager.h"
+#include "../tLog/tLog.h"
 
 using namespace std;
 
@@ -66,7 +67,8 @@ tLithologyManager::
 tLithologyManager() :
   meshPtr_(0)
 {
-  if(1) cout << "tLithologyManager default constructor" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kLithology,
+             "tLithologyManager default constructor" );
 }
 
 
@@ -80,7 +82,7 @@ tLithologyManager() :
 tLithologyManager::
 ~tLithologyManager()
 {
-  if(1) cout << "tLithologyManager destructor" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kLithology, "tLithologyManager destructor" );
 }
 
 
@@ -93,7 +95,8 @@ tLithologyManager::
 void tLithologyManager::
 InitializeFromInputFile( tInputFile &inputFile, tMesh<tLNode> *meshPtr )
 {
-  if(1) cout << "tLithologyManager::InitializeFromInputFile" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kLithology,
+             "tLithologyManager::InitializeFromInputFile" );
   
   meshPtr_ = meshPtr;
   
@@ -163,7 +166,7 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
   std::ifstream layerinfile;
   infile.ReadItem( thestring, sizeof(thestring), "INPUT_LAY_FILE" );
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) )
     std::cout<<"in SetLithologyFromChildLayFile..."<<std::endl;
   
   meshPtr_->RenumberIDCanonically();
@@ -175,13 +178,12 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
   // Read first line, which should contain the time corresponding to the run
   layerinfile >> time;
 
-  if(1) //DEBUG
-    std::cout<<"Time="<<time<<std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kLithology, "Time="<<time );
   
   // Read second line, which specified number of interior nodes in file.
   layerinfile >> numlayernodes;
-  if(1) //DEBUG
-    std::cout<<"nnodes in file="<<numlayernodes<<std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kLithology,
+             "nnodes in file="<<numlayernodes );
   if( numlayernodes != meshPtr_->getNodeList()->getActiveSize() )
     ReportFatalError( "Number of nodes in layer file doesn't match number in mesh" );
   
@@ -214,7 +216,7 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
     // Find the node with the current ID #
     cn = ni.GetP( k );
     
-    if (0) std::cout << "read lays at node " << cn->getID() << " pid=" << cn->getPermID() << "(x,y)=" << cn->getX() << "," << cn->getY() << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "read lays at node " << cn->getID() << " pid=" << cn->getPermID() << "(x,y)=" << cn->getX() << "," << cn->getY() << std::endl;
     
     // Remove pre-existing layers
     for(i=cn->getNumLayer()-1; i>=0; i-- )
@@ -222,7 +224,7 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
     
     // Read the number of layers at the current node
     layerinfile >> numl;
-    if (0) std::cout << " " << numl << "lays\n";
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << " " << numl << "lays\n";
     if( numl<1 )
     {
       std::cout << "In SetLithologyFromChildLayFile: node " 
@@ -251,7 +253,7 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
         << " has thickness " << ditem << std::endl;
         ReportFatalError("Layers must have positive thickness.");
       }
-      if (0) std::cout << "  lay" << i << " thickness=" << ditem << std::endl;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "  lay" << i << " thickness=" << ditem << std::endl;
       layer_template.setDepth(ditem);
       layerinfile >> ditem;     // layer erodibility
       layer_template.setErody(ditem);
@@ -293,7 +295,7 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
 			for(int g=0; g<numg; g++){
         layerinfile >> ditem;   // equivalent thickness of grain size g
         layer_template.setDgrade(g, ditem);
-        if (0) std::cout << "   thick of " << g << "=" << ditem << std::endl;
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "   thick of " << g << "=" << ditem << std::endl;
       }
       
       // Insert a copy of the layer on the bottom of the layer stack
@@ -316,7 +318,8 @@ SetLithologyFromChildLayFile( const tInputFile &infile )
 void tLithologyManager::
 SetLithologyFromEtchFile( const tInputFile &infile )
 {
-  if(1) std::cout << "tLithologyManager::SetLithologyFromEtchFile here\n";
+  CHILD_LOG( tLog::kDebug, tLog::kLithology,
+             "tLithologyManager::SetLithologyFromEtchFile here" );
   
   // Open the etch file
   ifstream etchfile;
@@ -347,22 +350,26 @@ SetLithologyFromEtchFile( const tInputFile &infile )
     //tLayer layer_properties;
     
     // Read properties for the current layer: general properties
-    if(1) cout << "Reading properties for layer " << i << endl;
+    CHILD_LOG( tLog::kDebug, tLog::kLithology,
+               "Reading properties for layer " << i );
     etchfile >> erody;
     new_etch_layer.layer_properties_.setErody( erody );
     etchfile >> bulk_density;
     new_etch_layer.layer_properties_.setBulkDensity( bulk_density );
     etchfile >> sedrockflag;
     tLayer::tSed_t flag = ( sedrockflag>0 ) ? tLayer::kSed : tLayer::kBedRock;
-    if(1) cout << "  Sed/rock flag = " << sedrockflag << endl;
+    CHILD_LOG( tLog::kDebug, tLog::kLithology,
+               "  Sed/rock flag = " << sedrockflag );
     new_etch_layer.layer_properties_.setSed( flag );
-    if(1) cout << "  Confirming: sed/rock flag = " << new_etch_layer.layer_properties_.getSed() << endl;
+    CHILD_LOG( tLog::kDebug, tLog::kLithology,
+               "  Confirming: sed/rock flag = " << new_etch_layer.layer_properties_.getSed() );
     cum_fraction = 0.0;
     
     // Read properties: grain-size related
     for( unsigned j=1; j<num_grain_sizes; j++ )
     {
-      if(1) std::cout << " Reading dgrade info for size " << j << " of " << num_grain_sizes << std::endl;
+      CHILD_LOG( tLog::kDebug, tLog::kLithology,
+                 " Reading dgrade info for size " << j << " of " << num_grain_sizes );
       etchfile >> grain_size_proportion;   // Note: dgrades are meant to be proportion, not
       if( grain_size_proportion < 0.0 || grain_size_proportion > 1.0 )
         ReportFatalError( "Grain size proportions must be 0 to 1." );
@@ -378,12 +385,14 @@ SetLithologyFromEtchFile( const tInputFile &infile )
     etchfile >> new_etch_layer.d;
     etchfile >> new_etch_layer.keep_regolith_ >> new_etch_layer.use_bounding_polygon_;
     
-    if(1) new_etch_layer.TellData();
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) )
+      new_etch_layer.TellData();
 
     if( new_etch_layer.use_bounding_polygon_ )
     {
       etchfile >> new_etch_layer.layer_is_inside_poly_;
-      if(1) std::cout << "layer in poly = " << new_etch_layer.layer_is_inside_poly_ << std::endl;
+      CHILD_LOG( tLog::kDebug, tLog::kLithology,
+                 "layer in poly = " << new_etch_layer.layer_is_inside_poly_ );
       int npoints;
       etchfile >> npoints;
       if( npoints < 3 || npoints>1000 )
@@ -392,7 +401,8 @@ SetLithologyFromEtchFile( const tInputFile &infile )
         << " points, which seems unlikely.\n";
         ReportFatalError( "Error in etchfile format" );
       }
-      if(1) std::cout << "Using bounding polygon with " << npoints << " points.\n";
+      CHILD_LOG( tLog::kDebug, tLog::kLithology,
+                 "Using bounding polygon with " << npoints << " points." );
       new_etch_layer.px.resize( npoints );
       new_etch_layer.py.resize( npoints );
       for( unsigned j=0; j<npoints; j++ )
@@ -400,7 +410,8 @@ SetLithologyFromEtchFile( const tInputFile &infile )
         etchfile >> new_etch_layer.px[j] >> new_etch_layer.py[j];
       }
     }
-    if(1) new_etch_layer.TellData();
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) )
+      new_etch_layer.TellData();
     
     // Do some error checking.
     // Some potential signs of a problem with the etch file format:
@@ -508,7 +519,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
   // layer to be added, or we hit the bottom of the layer stack.
   while( !layer_found && !li.AtEnd() )
   {
-    if(0) std::cout << "Checking layer " << layer_number << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Checking layer " << layer_number << std::endl;
     
     // To get the height of the current layer's base, we take its current
     // value (which starts at the land surface) and subtract the thickness
@@ -539,7 +550,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
   // a layer at the bottom of the stack
   if( !layer_found )
   {
-    if(0) std::cout << "Did not find a layer at depth "
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Did not find a layer at depth "
       << new_layer_base_height << " at node " << node->getPermID() << std::endl;
     
     // Create a new layer to be copied and added at the bottom of the current
@@ -567,7 +578,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
   // equal to one tenth of the standard layer thickness "maxregdepth").
   if( (new_layer_base_height-current_layer_base_height) > 0.1*node->getMaxregdep() )
   {
-    if(0) std::cout << "Now splitting layer ...\n";
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Now splitting layer ...\n";
     // Our layer splitting function will use the following algorithm:
     //  - Create a new layer, copying from the current layer
     //  - Assign the bottom (new) layer the top layer's original thickness 
@@ -585,7 +596,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
     // between these two.
     double layer_thickness = new_layer_base_height - current_layer_base_height;
     new_layer.setDepth( layer_thickness );
-    if(0) std::cout << "Setting thickness of new layer to " << layer_thickness << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Setting thickness of new layer to " << layer_thickness << std::endl;
     
     // Insert this layer below the current one.
     node->getLayersRefNC().insertAtNext( new_layer, li.NodePtr() );
@@ -595,7 +606,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
     layer_thickness = curlay->getDepth() - layer_thickness;
     assert( layer_thickness > 0.0 );
     curlay->setDepth( layer_thickness );
-    if(0) {
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) {
       std::cout << "The remaining upper layer has been reduced to " << layer_thickness << std::endl;
       std::cout << "To confirm: " << curlay->getDepth() << std::endl;
       std::cout << "Top layer thickness: " << node->getLayerDepth(0) << std::endl;
@@ -609,7 +620,7 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
   curlay = li.FirstP();
   for( int i=0; i<=layer_number; i++, curlay=li.NextP() )
   {
-    if(0) {
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) {
       std::cout << "Layer " << i << " has thickness " << curlay->getDepth() << std::endl;
       std::cout << "Via the node: " << node->getLayerDepth(i) << std::endl;
     }
@@ -632,10 +643,10 @@ EtchLayerAboveHeightAtNode( double new_layer_base_height, tLNode * node,
     for( size_t j=0; j<layer_properties.getDgradesize(); j++ )
     {
       double proportion_of_this_size = layer_properties.getDgrade(j);
-      if(0) std::cout << "Setting dgrade " << j << " to " << proportion_of_this_size << " times " << thickness << " = " << proportion_of_this_size*thickness << std::endl;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Setting dgrade " << j << " to " << proportion_of_this_size << " times " << thickness << " = " << proportion_of_this_size*thickness << std::endl;
       curlay->setDgrade( j, proportion_of_this_size*thickness );
     }
-    if(0) std::cout << "Now at end of loop we have layer thickness " << curlay->getDepth() << " and " << node->getLayerDepth(i) << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Now at end of loop we have layer thickness " << curlay->getDepth() << " and " << node->getLayerDepth(i) << std::endl;
   }
 
 }
@@ -679,7 +690,7 @@ PointInPolygon( std::vector<double> vertx,
 void tLithologyManager::
 EtchLayerAbove2DSurface( Etchlayer &etchlay )
 {
-  if(0) std::cout << "tLithologyManager::EtchLayerAbove2DSurface here\n";
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "tLithologyManager::EtchLayerAbove2DSurface here\n";
   
   tLNode * cn;
   tMesh<tLNode>::nodeListIter_t ni( meshPtr_->getNodeList() );
@@ -712,12 +723,12 @@ EtchLayerAbove2DSurface( Etchlayer &etchlay )
 
       // If the base of the layer falls below the ground surface, then
       // go ahead and "etch" it in.
-      if(0) std::cout << "About to etch at " << new_layer_base_height << std::endl;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "About to etch at " << new_layer_base_height << std::endl;
       if( new_layer_base_height < cn->getZ() )
         EtchLayerAboveHeightAtNode( new_layer_base_height, cn, 
                                     etchlay.layer_properties_, 
                                     etchlay.keep_regolith_ );
-      if(0) std::cout << "Our top layer is now " << cn->getLayerDepth(0) << std::endl;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kLithology ) ) std::cout << "Our top layer is now " << cn->getLayerDepth(0) << std::endl;
       
     }
   }
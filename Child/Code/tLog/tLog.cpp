@@ -0,0 +1,112 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tLog.cpp
+**
+**  @brief Functions for tLog, the model's leveled diagnostic output.
+**  See tLog.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <sstream>
+#include <string>
+#include "tLog.h"
+#include "../errors/errors.h"
+#include "../tInputFile/tInputFile.h"
+
+int tLog::level_[kNumSubsystems] =
+{
+  kInfo, kInfo, kInfo, kInfo, kInfo, kInfo, kInfo, kInfo,
+  kInfo, kInfo, kInfo, kInfo, kInfo, kInfo, kInfo
+};
+
+namespace
+{
+  // Names used in LOG_SUBSYSTEM_LEVELS, in the order of tLog::tSubsystem
+  const char *const subsystemNames[tLog::kNumSubsystems] =
+  {
+    "general", "mesh", "streamnet", "erosion", "floodplain", "meander",
+    "storm", "uplift", "vegetation", "eolian", "stratgrid", "lithology",
+    "tracker", "output", "interface"
+  };
+}
+
+/**************************************************************************/
+/**
+**  tLog::SetLevel
+**
+**  Sets the level of one or all subsystems. Levels out of range are
+**  brought to the nearest valid level.
+*/
+/**************************************************************************/
+void tLog::SetLevel( int level )
+{
+  for( int i=0; i<kNumSubsystems; ++i )
+    SetLevel( static_cast<tSubsystem>(i), level );
+}
+
+void tLog::SetLevel( tSubsystem subsystem, int level )
+{
+  if( level<kError ) level = kError;
+  if( level>kDebug ) level = kDebug;
+  level_[subsystem] = level;
+}
+
+const char *tLog::SubsystemName( tSubsystem subsystem )
+{
+  return subsystemNames[subsystem];
+}
+
+/**************************************************************************/
+/**
+**  tLog::InitializeFromInputFile
+**
+**  Sets the levels from LOG_LEVEL and LOG_SUBSYSTEM_LEVELS. Subsystems
+**  not named in LOG_SUBSYSTEM_LEVELS get LOG_LEVEL. If neither keyword is
+**  present, the levels are left as they are.
+*/
+/**************************************************************************/
+void tLog::InitializeFromInputFile( const tInputFile &infile )
+{
+  if( infile.Contain( "LOG_LEVEL" ) )
+    SetLevel( infile.ReadInt( "LOG_LEVEL" ) );
+
+  if( !infile.Contain( "LOG_SUBSYSTEM_LEVELS" ) )
+    return;
+  std::istringstream pairs( infile.ReadString( "LOG_SUBSYSTEM_LEVELS" ) );
+  std::string pair;
+  while( pairs >> pair )
+  {
+    const std::string::size_type colon = pair.find( ':' );
+    if( colon==std::string::npos )
+      ReportFatalError( "LOG_SUBSYSTEM_LEVELS: expected name:level pairs." );
+    const std::string name = pair.substr( 0, colon );
+    const char *levelString = pair.c_str() + colon + 1;
+    char *end;
+    const long level = strtol( levelString, &end, 10 );
+    if( end==levelString || *end!='\0' )
+      ReportFatalError( "LOG_SUBSYSTEM_LEVELS: level is not a number." );
+    int i;
+    for( i=0; i<kNumSubsystems; ++i )
+      if( name==subsystemNames[i] )
+        break;
+    if( i==kNumSubsystems )
+    {
+      std::cerr << "Unknown subsystem '" << name
+		<< "' in LOG_SUBSYSTEM_LEVELS.\n";
+      ReportFatalError( "LOG_SUBSYSTEM_LEVELS: unknown subsystem." );
+    }
+    SetLevel( static_cast<tSubsystem>(i), static_cast<int>(level) );
+  }
+}
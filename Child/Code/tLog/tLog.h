@@ -0,0 +1,132 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tLog.h
+**
+**  @brief Header file for tLog, the model's leveled diagnostic output.
+**
+**  Progress and debugging messages that used to go straight to std::cout
+**  (or sat in "if(0) //DEBUG" blocks) are written through tLog instead.
+**  Each message has a level and belongs to a subsystem, and is written
+**  only if its level is no higher than the current level for that
+**  subsystem:
+**
+**    kError    fatal or near-fatal conditions (to std::cerr)
+**    kWarning  suspicious conditions the run survives (to std::cerr)
+**    kInfo     startup and occasional progress messages (the default)
+**    kDetail   messages written every storm or every mesh update
+**    kDebug    traces and dumps formerly in if(0) blocks
+**
+**  The levels are set at run time from the input file:
+**
+**    LOG_LEVEL             level for all subsystems (default 2 = kInfo)
+**    LOG_SUBSYSTEM_LEVELS  per-subsystem levels, as name:level pairs
+**                          separated by blanks, e.g. "mesh:4 erosion:3"
+**                          (see SubsystemName for the names)
+**
+**  In addition, messages above the build threshold CHILD_LOG_MAX_LEVEL
+**  (kDetail, unless defined otherwise when compiling) are removed by the
+**  compiler altogether, so that debugging traces cost nothing in a
+**  normal build; compile with -DCHILD_LOG_MAX_LEVEL=4 to make them
+**  available.
+**
+**  Usage:
+**
+**    CHILD_LOG( tLog::kDetail, tLog::kFloodplain,
+**               "tFloodplain::Done.." );
+**
+**    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
+**      { ...longer dump... }
+**
+**  The levels are shared by every model in the process. They are meant
+**  to be set while models are being set up (which the multithreaded
+**  drivers do on one thread), and only read while models run.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TLOG_H
+#define TLOG_H
+
+#include <iostream>
+
+class tInputFile;
+
+#ifndef CHILD_LOG_MAX_LEVEL
+#define CHILD_LOG_MAX_LEVEL 3   // tLog::kDetail
+#endif
+
+// True if a message of the given level and subsystem would be written.
+// The first test is a constant, so that the whole statement is dropped
+// when the level is above the build threshold.
+#define CHILD_LOG_ENABLED( level, subsystem ) \
+  ( (level)<=CHILD_LOG_MAX_LEVEL && tLog::Enabled( (level), (subsystem) ) )
+
+// Writes a message (anything that can follow "<<") and a newline
+#define CHILD_LOG( level, subsystem, message ) \
+  do { \
+    if( CHILD_LOG_ENABLED( level, subsystem ) ) \
+      tLog::Stream( level ) << message << '\n'; \
+  } while(0)
+
+class tLog
+{
+public:
+  enum tLevel
+  {
+    kError = 0,
+    kWarning,
+    kInfo,
+    kDetail,
+    kDebug
+  };
+
+  enum tSubsystem
+  {
+    kGeneral = 0,
+    kMesh,
+    kStreamNet,
+    kErosion,
+    kFloodplain,
+    kMeander,
+    kStorm,
+    kUplift,
+    kVegetation,
+    kEolian,
+    kStratGrid,
+    kLithology,
+    kTracker,
+    kOutput,
+    kInterface,
+    kNumSubsystems
+  };
+
+  // Is a message of this level and subsystem to be written?
+  static bool Enabled( tLevel level, tSubsystem subsystem )
+  { return level <= level_[subsystem]; }
+
+  // Stream for messages of a given level
+  static std::ostream &Stream( tLevel level )
+  { return level<=kWarning ? std::cerr : std::cout; }
+
+  static void SetLevel( int level );                        // all subsystems
+  static void SetLevel( tSubsystem subsystem, int level );
+  static int GetLevel( tSubsystem subsystem ) { return level_[subsystem]; }
+  static const char *SubsystemName( tSubsystem subsystem );
+
+  // Reads LOG_LEVEL and LOG_SUBSYSTEM_LEVELS (both optional)
+  static void InitializeFromInputFile( const tInputFile &infile );
+
+private:
+  static int level_[kNumSubsystems];
+};
+
+#endif
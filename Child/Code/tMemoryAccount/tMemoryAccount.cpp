@@ -0,0 +1,124 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tMemoryAccount.cpp
+**
+**  @brief Functions for tMemoryAccount. See tMemoryAccount.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tMemoryAccount.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <sstream>
+
+long tMemoryAccount::counts_[tMemoryAccount::kNumKinds];
+long tMemoryAccount::bytes_[tMemoryAccount::kNumKinds];
+
+const char *tMemoryAccount::getName( tKind kind )
+{
+  static const char *names[kNumKinds] =
+    { "tLNode", "tEdge", "tTriangle", "tLayer", "tStratNode", "tTrees",
+      "tArray payload" };
+  return names[kind];
+}
+
+long tMemoryAccount::getTotalBytes()
+{
+  long total = 0;
+  for( int k=0; k<kNumKinds; ++k )
+    total += bytes_[k];
+  return total;
+}
+
+/**************************************************************************/
+/**
+**  tMemoryAccount::getResidentSize
+**
+**  Reads VmRSS and VmHWM from /proc/self/status, where there is one.
+*/
+/**************************************************************************/
+void tMemoryAccount::getResidentSize( long &current, long &peak )
+{
+  current = peak = 0;
+#ifdef __linux__
+  std::ifstream status( "/proc/self/status" );
+  std::string line;
+  while( std::getline( status, line ) )
+  {
+    long *field = 0;
+    if( line.compare( 0, 6, "VmRSS:" )==0 )
+      field = &current;
+    else if( line.compare( 0, 6, "VmHWM:" )==0 )
+      field = &peak;
+    if( field!=0 )
+    {
+      std::istringstream value( line.substr( 6 ) );
+      long kB = 0;
+      value >> kB;
+      *field = kB * 1024;
+    }
+  }
+#endif
+}
+
+/**************************************************************************/
+/**
+**  tMemoryAccount::WriteReport
+**
+**  Writes, for each kind, the live objects, their bytes, and their bytes
+**  per mesh node (per live tLNode). The total per node is the projected
+**  footprint: a mesh of N nodes, with the same options and a similar
+**  history, needs about N times as much for these objects.
+*/
+/**************************************************************************/
+void tMemoryAccount::WriteReport( std::ostream &out, double time )
+{
+  const long numNodes = counts_[kLNode];
+  const double MB = 1024.0 * 1024.0;
+
+  out << "Memory at time " << time;
+#if !CHILD_MEMORY_ACCOUNTING
+  out << " (accounting compiled out)";
+#endif
+  out << '\n';
+  out << std::setw(16) << std::left << "type" << std::right
+      << std::setw(12) << "count" << std::setw(14) << "bytes"
+      << std::setw(14) << "bytes/node" << '\n';
+  for( int k=0; k<kNumKinds; ++k )
+  {
+    const tKind kind = static_cast<tKind>(k);
+    out << std::setw(16) << std::left << getName( kind ) << std::right
+	<< std::setw(12) << counts_[k] << std::setw(14) << bytes_[k]
+	<< std::setw(14) << std::fixed << std::setprecision(1)
+	<< ( numNodes>0 ? double(bytes_[k]) / numNodes : 0.0 ) << '\n';
+  }
+  const long total = getTotalBytes();
+  const double perNode = numNodes>0 ? double(total) / numNodes : 0.0;
+  out << std::setw(16) << std::left << "total" << std::right
+      << std::setw(12) << "" << std::setw(14) << total
+      << std::setw(14) << perNode << '\n';
+  out << "Projected footprint: " << perNode << " bytes per node ("
+      << std::setprecision(0) << perNode * 1.0e6 / MB
+      << " MB per million nodes)\n";
+
+  long current, peak;
+  getResidentSize( current, peak );
+  if( current>0 )
+    out << "Resident size: " << std::setprecision(1) << current / MB
+	<< " MB (peak " << peak / MB << " MB)\n";
+  out << '\n';
+  out.unsetf( std::ios::fixed );
+  out << std::setprecision(6) << std::flush;
+}
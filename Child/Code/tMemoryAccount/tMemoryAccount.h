@@ -0,0 +1,118 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tMemoryAccount.h
+**
+**  @brief Header file for tMemoryAccount, which counts the objects (and
+**         bytes) of the classes that make up most of a model's memory.
+**
+**  The mesh nodes, edges and triangles, the layers of the nodes, the
+**  nodes of the stratigraphy grid, the trees of the forest model, and
+**  the payloads of tArray objects are counted as they are created and
+**  destroyed. A class is counted by deriving (privately) from
+**  tCounted, which adds nothing to its size:
+**
+**    class tEdge : private tCounted< tEdge, tMemoryAccount::kEdge >
+**
+**  and tArray counts the elements it allocates. The counts are for the
+**  whole process (all models in it) and are kept with atomic additions,
+**  so objects may be made and destroyed on any thread.
+**
+**  WriteReport writes a table of the live objects and their bytes of
+**  each kind, their share per mesh node (a projected footprint for
+**  sizing larger meshes), and, where the system provides it, the
+**  resident set size of the process. childInterface writes one to
+**  <OUTFILENAME>.memory at each output time and at the end of the run
+**  when OPT_MEMORY_REPORT is set. The bytes are those of the objects
+**  themselves and of tArray payloads; other heap data (lists, STL
+**  containers, allocator overhead) shows up only in the resident size.
+**
+**  Accounting is compiled in only if CHILD_MEMORY_ACCOUNTING is defined
+**  as 1 (CMake option of the same name, off by default), since every
+**  counted allocation and free then costs two atomic additions on
+**  counters shared by all threads. Otherwise the counts stay at zero and
+**  the report gives only the resident size.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TMEMORYACCOUNT_H
+#define TMEMORYACCOUNT_H
+
+#include <stddef.h>
+#include <iosfwd>
+
+#ifndef CHILD_MEMORY_ACCOUNTING
+#define CHILD_MEMORY_ACCOUNTING 0
+#endif
+
+class tMemoryAccount
+{
+public:
+  enum tKind
+  {
+    kLNode,
+    kEdge,
+    kTriangle,
+    kLayer,
+    kStratNode,
+    kTrees,
+    kArrayPayload,
+    kNumKinds
+  };
+
+  // Records count objects of the given kind, of bytes in total, made
+  // (or, if negative, destroyed)
+  static void Add( tKind kind, long count, long bytes )
+  {
+#if CHILD_MEMORY_ACCOUNTING
+    __sync_fetch_and_add( &counts_[kind], count );
+    __sync_fetch_and_add( &bytes_[kind], bytes );
+#else
+    (void)kind; (void)count; (void)bytes;
+#endif
+  }
+
+  static long getCount( tKind kind ) { return counts_[kind]; }
+  static long getBytes( tKind kind ) { return bytes_[kind]; }
+  static long getTotalBytes();
+  static const char *getName( tKind );
+
+  // Resident set size of the process and its peak, in bytes (0 if the
+  // system does not report them)
+  static void getResidentSize( long &current, long &peak );
+
+  // Writes the table for the given model time
+  static void WriteReport( std::ostream &, double time );
+
+private:
+  static long counts_[kNumKinds];
+  static long bytes_[kNumKinds];
+};
+
+/**************************************************************************/
+/**
+**  Class tCounted
+**
+**  Base class that counts the objects of class T as kind K.
+*/
+/**************************************************************************/
+template< class T, tMemoryAccount::tKind K >
+class tCounted
+{
+protected:
+  tCounted() { tMemoryAccount::Add( K, 1, sizeof(T) ); }
+  tCounted( const tCounted & ) { tMemoryAccount::Add( K, 1, sizeof(T) ); }
+  ~tCounted() { tMemoryAccount::Add( K, -1, -static_cast<long>(sizeof(T)) ); }
+  tCounted &operator=( const tCounted & ) { return *this; }
+};
+
+#endif
@@ -24,6 +24,7 @@
 
 #ifndef DONT_USE_PREDICATE
 #include "../globalFns.h"
+#include "../tLog/tLog.h"
 #endif
 
 #define TIMING 1
@@ -385,7 +386,7 @@ void start_aligned_point(int &lower_hull_pos, int &upper_hull_pos,
   }
   // if orient > 0, build edge from 0 to j-1
   // if orient < 0, build edge from j-1 to 0
-  if (0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "first non aligned j=" << j << " o=" << orient << std::endl;
 
   const int nap = j; // first non aligned point
@@ -396,7 +397,7 @@ void start_aligned_point(int &lower_hull_pos, int &upper_hull_pos,
       edges[iedge].from=inode;
       edges[iedge].to=inode+1;
       inode++;
-      if (0) // DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout << "edge=" << iedge << " from=" << edges[iedge].from << " to="
 		  << edges[iedge].to << std::endl;
     }
@@ -407,7 +408,7 @@ void start_aligned_point(int &lower_hull_pos, int &upper_hull_pos,
       edges[iedge].from=inode+1;
       edges[iedge].to=inode;
       inode--;
-      if (0) // DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	std::cout << "edge=" << iedge << " from=" << edges[iedge].from << " to="
 		  << edges[iedge].to << std::endl;
     }
@@ -473,10 +474,10 @@ void start_aligned_point(int &lower_hull_pos, int &upper_hull_pos,
   //
   next_edge = 2*nap-1; // number of existing edges: 2*nap-1
   next_point = nap+1;
-  if (0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "next point=" << next_point << std::endl;
   //
-  if (0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     for (int iedge=0;iedge<next_edge; iedge++){
       std::cout << "iedge=" << iedge
 		<< " from=" << edges[iedge].from
@@ -802,7 +803,7 @@ void tt_sort_triangulate(int npoints, point *p,
 	 << " s" << std::endl;
   }
 #endif
-  if (0) { // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     for (int iedge=0;iedge<*pnedges; iedge++){
       std::cout << "iedge=" << iedge
 	   << " from=" << (*edges_ret)[iedge].from
@@ -1078,7 +1079,7 @@ void tt_build_elem_table(int npoints, const point *p,
 	edges_visit[elems[ielem].e3].ielem_right();
     }
   }
-  if (0) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     for(int ielem=0;ielem<nelem;ielem++){
       std::cout << "elem=" << ielem
 	   << " p1=" << elems[ielem].p1
@@ -24,7 +24,6 @@
 
 #ifndef DONT_USE_PREDICATE
 #include "../globalFns.h"
-Predicates predicate;
 #endif
 
 // generate output files
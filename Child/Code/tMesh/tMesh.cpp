@@ -20,6 +20,8 @@
 #include <stdlib.h>
 
 #include "ParamMesh_t.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
 
 /***************************************************************************\
  **  Templated global functions used by tMesh here
@@ -42,12 +44,6 @@ template< class tSubNode >
 int Next3Delaunay( tPtrList< tSubNode > & /*nbrList*/,
                   tPtrListIter< tSubNode > &nbrIter )
 {
-  if (0) { //DEBUG
-    static int ncalls = 0;
-    ncalls++;
-    std::cout << "Next3Delaunay? no calls =  " << ncalls << std::endl;
-  }
-  
   tSubNode *nbrnd = nbrIter.DatPtr();
   tPtrListIter< tSubNode > nbrIterCopy( nbrIter );
   const tArray< double > p0( nbrIterCopy.DatPtr()->get2DCoords() );
@@ -77,27 +73,134 @@ int Next3Delaunay( tPtrList< tSubNode > & /*nbrList*/,
  \**************************************************************************/
 
 //copy constructor (created 11/99, GT)
-//WARNING: this constructor relies on the behavior of assignment operations
-//in tMeshList, tList, and tPtrList, which may or not give the desired
-//results! Caveat emptor! -GT
+//The new mesh's nodes point to "context" (e.g., the copy of the original
+//model's tModelContext owned by the new model) rather than to the
+//original mesh's context.
+//
+//The node and edge lists are copied item by item, so at first the copied
+//nodes and edges still point to the original mesh's edges, nodes and
+//triangles. Each pointer is then mapped to its counterpart in the new
+//mesh, so that the copy is fully independent of the original: changes
+//to one (e.g., when running a "daughter" model made by
+//childInterface::Initialize_Copy) leave the other untouched. The
+//triangles are rebuilt from the mapped nodes and edges rather than
+//copied, because tTriangle's copy constructor resets the back-pointers
+//of the edges it refers to, which would alter the original mesh.
+//(Deep copy added for the ensemble driver, see childEnsemble.h.)
 template< class tSubNode >
-tMesh<tSubNode>::tMesh( tMesh const *originalMesh )
+tMesh<tSubNode>::tMesh( tMesh const *originalMesh, tModelContext *context )
 :
 xOffset(originalMesh->xOffset),
 yOffset(originalMesh->yOffset),
 nodeList(originalMesh->nodeList),
 edgeList(originalMesh->edgeList),
-triList(originalMesh->triList),
+triList(),
 mSearchOriginTriPtr(0),
 nnodes(originalMesh->nnodes),
 nedges(originalMesh->nedges),
 ntri(originalMesh->ntri),
 miNextNodeID(originalMesh->miNextNodeID),
+miNextPermNodeID(originalMesh->miNextPermNodeID),
 miNextEdgID(originalMesh->miNextEdgID),
 miNextTriID(originalMesh->miNextTriID),
 layerflag(originalMesh->layerflag),
-runCheckMeshConsistency(originalMesh->runCheckMeshConsistency)
-{}
+runCheckMeshConsistency(originalMesh->runCheckMeshConsistency),
+node_ID_generator(originalMesh->node_ID_generator),
+context_(context)
+{
+  typedef tListNodeListable< tSubNode > nodeListNode_t;
+  typedef tListNodeListable< tEdge > edgeListNode_t;
+  typedef tListNodeListable< tTriangle > triListNode_t;
+
+  std::map< const tNode *, tNode * > nodeMap;
+  std::map< const tEdge *, tEdge * > edgeMap;
+  std::map< const tTriangle *, tTriangle * > triMap;
+  std::map< int, tEdge * > edgeByID;
+  nodeMap[0] = 0;
+  edgeMap[0] = 0;
+  triMap[0] = 0;
+
+  // Pair up original and new nodes and edges (the lists are in the same
+  // order)
+  {
+    const nodeListNode_t *oln = originalMesh->nodeList.getFirst();
+    for( nodeListNode_t *ln = nodeList.getFirstNC(); ln!=0;
+         ln = ln->getNextNC(), oln = oln->getNext() )
+      nodeMap[ oln->getDataPtr() ] = ln->getDataPtrNC();
+    const edgeListNode_t *oln2 = originalMesh->edgeList.getFirst();
+    for( edgeListNode_t *ln = edgeList.getFirstNC(); ln!=0;
+         ln = ln->getNextNC(), oln2 = oln2->getNext() )
+    {
+      edgeMap[ oln2->getDataPtr() ] = ln->getDataPtrNC();
+      if( !edgeByID.insert( std::make_pair( ln->getDataPtr()->getID(),
+                                            ln->getDataPtrNC() ) ).second )
+        ReportFatalError( "tMesh copy: duplicate edge ID in original mesh." );
+    }
+  }
+
+  // Rebuild the triangles from the new nodes and edges
+  for( const triListNode_t *oln = originalMesh->triList.getFirst(); oln!=0;
+       oln = oln->getNext() )
+  {
+    const tTriangle *ot = oln->getDataPtr();
+    tTriangle newtri( ot->getID(),
+                      nodeMap[ ot->pPtr(0) ], nodeMap[ ot->pPtr(1) ],
+                      nodeMap[ ot->pPtr(2) ],
+                      edgeMap[ ot->ePtr(0) ], edgeMap[ ot->ePtr(1) ],
+                      edgeMap[ ot->ePtr(2) ] );
+    if( ot->isIndexIDOrdered() )
+      newtri.SetIndexIDOrdered();
+    triList.insertAtBack( newtri );
+    triMap[ ot ] = triList.getLastNC()->getDataPtrNC();
+  }
+  {
+    const triListNode_t *oln = originalMesh->triList.getFirst();
+    for( triListNode_t *ln = triList.getFirstNC(); ln!=0;
+         ln = ln->getNextNC(), oln = oln->getNext() )
+      for( int i=0; i<3; ++i )
+        ln->getDataPtrNC()->setTPtr( i, triMap[ oln->getDataPtr()->tPtr(i) ] );
+  }
+
+  // Re-point the edges
+  {
+    const edgeListNode_t *oln = originalMesh->edgeList.getFirst();
+    for( edgeListNode_t *ln = edgeList.getFirstNC(); ln!=0;
+         ln = ln->getNextNC(), oln = oln->getNext() )
+    {
+      tEdge *ce = ln->getDataPtrNC();
+      const tEdge *oe = oln->getDataPtr();
+      ce->setOriginPtr( nodeMap[ oe->getOriginPtr() ] );
+      ce->setDestinationPtr( nodeMap[ oe->getDestinationPtr() ] );
+      ce->setCCWEdg( edgeMap[ const_cast<tEdge *>( oe )->getCCWEdg() ] );
+      ce->setCWEdg( edgeMap[ const_cast<tEdge *>( oe )->getCWEdg() ] );
+      ce->setComplementEdge( edgeMap[ oe->getComplementEdge() ] );
+      ce->setTri( triMap[ const_cast<tEdge *>( oe )->TriWithEdgePtr() ] );
+    }
+  }
+
+  // Re-point the nodes' edge pointers (via the getEdgePtrIndices /
+  // setEdgePtrsFromVector hooks, which also cover tLNode's flow edge),
+  // restore their permanent IDs (not kept by tNode's copy constructor)
+  // and attach them to the new context
+  {
+    const nodeListNode_t *oln = originalMesh->nodeList.getFirst();
+    for( nodeListNode_t *ln = nodeList.getFirstNC(); ln!=0;
+         ln = ln->getNextNC(), oln = oln->getNext() )
+    {
+      tSubNode *cn = ln->getDataPtrNC();
+      tArray< int > edgIDs = cn->getEdgePtrIndices();
+      vector< tEdge * > edgPtrs( edgIDs.getSize() );
+      for( size_t i=0; i<edgPtrs.size(); ++i )
+        edgPtrs[i] = ( edgIDs[i]>=0 ) ? edgeByID[ edgIDs[i] ] : 0;
+      cn->setEdgePtrsFromVector( edgPtrs );
+      cn->setPermID( oln->getDataPtr()->getPermID() );
+      cn->setContext( context_ );
+    }
+  }
+
+  // Start point searches where the original would
+  mSearchOriginTriPtr = triMap[ originalMesh->mSearchOriginTriPtr ];
+}
 
 
 /**************************************************************************\
@@ -127,7 +230,8 @@ runCheckMeshConsistency(originalMesh->runCheckMeshConsistency)
  \**************************************************************************/
 template< class tSubNode >
 tMesh< tSubNode >::
-tMesh( const tInputFile &infile, bool checkMeshConsistency  )
+tMesh( const tInputFile &infile, bool checkMeshConsistency,
+       tModelContext *context )
 :
 xOffset(0.0),
 yOffset(0.0),
@@ -141,7 +245,8 @@ miNextPermNodeID(0),
 miNextEdgID(0),
 miNextTriID(0),
 layerflag(false),
-runCheckMeshConsistency(checkMeshConsistency)
+runCheckMeshConsistency(checkMeshConsistency),
+context_(context)
 {
   // mSearchOriginTriPtr:
   // initially set search origin (tTriangle*) to zero:
@@ -158,8 +263,9 @@ runCheckMeshConsistency(checkMeshConsistency)
     case 10:
     {
       // Random number generator used for mesh generation.
-      // Its seed is initialized with the appropriate keyword.
-      tRand randM( infile );
+      // Its seed is initialized with the appropriate keyword
+      // (with Philox, on the mesh's own stream).
+      tRand randM( infile, tRand::kMeshStream );
       //create new mesh with parameters
       if (read == 0)
         MakeMeshFromScratch( infile, randM );
@@ -187,7 +293,13 @@ runCheckMeshConsistency(checkMeshConsistency)
       MakeMeshFromPointsTipper( infile ); //create new mesh from list of points
       break;
     case 3:
-      MakeRandomPointsFromArcGrid( infile ); //create mesh from regular grid
+    {
+      // Random number generator used for mesh generation.
+      // Its seed is initialized with the appropriate keyword
+      // (with Philox, on the mesh's own stream).
+      tRand randM( infile, tRand::kMeshStream );
+      MakeRandomPointsFromArcGrid( infile, randM ); //create mesh from regular grid
+    }
       break;
     case 4:
       MakeHexMeshFromArcGrid( infile );
@@ -195,8 +307,9 @@ runCheckMeshConsistency(checkMeshConsistency)
     case 5:
     {
       // Random number generator used for mesh generation.
-      // Its seed is initialized with the appropriate keyword.
-      tRand randM( infile );
+      // Its seed is initialized with the appropriate keyword
+      // (with Philox, on the mesh's own stream).
+      tRand randM( infile, tRand::kMeshStream );
       // create mesh from point tiles and masked ArcGrid
       MakeMeshFromPointTilesAndArcGridMask( infile, randM );
     }
@@ -243,7 +356,7 @@ template< class tSubNode >
 tMesh< tSubNode >::
 ~tMesh() {
   mSearchOriginTriPtr = 0;
-  if (0)//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "    ~tMesh()" << std::endl;
 }
 
@@ -259,6 +372,7 @@ tMesh< tSubNode >::
  **
  **  Takes: 
  **    - Arrays (by reference) with x, y, and z coordinates, respectively
+ **    - Model context for the new nodes (optional)
  **  Calls: 
  **    - tMesh::BuildDelaunayMeshTipper
  **    - tMesh::LocateTriangle
@@ -270,7 +384,8 @@ tMesh< tSubNode >::
  \***************************************************************************/
 template< class tSubNode >
 tMesh< tSubNode >::
-tMesh( tArray<double> &x, tArray<double> &y, tArray<double> &z  )
+tMesh( tArray<double> &x, tArray<double> &y, tArray<double> &z,
+       tModelContext *context )
 :
 xOffset(0.0),
 yOffset(0.0),
@@ -283,12 +398,14 @@ miNextNodeID(0),
 miNextPermNodeID(0),
 miNextEdgID(0),
 miNextTriID(0),
-layerflag(false)
+layerflag(false),
+context_(context)
 {
   // do what MakeMeshFromPointsTipper does:
   int numpts = x.getSize();                      // no. of points in mesh
                                                  // temporary node used to create node list (creation is costly)
   tSubNode tempnode;
+  tempnode.setContext( context_ );
   tempnode.setBoundaryFlag( kNonBoundary );
   //Read point file, make Nodelist
   for( int i=0; i<numpts; i++ )
@@ -337,7 +454,7 @@ MakeLayersFromInputData( const tInputFile &infile )
   std::ifstream layerinfile;
   infile.ReadItem( thestring, sizeof(thestring), "INPUTDATAFILE" );
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"in MakeLayersFromInputData..."<<std::endl;
   
   strcpy( inname, thestring );
@@ -360,7 +477,7 @@ MakeLayersFromInputData( const tInputFile &infile )
       if( time >= intime ) righttime = 1;
     }
   }
-  if(1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"MakeLayersFromInputData: nnodes before="<<nnodes<<std::endl;
   int temp_nintnodes;  // Temporary variable used to read number of interior nodes
   if( !( layerinfile.eof() ) ) layerinfile >> temp_nintnodes;
@@ -369,7 +486,7 @@ MakeLayersFromInputData( const tInputFile &infile )
     std::cerr << "Couldn't find specified input time in layer file" << std::endl;
     ReportFatalError( "Input error" );
   }
-  if(1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"nnodes after="<<nnodes<<std::endl;
   
   tLayer layhelp;
@@ -509,7 +626,7 @@ MeshDensification( const tInputFile &infile )
   initMeshDensLevel = infile.ReadItem( initMeshDensLevel, "OPTINITMESHDENS" );
   if( initMeshDensLevel)
   {
-    tSubNode tempnode( infile );
+    tSubNode tempnode( infile, context_ );
     int j;  // Level counter
     int nnewpoints;  // No. of new points added in a given pass
     tArray<double> newx, newy, newz;   // Lists of new coords
@@ -596,7 +713,7 @@ MakeMeshFromInputData( const tInputFile &infile )
   nnodes = input.x.getSize();
   nedges = input.orgid.getSize();
   ntri = input.p0.getSize();
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "nnodes, nedges, ntri: "
 	  << nnodes << " " << nedges << " " << ntri << std::endl;
   assert( nnodes > 0 );
@@ -607,7 +724,7 @@ MakeMeshFromInputData( const tInputFile &infile )
   // (1) assigning it values from the input data and (2) inserting it onto
   // the back of the node list.
   std::cout << "Creating node list..." << std::flush;
-  tSubNode tempnode( infile );
+  tSubNode tempnode( infile, context_ );
   for( i = 0; i< nnodes; i++ )
   {
     tempnode.set3DCoords( input.x[i], input.y[i], input.z[i] );
@@ -628,7 +745,7 @@ MakeMeshFromInputData( const tInputFile &infile )
         nodeList.insertAtBack( tempnode );
         break;
     }
-    if (0) { // DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
       std::cout << input.x[i] << input.y[i] << input.z[i]
       << input.boundflag[i] << std::endl;
       std::cout << BoundName(tempnode.getBoundaryFlag()) << " "
@@ -648,12 +765,12 @@ MakeMeshFromInputData( const tInputFile &infile )
     {
       for( miNextEdgID = 0; miNextEdgID < nedges-1; miNextEdgID+=2 )
       {
-        if (0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
           std::cout << input.orgid[miNextEdgID] << " "
           << input.destid[miNextEdgID] << std::endl;
         tSubNode *nodPtr1 = NodeTable[ input.orgid[miNextEdgID] ];
         tSubNode *nodPtr2 = NodeTable[ input.destid[miNextEdgID] ];
-        if (0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
           std::cout << nodPtr1->getID() << "->" << nodPtr2->getID() << std::endl;
         
         // Assign values: ID, origin and destination pointers,
@@ -664,7 +781,7 @@ MakeMeshFromInputData( const tInputFile &infile )
         
         // insert edge pair onto the list --- active
         // part of list if flow is allowed, inactive if not
-        if (0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
           std::cout << "Setting edges " << tempedge1.getID() << " and "
           << tempedge2.getID() <<
           (tempedge1.FlowAllowed() ? " as OPEN" : " as no-flux")
@@ -717,7 +834,7 @@ MakeMeshFromInputData( const tInputFile &infile )
       do
       {
         curnode = nodIter.DatPtr();
-				if(0) { // debug
+				if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
 					std::cout << "current node's edg = " << curnode->getEdg() << std::endl;
 				  if( curnode->getEdg()!=0 ) std::cout << "this edg's ID = " << curnode->getEdg()->getID() << 
 				  " org id " << curnode->getEdg()->getOriginPtr()->getID() << std::endl;
@@ -746,7 +863,7 @@ MakeMeshFromInputData( const tInputFile &infile )
     {
       for ( int i=0; i<ntri; i++ )
       {
-        if (0) // DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
           std::cout << "TRI " << i << std::endl;
         tTriangle newtri( i,
                          NodeTable[ input.p0[i] ],
@@ -1147,7 +1264,7 @@ MakePointBoundary( const ParamMMFS_t &Param, const tInputFile &infile,
   int i,                        // counters
   n;                        // no. of nodes along a side
   double dist;                  // current distance along boundary
-  tSubNode tempnode( infile );  // temporary node used to create node list
+  tSubNode tempnode( infile, context_ );  // temporary node used to create node list
   nodeListIter_t nodIter( nodeList );
   
   //MAKE BOUNDARY
@@ -1575,7 +1692,7 @@ MakePointInterior( const ParamMMFS_t &Param, const tInputFile &infile,
   nx, ny;                   // no. of nodes along a side
   double slope;
   tArray< double > xyz(3);
-  tSubNode tempnode( infile );  // temporary node used to create node list
+  tSubNode tempnode( infile, context_ );  // temporary node used to create node list
   
   // Add the interior points.
   // Variations on the theme are these:
@@ -1675,7 +1792,7 @@ template< class tSubNode >
 void tMesh< tSubNode >::
 MakeMeshFromScratch( const tInputFile &infile, tRand &rand )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "In MGFS, calling node constr w/ infile\n";
   
   tSubNode *node0, *node1, *node2;
@@ -1765,7 +1882,7 @@ MakeMeshFromPoints( const tInputFile &infile )
   double minx = 1e12, miny = 1e12, // minimum x and y coords
   maxx = 0., maxy=0.,          // maximum x and y coords
   dx, dy;                      // max width and height of region
-  tSubNode tempnode( infile ),     // temporary node used in creating new pts
+  tSubNode tempnode( infile, context_ ),     // temporary node used in creating new pts
   *stp1, *stp2, *stp3;         // supertriangle vertices
   
   std::cout<<"MakeMeshFromPoints"<<std::endl;
@@ -1917,7 +2034,7 @@ MakeMeshFromPoints( const tInputFile &infile )
  **
  **   Calls: tInputFile::ReadItem, MakeCCWEdges(),
  **          UpdateMesh(), CheckMeshConsistency()
- **   Parameters: infile -- main parameter input file
+ **   Parameters: infile -- main parameter input file, rand
  **   Assumes: infile is valid and open
  **   Created: 10/98 SL
  **   Modified:
@@ -1925,7 +2042,7 @@ MakeMeshFromPoints( const tInputFile &infile )
  \**************************************************************************/
 template< class tSubNode >
 void tMesh< tSubNode >::
-MakeRandomPointsFromArcGrid( const tInputFile &infile )
+MakeRandomPointsFromArcGrid( const tInputFile &infile, tRand &rand )
 {
   int i, j;                        // loop counter
                                    //Xn;                            // counter
@@ -1950,7 +2067,7 @@ MakeRandomPointsFromArcGrid( const tInputFile &infile )
   double mindist;
   double delx, dely, dist;
   //XtSubNode *closestPtr;
-  tSubNode tempnode( infile ),     // temporary node used in creating new pts
+  tSubNode tempnode( infile, context_ ),     // temporary node used in creating new pts
   *stp1, *stp2, *stp3;         // supertriangle vertices
                                //Xdouble dumval;
   char dumhead[3];
@@ -2039,18 +2156,14 @@ MakeRandomPointsFromArcGrid( const tInputFile &infile )
   std::cout << "1 NN: " << nnodes << " (" << nodeList.getActiveSize() << ")  NE: " << nedges << " NT: " << ntri << std::endl;
   
   std::cout << "begin interpolation\n";
-  // Read and initialize seed for random number generation
-  int seed_;
-  seed_ = infile.ReadItem( seed_, "SEED" );
-  init_genrand( seed_ );
   numpts = numcols * numrows;
   tempnode.setBoundaryFlag( kNonBoundary );
   //Xn = 0;
   mindist = delgrid / 10.0;
   for( i=0; i<numpts; ++i )
   {
-    xgen = genrand_res53() * (di - 1.0);
-    ygen = genrand_res53() * (dj - 1.0);
+    xgen = rand.ran3() * (di - 1.0);
+    ygen = rand.ran3() * (dj - 1.0);
     
     zinterp = InterpSquareGrid( xgen, ygen, elev, nodata );
     
@@ -2169,7 +2282,7 @@ MakeHexMeshFromArcGrid( const tInputFile &infile )
   di, dj,                      // width and height of region in pixels
   xgen, ygen,                  // randomly generated x and y val's
   zinterp;                     // interp'd elev.
-  tSubNode tempnode( infile ),     // temporary node used in creating new pts
+  tSubNode tempnode( infile, context_ ),     // temporary node used in creating new pts
   *stp1, *stp2, *stp3;         // supertriangle vertices
                                //Xdouble dumval;
   char dumhead[3];
@@ -2486,13 +2599,13 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
   << " (" << nodeList.getActiveSize() << ") NE: "
   << nedges << " NT: " << ntri << std::endl;
   // any elevations below minz?
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     tListIter<double> zLI(zList);
     for( double *zPtr = zLI.FirstP(); !zLI.AtEnd(); zPtr = zLI.NextP() )
       if( *zPtr < minz ) std::cout << "elev too low:" << *zPtr << "\n";
   }
-  tSubNode tempnode( infile );
+  tSubNode tempnode( infile, context_ );
   tempnode.setBoundaryFlag( kNonBoundary );
   // checks for duplicate locations, removes duplicates,
   // and puts rest in nodeList:
@@ -2503,7 +2616,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
   std::cout << "\n2 NN: " << nnodes 
   << " (" << nodeList.getActiveSize() << ") NE: "
   << nedges << " NT: " << ntri << std::endl;
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); cn = nI.NextP() )
       if( cn->getZ() < minz ) 
@@ -2560,7 +2673,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
         std::cout << "\n3 NN: " << nnodes 
         << " (" << nodeList.getActiveSize() << ") NE: "
         << nedges << " NT: " << ntri << std::endl;
-        if(0) // DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	      {
           for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
               cn = nI.NextP() )
@@ -2627,7 +2740,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
       std::cout << "\n4 NN: " << nnodes 
 		  << " (" << nodeList.getActiveSize() << ") NE: "
 		  << nedges << " NT: " << ntri << std::endl;
-      if(0) // DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       {
         for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
             cn = nI.NextP() )
@@ -2642,7 +2755,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
       std::cout << "\n5 NN: " << nnodes 
 		  << " (" << nodeList.getActiveSize() << ") NE: "
 		  << nedges << " NT: " << ntri << std::endl;
-      if(0) // DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       {
         for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
             cn = nI.NextP() )
@@ -2805,7 +2918,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
   std::cout << "deleted superfluous boundary nodes\n";
   std::cout << "6 NN: " << nnodes << " (" << nodeList.getActiveSize() 
   << ")  NE: " << nedges << " NT: " << ntri << std::endl;
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
         cn = nI.NextP() )
@@ -2816,7 +2929,7 @@ MakeMeshFromPointTilesAndArcGridMask( const tInputFile &infile, tRand &rand )
   std::cout << "made hull convex\n";
   std::cout << "7 NN: " << nnodes << " (" << nodeList.getActiveSize() 
   << ")  NE: " << nedges << " NT: " << ntri << std::endl;
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
         cn = nI.NextP() )
@@ -2942,7 +3055,7 @@ MakeStreamLineBoundaries( tPtrList< tSubNode > &streamList )
   std::cout << "8 NN: " << nnodes << " (" << nodeList.getActiveSize() 
   << ")  NE: " << nedges << " NT: " << ntri << std::endl;
   nodeListIter_t nI( nodeList );
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
         cn = nI.NextP() )
@@ -2976,7 +3089,7 @@ MakeStreamLineBoundaries( tPtrList< tSubNode > &streamList )
   std::cout << "deleted superfluous boundary nodes (2nd time)\n";
   std::cout << "10 NN: " << nnodes << " (" << nodeList.getActiveSize() 
   << ")  NE: " << nedges << " NT: " << ntri << std::endl;
-  if(0) // DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( tSubNode *cn = nI.FirstP(); !nI.AtEnd(); 
         cn = nI.NextP() )
@@ -3049,7 +3162,7 @@ CheckMeshConsistency( bool boundaryCheckFlag /* default: true */)
   if (!runCheckMeshConsistency)
     return;
   
-  if(1) std::cout << "CheckMeshConsistency() ...\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "CheckMeshConsistency() ..." );
   
   nodeListIter_t nodIter( nodeList );
   edgeListIter_t edgIter( edgeList );
@@ -3271,7 +3384,7 @@ CheckMeshConsistency( bool boundaryCheckFlag /* default: true */)
         }
       }
       // check flip test
-      if(0) std::cout << " About to do flip test ... ";
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) std::cout << " About to do flip test ... ";
       if( ct->tPtr(i) != 0 )
       {
         switch(CheckForFlip( ct, i, false, false )) {
@@ -3364,7 +3477,7 @@ Print() const
 template <class tSubNode>
 void tMesh<tSubNode>::setVoronoiVertices()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "setVoronoiVertices()..." << std::endl;
   triListIter_t triIter( triList );
   tTriangle * ct;
@@ -3380,7 +3493,7 @@ void tMesh<tSubNode>::setVoronoiVertices()
     ct->ePtr(1)->setRVtx( xy );
     ct->ePtr(2)->setRVtx( xy );
     
-    if (0) {//DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
       std::cout << "FOR edges: ";
       for( int i=0; i<=2; i++ )
         std::cout << ct->ePtr(i)->getID() << " ("
@@ -3392,7 +3505,7 @@ void tMesh<tSubNode>::setVoronoiVertices()
       << " " << xy_.at(1) << std::endl;
     }
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "setVoronoiVertices() finished" << std::endl;
 }
 
@@ -3444,7 +3557,7 @@ void tMesh<tSubNode>::CalcVoronoiEdgeLengths()
 template <class tSubNode>
 void tMesh<tSubNode>::CalcVAreas()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "CalcVAreas()..." << std::endl;
   tSubNode* curnode;
   nodeListIter_t nodIter( nodeList );
@@ -3539,7 +3652,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   }
 #endif
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     std::cout << "DeleteNode: " << node->getID() << " at " << node->getX() << " "
 	  << node->getY() << " " << node->getZ() << std::endl;
@@ -3560,7 +3673,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   // extricate node from mesh and get list of its neighbors:
   if( !( ExtricateNode( node, nbrList ) ) ) return 0;
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     int nactive = 0, ntotalnodes = 0;
     nodeListIter_t nodIter( nodeList );
@@ -3586,7 +3699,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
     nodeList.removeFromFront( nodeVal );
   }
   
-  if(1) 
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     std::cout << "Removed node " << nodeVal.getID() << " at x, y "
       << nodeVal.getX() << ", " << nodeVal.getY() << "; " << std::endl;
@@ -3604,7 +3717,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   nedges = edgeList.getSize();
   ntri = triList.getSize();
   
-  if (1) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     std::cout << "nn " << nnodes << "  ne " << nedges << "  nt " << ntri << std::endl;
     tPtrListIter< tSubNode > nbrIter( nbrList );
     std::cout << "leaving hole defined by \n"
@@ -3637,7 +3750,7 @@ DeleteNode( nodeListNode_t *nodPtr, kRepairMesh_t repairFlag,
   //reset node id's
   ResetNodeIDIfNecessary();
   
-  if (1) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     std::cout << "Mesh repaired" << std::endl;
     nodeListIter_t nodIter( nodeList );
     tSubNode *cn;
@@ -3686,13 +3799,13 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 ExtricateNode( tSubNode *node, tPtrList< tSubNode > &nbrList )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "ExtricateNode: " << node->getID() << std::endl;
   tSpkIter spokIter( node );
   tEdge *ce;
   tSubNode *nbrPtr;
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     int nactive = 0, ntotalnodes = 0;
     nodeListIter_t nodIter( nodeList );
@@ -3719,7 +3832,7 @@ ExtricateNode( tSubNode *node, tPtrList< tSubNode > &nbrList )
       nodeList.moveToBack( nbrPtr );
       nbrPtr->ConvertToClosedBoundary();
     }
-    if (1) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     {
       int nactive = 0, ntotalnodes = 0;
       nodeListIter_t nodIter( nodeList );
@@ -3759,7 +3872,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 DeleteEdge( tEdge * edgePtr )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "DeleteEdge(...) " << edgePtr->getID() << std::endl;
   //edgePtr->TellCoords();
   tEdge edgeVal1, edgeVal2;
@@ -3814,7 +3927,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 ExtricateEdge( tEdge * edgePtr )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "ExtricateEdge: " << edgePtr->getID() << std::endl;
   //edgePtr->TellCoords();
   assert( edgePtr != 0 );
@@ -4003,7 +4116,7 @@ template< class tSubNode >
 tTriangle * tMesh< tSubNode >::
 LocateTriangle( double x, double y, bool useFuturePosn)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "\nLocateTriangle (" << x << "," << y << ")\n";
   triListIter_t triIter( triList );  //lt
   tTriangle *lt = ( mSearchOriginTriPtr != 0 ) ? mSearchOriginTriPtr
@@ -4068,7 +4181,7 @@ template< class tSubNode >
 tTriangle * tMesh< tSubNode >::
 LocateNewTriangle( double x, double y )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "LocateNewTriangle" << std::endl;
   return
   LocateTriangle( x, y, true );
@@ -4087,7 +4200,7 @@ template< class tSubNode >
 tTriangle *tMesh< tSubNode >::
 TriWithEdgePtr( tEdge *edgPtr ) const
 {
-  if(1) std::cout << "tMesh::TriWithEdgePtr\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "tMesh::TriWithEdgePtr" );
   assert( edgPtr != 0 );
   return edgPtr->TriWithEdgePtr();
 }
@@ -4112,7 +4225,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 DeleteTriangle( tTriangle const * triPtr )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "DeleteTriangle(...) " << triPtr->getID() << std::endl;
   //triPtr->TellAll();
   tTriangle triVal;
@@ -4167,7 +4280,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 ExtricateTriangle( tTriangle const *triPtr )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "ExtricateTriangle" << std::endl;
   triListIter_t triIter( triList );
   
@@ -4232,7 +4345,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 RepairMesh( tPtrList< tSubNode > &nbrList )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "RepairMesh: " << std::endl;
   if( nbrList.getSize() < 3 ) return 0;
   nbrList.makeCircular();
@@ -4268,11 +4381,12 @@ RepairMesh( tPtrList< tSubNode > &nbrList )
     //n_iterations++;
     //if( n_iterations > max_iterations )
     //ReportFatalError( "Too many iterations in RepairMesh()" );
-    if(1) std::cout << "in loop, nbr size = " << nbrList.getSize() << std::endl;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "in loop, nbr size = " << nbrList.getSize() );
     //Xflowflag = 1;  // PURPOSE??
     if( Next3Delaunay( nbrList, nbrIter ) ) //checks for ccw and Del.
     {
-      if(1) std::cout << "found 3 Delaun!\n";
+      CHILD_LOG( tLog::kDebug, tLog::kMesh, "found 3 Delaun!" );
       ret = AddEdgeAndMakeTriangle( nbrList, nbrIter );
       assert( ret );
       //remove "closed off" pt
@@ -4292,7 +4406,8 @@ RepairMesh( tPtrList< tSubNode > &nbrList )
   // Determine whether we need to call MakeTriangle or AddEdgeAndMakeTriangle. 
   // We only need to call the latter if the "hole" in the mesh is on the edge
   // and as a result there is a missing edge between two of the remaining points.
-  if(1) std::cout << "Checking whether we need to add a new edge...\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh,
+             "Checking whether we need to add a new edge..." );
   bool new_edge_needed = false;    // assume we don't need to add an edge unless proven otherwise
   tSubNode *cn = nbrIter.FirstP(); // start w/ first node on list of 3
   tSubNode *next_node_ccw = nbrIter.NextP();  // next one counter-clockwise
@@ -4301,7 +4416,8 @@ RepairMesh( tPtrList< tSubNode > &nbrList )
     tEdge *ce = cn->EdgToNod( next_node_ccw );  // find the edge, if any, connecting these
     if( ce==0 )
     {
-      if(1) std::cout << "aha, there's no edge from node " << cn->getID() << " to node " << next_node_ccw->getID() << std::endl;
+      CHILD_LOG( tLog::kDebug, tLog::kMesh,
+                 "aha, there's no edge from node " << cn->getID() << " to node " << next_node_ccw->getID() );
       new_edge_needed = true;
       ret = AddEdgeAndMakeTriangle( nbrList, nbrIter );
       break;
@@ -4312,7 +4428,8 @@ RepairMesh( tPtrList< tSubNode > &nbrList )
   
   if( !new_edge_needed )
   {
-    if(1) std::cout << "all edges seem to be present and accounted for\n";
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "all edges seem to be present and accounted for" );
     ret = MakeTriangle( nbrList, nbrIter );             //make final triangle
   }
                                                              //    if( !ret )
@@ -4320,7 +4437,7 @@ RepairMesh( tPtrList< tSubNode > &nbrList )
                                                              //        assert( cn->getBoundaryFlag() != kNonBoundary );
   assert( ret );
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "done" << std::endl;
   return 1;
 }
@@ -4472,7 +4589,7 @@ int tMesh< tSubNode >::
 AddEdge( tSubNode *node1, tSubNode *node2, tSubNode const *node3 )
 {
   assert( node1 != 0 && node2 != 0 && node3 != 0 );
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddEdge"
 	  << "between nodes " << node1->getID()
 	  << " and " << node2->getID() << " w/ ref to node "
@@ -4579,7 +4696,7 @@ AddEdge( tSubNode *node1, tSubNode *node2, tSubNode const *node3 )
   // Reset edge id's
   ResetEdgeIDIfNecessary();
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddEdge() done\n" << std::flush;
   return 1;
 }
@@ -4601,7 +4718,7 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 AddEdgeAtMeshBoundary( tSubNode *a, tSubNode *b, tSubNode *c, tSubNode *d )
 {
-  if(1)
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     std::cout << "AddEdgeAtMeshBoundary here, about to add a pair of edges ";
     std::cout << "between nodes " << b->getPermID() << " and " << c->getPermID();
@@ -4688,7 +4805,7 @@ AddEdgeAtMeshBoundary( tSubNode *a, tSubNode *b, tSubNode *c, tSubNode *d )
   // Reset edge id's
   ResetEdgeIDIfNecessary();
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddEdge() done\n" << std::flush;
   return 1;
 }
@@ -4717,7 +4834,7 @@ int tMesh< tSubNode >::
 AddEdgeAndMakeTriangle( tPtrList< tSubNode > & /*nbrList*/,
                        tPtrListIter< tSubNode > &nbrIter )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddEdgeAndMakeTriangle 1" << std::endl;
   tSubNode *cn, *cnn, *cnnn;
   cn = nbrIter.DatPtr();
@@ -4731,11 +4848,11 @@ template< class tSubNode >
 int tMesh< tSubNode >::
 AddEdgeAndMakeTriangle( tSubNode* cn, tSubNode* cnn, tSubNode* cnnn )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddEdgeAndMakeTriangle 2" << std::endl;
   if( !AddEdge( cnnn, cn, cnn ) ) return 0;
   if( !MakeTriangle( cn, cnn, cnnn ) ) return 0;
-  if(1) std::cout << "Done with AddEdgeAndMakeTriangle\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "Done with AddEdgeAndMakeTriangle" );
   return 1;
 }
 
@@ -4767,7 +4884,7 @@ int tMesh< tSubNode >::
 MakeTriangle( tPtrList< tSubNode > const &nbrList,
              tPtrListIter< tSubNode > &nbrIter )
 {
-  if(1) std::cout << "MakeTriangle 1\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "MakeTriangle 1" );
   assert( nbrList.getSize() == 3 );
   tSubNode *cn, *cnn, *cnnn;
   cn = nbrIter.FirstP();      // cn, cnn, and cnnn are the 3 nodes in the tri
@@ -4784,7 +4901,7 @@ MakeTriangle( tSubNode *cn, tSubNode *cnn, tSubNode *cnnn )
   assert( cn != 0 && cnn != 0 && cnnn != 0 );
   assert( cn != cnn && cn != cnnn && cnn != cnnn );
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "MakeTriangle 2" << std::endl;
   const tArray< double > p0( cn->get2DCoords() ), p1( cnn->get2DCoords() ),
   p2( cnnn->get2DCoords() );
@@ -4829,7 +4946,8 @@ MakeTriangle( tSubNode *cn, tSubNode *cnn, tSubNode *cnnn )
   {
     // Find edge ce that connects p(j)->p(j+1)
     tEdge *ce = ct->pPtr(j)->EdgToNod( ct->pPtr( (j+1)%3 ) );
-    if(1) std::cout << "in loop j=" << j << " and ce=" << ce << std::endl;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "in loop j=" << j << " and ce=" << ce );
     
     if( nbrtriPtr != 0 && TriWithEdgePtr( ce ) == nbrtriPtr )
     {
@@ -4840,7 +4958,8 @@ MakeTriangle( tSubNode *cn, tSubNode *cnn, tSubNode *cnnn )
     
     // Find the triangle, if any, that shares (points to) this edge
     // and assign it as the neighbor triangle t((j+2)%3).
-    if(1) std::cout << "In MakeTriangle(2) calling TriWithEdgePtr for edge " << ce << std::endl;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "In MakeTriangle(2) calling TriWithEdgePtr for edge " << ce );
     nbrtriPtr = TriWithEdgePtr( ce );
     
     ct->setTPtr( (j+2)%3, nbrtriPtr );      //set tri TRI ptr (j+2)%3
@@ -4875,7 +4994,7 @@ MakeTriangle( tSubNode *cn, tSubNode *cnn, tSubNode *cnnn )
   //we have active and inactive members), but I'm sure it doesn't hurt; better safe
   //than sorry...
   ResetTriangleIDIfNecessary();
-  if(1) std::cout << "End of MakeTriangle 2\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "End of MakeTriangle 2" );
   return 1;
 }
 
@@ -4914,7 +5033,7 @@ AddNode( tSubNode &nodeRef, kUpdateMesh_t updatemesh, double time,
 {
   const tArray< double > xyz( nodeRef.get3DCoords() );
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddNode at " << xyz[0] << ", " << xyz[1]
 	  << ", " << xyz[2] << " time "<<time<<std::endl;
   
@@ -4926,12 +5045,12 @@ AddNode( tSubNode &nodeRef, kUpdateMesh_t updatemesh, double time,
   nodeRef.setPermID( node_ID_generator.getNextID() );
   miNextPermNodeID++;
   
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "call InsertNode" << std::endl;
   tSubNode* newNodePtr = InsertNode(&nodeRef, time);
   if(newNodePtr == 0)
     return 0;
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "call CheckTrianglesAt" << std::endl;
   if( flip == kFlip &&  xyz.getSize() == 3 )
     CheckTrianglesAt( newNodePtr, time );
@@ -4953,7 +5072,7 @@ template< class tSubNode >
 void tMesh< tSubNode >::
 CheckTrianglesAt( tSubNode* nPtr, double time )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "CheckTrianglesAt()"<< std::endl;
   
   tPtrList< tTriangle > triptrList;
@@ -5041,7 +5160,7 @@ MakeDelaunay( tPtrList< tTriangle > &triPtrList, double time )
             if( !NonFlippableEdgeIter.Get( flowEdgeToFlip ) ){
               NonFlippableEdge.insertAtBack(flowEdgeToFlip);
               
-              if (0) //DEBUG
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
                 std::cerr << "MakeDelaunay(): flip could not been done"
                 " between node " << at->pPtr((i+1)%3)->getID()
                 << " and node " << at->pPtr((i+2)%3)->getID() << "."
@@ -5090,7 +5209,7 @@ SplitNonFlippableEdge( tPtrList< tEdge > &NonFlippableEdge, double time ){
     tNode *orig = edg->getOriginPtrNC();
     tNode *dest = edg->getDestinationPtrNC();
     
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       std::cerr << "SplitNonFlippableEdge(): going to split flowedge for node "
       << orig->getID() << " and node "
       << dest->getID() << "." << std::endl;
@@ -5109,14 +5228,14 @@ SplitNonFlippableEdge( tPtrList< tEdge > &NonFlippableEdge, double time ){
     AddedPoints.insertAtBack( newnode );
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cerr << "SplitNonFlippableEdge(): going to flip for new nodes" << std::endl;
   // Now do the flip test around the new nodes
   tSubNode *theNode;
   while( (theNode = AddedPoints.removeFromFront()) != 0 ){
     CheckTrianglesAt( theNode, time );
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cerr << "SplitNonFlippableEdge(): bye bye" << std::endl;
 }
 
@@ -5133,7 +5252,7 @@ template< class tSubNode >
 tSubNode * tMesh< tSubNode >::
 InsertNode( tSubNode* newNodePtr, double time )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "tMesh::InsertNode()" << std::endl;
   
   tTriangle *tri = LocateTriangle( newNodePtr->getX(), newNodePtr->getY() );
@@ -5147,7 +5266,7 @@ InsertNode( tSubNode* newNodePtr, double time )
     return 0;
   }
 
-  if(1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     for( int i=0; i<3; i++ )
     {
@@ -5188,7 +5307,7 @@ AddToList( tSubNode const & newNode )
   // insert node at the back of either the
   // active portion of the node list (if it's not a boundary) or the
   // boundary portion (if it is)
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"AddToList: nnodes="<<nnodes<<std::endl;
   nodeListIter_t nodIter( nodeList );
   tSubNode *cn = 0;
@@ -5206,7 +5325,7 @@ AddToList( tSubNode const & newNode )
       cn = nodIter.LastP();
       break;
   }
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout<<"in AddToList, list size ="<<nodeList.getSize()<<std::endl;
   assert( nodeList.getSize() == nnodes + 1 );
   ++nnodes;
@@ -5260,7 +5379,7 @@ template< class tSubNode >
 tSubNode* tMesh< tSubNode >::
 AttachNode( tSubNode* cn, tTriangle* tri )
 {
-  if(1) std::cout << "AttachNode()\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "AttachNode()" );
   
   assert( tri != 0 && cn != 0 );
   int i;
@@ -5296,8 +5415,9 @@ AttachNode( tSubNode* cn, tTriangle* tri )
                           // If we need to access new coords:
                           //size of xyz is basically the flag; the 4th element is never used o.w.
   {
-    if(1) std::cout << "   in triangle w/ vtcs. at " << p3[0] << " " << p3[1] << "; "
-         << p1[0] << " " << p1[1] << "; " << p4[0] << " " << p4[1] << std::endl;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "   in triangle w/ vtcs. at " << p3[0] << " " << p3[1] << "; "
+               << p1[0] << " " << p1[1] << "; " << p4[0] << " " << p4[1] );
     if( !PointsCCW( p3, p1, p2 ) ||
        !PointsCCW( p2, p1, p4 ) ||
        !PointsCCW( p2, p4, p3 ) )
@@ -5310,7 +5430,7 @@ AttachNode( tSubNode* cn, tTriangle* tri )
   }
   else
   {
-    if(1) std::cout << "In ELSE clause ...\n";
+    CHILD_LOG( tLog::kDebug, tLog::kMesh, "In ELSE clause ..." );
     // use virtual function that will return new coords for nodes
     p1 = node1->FuturePosn();
     p2 = node2->FuturePosn();
@@ -5334,7 +5454,7 @@ AttachNode( tSubNode* cn, tTriangle* tri )
     // ABN and edge pair AN. AEMT is called again to create tri NBC and edge
     // pair CN. With all the edge pairs created, it remains only to call
     // MakeTriangle to create tri NCA.
-    if(1) std::cout << "calling AE, AEMT, AEMT, and MT\n" << std::flush;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh, "calling AE, AEMT, AEMT, and MT" );
     
     AddEdge( node1, node2, node3 );  //add edge between node1 and node2
     AddEdgeAndMakeTriangle( node3, node1, node2 ); // ABN
@@ -5365,7 +5485,7 @@ AttachNode( tSubNode* cn, tTriangle* tri )
     {
       // may be trying to add a node in exact location of another node
       // return a NULL pointer before messing with triangulation
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
         std::cout << "node cannot be added at " << node2->getX() << ", "
         << node2->getY() << std::endl;
       return NULL;
@@ -5401,10 +5521,10 @@ template< class tSubNode >
 tSubNode *tMesh< tSubNode >::
 AddNodeAt( tArray< double > &xyz, double time )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddNodeAt " << xyz[0] << ", " << xyz[1] << ", "
 	  << xyz[2] <<" time "<<time<< std::endl;
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "locate tri" << std::endl;
   tTriangle *tri;
   if( xyz.getSize() == 3 ) tri = LocateTriangle( xyz[0], xyz[1] );
@@ -5413,6 +5533,7 @@ AddNodeAt( tArray< double > &xyz, double time )
     return 0;
   
   tSubNode tempNode;
+  tempNode.setContext( context_ );
   tempNode.set3DCoords( xyz[0], xyz[1], xyz[2]  );
   if( layerflag && time > 0. )
     tempNode.PrepForAddition( tri, time );
@@ -5441,7 +5562,7 @@ AddNodeAt( tArray< double > &xyz, double time )
   
   UpdateMesh();
   
-  if (1)//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "AddNodeAt finished, " << nnodes << std::endl;
   return newNodePtr2;
 }
@@ -5493,7 +5614,8 @@ template <class tSubNode>
 void tMesh<tSubNode>::
 UpdateMesh( bool checkMeshConsistency )
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tMesh::UpdateMesh" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "UpdateMesh()" << std::endl;
   
   edgeListIter_t elist( edgeList );
@@ -5514,12 +5636,12 @@ UpdateMesh( bool checkMeshConsistency )
     curedg = elist.NextP();
     assert( curedg != 0 ); // failure = complementary edges not consecutive
     curedg->setLength( len );
-    if(1) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDetail, tLog::kMesh ) )
       if( elist.IsActive() )
         if( len < minlen ) minlen = len;
   } while( (curedg=elist.NextP()) != NULL);
-  if(1) //DEBUG
-    std::cout << "minimum edge length: " << minlen << " m \n";
+  CHILD_LOG( tLog::kDetail, tLog::kMesh,
+             "minimum edge length: " << minlen << " m" );
   
   setVoronoiVertices();
   CalcVoronoiEdgeLengths();
@@ -5566,7 +5688,7 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
     return FLIP_ERROR;
   }
   assert( nv < 3 );
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "THIS IS CheckForFlip(...) " << tri->getID() << std::endl;
   tSubNode *node0, *node1, *node2, *node3;
   node0 = static_cast< tSubNode * >(tri->pPtr(nv));
@@ -5588,7 +5710,8 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   // coordinates rather than current coordinates
   if( !flip && useFuturePosn)
   {
-    if(1) std::cout << "  Doing flip test based on future position\n";
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "  Doing flip test based on future position" );
     // use virtual function that will return new coords for nodes
     p0 = node0->FuturePosn();
     p1 = node1->FuturePosn();
@@ -5599,12 +5722,13 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   // If p0-p1-p2 passes the test, no flip is necessary
   if( TriPasses( ptest, p0, p1, p2 ) ) return FLIP_NOT_NEEDED;
   
-  if(1) std::cout << "CheckForFlip: case flip needed\n";
+  CHILD_LOG( tLog::kDebug, tLog::kMesh, "CheckForFlip: case flip needed" );
   
   // Now a flip is necessary
   if ( !tri->ePtr( (nv+2)%3)->isFlippable() )
   {
-    if(1) std::cout << "In CheckForFlip, case FLIP_NOT_ALLOWED\n";
+    CHILD_LOG( tLog::kDebug, tLog::kMesh,
+               "In CheckForFlip, case FLIP_NOT_ALLOWED" );
     return FLIP_NOT_ALLOWED;
   }
   
@@ -5615,7 +5739,7 @@ CheckForFlip( tTriangle * tri, int nv, bool flip, bool useFuturePosn )
   {
     if( !PointsCCW( p0, p1, ptest ) || !PointsCCW( p0, ptest, p2 ) )
       return FLIP_ERROR;
-    if(1) std::cout << "calling Flip edge from cff" << std::endl;
+    CHILD_LOG( tLog::kDebug, tLog::kMesh, "calling Flip edge from cff" );
     FlipEdge( tri, triop, nv, nvop );
     return FLIP_DONE;
   }
@@ -5681,7 +5805,7 @@ bool tMesh< tSubNode >::
 FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
          bool useFuturePosn )
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
   {
     std::cout << "FlipEdge(...)..." << std::endl;
     std::cout << " with tri = #" << tri->getID() << " p0=" << tri->pPtr(0)->getID()  << " p1=" << tri->pPtr(1)->getID() << " p2=" << tri->pPtr(2)->getID() << std::endl;
@@ -5703,7 +5827,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
        tEdge::isFlowAllowed(na, nc) != tEdge::isFlowAllowed(nb, nd)
        );
   
-  if (1) {
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
     std::cout << " move=" << move << std::endl;
     std::cout << " na: " << na->getX() << " " << na->getY() << " " << na->getID() << " " << na->getBoundaryFlag() << std::endl;
     std::cout << " nb: " << nb->getX() << " " << nb->getY() << " " << nb->getID() << " " << nb->getBoundaryFlag() << std::endl;
@@ -5735,7 +5859,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
   {
     if( edg->FlowAllowed() )
     {
-      if (1) std::cout << " case flow allowed\n";
+      CHILD_LOG( tLog::kDebug, tLog::kMesh, " case flow allowed" );
       edgeList.moveToActiveBack( enodePtr1 );
       edgeList.setNActiveNodes(edgeList.getActiveSize()+1);
       edgeList.moveToActiveBack( enodePtr2 );
@@ -5743,7 +5867,7 @@ FlipEdge( tTriangle * tri, tTriangle * triop ,int nv, int nvop,
     }
     else
     {
-      if (1) std::cout << " case flow not allowed\n";
+      CHILD_LOG( tLog::kDebug, tLog::kMesh, " case flow not allowed" );
       edgeList.moveToBack( enodePtr1 );
       edgeList.setNActiveNodes(edgeList.getActiveSize()-1);
       edgeList.moveToBack( enodePtr2 );
@@ -5800,7 +5924,7 @@ template< class tSubNode >
 void tMesh< tSubNode >::
 CheckLocallyDelaunay( double time )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "CheckLocallyDelaunay()" << std::endl;
   tPtrList< tTriangle > triPtrList;
   
@@ -5872,7 +5996,7 @@ template< class tSubNode >
 void tMesh< tSubNode >::
 CheckTriEdgeIntersect()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "CheckTriEdgeIntersect()..." << std::endl;
   //DumpNodes();
   int i, j, nv, nvopp;
@@ -5911,7 +6035,7 @@ CheckTriEdgeIntersect()
     for( ct = tpIter.FirstP(); !(triptrList.isEmpty());
         ct = triptrList.removeFromFront(), ct = tpIter.FirstP() )
     {
-      if(0) {
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
         std::cout << "Tri " << ct->getID() << " with verts ";
         for( int debug_ctr=0; debug_ctr<3; debug_ctr++ )
           std::cout << ct->pPtr(debug_ctr)->getX() << "," << ct->pPtr(debug_ctr)->getY() << " ";
@@ -5921,13 +6045,13 @@ CheckTriEdgeIntersect()
       //         <<ct->e[0]->id<<", "<<ct->e[1]->id<<", "<<ct->e[2]->id<<std::endl;
       if( !NewTriCCW( ct ) )
       {
-        if(0) std::cout << "NewTriCCW says false\n";
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) std::cout << "NewTriCCW says false\n";
         flipped = true;
         for( i=0, j=0; i<3; i++ )
         {
           if( ct->pPtr(i)->getBoundaryFlag() != kNonBoundary ) j++;
         }
-        if(1) {
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
           std::cout << " It has " << j << " boundary verts.\n";
         }
         if( j > 1 )
@@ -5943,7 +6067,7 @@ CheckTriEdgeIntersect()
         }
         else
         {
-          if(0) std::cout << "In else clause\n";
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) std::cout << "In else clause\n";
           crossed = false;
           bool no_edge = true;
           bool useFuturePosn = false;
@@ -5988,7 +6112,7 @@ CheckTriEdgeIntersect()
                     }
                     nv = ct->nVOp( ctop );
                     nvopp = ctop->nVOp( ct );
-                    if (0) //DEBUG
+                    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
                       std::cout << "call FlipEdge from CTEI for edge between nodes "
                       << ct->pPtr( (nv+1)%3 )->getID() << " and "
                       << ct->pPtr( (nv+2)%3 )->getID() << std::endl;
@@ -6030,7 +6154,7 @@ CheckTriEdgeIntersect()
                   }
                 }
                 //delete the node;
-                if (0) {//DEBUG
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
                   const tArray<double> xyz = cn->getNew3DCoords();
                   std::cout << "delete node at " << xyz[0] << ", " << xyz[1]
                   << ", " << xyz[2] << std::endl;
@@ -6038,7 +6162,7 @@ CheckTriEdgeIntersect()
                 tmpNodeList.insertAtBack( *cn );
                 
                 //DEBUG-QC
-                if (0) //DEBUG
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
                   std::cout<<"CTI, deleting node with ID,x,y,z:"
                   << cn->getID()<<" "<<cn->getX()
                   <<" "<<cn->getY()<<" "<<cn->getZ()<<std::endl;
@@ -6067,7 +6191,7 @@ CheckTriEdgeIntersect()
     else
       cn->RevertToOldCoords();
     //DEBUG-QC
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
       std::cout<<"CTI, adding node with x,y,z:"
 	    <<cn->getX()<<" "<<cn->getY()<<" "<<cn->getZ()<<std::endl;
     
@@ -6122,7 +6246,8 @@ template< class tSubNode >
 void tMesh< tSubNode >::
 MoveNodes( double time, bool interpFlag )
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tMesh::MoveNodes" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "MoveNodes()... time " << time << std::endl;
   
   //Before any edges and triangles are changed, layer interpolation
@@ -6149,7 +6274,7 @@ MoveNodes( double time, bool interpFlag )
   CheckLocallyDelaunay( time );
   UpdateMesh(false);
   CheckMeshConsistency();  // TODO: remove this debugging call for release
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "MoveNodes() finished" << std::endl;
 }
 
@@ -6692,7 +6817,7 @@ template<class tSubNode>
 void tMesh<tSubNode>::
 ForceFlow( tSubNode* un, tSubNode* dn, double time )
 {
-  if(0)//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
     std::cout << "tMesh::ForceFlow connecting nodes" << un->getID()
     << " and " << dn->getID() << std::endl;
   
@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include "../Classes.h"
@@ -152,9 +153,10 @@ public:
    typedef tIdArray< tEdge, tListNodeListable< tEdge > > tIdArrayEdge_t;
    typedef tIdArray< tTriangle, tListNodeListable< tTriangle > > tIdArrayTri_t;
 
-   tMesh( const tInputFile &, bool checkMeshConsistency );
-   tMesh( tMesh const * );
-  tMesh( tArray<double> &, tArray<double> &, tArray<double> &  );
+   tMesh( const tInputFile &, bool checkMeshConsistency, tModelContext * );
+   tMesh( tMesh const *, tModelContext * );
+  tMesh( tArray<double> &, tArray<double> &, tArray<double> &,
+         tModelContext * = 0 );
    ~tMesh();
    void BatchAddNodes(); // quickly adds many nodes when starting w/ dense mesh
   void RemovePointDuplicates( tSubNode &, tList<double> &, tList<double> &, 
@@ -164,7 +166,7 @@ public:
    void MakeMeshFromInputData( const tInputFile & ); // reads in an existing mesh
    void MakeMeshFromPoints( const tInputFile & );    // creates mesh from list of pts
    void MakeMeshFromPointsTipper( const tInputFile & ); // creates mesh from list of pts
-   void MakeRandomPointsFromArcGrid( const tInputFile & ); // mesh from arc (rand)
+   void MakeRandomPointsFromArcGrid( const tInputFile &, tRand & ); // mesh from arc (rand)
    void MakeHexMeshFromArcGrid( const tInputFile & );// mesh from arc (hex)
   void MakeMeshFromPointTilesAndArcGridMask( const tInputFile &, tRand & );
   void ConvertToOpenBoundary( tSubNode * );
@@ -221,6 +223,7 @@ public:
    edgeList_t * getEdgeList() { return &edgeList; }
    nodeList_t * getNodeList() { return &nodeList; }
    triList_t * getTriList() { return &triList; }
+   tModelContext * getContext() const { return context_; }
    tEdge *getEdgeComplement( tEdge * ) const;
    /* Tests consistency of a user-defined mesh */
    void CheckMeshConsistency( bool boundaryCheckFlag=true );
@@ -291,6 +294,7 @@ protected:
    bool layerflag;                 // flag indicating whether nodes have layers
    bool runCheckMeshConsistency;    // shall we run the tests ?
    tIDGenerator node_ID_generator;  // generates permanent IDs for nodes
+   tModelContext *context_;  // per-model parameters shared by all nodes
 
 };
 
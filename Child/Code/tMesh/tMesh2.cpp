@@ -117,7 +117,7 @@ MakeMeshFromPointsTipper( const tInputFile &infile ){
       ReportFatalError( "Error reading points file: check the file format." );
     }
     // temporary node used to create node list (creation is costly)
-    const tSubNode aNode( infile );
+    const tSubNode aNode( infile, context_ );
     //Read point file, make Nodelist
     for( int i=0; i<numpts; i++ ){
       double x, y, z;
@@ -199,7 +199,7 @@ BuildDelaunayMeshTipper( kUpdateMesh_t updateFlag /*= kUpdateMesh*/ )
        ++inode;
      }
 
-     if (0) { // DEBUG
+     if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
        for (int i=0; i<nnodes; ++i){
 	 std::cout << i << " x=" << p[i].x() << " y=" << p[i].y() << std::endl;
        }
@@ -222,7 +222,7 @@ BuildDelaunayMeshTipper( kUpdateMesh_t updateFlag /*= kUpdateMesh*/ )
 
    std::cout << "done.\n";
 
-   if (0) { // DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
      std::cout << "After sort_triangulate:\n";
      for( int iedge=0; iedge < nedgesl; ++iedge) {
        std::cout << "edge " << 2*iedge
@@ -260,7 +260,7 @@ BuildDelaunayMeshTipper( kUpdateMesh_t updateFlag /*= kUpdateMesh*/ )
 	 // insert edge pair onto the list --- active
 	 // part of list if flow is allowed, inactive if not
 
-	 if (0) //DEBUG
+	 if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	   std::cout << "Setting edges " << tempedge1.getID() << " and "
 		     << tempedge2.getID() <<
 	     (tempedge1.FlowAllowed() ? " as OPEN" : " as no-flux")
@@ -348,9 +348,9 @@ BuildDelaunayMeshTipper( kUpdateMesh_t updateFlag /*= kUpdateMesh*/ )
      {
        int ielem;
        for ( ielem=0; ielem<nelem; ++ielem ) {
-	 if (0) // DEBUG
+	 if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
 	   std::cout << "TRI " << ielem << std::endl << std::flush;
-	 if (0) { // DEBUG
+	 if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) ) {
 	   std::cout << "p0=" << p[elems[ielem].p1].id() << " "
 		<< "(" << p[elems[ielem].p1].x()
 		<< "," << p[elems[ielem].p1].y() << "), "
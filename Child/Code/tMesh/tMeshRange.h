@@ -0,0 +1,152 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tMeshRange.h
+**
+**  @brief Parallel loops over the nodes and edges of a tMesh.
+**
+**  The mesh lists are linked lists, which threads cannot share out. A
+**  tMeshRange is a snapshot of a list (by default its active part) as an
+**  array of pointers, in list order, so that a tThreadPool can cut it
+**  into chunks:
+**
+**    tMeshRange< tLNode > nodes( mesh->getNodeList() );
+**    ParallelFor( ThreadPoolOf( mesh ), nodes, body );
+**
+**  calls body( node ) for every active node, and
+**
+**    double total = ParallelReduce( ThreadPoolOf( mesh ), nodes, body, 0. );
+**
+**  calls body( node, acc ) for every active node and combines the
+**  per-chunk accumulators with body.Join( total, acc ), in list order,
+**  so that the result does not depend on the number of threads (see
+**  tThreadPool.h).
+**
+**  A snapshot stays valid until nodes or edges are added, deleted or
+**  reordered in the list (e.g., by tMesh::UpdateMesh, or moving a node
+**  to the boundary part of the list); it may be used for any number of
+**  loops until then. The body must only change the element it is given
+**  (and data no other element's call touches).
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TMESHRANGE_H
+#define TMESHRANGE_H
+
+#include <vector>
+#include "../tMeshList/tMeshList.h"
+#include "../tThreadPool/tThreadPool.h"
+#include "../tModelContext/tModelContext.h"
+
+/**************************************************************************/
+/**
+**  Class tMeshRange
+**
+**  Snapshot of the active part of a mesh list, or of the whole list.
+*/
+/**************************************************************************/
+template< class T >
+class tMeshRange
+{
+public:
+  typedef tMeshList< T, tListNodeListable< T > > list_t;
+  typedef tMeshListIter< T, tListNodeListable< T > > iter_t;
+
+  explicit tMeshRange( list_t *list, bool activeOnly = true )
+  {
+    items_.reserve( activeOnly ? list->getActiveSize() : list->getSize() );
+    iter_t iter( list );
+    for( T *item = iter.FirstP(); !iter.AtEnd(); item = iter.NextP() )
+    {
+      if( activeOnly && !iter.IsActive() )
+	break;
+      items_.push_back( item );
+    }
+  }
+
+  long size() const { return static_cast<long>(items_.size()); }
+  T *operator[]( long i ) const { return items_[i]; }
+
+private:
+  std::vector< T * > items_;
+};
+
+/**************************************************************************/
+/**
+**  ThreadPoolOf
+**
+**  The pool of the model a mesh belongs to, or a serial pool if the mesh
+**  has no model context.
+*/
+/**************************************************************************/
+template< class tMesh_t >
+inline tThreadPool &ThreadPoolOf( const tMesh_t *mesh )
+{
+  tModelContext *context = mesh->getContext();
+  return context ? context->threadPool : tThreadPool::Serial();
+}
+
+/**************************************************************************/
+/**
+**  ParallelFor, ParallelReduce over a tMeshRange
+*/
+/**************************************************************************/
+template< class T, class Body >
+class tMeshForBody
+{
+public:
+  tMeshForBody( const tMeshRange< T > &range, const Body &body )
+    : range_(range), body_(body) {}
+  void operator()( long begin, long end ) const
+  {
+    for( long i=begin; i<end; ++i )
+      body_( range_[i] );
+  }
+private:
+  const tMeshRange< T > &range_;
+  const Body &body_;
+};
+
+template< class T, class R, class Body >
+class tMeshReduceBody
+{
+public:
+  tMeshReduceBody( const tMeshRange< T > &range, const Body &body )
+    : range_(range), body_(body) {}
+  void operator()( long begin, long end, R &acc ) const
+  {
+    for( long i=begin; i<end; ++i )
+      body_( range_[i], acc );
+  }
+  void Join( R &total, const R &acc ) const { body_.Join( total, acc ); }
+private:
+  const tMeshRange< T > &range_;
+  const Body &body_;
+};
+
+template< class T, class Body >
+inline void ParallelFor( tThreadPool &pool, const tMeshRange< T > &range,
+			 const Body &body )
+{
+  pool.ParallelFor( range.size(), tMeshForBody< T, Body >( range, body ) );
+}
+
+template< class T, class R, class Body >
+inline R ParallelReduce( tThreadPool &pool, const tMeshRange< T > &range,
+			 const Body &body, const R &identity )
+{
+  return pool.ParallelReduce( range.size(),
+			      tMeshReduceBody< T, R, Body >( range, body ),
+			      identity );
+}
+
+#endif
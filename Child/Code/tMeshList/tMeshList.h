@@ -39,6 +39,7 @@
 
 #include "../Classes.h"
 #include "../tList/tList.h"
+#include "../tLog/tLog.h"
 #include <assert.h>
 
 /**************************************************************************/
@@ -378,7 +379,7 @@ template< class NodeType, class ListNodeType >
 void tMeshList< NodeType, ListNodeType >::
 moveToBack( ListNodeType * mvnode )
 {
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMesh ) )
      std::cout << "moveToBack( ListNodeType )\n";
 
    assert( mvnode!=0 );
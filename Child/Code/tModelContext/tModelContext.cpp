@@ -0,0 +1,96 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tModelContext.cpp
+**
+**  @brief Implementation of the tModelContext class.
+**
+**  A tModelContext holds per-model configuration formerly kept in static
+**  data members of tNode, tLNode and tStratNode. See tModelContext.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <string.h>
+#include <assert.h>
+#include "tModelContext.h"
+#include "../Definitions.h"
+#include "../errors/errors.h"
+#include "../tInputFile/tInputFile.h"
+
+/**************************************************************************/
+/**
+**  Basic constructor
+**
+**  Uses the same defaults as the former static initializers in tLNode,
+**  tStratNode and tNode.
+*/
+/**************************************************************************/
+tModelContext::
+tModelContext()
+  : numg(0), grade(1), maxregdep(1.), KRnew(1.0),
+    new_sed_bulk_density_(kDefaultSoilBulkDensity),
+    sg_numg(0), sg_grade(1), sg_maxregdep(1.), sg_KRnew(1.0),
+    freezeElevations(false),
+    trackVolume(false), volumeValid(false), volume(0.), volumeArea(0.),
+    zDatum(0.), vegetation(0)
+{}
+
+/**************************************************************************/
+/**
+**  InitializeFromInputFile
+**
+**  Reads the grain-size and layering parameters shared by all nodes of
+**  the mesh, and the option to freeze elevations. These used to be read
+**  (again and again) by every tLNode( infile ) constructor call. Also
+**  sets the number of threads of the model's pool (NUM_THREADS).
+*/
+/**************************************************************************/
+void tModelContext::
+InitializeFromInputFile( const tInputFile &infile )
+{
+  char add[2], name[20];
+  double help;
+
+  {
+    int tmp_;
+    tmp_ = infile.ReadItem( tmp_, "NUMGRNSIZE" );
+    assert(tmp_ >= 0);
+    numg = tmp_;
+  }
+  grade.setSize( numg );
+  maxregdep = infile.ReadItem( maxregdep, "MAXREGDEPTH" );
+  KRnew = infile.ReadItem( KRnew, "KR" );
+  if( KRnew<0.0 )
+    ReportFatalError( "Erodibility factor KR must be positive." );
+  new_sed_bulk_density_ = infile.ReadDouble( "SOILBULKDENSITY", false );
+  if( new_sed_bulk_density_<=0.0 ) new_sed_bulk_density_ = kDefaultSoilBulkDensity;
+
+  size_t i = 0;
+  add[0]='1';
+  add[1]='\0';
+  while ( i<numg ){
+    // Reading in grain size diameter info
+    strcpy( name, "GRAINDIAM");
+    strcat( name, add );
+    help = infile.ReadItem( help, name);
+    grade[i] = help;
+    i++;
+    add[0]++;
+  }
+
+  // boolean to enable running model without changing elevations:
+  freezeElevations = infile.ReadBool( "OPT_FREEZE_ELEVATIONS", false );
+
+  // threads for parallel loops over the mesh:
+  if( infile.Contain( "NUM_THREADS" ) )
+    threadPool.SetThreads( infile.ReadInt( "NUM_THREADS" ) );
+}
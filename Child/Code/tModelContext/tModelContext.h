@@ -0,0 +1,105 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tModelContext.h
+**
+**  @brief Header file for the tModelContext class.
+**
+**  A tModelContext holds the configuration that used to live in static
+**  data members and globals: the grain-size and layering parameters
+**  formerly kept as statics in tLNode and tStratNode, and the option to
+**  freeze elevations formerly kept as a static in tNode. It also owns the
+**  model's thread pool, shared by every parallel loop over its mesh.
+**
+**  Each model (e.g., each childInterface) owns one tModelContext, and
+**  every node in that model's mesh keeps a pointer to it. Two models in
+**  the same process therefore no longer share (and overwrite) each
+**  other's parameters, and can run on separate threads.
+**
+**  Note that the robust geometric predicates object (see predicates.h)
+**  is not part of the context: it holds only round-off error bounds
+**  computed once at construction, and so a single read-only instance
+**  can be safely shared by every model.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TMODELCONTEXT_H
+#define TMODELCONTEXT_H
+
+#include <stddef.h>
+#include "../tArray/tArray.h"
+#include "../tThreadPool/tThreadPool.h"
+
+class tInputFile;
+class tVegetation;
+
+class tModelContext
+{
+public:
+
+  // Constructor for basic initialization (one grain size, no freezing)
+  tModelContext();
+
+  // Read the per-model node parameters from the input file
+  void InitializeFromInputFile( const tInputFile &infile );
+
+  // Layering parameters for mesh nodes (formerly static in tLNode)
+  size_t numg;                   // number of grain sizes
+  tArray< double > grade;        // diameter of each grain size class
+  double maxregdep;              // thickness of the active (surface) layer
+  double KRnew;                  // erodibility of newly deposited sediment
+  double new_sed_bulk_density_;  // bulk density of newly deposited sediment
+
+  // Layering parameters for stratigraphy grid nodes (formerly static in
+  // tStratNode; set by tStratNode's input-file constructor)
+  int sg_numg;
+  tArray< double > sg_grade;
+  double sg_maxregdep;
+  double sg_KRnew;
+
+  // Option for running model without changing elevations (formerly
+  // static in tNode)
+  bool freezeElevations;
+
+  // Running total of elevation times Voronoi area over the interior
+  // nodes, kept up to date by tNode::setZ and tNode::ChangeZ while
+  // trackVolume is set, so that the mean elevation can be had without a
+  // pass over the mesh (see tEquilibCheck). Changing a node's area or
+  // boundary flag clears volumeValid; the total must then be recomputed
+  // (with volumeArea, the total area) by a pass over the mesh. While
+  // tracking, elevations must not be changed from several threads at
+  // once.
+  bool trackVolume;
+  bool volumeValid;
+  double volume;
+  double volumeArea;
+
+  // Uniform uplift of the interior not yet applied to the nodes (lazy
+  // uniform uplift, see tUplift::UpliftUniform): the boundary nodes are
+  // lowered instead, so that slopes are unchanged, and a node's actual
+  // elevation is its z plus zDatum until tUplift::ApplyPendingUplift
+  // brings the nodes up to date.
+  double zDatum;
+
+  // The model's vegetation, when its nodes' simple cover regrows lazily
+  // (see tVegetation::AttachToMesh), or 0. tLNode::RegrowVegCover then
+  // brings a node's cover and critical shear stress up to date; it
+  // changes only the node it is called on.
+  const tVegetation *vegetation;
+
+  // Threads for parallel loops over the mesh (keyword NUM_THREADS,
+  // default 1; see tThreadPool.h and tMesh/tMeshRange.h). A copy of the
+  // context gets its own pool with the same number of threads.
+  tThreadPool threadPool;
+};
+
+#endif
@@ -0,0 +1,115 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tNodeFields.cpp
+**
+**  @brief Functions for tNodeFields. See tNodeFields.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tNodeFields.h"
+#include "../tMesh/tMesh.h"
+#include "../tMesh/tMeshRange.h"
+#include "../tLNode/tLNode.h"
+
+namespace
+{
+  // Copies one field of a node to its slot in the array
+  class tGetBody
+  {
+  public:
+    tGetBody( tNodeFields::tField field, double *values ) :
+      field_(field), values_(values) {}
+    void operator()( tLNode *cn ) const
+    {
+      double &value = values_[cn->getPermID()];
+      switch( field_ )
+      {
+	case tNodeFields::kX:
+	  value = cn->getX();
+	  break;
+	case tNodeFields::kY:
+	  value = cn->getY();
+	  break;
+	case tNodeFields::kElevation:
+	  value = cn->getZ();
+	  break;
+	case tNodeFields::kErosion:
+	  value = cn->getCumulativeEroDep();
+	  cn->ResetCumulativeEroDep();
+	  break;
+	case tNodeFields::kDischarge:
+	  value = cn->getQ();
+	  break;
+	case tNodeFields::kSedimentFlux:
+	  value = cn->getQs();
+	  break;
+	default:
+	  value = 0.;
+      }
+    }
+  private:
+    const tNodeFields::tField field_;
+    double *values_;
+  };
+}
+
+tNodeFields::tField tNodeFields::Find( const std::string &name )
+{
+  if( name.compare( 0,4,"elev" )==0 )
+    return kElevation;
+  if( name.compare( 0,1,"x" )==0 || name.compare( 0,5,"nodex" )==0 )
+    return kX;
+  if( name.compare( 0,1,"y" )==0 || name.compare( 0,5,"nodey" )==0 )
+    return kY;
+  if( name.compare( 0,2,"dz" )==0 || name.compare( 0,3,"ero" )==0 )
+    return kErosion;
+  if( name.compare( 0,5,"disch" )==0 || name.compare( 0,5,"water" )==0 )
+    return kDischarge;
+  if( name.compare( 0,3,"sed" )==0 )
+    return kSedimentFlux;
+  return kUnknown;
+}
+
+long tNodeFields::Size( tMesh< tLNode > *mesh )
+{
+  return mesh->getNodeList()->getSize();
+}
+
+void tNodeFields::Get( tMesh< tLNode > *mesh, tField field, double *values )
+{
+  tMeshRange< tLNode > nodes( mesh->getNodeList(), false );
+  ParallelFor( ThreadPoolOf( mesh ), nodes, tGetBody( field, values ) );
+}
+
+void tNodeFields::SetElevations( tMesh< tLNode > *mesh, const double *z )
+{
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn=ni.FirstP(); !ni.AtEnd(); cn=ni.NextP() )
+    cn->setZ( z[cn->getPermID()] );
+}
+
+void tNodeFields::ErodeDeposit( tMesh< tLNode > *mesh, const double *dz )
+{
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
+    cn->EroDep( dz[cn->getPermID()] );
+}
+
+void tNodeFields::AdjustElevations( tMesh< tLNode > *mesh, const double *dz,
+				    bool interiorOnly )
+{
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn=ni.FirstP();
+       interiorOnly ? ni.IsActive() : !ni.AtEnd(); cn=ni.NextP() )
+    cn->ChangeZ( dz[cn->getPermID()] );
+}
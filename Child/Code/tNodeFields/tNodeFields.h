@@ -0,0 +1,81 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tNodeFields.h
+**
+**  @brief Header file for tNodeFields, whole-field transfer of node
+**         values between a mesh and a caller's array.
+**
+**  A field is one value per node, in order of permanent ID (0 to N-1,
+**  N being the number of nodes, boundary nodes included), held in a
+**  contiguous array the caller owns. Get fills such an array in one
+**  pass over the nodes, in parallel on the model's thread pool (see
+**  tThreadPool), and the setters apply one in one pass. childInterface
+**  (GetValueSet, SetValueSet) and childRInterface (GetValues, SetValues,
+**  which write straight into preallocated R numeric vectors) both go
+**  through these functions, so a field costs a single copy however it
+**  is fetched.
+**
+**  The setters run serially, because changing an elevation updates the
+**  model's volume tally (see tModelContext).
+**
+**  Elevations are read as they stand: callers using lazy uplift (see
+**  tUplift) should apply it first.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TNODEFIELDS_H
+#define TNODEFIELDS_H
+
+#include <string>
+
+class tLNode;
+template< class tSubNode > class tMesh;
+
+/**************************************************************************/
+/**
+**  Class tNodeFields
+*/
+/**************************************************************************/
+class tNodeFields
+{
+public:
+  enum tField
+  {
+    kUnknown = -1,
+    kX,
+    kY,
+    kElevation,
+    kErosion,       // cumulative erosion/deposition; reset when read
+    kDischarge,     // of the most recent storm
+    kSedimentFlux   // water-borne, of the most recent storm
+  };
+
+  // The field a name refers to ("elev", "x", "dz", "disch", ... as
+  // accepted by childInterface::GetValueSet), or kUnknown
+  static tField Find( const std::string &name );
+  // Number of values in a field (the number of nodes)
+  static long Size( tMesh< tLNode > * );
+
+  // Copies a field into values[0..Size-1]
+  static void Get( tMesh< tLNode > *, tField, double *values );
+  // Sets the elevation of every node
+  static void SetElevations( tMesh< tLNode > *, const double *z );
+  // Erodes (dz<0) or deposits (dz>0) at every interior node
+  static void ErodeDeposit( tMesh< tLNode > *, const double *dz );
+  // Changes elevations without changing the layers, at every node or
+  // only at interior nodes
+  static void AdjustElevations( tMesh< tLNode > *, const double *dz,
+				bool interiorOnly );
+};
+
+#endif
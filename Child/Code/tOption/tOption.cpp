@@ -20,6 +20,7 @@
 tOption::tOption(int argc, char const * const argv[])
   : exeName(argv[0]),
     silent_mode(false), checkMeshConsistency(true), no_write_mode(false), 
+    profile(false), profile_trace(false),
     inputFile(0)
 {
   argv++;
@@ -37,6 +38,7 @@ tOption::tOption(int argc, char const * const argv[])
 tOption::tOption(string arguments)
 : exeName("child"),
 silent_mode(false), checkMeshConsistency(true), no_write_mode(false), 
+profile(false), profile_trace(false),
 inputFile(0)
 {
   ProcessOptionsFromString( arguments );
@@ -45,6 +47,7 @@ inputFile(0)
 tOption::tOption(const char * args)
 : exeName("child"),
 silent_mode(false), checkMeshConsistency(true), no_write_mode(false), 
+profile(false), profile_trace(false),
 inputFile(0)
 {
   string arg_string( args );
@@ -81,6 +84,14 @@ int tOption::parseOptions(char const * const argv[]) {
     checkMeshConsistency = false;
     return 1;
   }
+  if (strcmp(thisOption, "--profile") == 0){
+    profile = true;
+    return 1;
+  }
+  if (strcmp(thisOption, "--profile-trace") == 0){
+    profile = profile_trace = true;
+    return 1;
+  }
   if (strcmp(thisOption, "--help") == 0){
     usage();
     exit(EXIT_SUCCESS);
@@ -117,6 +128,14 @@ int tOption::parseOptions(string thisOption) {
     checkMeshConsistency = false;
     return 1;
   }
+  if (thisOption.compare("--profile") == 0){
+    profile = true;
+    return 1;
+  }
+  if (thisOption.compare("--profile-trace") == 0){
+    profile = profile_trace = true;
+    return 1;
+  }
   if (thisOption.compare("--help") == 0){
     usage();
     exit(EXIT_SUCCESS);
@@ -146,6 +165,9 @@ void tOption::usage() const {
     << " --no-check: disable CheckMeshConsistency().\n"
     << " --silent-mode: silent mode.\n"
     << " --no-write-mode: no writing to output.\n"
+    << " --profile: write a timing report to <OUTFILENAME>.profile.\n"
+    << " --profile-trace: --profile, plus a per-storm Chrome trace\n"
+    << "   in <OUTFILENAME>.trace.json.\n"
     << " --version: display version.\n"
     << std::endl;
 }
@@ -27,6 +27,8 @@ public:
   bool silent_mode;      // Option for silent mode (no time output to stdout)
   bool checkMeshConsistency;
   bool no_write_mode; // option to force no writing to files
+  bool profile;       // option to time the main loop (see tProfiler)
+  bool profile_trace; // ... and also write a per-storm trace
   char const *inputFile;
 
   tOption(int argc, char const * const argv[]);
@@ -32,6 +32,8 @@
 #include "../tStreamNet/tStreamNet.h" // For k2DKinematicWave and kHydrographPeakMethod
 #include "../tStratGrid/tStratGrid.h"
 #include "../tFloodplain/tFloodplain.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
 
 
 /**************************************************************************/
@@ -242,6 +244,7 @@ tOutput<tSubNode>::tOutput( tMesh<tSubNode> * meshPtr,
 template< class tSubNode >
 void tOutput<tSubNode>::WriteOutput( double time )
 {
+  tProfileScope scope( "tOutput::WriteOutput" );
   typename tMesh< tSubNode >::nodeListIter_t niter( this->m->getNodeList() ); // node list iterator
   typename tMesh< tSubNode >::edgeListIter_t eiter( this->m->getEdgeList() ); // edge list iterator
   typename tMesh< tSubNode >::triListIter_t titer( this->m->getTriList() );   // tri list iterator
@@ -249,8 +252,8 @@ void tOutput<tSubNode>::WriteOutput( double time )
   const int nedges = this->m->getEdgeList()->getSize();  // "    edges "
   const int ntri = this->m->getTriList()->getSize();     // "    triangles "
 
-  if(1)//DEBUG
-    std::cout << "tOutput::WriteOutput() time=" << time << std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput,
+             "tOutput::WriteOutput() time=" << time );
 
   // Renumber IDs in order by position on list
   if (!CanonicalNumbering)
@@ -258,8 +261,7 @@ void tOutput<tSubNode>::WriteOutput( double time )
   else
     this->m->RenumberIDCanonically();
 
-  if(1)//DEBUG
-    std::cout << "tOutput::WriteOutput() loc 1" << std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput, "tOutput::WriteOutput() loc 1" );
   
   // Write node file, z file, and varea file
   this->WriteTimeNumberElements( nodeofs, time, nnodes);
@@ -275,8 +277,7 @@ void tOutput<tSubNode>::WriteOutput( double time )
       WriteNodeRecord( RNode[i] );
   }
 
-  if(1)//DEBUG
-    std::cout << "tOutput::WriteOutput() loc 2" << std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput, "tOutput::WriteOutput() loc 2" );
   
   // Write edge file
   this->WriteTimeNumberElements( edgofs, time, nedges);
@@ -290,8 +291,7 @@ void tOutput<tSubNode>::WriteOutput( double time )
       WriteEdgeRecord( REdge[i] );
   }
 
-  if(1)//DEBUG
-    std::cout << "tOutput::WriteOutput() loc 3" << std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput, "tOutput::WriteOutput() loc 3" );
   
   // Write triangle file
   this->WriteTimeNumberElements( triofs, time, ntri);
@@ -316,8 +316,8 @@ void tOutput<tSubNode>::WriteOutput( double time )
   // Call virtual function to write any additional data
   WriteNodeData( time );
 
-  if (1)//DEBUG
-    std::cout << "tOutput::WriteOutput() Output done" << std::endl;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput,
+             "tOutput::WriteOutput() Output done" );
 }
 
 /*************************************************************************\
@@ -487,8 +487,7 @@ tLOutput<tSubNode>::~tLOutput()
 template< class tSubNode >
 void tLOutput<tSubNode>::WriteNodeData( double time )
 {
-  if(1)//DEBUG
-    std::cout << "tLOutput::WriteNodeData 1\n" << std::flush;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput, "tLOutput::WriteNodeData 1" );
   
   //for writing out layer info to different files at each time
   const char* const nums("0123456789");
@@ -564,8 +563,7 @@ void tLOutput<tSubNode>::WriteNodeData( double time )
   if( publicflagofs.good() )
     this->WriteTimeNumberElements( publicflagofs, time, nnodes );
 
-  if(1)//DEBUG
-    std::cout << "tLOutput::WriteNodeData 2\n" << std::flush;
+  CHILD_LOG( tLog::kDetail, tLog::kOutput, "tLOutput::WriteNodeData 2" );
   
   // Write Random number generator state
   rand->dumpToFile( randomofs );
@@ -628,6 +626,7 @@ void tLOutput<tSubNode>::WriteNodeData( double time )
 template< class tSubNode >
 void tLOutput<tSubNode>::WriteTSOutput()
 {
+  tProfileScope scope( "tOutput::WriteTSOutput" );
   if (TSOutput) TSOutput->WriteTSOutput();
 }
 
@@ -692,7 +691,7 @@ void tTSOutputImp<tSubNode>::WriteTSOutput()
     area = 0.,
     cover = 0.;
 
-  if (0)//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kOutput ) )
     std::cout << "tTSOutputImp::WriteTSOutput()" << std::endl;
 
   for( cn=niter.FirstP(); !(niter.AtEnd()); cn=niter.NextP() ) {
@@ -709,7 +708,10 @@ void tTSOutputImp<tSubNode>::WriteTSOutput()
   if( vegcovofs.good() ) 
     {
       for( cn = niter.FirstP(); !(niter.AtEnd()); cn=niter.NextP() )
-	cover += cn->getVegCover().getVeg()*cn->getVArea();
+	{
+	  cn->RegrowVegCover();  // lazy regrowth (see tVegetation.h)
+	  cover += cn->getVegCover().getVeg()*cn->getVArea();
+	}
       vegcovofs << cover/area << std::endl;
     }
 }
@@ -1561,7 +1563,7 @@ void tStratOutputImp<tSubNode>::WritePreservationPotential(double time,
       subsurface_preservation_mbelt<<' '<<subsurface_mbelt[ts]*50.0*50.0<<'\n';
 
   }
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kOutput ) )
     std::cout << "Output::Finished writing Preservation potential of fluvial units..." << '\n';
 } //Presevation potential
 
@@ -327,7 +327,11 @@ inline void tLOutput<tSubNode>::WriteAllNodeData( tSubNode *cn )
     std::cout << "WriteAllNodeData 2\n" << std::flush;
   
   qofs << cn->getQ() << '\n';
-  if( vegofs.good() ) vegofs << cn->getVegCover().getVeg() << '\n';
+  if( vegofs.good() )
+    {
+      cn->RegrowVegCover();  // lazy regrowth (see tVegetation.h)
+      vegofs << cn->getVegCover().getVeg() << '\n';
+    }
   if( forestofs.good() ) 
     {
       tTrees *tPtr = cn->getVegCover().getTrees();
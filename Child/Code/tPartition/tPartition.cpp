@@ -0,0 +1,203 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tPartition.cpp
+**
+**  @brief Functions for tPartition. See tPartition.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tPartition.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include "../errors/errors.h"
+#include "../tMesh/tMesh.h"
+#include "../tLNode/tLNode.h"
+
+namespace
+{
+  // Orders node IDs by one coordinate, then by ID (so that the order,
+  // and hence the partition, is the same on every process)
+  class tCoordLess
+  {
+  public:
+    tCoordLess( const std::vector<double> &coord ) : coord_(coord) {}
+    bool operator()( int a, int b ) const
+    {
+      return coord_[a]<coord_[b] || ( coord_[a]==coord_[b] && a<b );
+    }
+  private:
+    const std::vector<double> &coord_;
+  };
+}
+
+/**************************************************************************/
+/**
+**  tPartition constructor
+**
+**  Bisects the nodes into parts, then finds each part's ghosts,
+**  neighbours, and send and receive lists.
+*/
+/**************************************************************************/
+tPartition::tPartition( tMesh< tLNode > *mesh, int numParts ) :
+  numParts_(numParts)
+{
+  if( numParts<1 )
+    ReportFatalError( "tPartition: the number of parts must be positive." );
+  const long numNodes = mesh->getNodeList()->getSize();
+  if( numNodes<numParts )
+    ReportFatalError( "tPartition: more parts than nodes." );
+
+  x_.resize( numNodes );
+  y_.resize( numNodes );
+  owner_.assign( numNodes, -1 );
+  std::vector< tLNode * > nodes( numNodes, static_cast<tLNode *>(0) );
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP() )
+  {
+    const int id = cn->getID();
+    if( id<0 || id>=numNodes || nodes[id]!=0 )
+      ReportFatalError( "tPartition: node IDs must run from 0 to the "
+			"number of nodes less one." );
+    nodes[id] = cn;
+    x_[id] = cn->getX();
+    y_[id] = cn->getY();
+  }
+
+  std::vector<int> ids( numNodes );
+  for( long i=0; i<numNodes; ++i )
+    ids[i] = static_cast<int>(i);
+  Bisect( ids.begin(), ids.end(), 0, numParts );
+
+  owned_.resize( numParts );
+  for( long i=0; i<numNodes; ++i )
+    owned_[owner_[i]].push_back( static_cast<int>(i) );
+
+  // Ghosts: other parts' nodes joined by an edge to our own
+  ghosts_.resize( numParts );
+  for( int p=0; p<numParts; ++p )
+  {
+    std::vector<int> &ghosts = ghosts_[p];
+    for( size_t i=0; i<owned_[p].size(); ++i )
+    {
+      tLNode *cn = nodes[owned_[p][i]];
+      tEdge *first = cn->getEdg();
+      if( first==0 ) continue;
+      tEdge *ce = first;
+      do
+      {
+	const int nbr = ce->getDestinationPtr()->getID();
+	if( owner_[nbr]!=p )
+	  ghosts.push_back( nbr );
+      } while( ( ce = ce->getCCWEdg() )!=first );
+    }
+    std::sort( ghosts.begin(), ghosts.end() );
+    ghosts.erase( std::unique( ghosts.begin(), ghosts.end() ), ghosts.end() );
+  }
+
+  // Neighbours, and receive lists (our ghosts, by owner)
+  neighbours_.resize( numParts );
+  recv_.resize( numParts );
+  send_.resize( numParts );
+  for( int p=0; p<numParts; ++p )
+  {
+    const std::vector<int> &ghosts = ghosts_[p];
+    for( size_t i=0; i<ghosts.size(); ++i )
+      neighbours_[p].push_back( owner_[ghosts[i]] );
+    std::sort( neighbours_[p].begin(), neighbours_[p].end() );
+    neighbours_[p].erase( std::unique( neighbours_[p].begin(),
+				       neighbours_[p].end() ),
+			  neighbours_[p].end() );
+    recv_[p].resize( neighbours_[p].size() );
+    send_[p].resize( neighbours_[p].size() );
+    for( size_t k=0; k<neighbours_[p].size(); ++k )
+      for( size_t i=0; i<ghosts.size(); ++i )
+	if( owner_[ghosts[i]]==neighbours_[p][k] )
+	  recv_[p][k].push_back( ghosts[i] );
+  }
+
+  // Send lists: what each neighbour receives from us
+  for( int p=0; p<numParts; ++p )
+    for( size_t k=0; k<neighbours_[p].size(); ++k )
+    {
+      const int q = neighbours_[p][k];
+      const std::vector<int> &nbrs = neighbours_[q];
+      const size_t kq =
+	std::lower_bound( nbrs.begin(), nbrs.end(), p ) - nbrs.begin();
+      if( kq==nbrs.size() || nbrs[kq]!=p )
+	ReportFatalError( "tPartition: neighbours are not symmetric." );
+      send_[p][k] = recv_[q][kq];
+    }
+}
+
+/**************************************************************************/
+/**
+**  tPartition::Bisect
+**
+**  Gives the nodes in [begin,end) to parts firstPart to
+**  firstPart+numParts-1.
+*/
+/**************************************************************************/
+void tPartition::Bisect( iter_t begin, iter_t end, int firstPart,
+			 int numParts )
+{
+  if( numParts==1 )
+  {
+    for( iter_t i=begin; i!=end; ++i )
+      owner_[*i] = firstPart;
+    return;
+  }
+
+  double xmin = x_[*begin], xmax = xmin, ymin = y_[*begin], ymax = ymin;
+  for( iter_t i=begin; i!=end; ++i )
+  {
+    xmin = std::min( xmin, x_[*i] );
+    xmax = std::max( xmax, x_[*i] );
+    ymin = std::min( ymin, y_[*i] );
+    ymax = std::max( ymax, y_[*i] );
+  }
+  const int leftParts = numParts / 2;
+  const long n = end - begin;
+  const iter_t middle = begin + n * leftParts / numParts;
+  if( xmax-xmin>=ymax-ymin )
+    std::nth_element( begin, middle, end, tCoordLess( x_ ) );
+  else
+    std::nth_element( begin, middle, end, tCoordLess( y_ ) );
+  Bisect( begin, middle, firstPart, leftParts );
+  Bisect( middle, end, firstPart+leftParts, numParts-leftParts );
+}
+
+void tPartition::WriteSummary( std::ostream &out ) const
+{
+  long minOwned = static_cast<long>(owned_[0].size()), maxOwned = 0,
+    numGhosts = 0, maxGhosts = 0;
+  size_t maxNeighbours = 0;
+  for( int p=0; p<numParts_; ++p )
+  {
+    const long owned = static_cast<long>(owned_[p].size()),
+      ghosts = static_cast<long>(ghosts_[p].size());
+    minOwned = std::min( minOwned, owned );
+    maxOwned = std::max( maxOwned, owned );
+    numGhosts += ghosts;
+    maxGhosts = std::max( maxGhosts, ghosts );
+    maxNeighbours = std::max( maxNeighbours, neighbours_[p].size() );
+  }
+  const double mean = double( getNumNodes() ) / numParts_;
+  out << "Partition: " << getNumNodes() << " nodes in " << numParts_
+      << " parts of " << minOwned << " to " << maxOwned
+      << " nodes (imbalance " << std::setprecision(3) << maxOwned/mean
+      << ")\n  ghosts: " << numGhosts << " in all, at most " << maxGhosts
+      << " per part (" << 100.0*numGhosts/getNumNodes()
+      << "% of the nodes); at most " << maxNeighbours
+      << " neighbours per part\n" << std::setprecision(6);
+}
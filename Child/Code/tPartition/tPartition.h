@@ -0,0 +1,93 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tPartition.h
+**
+**  @brief Header file for tPartition, a spatial decomposition of a mesh
+**         into parts with ghost layers, for running in parts over several
+**         processes (see tDomainComm).
+**
+**  The nodes are shared out by recursive coordinate bisection: the
+**  nodes of a set of parts are split across the longer side of their
+**  bounding box, in proportion to the number of parts on each side, and
+**  each side is split again until it holds one part. Parts thus have the
+**  same number of nodes to within one, and are compact, so that few
+**  nodes lie along their edges.
+**
+**  The ghosts of a part are the nodes it does not own that are joined by
+**  an edge to a node it does (one layer). A part's neighbours are the
+**  parts owning its ghosts. For each neighbour, the send list holds the
+**  part's own nodes that the neighbour has as ghosts, and the receive
+**  list the part's ghosts that the neighbour owns, both in ID order, so
+**  that the send list of one part matches the receive list of the other.
+**
+**  The partition depends only on the node coordinates and IDs, so every
+**  process that builds the same mesh gets the same one. Node IDs must
+**  run from 0 to the number of nodes less one. Nothing in the model
+**  runs in parts yet; ChildInterface/tests/partition_test.cpp checks the
+**  rules above.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TPARTITION_H
+#define TPARTITION_H
+
+#include <iosfwd>
+#include <vector>
+
+class tLNode;
+template< class tSubNode > class tMesh;
+
+/**************************************************************************/
+/**
+**  Class tPartition
+*/
+/**************************************************************************/
+class tPartition
+{
+public:
+  tPartition( tMesh< tLNode > *mesh, int numParts );
+
+  int getNumParts() const { return numParts_; }
+  long getNumNodes() const { return static_cast<long>(owner_.size()); }
+  int getOwner( int id ) const { return owner_[id]; }
+
+  // IDs of the nodes a part owns, and of its ghosts, in ID order
+  const std::vector<int> &getOwned( int part ) const { return owned_[part]; }
+  const std::vector<int> &getGhosts( int part ) const
+  { return ghosts_[part]; }
+
+  // Neighbours of a part, in ascending order, and for neighbour k (an
+  // index into getNeighbours), the send and receive lists
+  const std::vector<int> &getNeighbours( int part ) const
+  { return neighbours_[part]; }
+  const std::vector<int> &getSendList( int part, size_t k ) const
+  { return send_[part][k]; }
+  const std::vector<int> &getRecvList( int part, size_t k ) const
+  { return recv_[part][k]; }
+
+  // Sizes of the parts and ghost layers
+  void WriteSummary( std::ostream & ) const;
+
+private:
+  typedef std::vector<int>::iterator iter_t;
+  void Bisect( iter_t begin, iter_t end, int firstPart, int numParts );
+
+  int numParts_;
+  std::vector<double> x_, y_;                     // by node ID
+  std::vector<int> owner_;                        // by node ID
+  std::vector< std::vector<int> > owned_, ghosts_, neighbours_;  // by part
+  std::vector< std::vector< std::vector<int> > > send_, recv_;   // by part
+							       //  and nbr
+};
+
+#endif
@@ -0,0 +1,231 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tProfiler.cpp
+**
+**  @brief Functions for tProfiler, the hierarchical main-loop timer.
+**  See tProfiler.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include "tProfiler.h"
+#include "../errors/errors.h"
+
+bool tProfiler::on_ = false;
+pthread_t tProfiler::owner_;
+std::string tProfiler::baseName_;
+tProfiler::tCallNode *tProfiler::root_ = 0;
+tProfiler::tCallNode *tProfiler::current_ = 0;
+double tProfiler::startTime_ = 0.;
+std::ofstream *tProfiler::trace_ = 0;
+bool tProfiler::firstEvent_ = true;
+
+/**************************************************************************/
+/**
+**  tProfiler::Start
+**
+**  Sets up an empty call tree whose root stands for the whole run, and,
+**  if a trace is wanted, opens the trace file. The calling thread
+**  becomes the one that is timed.
+*/
+/**************************************************************************/
+bool tProfiler::Start( const std::string &baseName, bool trace )
+{
+  if( on_ )
+  {
+    ReportWarning( "Profiler already running in this process; "
+		   "this model will not be profiled." );
+    return false;
+  }
+  baseName_ = baseName;
+  root_ = new tCallNode;
+  root_->name = "(run)";
+  root_->parent = 0;
+  root_->calls = 1;
+  root_->total = 0.;
+  root_->start = 0.;
+  current_ = root_;
+  startTime_ = 0.;
+  startTime_ = Now();
+
+  if( trace )
+  {
+    const std::string traceName = baseName_ + ".trace.json";
+    trace_ = new std::ofstream( traceName.c_str() );
+    if( !trace_->good() )
+    {
+      std::cerr << "Unable to open '" << traceName << "'.\n";
+      ReportFatalError( "Unable to open the profiler trace file." );
+    }
+    *trace_ << "{\"traceEvents\":[\n";
+    firstEvent_ = true;
+  }
+
+  owner_ = pthread_self();
+  on_ = true;
+  return true;
+}
+
+/**************************************************************************/
+/**
+**  tProfiler::Stop
+**
+**  Closes any scopes still open (e.g., if the run stopped part way
+**  through a storm), writes <baseName>.profile, finishes the trace, and
+**  frees the call tree.
+*/
+/**************************************************************************/
+void tProfiler::Stop()
+{
+  if( !on_ )
+    return;
+  while( current_!=root_ )
+    Leave();
+  root_->total = Now();
+
+  const std::string reportName = baseName_ + ".profile";
+  std::ofstream report( reportName.c_str() );
+  if( report.good() )
+    WriteReport( report );
+  else
+    std::cerr << "Unable to open '" << reportName << "'.\n";
+
+  if( trace_ )
+  {
+    *trace_ << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    delete trace_;
+    trace_ = 0;
+  }
+
+  on_ = false;
+  DeleteTree( root_ );
+  root_ = current_ = 0;
+}
+
+/**************************************************************************/
+/**
+**  tProfiler::Enter, tProfiler::Leave
+**
+**  Enter opens a scope as a child of the current one, adding it to the
+**  tree the first time; Leave closes the current scope and adds its time
+**  to the totals (and, if tracing, writes it as a complete event, with
+**  times in microseconds).
+*/
+/**************************************************************************/
+void tProfiler::Enter( const char *name )
+{
+  tCallNode *node = 0;
+  std::vector<tCallNode *> &children = current_->children;
+  for( size_t i=0; i<children.size(); ++i )
+    if( children[i]->name==name || strcmp( children[i]->name, name )==0 )
+    {
+      node = children[i];
+      break;
+    }
+  if( node==0 )
+  {
+    node = new tCallNode;
+    node->name = name;
+    node->parent = current_;
+    node->calls = 0;
+    node->total = 0.;
+    children.push_back( node );
+  }
+  current_ = node;
+  node->start = Now();
+}
+
+void tProfiler::Leave()
+{
+  tCallNode *node = current_;
+  const double elapsed = Now() - node->start;
+  node->calls++;
+  node->total += elapsed;
+  current_ = node->parent;
+
+  if( trace_ )
+  {
+    if( !firstEvent_ )
+      *trace_ << ",\n";
+    firstEvent_ = false;
+    *trace_ << std::fixed << std::setprecision(3)
+	    << "{\"name\":\"" << node->name
+	    << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"
+	    << node->start*1.0e6 << ",\"dur\":" << elapsed*1.0e6 << "}";
+  }
+}
+
+/**************************************************************************/
+/**
+**  tProfiler::WriteReport
+**
+**  Writes the call tree, one line per node, children indented under
+**  their parent in the order they were first called. "Self" is the time
+**  not accounted for by child scopes.
+*/
+/**************************************************************************/
+void tProfiler::WriteReport( std::ostream &os )
+{
+  if( root_==0 )
+    return;
+  os << "CHILD profile of " << baseName_ << '\n'
+     << "Total wall time: " << std::fixed << std::setprecision(3)
+     << root_->total << " s\n\n"
+     << "      calls    total (s)     self (s)  % of run  scope\n";
+  WriteNode( os, root_, 0 );
+}
+
+void tProfiler::WriteNode( std::ostream &os, const tCallNode *node,
+			   int depth )
+{
+  double childTotal = 0.;
+  for( size_t i=0; i<node->children.size(); ++i )
+    childTotal += node->children[i]->total;
+  const double runTotal = root_->total>0. ? root_->total : 1.;
+
+  os << std::setw(11) << node->calls
+     << std::fixed << std::setprecision(3)
+     << std::setw(13) << node->total
+     << std::setw(13) << node->total - childTotal
+     << std::setprecision(1)
+     << std::setw(10) << 100.*node->total/runTotal
+     << "  " << std::string( 2*depth, ' ' ) << node->name << '\n';
+
+  for( size_t i=0; i<node->children.size(); ++i )
+    WriteNode( os, node->children[i], depth+1 );
+}
+
+/**************************************************************************/
+/**
+**  tProfiler::Now
+**
+**  Returns the time since Start in seconds, from the monotonic clock.
+*/
+/**************************************************************************/
+double tProfiler::Now()
+{
+  struct timespec t;
+  clock_gettime( CLOCK_MONOTONIC, &t );
+  return t.tv_sec + 1.0e-9*t.tv_nsec - startTime_;
+}
+
+void tProfiler::DeleteTree( tCallNode *node )
+{
+  for( size_t i=0; i<node->children.size(); ++i )
+    DeleteTree( node->children[i] );
+  delete node;
+}
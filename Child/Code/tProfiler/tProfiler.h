@@ -0,0 +1,119 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tProfiler.h
+**
+**  @brief Header file for tProfiler, a hierarchical timer for the main
+**         loop, and tProfileScope, the scoped timer that feeds it.
+**
+**  A tProfileScope placed at the top of a function (or block) times it
+**  from construction to destruction:
+**
+**    void tStreamNet::MakeFlow( double tm )
+**    {
+**      tProfileScope scope( "tStreamNet::MakeFlow" );
+**      ...
+**
+**  Timings are gathered into a call tree: a scope opened while another
+**  is open becomes its child, so the same function called from two
+**  places shows up twice. When the profiler is off, a scope costs one
+**  test of a flag.
+**
+**  The profiler is turned on with the --profile command-line option (see
+**  tOption), which writes a report to <OUTFILENAME>.profile at the end
+**  of the run: for each node of the call tree, the number of calls, the
+**  total time, the time not spent in child scopes, and the share of the
+**  whole run. The --profile-trace option also writes every scope
+**  occurrence, storm by storm, to <OUTFILENAME>.trace.json in Chrome
+**  trace format (viewable in chrome://tracing or Perfetto).
+**
+**  There is one profiler per process. It times only the thread that
+**  started it: scopes on other threads (e.g., the workers of
+**  childEnsemble) are ignored.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TPROFILER_H
+#define TPROFILER_H
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+class tProfiler
+{
+public:
+  // Turns the profiler on; returns false (and does nothing) if it is
+  // already on. Output files are named after baseName.
+  static bool Start( const std::string &baseName, bool trace );
+  // Writes the report (and finishes the trace) and turns the profiler off
+  static void Stop();
+
+  // Should a scope on the calling thread be timed?
+  static bool IsActive()
+  { return on_ && pthread_equal( owner_, pthread_self() ); }
+
+  static void Enter( const char *name );
+  static void Leave();
+
+  static void WriteReport( std::ostream & );
+
+private:
+  // A node of the call tree
+  struct tCallNode
+  {
+    const char *name;
+    tCallNode *parent;
+    std::vector<tCallNode *> children;
+    long calls;
+    double total;   // seconds
+    double start;   // time of the current call (seconds since Start)
+  };
+
+  static double Now();   // seconds since Start
+  static void DeleteTree( tCallNode * );
+  static void WriteNode( std::ostream &, const tCallNode *, int depth );
+
+  static bool on_;
+  static pthread_t owner_;
+  static std::string baseName_;
+  static tCallNode *root_;
+  static tCallNode *current_;
+  static double startTime_;    // absolute, seconds
+  static std::ofstream *trace_;
+  static bool firstEvent_;
+};
+
+/**************************************************************************/
+/**
+**  Class tProfileScope
+**
+**  Times the enclosing block (see above).
+*/
+/**************************************************************************/
+class tProfileScope
+{
+public:
+  explicit tProfileScope( const char *name )
+    : active_( tProfiler::IsActive() )
+  { if( active_ ) tProfiler::Enter( name ); }
+  ~tProfileScope() { if( active_ ) tProfiler::Leave(); }
+
+private:
+  const bool active_;
+
+  tProfileScope( const tProfileScope & );
+  tProfileScope &operator=( const tProfileScope & );
+};
+
+#endif
@@ -54,6 +54,7 @@
 
 tRunTimer::tRunTimer()
   :
+  timeStatusFileName("run.time"),
   currentTime(0),
   endTime(1),
   outputInterval(1),
@@ -69,6 +70,7 @@ tRunTimer::tRunTimer()
 
 tRunTimer::tRunTimer( double duration, double opint, bool optprint )
   :
+  timeStatusFileName("run.time"),
   currentTime(0),
   endTime(duration),
   outputInterval(opint),
@@ -84,6 +86,7 @@ tRunTimer::tRunTimer( double duration, double opint, bool optprint )
 
 tRunTimer::tRunTimer( const tInputFile &infile, bool optprint )
   :
+  timeStatusFileName("run.time"),
   currentTime(0),
   notifyInterval(1000),
   nextTSOutputTime(0),
@@ -128,6 +131,17 @@ void tRunTimer::Start( double start, double end )
    if( end>0.0 ) endTime = end;
 }
 
+//****************************************************
+// setTimeStatusFile
+//
+// Sets the name of the time status file written by
+// ReportTimeStatus, for runs that share a directory.
+//****************************************************
+void tRunTimer::setTimeStatusFile( const std::string &name )
+{
+   timeStatusFileName = name;
+}
+
 //****************************************************
 // getCurrentTime
 //
@@ -180,7 +194,7 @@ void tRunTimer::ReportTimeStatus()
 	if( optPrintEachTime ) std::cout << currentTime << std::endl;
 	if( currentTime >= nextNotify )
 	{
-		timeStatusFile.open( "run.time" );
+		timeStatusFile.open( timeStatusFileName.c_str() );
 		assert( timeStatusFile.good() );
 		timeStatusFile << currentTime << std::endl;
 		timeStatusFile.close();
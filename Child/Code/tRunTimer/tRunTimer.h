@@ -31,11 +31,14 @@ public:
 	double RemainingTime() const;      // How much time is left
 	void Start( double, double=0.0 );  // Set current and (optionally) end times
 	bool CheckOutputTime();             // Is it time to write output yet?
+	double getNextOutputTime() const { return nextOutputTime; }
 	void ReportTimeStatus();           // Report time to file and (opt) screen
 	bool CheckTSOutputTime();           // Is it time to write time series output yet?
+	void setTimeStatusFile( const std::string & );  // default "run.time"
 
 private:
 	std::ofstream timeStatusFile;  // file "run.time" for tracking current time
+	std::string timeStatusFileName;  // name of that file
 	double currentTime;       // current time in simulation
 	double endTime;           // time at which simulation ends
 	double outputInterval;    // interval between outputs
@@ -50,7 +53,8 @@ private:
 
 // copy constructor:
 inline tRunTimer::tRunTimer( const tRunTimer& orig ) 
-  : currentTime(orig.currentTime), endTime(orig.endTime), 
+  : timeStatusFileName(orig.timeStatusFileName),
+    currentTime(orig.currentTime), endTime(orig.endTime), 
     outputInterval(orig.outputInterval), nextOutputTime(orig.nextOutputTime), 
     notifyInterval(orig.notifyInterval), nextNotify(orig.nextNotify), 
     nextTSOutputTime(orig.nextTSOutputTime), 
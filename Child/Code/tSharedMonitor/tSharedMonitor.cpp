@@ -0,0 +1,359 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tSharedMonitor.cpp
+**
+**  @brief Functions for tSharedMonitor and tSharedMonitorReader. See
+**  tSharedMonitor.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tSharedMonitor.h"
+#include <string.h>
+#include "../errors/errors.h"
+#include "../tInputFile/tInputFile.h"
+#include "../tMesh/tMesh.h"
+#include "../tLNode/tLNode.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+# define CHILD_HAVE_SHM 1
+# include <fcntl.h>
+# include <sched.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+// The header must fit in the space kept for it
+typedef char tSharedMonitorHeaderFits
+[ sizeof(tSharedMonitorHeader)<=tSharedMonitor::kHeaderBytes ? 1 : -1 ];
+
+namespace
+{
+  const char kMagic[8] = { 'C', 'H', 'I', 'L', 'D', 'M', 'O', 'N' };
+
+  size_t SegmentBytes( uint64_t capacity )
+  {
+    return tSharedMonitor::kHeaderBytes
+      + tSharedMonitor::kNumFields * capacity * sizeof(double);
+  }
+
+  inline double *Field( void *base, uint64_t capacity, int field )
+  {
+    return reinterpret_cast<double *>( static_cast<char *>(base)
+				       + tSharedMonitor::kHeaderBytes )
+      + field * capacity;
+  }
+}
+
+/**************************************************************************/
+/**
+**  tSharedMonitor constructor
+**
+**  Makes the object, replacing any left with the same name (e.g., by a
+**  run that crashed). If the system cannot make it, the run goes on
+**  without a monitor.
+*/
+/**************************************************************************/
+tSharedMonitor::tSharedMonitor( const tInputFile &infile ) :
+  interval_(0.), lastTime_(0.), numPublished_(0), active_(false),
+  fd_(-1), base_(0), bytes_(0)
+{
+  name_ = infile.Contain( "SHARED_MONITOR_NAME" ) ?
+    infile.ReadString( "SHARED_MONITOR_NAME" ) : "/child_monitor";
+  if( name_.empty() || name_[0]!='/' )
+    name_ = "/" + name_;
+  if( name_.find( '/', 1 )!=std::string::npos )
+    ReportFatalError( "SHARED_MONITOR_NAME may not contain '/' "
+		      "(other than a leading one)." );
+  if( infile.Contain( "SHARED_MONITOR_INTERVAL" ) )
+    interval_ = infile.ReadDouble( "SHARED_MONITOR_INTERVAL" );
+  if( interval_<0. )
+    ReportFatalError( "SHARED_MONITOR_INTERVAL must not be negative." );
+
+#if CHILD_HAVE_SHM
+  shm_unlink( name_.c_str() );
+  fd_ = shm_open( name_.c_str(), O_CREAT | O_RDWR, 0644 );
+  if( fd_<0 )
+  {
+    ReportWarning( "Unable to create the shared-memory monitor; "
+		   "running without it." );
+    return;
+  }
+  active_ = true;
+  Map( 1024 );
+#else
+  ReportWarning( "Shared memory is not available on this system; "
+		 "running without a monitor." );
+#endif
+}
+
+tSharedMonitor::~tSharedMonitor()
+{
+#if CHILD_HAVE_SHM
+  if( base_ )
+  {
+    tSharedMonitorHeader *header = static_cast<tSharedMonitorHeader *>(base_);
+    header->finished = 1;
+    munmap( base_, bytes_ );
+  }
+  if( fd_>=0 )
+  {
+    close( fd_ );
+    shm_unlink( name_.c_str() );
+  }
+#endif
+}
+
+const char *tSharedMonitor::getFieldName( tField field )
+{
+  static const char *names[kNumFields] =
+    { "x", "y", "elevation", "discharge", "erosion rate", "boundary" };
+  return names[field];
+}
+
+/**************************************************************************/
+/**
+**  tSharedMonitor::Map
+**
+**  Sizes the object for the given number of nodes and maps it (again).
+**  Growing the object keeps its contents, including the sequence
+**  number.
+*/
+/**************************************************************************/
+void tSharedMonitor::Map( uint64_t capacity )
+{
+#if CHILD_HAVE_SHM
+  const size_t bytes = SegmentBytes( capacity );
+  if( base_ )
+    munmap( base_, bytes_ );
+  base_ = 0;
+  void *base = MAP_FAILED;
+  if( ftruncate( fd_, bytes )==0 )
+    base = mmap( 0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0 );
+  if( base==MAP_FAILED )
+  {
+    ReportWarning( "Unable to map the shared-memory monitor; "
+		   "running without it." );
+    active_ = false;
+    return;
+  }
+  base_ = base;
+  bytes_ = bytes;
+
+  tSharedMonitorHeader *header = static_cast<tSharedMonitorHeader *>(base_);
+  memcpy( header->magic, kMagic, sizeof(kMagic) );
+  header->version = kVersion;
+  header->numFields = kNumFields;
+  header->pid = static_cast<uint32_t>( getpid() );
+  header->capacity = capacity;
+  header->segmentBytes = bytes;
+#else
+  (void)capacity;
+#endif
+}
+
+/**************************************************************************/
+/**
+**  tSharedMonitor::Publish
+**
+**  Copies the nodes (all of them, in list order) into the object, inside
+**  an odd sequence number.
+*/
+/**************************************************************************/
+void tSharedMonitor::Publish( tMesh< tLNode > *mesh, double time )
+{
+  if( !active_ )
+    return;
+  tSharedMonitorHeader *header = static_cast<tSharedMonitorHeader *>(base_);
+  ++header->sequence;
+  __sync_synchronize();
+
+  const uint64_t numNodes = mesh->getNodeList()->getSize();
+  if( numNodes>header->capacity )
+  {
+    Map( 2*numNodes );
+    if( !active_ )
+      return;
+    header = static_cast<tSharedMonitorHeader *>(base_);
+  }
+
+  const uint64_t capacity = header->capacity;
+  double *x = Field( base_, capacity, kX ),
+    *y = Field( base_, capacity, kY ),
+    *z = Field( base_, capacity, kElevation ),
+    *q = Field( base_, capacity, kDischarge ),
+    *dzdt = Field( base_, capacity, kErosionRate ),
+    *boundary = Field( base_, capacity, kBoundary );
+  tMesh< tLNode >::nodeListIter_t ni( mesh->getNodeList() );
+  uint64_t i = 0;
+  for( tLNode *cn = ni.FirstP(); !ni.AtEnd(); cn = ni.NextP(), ++i )
+  {
+    x[i] = cn->getX();
+    y[i] = cn->getY();
+    z[i] = cn->getZ();
+    q[i] = cn->getQ();
+    dzdt[i] = cn->getDzDt();
+    boundary[i] = cn->getBoundaryFlag();
+  }
+  header->numNodes = numNodes;
+  header->time = time;
+  header->numPublished = ++numPublished_;
+  lastTime_ = time;
+
+  __sync_synchronize();
+  ++header->sequence;
+}
+
+void tSharedMonitor::Finish( tMesh< tLNode > *mesh, double time )
+{
+  if( !active_ )
+    return;
+  Publish( mesh, time );
+  if( active_ )
+    static_cast<tSharedMonitorHeader *>(base_)->finished = 1;
+}
+
+/**************************************************************************/
+/**
+**  tSharedMonitorReader
+*/
+/**************************************************************************/
+tSharedMonitorReader::tSharedMonitorReader() :
+  fd_(-1), base_(0), bytes_(0)
+{}
+
+tSharedMonitorReader::~tSharedMonitorReader()
+{
+  Detach();
+}
+
+bool tSharedMonitorReader::Attach( const std::string &name )
+{
+  Detach();
+#if CHILD_HAVE_SHM
+  const std::string path = ( !name.empty() && name[0]=='/' ) ? name
+    : "/" + name;
+  fd_ = shm_open( path.c_str(), O_RDONLY, 0 );
+  if( fd_<0 )
+    return false;
+  struct stat info;
+  if( fstat( fd_, &info )!=0
+      || info.st_size<static_cast<off_t>(tSharedMonitor::kHeaderBytes)
+      || !Remap( info.st_size ) )
+  {
+    Detach();
+    return false;
+  }
+  const tSharedMonitorHeader *header =
+    static_cast<const tSharedMonitorHeader *>(base_);
+  if( memcmp( header->magic, kMagic, sizeof(kMagic) )!=0
+      || header->version!=tSharedMonitor::kVersion )
+  {
+    Detach();
+    return false;
+  }
+  return true;
+#else
+  (void)name;
+  return false;
+#endif
+}
+
+void tSharedMonitorReader::Detach()
+{
+#if CHILD_HAVE_SHM
+  if( base_ )
+    munmap( base_, bytes_ );
+  if( fd_>=0 )
+    close( fd_ );
+#endif
+  base_ = 0;
+  bytes_ = 0;
+  fd_ = -1;
+}
+
+bool tSharedMonitorReader::Remap( size_t bytes )
+{
+#if CHILD_HAVE_SHM
+  if( base_ )
+    munmap( base_, bytes_ );
+  base_ = mmap( 0, bytes, PROT_READ, MAP_SHARED, fd_, 0 );
+  if( base_==MAP_FAILED )
+  {
+    base_ = 0;
+    bytes_ = 0;
+    return false;
+  }
+  bytes_ = bytes;
+  return true;
+#else
+  (void)bytes;
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/**
+**  tSharedMonitorReader::Read
+**
+**  The reading side of the seqlock: copy the header and fields between
+**  two reads of the sequence number, and keep the copy only if the
+**  number was even and did not change.
+*/
+/**************************************************************************/
+bool tSharedMonitorReader::Read( tSharedMonitorHeader &copy,
+		 std::vector< double > fields[tSharedMonitor::kNumFields] )
+{
+  if( !base_ )
+    return false;
+  const int kMaxTries = 1000;
+  for( int tries=0; tries<kMaxTries; ++tries )
+  {
+    const volatile tSharedMonitorHeader *header =
+      static_cast<const volatile tSharedMonitorHeader *>(base_);
+    const uint64_t before = header->sequence;
+    __sync_synchronize();
+    if( before & 1 )
+    {
+#if CHILD_HAVE_SHM
+      sched_yield();
+#endif
+      continue;
+    }
+    const uint64_t segmentBytes = header->segmentBytes;
+    if( segmentBytes>bytes_ )
+    {
+      if( !Remap( segmentBytes ) )
+	return false;
+      continue;
+    }
+    memcpy( &copy, const_cast<const tSharedMonitorHeader *>(header),
+	    sizeof(copy) );
+    if( copy.numPublished==0 )
+      return false;
+    if( copy.numNodes>copy.capacity
+	|| SegmentBytes( copy.capacity )>bytes_ )
+      continue;
+    for( int f=0; f<tSharedMonitor::kNumFields; ++f )
+    {
+      fields[f].resize( copy.numNodes );
+      if( copy.numNodes>0 )
+	memcpy( &fields[f][0], Field( base_, copy.capacity, f ),
+		copy.numNodes * sizeof(double) );
+    }
+    __sync_synchronize();
+    if( header->sequence==before )
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,169 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tSharedMonitor.h
+**
+**  @brief Header file for tSharedMonitor, which publishes the state of a
+**         running model in POSIX shared memory, and tSharedMonitorReader,
+**         which reads it from another process.
+**
+**  With OPT_SHARED_MONITOR set, childInterface copies the coordinates,
+**  elevation, discharge, erosion rate (dz/dt) and boundary code of every
+**  node into the shared-memory object SHARED_MONITOR_NAME (default
+**  "/child_monitor") at least SHARED_MONITOR_INTERVAL model years apart
+**  (default 0: after every storm), and at the end of the run. A viewer
+**  (e.g., childmonitor) attaches to the object and shows the progress of
+**  the run without any files being written or read.
+**
+**  Layout of the object: a tSharedMonitorHeader, padded to
+**  kHeaderBytes, then kNumFields arrays of `capacity' doubles (field f
+**  at kHeaderBytes + f*capacity*sizeof(double)), of which the first
+**  numNodes entries are valid, in the order of the mesh's node list.
+**
+**  The header's sequence number makes a seqlock: the publisher makes it
+**  odd before it changes anything and even again when it is done, so a
+**  reader that sees the same even number before and after copying the
+**  data has a consistent copy (and otherwise tries again). The reader
+**  never blocks the model. If the mesh outgrows the object, the
+**  publisher enlarges it (inside an odd sequence) and the reader maps
+**  it again when segmentBytes changes. When the run ends, the publisher
+**  sets `finished' and removes the name; readers that have it mapped
+**  keep the last state.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TSHAREDMONITOR_H
+#define TSHAREDMONITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class tInputFile;
+class tLNode;
+template< class tSubNode > class tMesh;
+
+/**************************************************************************/
+/**
+**  struct tSharedMonitorHeader
+**
+**  Start of the shared-memory object (fixed-size types only, so that
+**  readers in other languages can use it).
+*/
+/**************************************************************************/
+struct tSharedMonitorHeader
+{
+  char magic[8];                // "CHILDMON"
+  uint32_t version;             // tSharedMonitor::kVersion
+  uint32_t numFields;           // tSharedMonitor::kNumFields
+  volatile uint64_t sequence;   // seqlock: odd while being written
+  uint64_t segmentBytes;        // current size of the object
+  uint64_t capacity;            // nodes each field array holds
+  uint64_t numNodes;            // nodes published
+  uint64_t numPublished;        // states published so far
+  double time;                  // model time of the state
+  uint32_t finished;            // 1 once the run has ended
+  uint32_t pid;                 // process id of the publisher
+};
+
+/**************************************************************************/
+/**
+**  Class tSharedMonitor
+**
+**  The publishing side, owned by childInterface.
+*/
+/**************************************************************************/
+class tSharedMonitor
+{
+public:
+  enum
+  {
+    kVersion = 1,
+    kHeaderBytes = 128
+  };
+  enum tField
+  {
+    kX,
+    kY,
+    kElevation,
+    kDischarge,
+    kErosionRate,
+    kBoundary,
+    kNumFields
+  };
+
+  explicit tSharedMonitor( const tInputFile & );
+  ~tSharedMonitor();
+
+  // True if a state is due at the given time
+  bool Due( double time ) const
+  { return active_ && ( numPublished_==0 || time>=lastTime_+interval_ ); }
+  // Copies the state of the mesh into the object
+  void Publish( tMesh< tLNode > *mesh, double time );
+  // Publishes the last state and marks the run as finished
+  void Finish( tMesh< tLNode > *mesh, double time );
+
+  static const char *getFieldName( tField );
+
+private:
+  tSharedMonitor( const tSharedMonitor & );
+  tSharedMonitor &operator=( const tSharedMonitor & );
+
+  void Map( uint64_t capacity );
+
+  std::string name_;
+  double interval_;          // model years between states
+  double lastTime_;          // time of the last state
+  uint64_t numPublished_;
+  bool active_;              // false if the object could not be made
+  int fd_;
+  void *base_;
+  size_t bytes_;
+};
+
+/**************************************************************************/
+/**
+**  Class tSharedMonitorReader
+**
+**  Attaches to a model's object and takes consistent copies of its
+**  state.
+*/
+/**************************************************************************/
+class tSharedMonitorReader
+{
+public:
+  tSharedMonitorReader();
+  ~tSharedMonitorReader();
+
+  // Attaches to the named object; false if there is none (yet)
+  bool Attach( const std::string &name );
+  void Detach();
+  bool IsAttached() const { return base_!=0; }
+
+  // Copies the latest state; false if none could be had (no state
+  // published yet, or the publisher kept writing through every try)
+  bool Read( tSharedMonitorHeader &header,
+	     std::vector< double > fields[tSharedMonitor::kNumFields] );
+
+private:
+  tSharedMonitorReader( const tSharedMonitorReader & );
+  tSharedMonitorReader &operator=( const tSharedMonitorReader & );
+
+  bool Remap( size_t bytes );
+
+  int fd_;
+  void *base_;
+  size_t bytes_;
+};
+
+#endif
@@ -0,0 +1,114 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tStateHash.cpp
+**
+**  @brief Functions for tStateHash. See tStateHash.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tStateHash.h"
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "../Mathutil/mathutil.h"
+#include "../tMesh/tMesh.h"
+#include "../tMesh/tMeshRange.h"
+#include "../tLNode/tLNode.h"
+
+namespace
+{
+  bool PermIDLess( const tLNode *a, const tLNode *b )
+  {
+    return a->getPermID()<b->getPermID();
+  }
+
+  // Hashes a chunk of nodes; the chunk hashes are chained in order
+  class tNodeHashBody
+  {
+  public:
+    explicit tNodeHashBody( const std::vector< tLNode * > &nodes ) :
+      nodes_(nodes) {}
+    void operator()( long begin, long end, uint64_t &acc ) const
+    {
+      tStateHash hash;
+      for( long i=begin; i<end; ++i )
+      {
+	const tLNode *cn = nodes_[i];
+	hash.Add( static_cast<uint64_t>( cn->getPermID() ) );
+	hash.Add( cn->getX() );
+	hash.Add( cn->getY() );
+	hash.Add( cn->getZ() );
+	hash.Add( static_cast<uint64_t>( cn->getBoundaryFlag() ) );
+	const int numLayers = cn->getNumLayer();
+	const size_t numg = cn->getNumg();
+	hash.Add( static_cast<uint64_t>( numLayers ) );
+	for( int j=0; j<numLayers; ++j )
+	{
+	  hash.Add( cn->getLayerDepth( j ) );
+	  hash.Add( cn->getLayerErody( j ) );
+	  hash.Add( static_cast<uint64_t>( cn->getLayerSed( j ) ) );
+	  hash.Add( cn->getLayerCtime( j ) );
+	  hash.Add( cn->getLayerRtime( j ) );
+	  hash.Add( cn->getLayerEtime( j ) );
+	  for( size_t g=0; g<numg; ++g )
+	    hash.Add( cn->getLayerDgrade( j, g ) );
+	}
+      }
+      acc = hash.getValue();
+    }
+    void Join( uint64_t &total, const uint64_t &acc ) const
+    {
+      tStateHash hash;
+      hash.Add( total );
+      hash.Add( acc );
+      total = hash.getValue();
+    }
+  private:
+    const std::vector< tLNode * > &nodes_;
+  };
+}
+
+uint64_t tStateHash::HashModel( tMesh< tLNode > *mesh, const tRand *rand,
+				double time )
+{
+  tMeshRange< tLNode > range( mesh->getNodeList(), false );
+  std::vector< tLNode * > nodes( range.size() );
+  for( long i=0; i<range.size(); ++i )
+    nodes[i] = range[i];
+  std::sort( nodes.begin(), nodes.end(), PermIDLess );
+
+  tStateHash hash;
+  hash.Add( time );
+  hash.Add( static_cast<uint64_t>( nodes.size() ) );
+  hash.Add( ThreadPoolOf( mesh ).ParallelReduce(
+	      static_cast<long>( nodes.size() ), tNodeHashBody( nodes ),
+	      static_cast<uint64_t>( 0 ) ) );
+  const tModelContext *context = mesh->getContext();
+  hash.Add( context ? context->zDatum : 0. );
+  if( rand )
+  {
+    std::vector< uint64_t > words;
+    rand->getState( words );
+    for( size_t i=0; i<words.size(); ++i )
+      hash.Add( words[i] );
+  }
+  return hash.getValue();
+}
+
+std::string tStateHash::Format( uint64_t value )
+{
+  char digits[17];
+  snprintf( digits, sizeof(digits), "%016llx",
+	    static_cast<unsigned long long>( value ) );
+  return digits;
+}
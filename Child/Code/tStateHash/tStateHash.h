@@ -0,0 +1,101 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tStateHash.h
+**
+**  @brief Header file for tStateHash, a 64-bit hash of the state of a
+**         model, for checking cheaply that two runs (e.g., serial and
+**         parallel, or before and after an optimization) are the same
+**         to the last bit.
+**
+**  HashModel covers, in this order: the time; the number of nodes; for
+**  each node, in order of permanent ID, its permanent ID, x, y, z,
+**  boundary code and layer stack (for each layer: depth, erodibility,
+**  sediment flag, creation, recent and exposure times and the depth of
+**  each grain size); the datum offset of lazy uplift (see tUplift); and
+**  the state of the random number generator. Values are hashed by their
+**  bits, so a difference in round-off changes the hash, as it should.
+**
+**  The nodes are hashed in parallel on the model's thread pool (see
+**  tThreadPool): each chunk of the permanent-ID order is hashed on its
+**  own, and the chunk hashes are combined in order, so the hash does not
+**  depend on the number of threads.
+**
+**  childInterface::GetStateHash returns the hash of a model, and with
+**  OPT_STATE_HASH it is written, with the time, to <OUTFILENAME>.hash at
+**  each output time.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TSTATEHASH_H
+#define TSTATEHASH_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+class tLNode;
+class tRand;
+template< class tSubNode > class tMesh;
+
+/**************************************************************************/
+/**
+**  Class tStateHash
+**
+**  A running hash of a sequence of 64-bit words (and doubles, by their
+**  bits).
+*/
+/**************************************************************************/
+class tStateHash
+{
+public:
+  tStateHash() : value_(kSeed) {}
+
+  void Add( uint64_t word )
+  {
+    value_ = Scramble( value_ ^ ( word + kGolden + ( value_<<6 )
+				  + ( value_>>2 ) ) );
+  }
+  void Add( double x )
+  {
+    uint64_t word;
+    memcpy( &word, &x, sizeof(word) );
+    Add( word );
+  }
+  uint64_t getValue() const { return value_; }
+
+  // Hash of the state of a model (rand may be 0)
+  static uint64_t HashModel( tMesh< tLNode > *mesh, const tRand *rand,
+			     double time );
+  // The hash as 16 hexadecimal digits
+  static std::string Format( uint64_t );
+
+private:
+  static const uint64_t kSeed = 0x6a09e667f3bcc909ULL;
+  static const uint64_t kGolden = 0x9e3779b97f4a7c15ULL;
+
+  // Finalizer of MurmurHash3: every bit of the result depends on every
+  // bit of x
+  static uint64_t Scramble( uint64_t x )
+  {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  uint64_t value_;
+};
+
+#endif
@@ -22,6 +22,9 @@
 #include <fstream>
 
 #include "tStorm.h"
+#include "../errors/errors.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
 
 /**************************************************************************\
 **
@@ -39,7 +42,10 @@ tStorm::tStorm( bool optvar )
   stdur(1.0),
   istdur(1.0),
   endtm(1.0e9),
-  optVariable(optvar)
+  optVariable(optvar),
+  optMergeDry(false),
+  maxMergeDur(0.0),
+  nMerged(1)
 {
    //srand( 0 );
 }
@@ -67,10 +73,19 @@ tStorm::tStorm( bool optvar )
 \**************************************************************************/
 tStorm::tStorm( const tInputFile &infile, tRand *rand_, 
 		bool no_write_mode /* = false */ ) :
-  rand(rand_)
+  rand(rand_),
+  maxMergeDur(0.0),
+  nMerged(1)
 {
    // Read + set parameters for storm intensity, duration, and spacing
    optVariable = infile.ReadBool( "OPTVAR" );
+   optMergeDry = infile.ReadBool( "OPT_MERGE_DRY_STORMS", false );
+   if( optMergeDry && infile.Contain( "MERGE_DRY_STORMS_MAXDUR" ) )
+   {
+      maxMergeDur = infile.ReadDouble( "MERGE_DRY_STORMS_MAXDUR" );
+      if( maxMergeDur<0.0 )
+         ReportFatalError( "MERGE_DRY_STORMS_MAXDUR must not be negative." );
+   }
    if( !no_write_mode )
      {
        infile.WarnObsoleteKeyword("PMEAN", "ST_PMEAN");
@@ -125,7 +140,10 @@ tStorm::tStorm( const tStorm& orig )
       stdur(orig.stdur),
       istdur(orig.istdur),
       endtm(orig.endtm),
-      optVariable(orig.optVariable)
+      optVariable(orig.optVariable),
+      optMergeDry(orig.optMergeDry),
+      maxMergeDur(orig.maxMergeDur),
+      nMerged(orig.nMerged)
 {}
 /**************************************************************************\
 **
@@ -171,11 +189,28 @@ void tStorm::TurnOffOutput()
 **  including the rejected storms and their associated interstorm periods,
 **  is stored istdur.
 **
+**    With OPT_MERGE_DRY_STORMS, storms that produce no runoff are merged
+**  in the same way whether or not they are random, so that a run of
+**  constant storms below the infiltration capacity becomes one event
+**  rather than one per storm. The means are then evaluated at the start
+**  of each storm drawn (not only at tm), and merging stops at maxtm
+**  (e.g., the next output time) as well as at the end of the run, so
+**  that the event does not run past an output, and once the event has
+**  lasted MERGE_DRY_STORMS_MAXDUR years, if given. The hillslope,
+**  uplift and vegetation routines integrate over the whole merged
+**  interval in one call; since they are applied one after the other,
+**  the longer the event, the larger the splitting error between them
+**  (hence the optional limit).
+**
 **  Inputs:      minp -- minimum value of rainfall rate p (default 0)
 **               mind -- minimum storm depth to produce runoff (default 0)
 **               tm -- current time in simulation
+**               maxtm -- time beyond which no-runoff storms are not
+**                        merged when OPT_MERGE_DRY_STORMS is set (if <0,
+**                        the end of the run)
 **  Members updated:  p, stdur, istdur take on new random values (if optVar)
 **                    pMean, stdurMean, istdurMean adjusted (if optSinVar)
+**                    nMerged is set to the number of storms drawn
 **  Assumptions:  pMean > 0
 **
 **  Modifications:
@@ -186,12 +221,24 @@ void tStorm::TurnOffOutput()
 **     GT 3/00
 **
 \**************************************************************************/
-void tStorm::GenerateStorm( double tm, double minp, double mind )
+void tStorm::GenerateStorm( double tm, double minp, double mind,
+                            double maxtm )
 {
+  tProfileScope scope( "tStorm::GenerateStorm" );
 
    p = p_ts.calc(tm);
    stdur = stdur_ts.calc(tm);
    istdur = istdur_ts.calc(tm);
+   nMerged = 1;
+
+   if( optMergeDry )
+   {
+      double tlim = ( maxtm>=0.0 && maxtm<endtm ) ? maxtm : endtm;
+      if( maxMergeDur>0.0 && tm+maxMergeDur<tlim )
+         tlim = tm + maxMergeDur;
+      MergeDryStorms( tm, minp, mind, tlim );
+      return;
+   }
 
    // If option for random storms is on, pick a storm at random.
    // Keep picking and accumulating time until the storm depth or intensity
@@ -210,7 +257,7 @@ void tStorm::GenerateStorm( double tm, double minp, double mind )
          p = pMean*ExpDev();
          istdur += istdurMean*ExpDev() + stdur;
          stdur = stdurMean*ExpDev();
-	 if(0) { // Debug
+	 if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStorm ) ) {
 	   std::cout << "P " << p << "  ST " << stdur << "  IST " << istdur
 		     << "  DP " << p*stdur << " minp " << minp
 		     << " mind " <<mind << std::endl;
@@ -222,6 +269,56 @@ void tStorm::GenerateStorm( double tm, double minp, double mind )
 }
 
 
+/**************************************************************************\
+**
+**  tStorm::MergeDryStorms
+**
+**  GenerateStorm with OPT_MERGE_DRY_STORMS: draws (or, for constant
+**  storms, repeats) storms until one produces runoff or the next would
+**  end after tlim, accumulating the time of those rejected in istdur.
+**
+\**************************************************************************/
+void tStorm::MergeDryStorms( double tm, double minp, double mind,
+                             double tlim )
+{
+   double elapsed = 0.0;  // time from tm to the start of the current storm
+   stdur = 0;
+   istdur = 0;
+   nMerged = 0;
+   do
+   {
+      // Means at the start of this storm
+      const double tstart = tm + elapsed;
+      const double pMean = p_ts.calc( tstart );
+      const double stdurMean = stdur_ts.calc( tstart );
+      const double istdurMean = istdur_ts.calc( tstart );
+
+      istdur += stdur;  // the previous (rejected) storm
+      if( optVariable )
+      {
+         p = pMean*ExpDev();
+         istdur += istdurMean*ExpDev();
+         stdur = stdurMean*ExpDev();
+      }
+      else
+      {
+         p = pMean;
+         istdur += istdurMean;
+         stdur = stdurMean;
+      }
+      elapsed = istdur + stdur;
+      ++nMerged;
+   } while( (p<=minp || (p*stdur)<=mind) && (tm+elapsed<tlim) );
+
+   if( nMerged>1 )
+      CHILD_LOG( tLog::kDebug, tLog::kStorm,
+                 nMerged << " storms merged into one event of "
+                 << stdur+istdur << " yr" );
+   if( optVariable && stormfile.good() )
+      stormfile << istdur << " " << p << " " << stdur << std::endl;
+}
+
+
 /**************************************************************************\
 **
 **  tStorm::ExpDev:  Finds a random number with an exponential distribution
@@ -27,6 +27,9 @@
 **  Modifications:
 **   - added data member "stormfile" to handle file containing history
 **     of storm events
+**   - added option OPT_MERGE_DRY_STORMS to merge storms that produce no
+**     runoff into one event, for constant as well as random storms
+**     (see GenerateStorm)
 **
 **  $Id: tStorm.h,v 1.31 2004-06-16 13:37:42 childcvs Exp $
 */
@@ -47,17 +50,20 @@ public:
     tStorm( bool optVariable = true );
   tStorm( const tInputFile &, tRand *, bool no_write_mode = false );
   tStorm( const tStorm& );
-    void GenerateStorm( double tm, double minp=0.0, double mind=0.0);
+    void GenerateStorm( double tm, double minp=0.0, double mind=0.0,
+                        double maxtm=-1.0 );
     double getStormDuration() const;
     double interstormDur() const;
     double getRainrate() const;
     bool getOptVar() const;
+    int getNumMerged() const {return nMerged;}  // storms in the last event
   void TurnOnOutput( const tInputFile& );
   void TurnOffOutput();
   inline void setRand( tRand* ptr ) {rand = ptr;}
   void setRainrate( double );
 
 private:
+    void MergeDryStorms( double tm, double minp, double mind, double tlim );
     double ExpDev() const;
     double GammaDev(double) const;
 
@@ -72,6 +78,9 @@ private:
     double endtm;      // The end time of the run, just in case a big enough
                        // storm is never generated
     bool optVariable;  // Flag indicating whether storms are random or not
+    bool optMergeDry;  // Merge storms that give no runoff (see GenerateStorm)
+    double maxMergeDur; // Longest merged event (0 = no limit)
+    int nMerged;       // Number of storms drawn for the last event
 };
 
 
@@ -23,6 +23,8 @@
 #include "tStratGrid.h"
 #include "../tLNode/tLNode.h"
 #include "../tMesh/tMesh.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
 
 #include <iostream>
 
@@ -101,7 +103,7 @@ tStratGrid::tStratGrid( tInputFile const &infile, tMesh<tLNode> *mp_)
   StratConnect = new tMatrix<tTriangle*>(imax,jmax);
 
   // Fill one stratnode with the initial layerlist properties
-  const tStratNode a_StratNode(infile);
+  const tStratNode a_StratNode( infile, mp->getContext() );
 
   // Construct the Grid by assigning coordinates and the initial layerlist
   // to the nodes present in the tStratNode Matrix
@@ -140,14 +142,14 @@ tStratGrid::tStratGrid( tInputFile const &infile, tMesh<tLNode> *mp_)
 
 
   // Build StratConnect
-  if (1) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) ) {
     std::cout
       <<"   \n"
       <<"Building the StratConnect table of triangles in constructor...."
       <<std::endl;
   }
   updateConnect();
-  if (1) { //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) ) {
     std::cout
       <<"Building the StratConnect table of triangles in constructor finished"
       <<"\n    "<<std::endl;
@@ -155,12 +157,12 @@ tStratGrid::tStratGrid( tInputFile const &infile, tMesh<tLNode> *mp_)
 
   // Initialize the elevations of the StratNodes by interpolating between the
   // Triangles of the tMesh
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) )
     std::cout<<" Initializing tStratGrid elevations by interpolation, for the first Time "<<std::endl;
   InterpolateElevations();
 
   setSectionBase();   // DEBUG FUNCTION, all stratnodes have to know their initial, stratigraphy basis
-  if (1) {//DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) ) {
     std::cout
       <<" Finished Initializing tStratGrid elevations by interpolation, for the first Time "
       <<"\n    "<<std::endl;
@@ -312,6 +314,20 @@ TriBox::TriBox(tTriangle const *ct,
   jmax = int(floor((maxy-ycorner)/griddx));
 }
 
+/**************************************************************************\
+ **
+ **  tStratGrid::setMesh
+ **  @brief point to a new mesh, and to that mesh's model context
+ **
+\**************************************************************************/
+void tStratGrid::setMesh( tMesh<tLNode>* ptr )
+{
+  mp = ptr;
+  for( int i=0; i<StratNodeMatrix->getNumRows(); ++i )
+    for( int j=0; j<StratNodeMatrix->getNumCols(); ++j )
+      (*StratNodeMatrix)( i, j ).setContext( mp->getContext() );
+}
+
 /**************************************************************************\
  **
  **  tStratGrid::updateConnect
@@ -366,6 +382,7 @@ void tStratGrid::updateConnect()
 \***********************************************************************/
 void tStratGrid::UpdateStratGrid(tUpdate_t mode, double time)
 {
+  tProfileScope scope( "tStratGrid::UpdateStratGrid" );
   // 0 = Initialisation at the beginning of a time step
   switch(mode){
   case k0:
@@ -490,7 +507,7 @@ void tStratGrid::InterpolateElevations()
 	// Set the elevation to the interpolated value, e.g force the StratNode columns up or down
 	(*StratNodeMatrix)(i,j).setZ( newz );
 
-	if (0) //DEBUG
+	if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) )
 	  std::cout<<"i= "<<i<<" j= "<<j<<" elev= "
 	      <<newz<<" ,surr 3 nodes have Z "<<lnds[0]->getZ()
 	      <<" "<<lnds[1]->getZ()<<" "<<lnds[2]->getZ()<<std::endl;
@@ -719,7 +736,7 @@ void tStratGrid::SweepChannelThroughRectGrid(double time)
 {
   int i,j;
   
-  if(1) std::cout<<"SCTRG";
+  CHILD_LOG( tLog::kDebug, tLog::kStratGrid, "SCTRG" );
 
   for(i=0; i<imax; i++){
     for(j=0; j<jmax; j++){
@@ -774,7 +791,7 @@ void tStratGrid::SweepChannelThroughRectGrid(double time)
     } // i
   }   // j
 
-  if(1) std::cout<<".End" << std::endl;
+  CHILD_LOG( tLog::kDebug, tLog::kStratGrid, ".End" );
 
 } // end of function tStratGrid SweepChannelThroughRectGrid(double time)
 
@@ -964,29 +981,21 @@ double tStratGrid::CompassAngle(tLNode *cn, tLNode *dn) const
  **
 \**************************************************************************/
 
-// initialize static members numg and grade
-int tStratNode::numg = 0;
-tArray<double> tStratNode::grade = 1;
-double tStratNode::maxregdep = 1.;
-double tStratNode::KRnew = 1.0;
-
-
-
 // 1) tStratNode default constructor
 tStratNode::tStratNode() :
   layerlist(),ClosestNode(0),
-  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0)
+  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0),context_(0)
 {}
 
 tStratNode::tStratNode( int ) :
   layerlist(),ClosestNode(0),
-  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0)
+  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0),context_(0)
 {}
 
 // 2) tStratNode constructor for indices & coordinates
 tStratNode::tStratNode( double x_, double y_):
   layerlist(),ClosestNode(0),
-  x(x_), y(y_), z(0.),sectionZ(0.),newz(0.),i(0),j(0)
+  x(x_), y(y_), z(0.),sectionZ(0.),newz(0.),i(0),j(0),context_(0)
 {}
 
 // 3) tStratNode constructor for indices, coordinates and assigning the initial
@@ -994,16 +1003,17 @@ tStratNode::tStratNode( double x_, double y_):
 tStratNode::tStratNode(double x_, double y_,
 		       const tStratNode &orig):
   layerlist(),ClosestNode(0),
-  x(x_), y(y_), z(0.),sectionZ(0.),newz(0.),i(0),j(0)
+  x(x_), y(y_), z(0.),sectionZ(0.),newz(0.),i(0),j(0),context_(0)
 {
   layerlist = orig.layerlist;
 }
 
 
-// 4) tStratNode constructor for layerlist initialisation by inputfile
-tStratNode::tStratNode( tInputFile const &infile ) :
+// 4) tStratNode constructor for layerlist initialisation by inputfile;
+//    stores the grain-size and layering parameters in the model context
+tStratNode::tStratNode( tInputFile const &infile, tModelContext *context ) :
   layerlist(),ClosestNode(0),
-  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0)
+  x(0.),y(0.), z(0.),sectionZ(0.),newz(0.),i(0),j(0),context_(context)
 {
   int i;
   char add[2], name[20];
@@ -1013,32 +1023,32 @@ tStratNode::tStratNode( tInputFile const &infile ) :
   tArray<double> dgradebrhelp;
 
   //std::cout << "=>STRATNODE( infile )" << std::endl;
-  numg = infile.ReadItem( numg, "NUMGRNSIZE" );
+  context_->sg_numg = infile.ReadItem( context_->sg_numg, "NUMGRNSIZE" );
 
   // This is a --HACK-- by QUINTIJN !!! Do not use this value
   // while trying to sort grainsizes properly on the tMesh, it only applies to tStratGRid
   // with is more geomettrical deposition functions in the tFloodplain class
-  numg++;
+  context_->sg_numg++;
   //-Carefull, this is done to give a StratNode 2 grainsizes classes,
   //while the Mesh is still running with 1 grain size as demanded
   //by detachment limited conditions during meandering
 
-  grade.setSize( numg );
-  maxregdep = infile.ReadItem( maxregdep, "SG_MAXREGDEPTH" );
-  KRnew = infile.ReadItem( KRnew, "KR" );
-  if( KRnew<0.0 )
+  context_->sg_grade.setSize( context_->sg_numg );
+  context_->sg_maxregdep = infile.ReadItem( context_->sg_maxregdep, "SG_MAXREGDEPTH" );
+  context_->sg_KRnew = infile.ReadItem( context_->sg_KRnew, "KR" );
+  if( context_->sg_KRnew<0.0 )
     ReportFatalError( "Erodibility factor KR must be positive." );
 
   i=0;
   add[0]='1';
   add[1]='\0';
 
-  while ( i<numg ){
+  while ( i<context_->sg_numg ){
     // Reading in grain size diameter info
     strcpy( name, "GRAINDIAM");
     strcat( name, add );
     help = infile.ReadItem( help, name);
-    grade[i] = help;
+    context_->sg_grade[i] = help;
     i++;
     add[0]++;
   }
@@ -1051,14 +1061,14 @@ tStratNode::tStratNode( tInputFile const &infile ) :
 
   if(!lay){
 
-    dgradehelp.setSize( numg );
-    dgradebrhelp.setSize( numg );
+    dgradehelp.setSize( context_->sg_numg );
+    dgradebrhelp.setSize( context_->sg_numg );
     sum = 0;
     sumbr = 0;
     i=0;
     add[0]='1';
 
-    while ( i<numg ){
+    while ( i<context_->sg_numg ){
       // Reading in proportions for initial regolith and bedrock
       strcpy( name, "REGPROPORTION");
       strcat( name, add );
@@ -1100,10 +1110,10 @@ tStratNode::tStratNode( tInputFile const &infile ) :
       // in the regolith layer dgrade is saving
       // the proportion of grain size available from the bedrock
 
-      layhelp.setDgradesize(numg);
+      layhelp.setDgradesize(context_->sg_numg);
       i=0;
       help = infile.ReadItem( help, "BEDROCKDEPTH");
-      while(i<numg){
+      while(i<context_->sg_numg){
 	layhelp.setDgrade(i, help*dgradebrhelp[i]);
 	i++;
       }
@@ -1118,13 +1128,13 @@ tStratNode::tStratNode( tInputFile const &infile ) :
       layhelp.setErody(help);
       help = infile.ReadItem( help, "REGINIT");
       extra = 0;
-      if(help > maxregdep){
+      if(help > context_->sg_maxregdep){
 	// too much regolith, create two layers the bottom layer is made here
-	extra = help - maxregdep;
+	extra = help - context_->sg_maxregdep;
 	//layhelp.setDepth(extra);
 	//layhelp.setDgradesize(numg);
 	i=0;
-	while(i<numg){
+	while(i<context_->sg_numg){
 	  layhelp.setDgrade(i, extra*dgradehelp[i]);
 	  i++;
 	}
@@ -1134,8 +1144,8 @@ tStratNode::tStratNode( tInputFile const &infile ) :
 	// the top regolith layer is now made
 	layhelp.setRtime(0.);
 	i=0;
-	while(i<numg){
-	  layhelp.setDgrade(i, maxregdep*dgradehelp[i]);
+	while(i<context_->sg_numg){
+	  layhelp.setDgrade(i, context_->sg_maxregdep*dgradehelp[i]);
 	  i++;
 	}
 	layerlist.insertAtFront( layhelp );
@@ -1143,7 +1153,7 @@ tStratNode::tStratNode( tInputFile const &infile ) :
       else{
 	// create only one regolith layer
 	i=0;
-	while(i<numg){
+	while(i<context_->sg_numg){
 	  layhelp.setDgrade(i, help*dgradehelp[i]);
 	  i++;
 	}
@@ -1160,10 +1170,10 @@ tStratNode::tStratNode( tInputFile const &infile ) :
 	ReportFatalError( "Erodibility factor KB must be positive." );
       layhelp.setErody(help);
       layhelp.setSed(tLayer::kBedRock);
-      layhelp.setDgradesize(numg);
+      layhelp.setDgradesize(context_->sg_numg);
       i=0;
       help = infile.ReadItem( help, "BEDROCKDEPTH");
-      while(i<numg){
+      while(i<context_->sg_numg){
 	layhelp.setDgrade(i, help*dgradebrhelp[i]);
 	i++;
       }
@@ -1178,6 +1188,7 @@ tStratNode::tStratNode( tInputFile const &infile ) :
 // 5) So, when do I use this one ?
 tStratNode::tStratNode( const tStratNode &orig )
   :
+  tCounted< tStratNode, tMemoryAccount::kStratNode >(),
   layerlist(),
   ClosestNode(orig.ClosestNode),
   x(orig.x),
@@ -1186,7 +1197,8 @@ tStratNode::tStratNode( const tStratNode &orig )
   sectionZ(orig.sectionZ),
   newz(orig.newz),
   i(orig.i),
-  j(orig.j)
+  j(orig.j),
+  context_(orig.context_)
 {
   layerlist = orig.layerlist;
 }
@@ -1204,13 +1216,14 @@ tStratNode &tStratNode::operator=( const tStratNode &right )
       newz = right.newz;
       i = right.i;
       j = right.j;
+      context_ = right.context_;
     }
   return *this;
 }
 
 tStratNode::~tStratNode()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStratGrid ) )
     std::cout << "    ~STRATNODE()" << std::endl;
 }
 
@@ -1339,34 +1352,34 @@ double tStratNode::getAgeAtDepth( double val) const
 
 void tStratNode::setGrade( int i, double size ) const
 {
-  if(i>=numg)
+  if(i>=context_->sg_numg)
     ReportFatalError("Trying to set a grain size for an index which is too large");
-  grade[i] = size;
+  context_->sg_grade[i] = size;
 }
 
 double tStratNode::getMaxregdep() const
 {
-  return maxregdep;
+  return context_->sg_maxregdep;
 }
 
 int tStratNode::getNumg() const
 {
-  return numg;
+  return context_->sg_numg;
 }
 
 void tStratNode::setNumg( int size ) const
 {
-  numg = size;
+  context_->sg_numg = size;
 }
 
 double tStratNode::getGrade( int i ) const
 {
-  return grade[i];
+  return context_->sg_grade[i];
 }
 
 const tArray< double >& tStratNode::getGrade( ) const
 {
-  return grade;
+  return context_->sg_grade;
 }
 
 double tStratNode::getLayerCtime( int l ) const
@@ -1562,9 +1575,9 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
   int g;
   double dhtotal,remainder,thickness;
   double tofill;
-  tArray<double> fill(numg);
-  tArray<double> ratio(numg);
-  tArray<double> newl(numg);
+  tArray<double> fill(context_->sg_numg);
+  tArray<double> ratio(context_->sg_numg);
+  tArray<double> newl(context_->sg_numg);
 
   g=0;
   dhtotal=0.0;
@@ -1578,7 +1591,7 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
   // SimpleErodep does not use an active top layer.
   // real layering starts with index 1, the rest is zero
   g=0;
-  while(g<numg){
+  while(g<context_->sg_numg){
     setLayerDgrade(l,g,0.0);
     g++;
   }
@@ -1625,7 +1638,7 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
 
       //std::cout << "Deposition at  "<< x <<' '<< y <<" dh[0]= " << dh[0] << " dh[1]= " << dh[1] << " dhtotal= " << dhtotal << " time= " <<tt<< '\n';
 
-      if(getLayerDepth(l) >=maxregdep){        // The top layer is already too thick
+      if(getLayerDepth(l) >=context_->sg_maxregdep){        // The top layer is already too thick
         if(getLayerDepth(l) >=1000.){         // its the initialisation layer
 	  makeNewLayerBelow(l-1, getLayerSed(l), getLayerErody(l), dh, tt,current);
         }
@@ -1633,22 +1646,22 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
           makeNewLayerBelow(l-1, getLayerSed(l), getLayerErody(l), dh, tt,current);
         }
       }
-      else if(getLayerDepth(l) < maxregdep){                   //potential for adding material in top layer
-     	if(getLayerDepth(l) + dhtotal <= maxregdep){          // enough space in top layer, put it here
+      else if(getLayerDepth(l) < context_->sg_maxregdep){                   //potential for adding material in top layer
+     	if(getLayerDepth(l) + dhtotal <= context_->sg_maxregdep){          // enough space in top layer, put it here
 	  g=0;
-	  while(g<numg){
+	  while(g<context_->sg_numg){
 	    addtoLayer(l,g,dh[g],tt,current);                       // just put everything here
 	    g++;
 	  }
      	}
-     	else if(getLayerDepth(l) + dhtotal > maxregdep){     // you would fill more than one layer
-	  tofill = maxregdep-getLayerDepth(l);              // remaining space available in top layer
+     	else if(getLayerDepth(l) + dhtotal > context_->sg_maxregdep){     // you would fill more than one layer
+	  tofill = context_->sg_maxregdep-getLayerDepth(l);              // remaining space available in top layer
 	  tArray<double>ratio(2);
 	  ratio[0] = dh[0]/dhtotal;                         // fraction coarse in added dh
 	  ratio[1] = dh[1]/dhtotal;                         // fraction fine
 
 	  g=0;
-	  while(g<numg){
+	  while(g<context_->sg_numg){
      	    fill[g]= (ratio[g])*tofill;
      	    addtoLayer(l,g,fill[g],tt,current);                     // complete top sediment layer
      	    g++;
@@ -1656,13 +1669,13 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
 
      	  // How much is left ?
      	  remainder=dhtotal-tofill;                // remaining stuff to make a new layer
-	  if(remainder <= maxregdep+10.){           // we can only fill one layer extra
+	  if(remainder <= context_->sg_maxregdep+10.){           // we can only fill one layer extra
 	    newl[0]=ratio[0]*remainder;
 	    newl[1]=ratio[1]*remainder;
 	    makeNewLayerBelow(l-1, getLayerSed(l), getLayerErody(l), newl, tt,current);
 	    remainder =0.0;
 	  }
-	  else if(remainder <= maxregdep+10.){
+	  else if(remainder <= context_->sg_maxregdep+10.){
      	    std::cout<<"Loads of deposition at " << x <<' '<< y <<" time= " <<tt<< '\n';
      	    std::cout<<"Make extra layers ??? \n";
      	    exit(1);
@@ -1675,7 +1688,7 @@ void tStratNode::EroDepSimple( int l, tArray<double>dh, double tt,double current
 
     //2)No top sediment layer, deposit everything  on top of bedrock
     else if(getLayerSed(i)==0){
-      makeNewLayerBelow(-1,tLayer::kSed,KRnew,dh,tt,current);
+      makeNewLayerBelow(-1,tLayer::kSed,context_->sg_KRnew,dh,tt,current);
     }
 
   }
@@ -1884,7 +1897,7 @@ tArray<double> tStratNode::addtoLayer(int l, double val, double tt)
   tListIter<tLayer> ly ( layerlist );
   tLayer  * hlp;
   hlp=ly.FirstP();
-  tArray<double> ret(numg);
+  tArray<double> ret(context_->sg_numg);
   double amt;
 
   int n=0;
@@ -1900,7 +1913,7 @@ tArray<double> tStratNode::addtoLayer(int l, double val, double tt)
       // have enough material in this layer to fufill all erosion needs
       amt=hlp->getDepth();			     // Total thickness
       n=0;
-      while(n<numg)
+      while(n<context_->sg_numg)
 	{
 	  ret[n]=hlp->getDgrade(n)*val/amt;             // return this, will be passed on to top layer
 	  hlp->addDgrade(n,hlp->getDgrade(n)*val/amt);  // modify the stratigraphic layer
@@ -1917,7 +1930,7 @@ tArray<double> tStratNode::addtoLayer(int l, double val, double tt)
     {
       // need to remove entire layer
       n=0;
-      while(n<numg)
+      while(n<context_->sg_numg)
 	{
 	  ret[n]=-1*hlp->getDgrade(n);
 	  n++;
@@ -2029,8 +2042,8 @@ void tStratNode::makeNewLayerBelow(int i, tLayer::tSed_t sd, double erd,
   hlp.setRtime(tt);
   hlp.setEtime(0.);
   n=0;
-  hlp.setDgradesize(numg);
-  while(n<numg){
+  hlp.setDgradesize(context_->sg_numg);
+  while(n<context_->sg_numg){
     assert( sz[n]>=0.0 );
     hlp.setDgrade(n, sz[n]);
     n++;
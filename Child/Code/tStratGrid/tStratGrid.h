@@ -22,6 +22,7 @@
 #include "../tInputFile/tInputFile.h"
 #include "../tMatrix/tMatrix.h"
 #include "../tList/tList.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
 
 template< class T > class tMesh;
 class tTriangle;
@@ -46,12 +47,13 @@ class tLNode;
  */
 /**************************************************************************/
 
-class tStratNode
+class tStratNode :
+  private tCounted< tStratNode, tMemoryAccount::kStratNode >
 {
 public:
   tStratNode();
   tStratNode( int ); // for tMatrix
-  tStratNode( tInputFile const &infile );
+  tStratNode( tInputFile const &infile, tModelContext *context );
   tStratNode( double , double );
   tStratNode( double , double , const tStratNode &);
   tStratNode( const tStratNode & );
@@ -66,6 +68,7 @@ public:
   void setJ( int );
   void setSectionBase(double);	  // sets the base of the stratigraphic section
   void setNewZ( double );	  // sets new z value, used for interpolation
+  void setContext( tModelContext *c ) { context_ = c; } // sets model params
 
   double getX() const {           // returns x coord
     return x;
@@ -151,10 +154,9 @@ protected:
   int i;
   int j;
 
-  static int numg;
-  static tArray< double > grade;
-  static double maxregdep;      // Active layer, and stratigraphic layer thickness.
-  static double KRnew;          // erodability of a new layer
+  tModelContext *context_;  // -> per-model params: number of grain sizes,
+                            // grain sizes, active layer and stratigraphic
+                            // layer thickness, erodibility of a new layer
 };
 
 //--------------------------END OF STRATNODE--------------------------------
@@ -223,7 +225,7 @@ public:
   double getSubsurface_mbelt(int) const;
   double getOutputTime(int) const;
   int getnWrite() const;
-  void setMesh( tMesh<tLNode>* ptr ){ mp = ptr;}
+  void setMesh( tMesh<tLNode>* );
   void updateConnect();
   double CalculateMeanderCurrent(tTriangle *, double, double) const;
   double CompassAngle(tLNode *,tLNode *) const;
@@ -12,10 +12,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <iostream>
 
 #include "meander.h"
 #include "../Definitions.h"
+#include "../tLog/tLog.h"
 
 #define integer int
 #define doublereal double
@@ -136,6 +138,14 @@ static const doublereal c_b7 = 1.;
 
 /*     $Id: meander.cpp,v 1.17 2004-06-16 13:37:44 childcvs Exp $ */
 
+/*     getcurv_, forcelag_ and forcedist_ are written so that their */
+/*     loops have no early exits and no loop-invariant branches, and */
+/*     forcedist_ looks up the span of each Gaussian by bisection of */
+/*     xs instead of walking to it; they give the same results as the */
+/*     straight translations. meander_ only uses its arguments, so */
+/*     tStreamMeander::CalcMigration may run it on several reaches at */
+/*     once. */
+
 void meander_(const integer *stations, const integer *stnserod, 
 	      const doublereal *x, const doublereal *y,
 	      const doublereal *xs, const doublereal *dels, 
@@ -336,7 +346,7 @@ void channel_(const integer *stnserod, const integer *stations,
 /*     print *, 'stnserod in channel:', stnserod */
     i__1 = *stnserod - 1;
     for (s = 1; s <= i__1; ++s) {
-	if (slope[s] <= 0.) {
+	if (slope[s] <= 0. && CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander )) {
 	  std::cout << "neg. or zero slope:" << slope[s] << " " << s 
 	       << " " << flow[s] << std::endl;
 	}
@@ -345,7 +355,8 @@ void channel_(const integer *stnserod, const integer *stations,
 /*          go back to H ~= R approx. */
 	    radh = depth[s];
 	    if (depth[s] <= 0.) {
-	      std::cout << depth[s] << std::endl;
+	      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
+	        std::cout << "non-positive depth:" << depth[s] << std::endl;
 		return;
 	    }
 	    vel[s] = flow[s] / depth[s] / width[s];
@@ -465,6 +476,7 @@ void getcurv_(const integer *stnserod, const integer * /*stations*/,
     doublereal a, b, c__;
     integer s;
     doublereal sn, mag, carg;
+    const doublereal pi = acos(-1.);
 
 /*     use law of cosines to find magnitude of angle, use cross */
 /*     product to find sign of curvature */
@@ -478,24 +490,22 @@ void getcurv_(const integer *stnserod, const integer * /*stations*/,
     /* Function Body */
 
     i__1 = *stnserod - 1;
-    for (s = 2; s <= i__1; ++s) {
-	a = dels[s];
-	b = dels[s - 1];
-	if (a == 0. || b == 0.) {
+    for (s = 1; i__1 >= 2 && s <= i__1; ++s) {
+	if (dels[s] == 0.) {
 	  std::cout << "dels(s) or dels(s-1) equals zero" << std::endl;
 	  exit(1);
 	}
+    }
+    for (s = 2; s <= i__1; ++s) {
+	a = dels[s];
+	b = dels[s - 1];
 	c__ = sqrt((delx[s - 1] + delx[s]) * (delx[s - 1] + delx[s]) + (dely[
 		s - 1] + dely[s]) * (dely[s - 1] + dely[s]));
 	carg = (a * a + b * b - c__ * c__) / (a * 2. * b);
-	if (carg < -1.) {
 /*            if( carg .gt. -1.0001 ) carg = -1.d0 */
-	    carg = -1.;
-	}
-	if (carg > 1.) {
+	carg = carg < -1. ? -1. : carg;
 /*            if( carg .lt. 1.0001 ) carg = 1.d0 */
-	    carg = 1.;
-	}
+	carg = carg > 1. ? 1. : carg;
 /*            print *, 'arccosine argument out of bounds: ',carg, */
 /*     +               ' at s= ', s,' of ',stnserod,'; a,b,c= ',a,b,c, */
 /*     +               '; delx(s-1),delx(s),dely(s-1),dely(s): ', */
@@ -503,7 +513,7 @@ void getcurv_(const integer *stnserod, const integer * /*stations*/,
 /*     +               '; last curv: ',curvature(s-1) */
 /*            stop */
 /*         end if */
-	mag = (acos(-1.) - acos(carg)) / ((a + b) / 2.);
+	mag = (pi - acos(carg)) / ((a + b) / 2.);
 	d__1 = delx[s - 1] * dely[s] - dely[s - 1] * delx[s];
 	sn = d_sign(&c_b7, &d__1);
 	curvature[s] = mag * sn;
@@ -556,78 +566,37 @@ void forcelag_(const integer *stnserod, const integer *stations,
 
     /* Function Body */
 
-    if (*stations != *stnserod) {
-	i__1 = *stations - 1;
-	for (s = 1; s <= i__1; ++s) {
-	    if (width[s] != 0. && width[s] > depth[s] * 2.) {
+/*     with a tail, only channels wider than twice their depth are */
+/*     forced */
+    const bool widechannels = *stations != *stnserod;
+    i__1 = *stations - 1;
+    for (s = 1; s <= i__1; ++s) {
+	latforce[s] = 0.;
+	lag[s] = 0.;
+	if (width[s] != 0. && (!widechannels || width[s] > depth[s] * 2.)) {
 /* Computing 2nd power */
-		d__1 = vel[s];
-		forcefactor = *rho * (d__1 * d__1) / depth[s];
-/* * (1. - depth[s] * 2. / width[s]);*/
-		latforce[s] = 0.;
-		lag[s] = 0.;
-		xmagcurvep1 = fabs(curvature[s + 1]);
-		xmagcurve =fabs(curvature[s]);
-		if ((curvature[s + 1] * curvature[s] > 0. && xmagcurvep1 > 
-			xmagcurve && xmagcurvep1 * width[s] <= 2.) || 
-			(curvature[s] == 0. && xmagcurvep1 * width[s] <= 2.)) {
-		    delacs = acs[s + 1] - acs[s];
-		} else if (curvature[s + 1] * curvature[s] < 0. && 
-			xmagcurvep1 * width[s] <= 2.) {
-		    delacs = acs[s + 1] - depth[s] * width[s] / 2.;
-		} else {
-		    delacs = 0.;
-		}
-		d__1 = -curvature[s + 1];
-		latforce[s] = forcefactor * delacs * delacs / dels[s] * 
-        d_sign(&c_b7, &d__1); /* * cos(dels[s] * xmagcurve / 2.); */
-		latvel = vel[s] * -1. * delacs / depth[s] / dels[s];
-		if (latvel > 0.) {
-		    lag[s] = vel[s] * (deln[s + 1] + deln[s]) / 2. / latvel;
-		} else {
-		    latforce[s] = 0.;
-		    lag[s] = 0.;
-		}
+	    d__1 = vel[s];
+	    forcefactor = *rho * (d__1 * d__1) / depth[s];
+/* * (1. - depth[s] * 2. / width[s]); */
+	    xmagcurvep1 = fabs(curvature[s + 1]);
+	    xmagcurve = fabs(curvature[s]);
+	    if ((curvature[s + 1] * curvature[s] > 0. && xmagcurvep1 > 
+		    xmagcurve && xmagcurvep1 * width[s] <= 2.) || 
+		    (curvature[s] == 0. && xmagcurvep1 * width[s] <= 2.)) {
+		delacs = acs[s + 1] - acs[s];
+	    } else if (curvature[s + 1] * curvature[s] < 0. && 
+		    xmagcurvep1 * width[s] <= 2.) {
+		delacs = acs[s + 1] - depth[s] * width[s] / 2.;
 	    } else {
-		latforce[s] = 0.;
-		lag[s] = 0.;
+		delacs = 0.;
 	    }
-	}
-    } else {
-	i__1 = *stations - 1;
-	for (s = 1; s <= i__1; ++s) {
-	    if (width[s] != 0.) {
-/* Computing 2nd power */
-		d__1 = vel[s];
-		forcefactor = *rho * (d__1 * d__1) / depth[s];
-/* * (1. - depth[s] * 2. / width[s]); */
-		latforce[s] = 0.;
-		lag[s] = 0.;
-		xmagcurvep1 = fabs(curvature[s + 1]);
-		xmagcurve = fabs(curvature[s]);
-		if ((curvature[s + 1] * curvature[s] > 0. && xmagcurvep1 > 
-			xmagcurve && xmagcurvep1 * width[s] <= 2.) || 
-			(curvature[s] == 0. && xmagcurvep1 * width[s] <= 2.)) {
-		    delacs = acs[s + 1] - acs[s];
-		} else if (curvature[s + 1] * curvature[s] < 0. && 
-			xmagcurvep1 * width[s] <= 2.) {
-		    delacs = acs[s + 1] - depth[s] * width[s] / 2.;
-		} else {
-		    delacs = 0.;
-		}
-		d__1 = -curvature[s + 1];
+	    d__1 = -curvature[s + 1];
+	    latvel = vel[s] * -1. * delacs / depth[s] / dels[s];
+	    if (latvel > 0.) {
 		latforce[s] = forcefactor * delacs * delacs / dels[s] * 
-        d_sign(&c_b7, &d__1); /* * cos(dels[s] * xmagcurve / 2.); */
-		latvel = vel[s] * -1. * delacs / depth[s] / dels[s];
-		if (latvel > 0.) {
-		    lag[s] = vel[s] * (deln[s + 1] + deln[s]) / 2. / latvel;
-		} else {
-		    latforce[s] = 0.;
-		    lag[s] = 0.;
-		}
-	    } else {
-		latforce[s] = 0.;
-		lag[s] = 0.;
+		    d_sign(&c_b7, &d__1);
+		/* * cos(dels[s] * xmagcurve / 2.); */
+		lag[s] = vel[s] * (deln[s + 1] + deln[s]) / 2. / latvel;
 	    }
 	}
     }
@@ -654,7 +623,7 @@ void forcedist_(const integer *stnserod, const integer *stations,
     doublereal gaussian;
     integer s;
     doublereal tenlambda;
-    integer sp;
+    integer sp, spfirst, splast;
     doublereal gaussfactor, xdel, xdest, xstrt, /*xdepth,*/ xtrmnt;
 
 
@@ -695,31 +664,30 @@ void forcedist_(const integer *stnserod, const integer *stations,
 	if (tenlambda > xs[*stations]) {
 	    tenlambda = xs[*stations];
 	}
-	if (lag[s] <= tenlambda) {
+	if (lag[s] <= tenlambda && lambda[s] != 0.) {
 	    xdest = xs[s] + lag[s];
 	    xtrmnt = xdest + lambda[s] * 2.;
 	    xstrt = xdest - lambda[s] * 2.;
 	    if (xstrt < xs[s]) {
 		xstrt = xs[s];
 	    }
-	    sp = s;
-	    while( sp <= *stnserod && xs[sp] <= xtrmnt) {
-		if (xs[sp] >= xstrt) {
-		    xdel = fabs(xdest - xs[sp]);
-		    if (lambda[s] != 0.) {
+/*           xs increases downstream, so the points sp >= s with */
+/*           xstrt <= xs(sp) <= xtrmnt are a run [spfirst, splast) */
+	    spfirst = std::lower_bound(&xs[s], &xs[*stnserod] + 1, xstrt) - 
+		    &xs[1] + 1;
+	    splast = std::upper_bound(&xs[spfirst], &xs[*stnserod] + 1, 
+		    xtrmnt) - &xs[1] + 1;
 /* Computing 2nd power */
-			d__1 = xdel;
+	    d__2 = lambda[s];
+	    d__2 *= d__2;
+	    for (sp = spfirst; sp < splast; ++sp) {
+		xdel = fabs(xdest - xs[sp]);
 /* Computing 2nd power */
-			d__2 = lambda[s];
-			gaussian = exp(d__1 * d__1 * -1. / 2. / (d__2 * d__2))
-				 / sqrt(2. * 3.1416) / lambda[s];
-			gaussfactor = gaussian * latforce[s];
-		    } else {
-			gaussfactor = 0.;
-		    }
-		    tauwall[sp] += gaussfactor;
-		}
-		++sp;
+		d__1 = xdel;
+		gaussian = exp(d__1 * d__1 * -1. / 2. / d__2)
+			 / sqrt(2. * 3.1416) / lambda[s];
+		gaussfactor = gaussian * latforce[s];
+		tauwall[sp] += gaussfactor;
 	    }
 	}
     }
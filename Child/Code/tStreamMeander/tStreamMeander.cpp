@@ -7,10 +7,16 @@
 */
 /**************************************************************************/
 
+#include <map>
+#include <set>
+#include <vector>
 #include "tStreamMeander.h"
 #define kBugTime 5000000
 
 #include "meander.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
+#include "../tMesh/tMeshRange.h"
 
 #if 0
 /*****************************************************************************\
@@ -213,13 +219,13 @@ void tStreamMeander::FindMeander()
   tLNode * cn;
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
 
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
     std::cout << "FindMeander...()";
 
   for( cn = nodIter.FirstP(); nodIter.IsActive(); cn = nodIter.NextP() )
     {
       //nmg
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 	     std::cout<<"FM cn "<<cn->getID()<<" z = "<<cn->getZ()<<std::endl;
       cn->setReachMember( false );
 #if FIXCRITFLOWBUG
@@ -234,7 +240,7 @@ void tStreamMeander::FindMeander()
 	  }
       else
 	  {
-	     if (0) {//DEBUG
+	     if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ) {
 	        if( cn->Meanders() )
 	           std::cout << "FindMeander: node " << cn->getID() << " has Q " << cn->getQ() << " and A " << cn->getDrArea()
 		            << " and mndr is being switched off." << std::endl;
@@ -242,7 +248,7 @@ void tStreamMeander::FindMeander()
 	     cn->setMeanderStatus( kNonMeanderNode );
 	   }
     }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
     std::cout << "done\n";
 }
 
@@ -297,7 +303,7 @@ tLNode* tStreamMeander::BlockShortcut( tLNode* crn, tLNode* bpn, tLNode& nn,
       bpn->setNew2DCoords( 0.0, 0.0 );
       bpn->AddDrArea( -crn->getDrArea() );
       crn->setDownstrmNbr( dn );
-	  if(0) //DEBUG
+	  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 	     std::cout<<"BlockShortcut: addition failed, un-meanderizing node "<<bpn->getID()<<std::endl;
    }
    
@@ -429,7 +435,7 @@ const tArray< double > tStreamMeander::FindInterpCoords( tLNode* crn, tLNode* nP
 int tStreamMeander::InterpChannel( double time )
 {
    const double timetrack = time;
-   if (1) {//DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ) {
       if( timetrack >= kBugTime )
           std::cout << "InterpChannel()\n";
    }
@@ -484,11 +490,11 @@ int tStreamMeander::InterpChannel( double time )
                tLNode* newnodeP = BlockShortcut( crn, bpn, nn, ic, time );
                if( newnodeP != NULL ){
                   change = true;
-                  if (1) //DEBUG
+                  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                       std::cout<<"IC BS pt "<<newnodeP->getID()<<" added at "
                           << newnodeP->getX() << "," << newnodeP->getY() << std::endl;
                } else {
-		 if (1) //DEBUG
+		 if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 		   std::cout<<"IC BS pt NOT added at "
 		       << ic[0] << "," << ic[1] << std::endl;
 		 // Process of aborting point addition may have left node(s)
@@ -511,7 +517,7 @@ int tStreamMeander::InterpChannel( double time )
                   if( newnodeP != NULL )
                   {
                      change = true;
-                      if (1) //DEBUG
+                      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 			std::cout<<"IC pt "<<newnodeP->getID()<<" added at "
 			    << ic[k*3+0] << "," << ic[k*3+1] << std::endl;
                     // previous node (prevNode) flows to new node (newnodeP)
@@ -523,7 +529,7 @@ int tStreamMeander::InterpChannel( double time )
                      assert( prevNode->getFlowEdg()->getDestinationPtr() == newnodeP );
                      prevNode = newnodeP;
                   } else {
-		    if (1) //DEBUG
+		    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 		      std::cout<<"IC pt NOT added at "
 			  << ic[k*3+0] << "," << ic[k*3+1] << std::endl;
 		    // Process of aborting point addition may have left node(s)
@@ -581,7 +587,7 @@ int tStreamMeander::InterpChannel( double time )
 
 void tStreamMeander::MakeReaches( double ctime)
 {
-  if (1) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
     std::cout<<"tStreamMeander::MakeReaches...";
   netPtr->UpdateNet( ctime ); //first update the net
   do
@@ -592,7 +598,7 @@ void tStreamMeander::MakeReaches( double ctime)
       FindReaches(); //find reaches of meandering nodes
     }
   while( InterpChannel( ctime ) ); //updates
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
     std::cout<<"done MakeReaches"<<std::endl;
 }
 
@@ -645,7 +651,7 @@ void tStreamMeander::FindReaches()
    tPtrList< tLNode > rnodList, *plPtr, listtodelete;
    rlListNode_t *tempnode;
 
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout<<"tStreamMeander::FindReaches()"<<std::endl;
 
    if( !(reachList.isEmpty()) ) reachList.Flush();
@@ -660,7 +666,7 @@ void tStreamMeander::FindReaches()
          //and add the reach to the list of reaches:
          rnodList.Flush();
          rnodList.insertAtFront( cn );
-         if (0){ //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ){
             if(cn->calcSlope()<=0) std::cout<<"bad node "<<cn->getID()<<" with slope "<<cn->calcSlope()<<" added to reachlist"<<std::endl;
          }
          reachList.insertAtBack( rnodList );
@@ -682,7 +688,7 @@ void tStreamMeander::FindReaches()
       taillen = *fArrPtr;
       delete fArrPtr;
    }
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "No. reaches: " << reachList.getSize() << std::endl;
    //loop through reaches
    //rlIter is the iterator for reachlist with is a list of ptrs to node lists
@@ -690,7 +696,7 @@ void tStreamMeander::FindReaches()
         plPtr = rlIter.NextP(), i++ )
    {
       assert( reachList.getSize() > 0 );
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << " on reach " << i << std::endl;
       assert( i<reachList.getSize() );
       //go downstream from reach head
@@ -706,7 +712,7 @@ void tStreamMeander::FindReaches()
              && cn->Meanders() )
       {
          //assert( cn->GetFlowEdg()->getLength() > 0 );
-         if (0){ //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ){
             if(cn->calcSlope()<=0) std::cout<<"bad node "<<cn->getID()<<" with slope "<<cn->calcSlope()<<" added to reachlist"<<std::endl;
          }
          nrnodes[i]++;
@@ -717,7 +723,7 @@ void tStreamMeander::FindReaches()
       }
 
       //make sure reach has more than 4 members:
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << "reach " << i << " length " << plPtr->getSize() << std::endl;
 
       if( plPtr->getSize() > 4 )
@@ -726,12 +732,12 @@ void tStreamMeander::FindReaches()
          lrn = rnIter.LastP();
          frn = rnIter.FirstP();
          rdrop = frn->getZ() - lrn->getZ();
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "reach drop: " << rdrop << std::endl;
          if( rdrop <= 0 )
          {
             //remove reach if it has non-positive slope:
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "remove reach for non-positive slope" << std::endl;
             tempnode = rlIter.NodePtr();
             rlIter.Prev();
@@ -745,7 +751,7 @@ void tStreamMeander::FindReaches()
       else
       {
          //remove reach if it has 4 or fewer members:
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "remove reach for being too small" << std::endl;
          tempnode = rlIter.NodePtr();
          rlIter.Prev();
@@ -756,7 +762,7 @@ void tStreamMeander::FindReaches()
          i--;
       }
    }
-   if (0){ //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ){
       std::cout << "Final no. reaches: " << reachList.getSize() << std::endl;
       for( /*plPtr =*/ rlIter.FirstP(), i=0; !(rlIter.AtEnd());
                        /*plPtr =*/ rlIter.NextP(), i++ )
@@ -769,7 +775,7 @@ void tStreamMeander::FindReaches()
    for( plPtr = rlIter.FirstP(), i=0; !(rlIter.AtEnd());
         plPtr = rlIter.NextP(), i++ )
    {
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << " on reach " << i << std::endl;
       assert( i<reachList.getSize() );
       rnIter.Reset( *plPtr );
@@ -818,13 +824,13 @@ void tStreamMeander::FindReaches()
       }
    }
 
-   if (0){ //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ){
       for( cn = nodIter.FirstP(); nodIter.IsActive(); cn = nodIter.NextP() )
       {
          std::cout << "end FindReaches, node " << cn->getID() << std::endl;
       }
    }
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "done FindReaches" << std::endl;
 }
 
@@ -860,15 +866,80 @@ void tStreamMeander::FindReaches()
 **    Calls: FindBankErody, external fortran routine _meander
 **		Created: 5/1/97  SL
 **    Modified: 11/03 SL, no longer sets "old" x and y.
+**    Modified: the arrays for all the reaches are made first, and
+**      _meander is run on them in parallel (see tMeanderBody).
 **
 \***************************************************************/
+namespace {
+// The arrays passed to meander_ for one reach
+struct tReachArrays
+{
+  int stations,   // number of actual landscape nodes on reach
+    nttlnodes;    // total # of reach nodes including 'tail'
+  tArray< double >
+    xa, ya, xsa, qa, rerodya, lerodya, delsa, slopea, widtha, deptha,
+    diama, deltaxa, deltaya, rdeptha, ldeptha, lambdaa;
+
+  tReachArrays() : stations(0), nttlnodes(0) {}
+  void setSize( int num, int numTotal )
+  {
+    stations = num;
+    nttlnodes = numTotal;
+    tArray< double > *arrays[] =
+      { &xa, &ya, &xsa, &qa, &rerodya, &lerodya, &delsa, &slopea, &widtha,
+	&deptha, &diama, &deltaxa, &deltaya, &rdeptha, &ldeptha, &lambdaa };
+    for( size_t k=0; k<sizeof(arrays)/sizeof(arrays[0]); ++k )
+      arrays[k]->setSize( numTotal );
+  }
+};
+
+// Runs meander_ on reaches [begin,end); meander_ only touches the
+// reach's own arrays
+class tMeanderBody
+{
+public:
+  explicit tMeanderBody( std::vector< tReachArrays > &arrays )
+    : arrays_(arrays) {}
+  void operator()( long begin, long end ) const
+  {
+    for( long i=begin; i<end; ++i )
+    {
+      tReachArrays &ra = arrays_[i];
+      //this looks horrible, but we need to pass the pointer to the array
+      //itself, not the tArray object, which contains the array pointer.
+      meander_( &ra.stations,
+		&ra.nttlnodes,
+		ra.xa.getArrayPtr(),
+		ra.ya.getArrayPtr(),
+		ra.xsa.getArrayPtr(),
+		ra.delsa.getArrayPtr(),
+		ra.qa.getArrayPtr(),
+		ra.rerodya.getArrayPtr(),
+		ra.lerodya.getArrayPtr(),
+		ra.slopea.getArrayPtr(),
+		ra.widtha.getArrayPtr(),
+		ra.deptha.getArrayPtr(),
+		ra.diama.getArrayPtr(),
+		ra.deltaxa.getArrayPtr(),
+		ra.deltaya.getArrayPtr(),
+		ra.rdeptha.getArrayPtr(),
+		ra.ldeptha.getArrayPtr(),
+		ra.lambdaa.getArrayPtr() );
+    }
+  }
+private:
+  std::vector< tReachArrays > &arrays_;
+};
+}
+
 void tStreamMeander::CalcMigration( double &time, double const &duration,
                                     double &cummvmt )
 {
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout<<"tStreamMeander::CalcMigration()...";
 
-   //loop through reaches:
+   //loop through reaches and make the arrays for meander_:
+   std::vector< tReachArrays > arrays( reachList.getSize() );
    int i;
    tPtrList< tLNode > *creach;
    for( creach = rlIter.FirstP(), i=0; !(rlIter.AtEnd());
@@ -876,36 +947,14 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
    {
       tPtrListIter< tLNode > rnIter;
       rnIter.Reset( *creach );
-      {
-         const int num = nrnodes[i];
-         int j;
-         tLNode *curnode;
-         for( curnode = rnIter.FirstP(), j=0; j<num;
-              curnode = rnIter.NextP(), j++ )
-             //initialize deltax, deltay, newx, newy:
-         {
-            curnode->setLatDisplace( 0.0, 0.0 );
-            curnode->setNew2DCoords( curnode->getX(), curnode->getY() );
-            if (1){ //DEBUG
-               const tArray< double > newxy = curnode->getNew2DCoords();
-               std::cout << "init. new coords to " << newxy[0] << " " << newxy[1] << std::endl;
-            }
-         }
-      }
-      if (1) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << "reach " << i << " length " << nrnodes[i] << std::endl;
 
-      const int stations  // number of actual landscape nodes on reach
-          = nrnodes[i];
+      tReachArrays &ra = arrays[i];
+      // number of actual landscape nodes on reach, and
       // total # of reach nodes including 'tail'
-      const int nttlnodes = creach->getSize();
-
-      tArray< double >
-          xa(nttlnodes), ya(nttlnodes), xsa(nttlnodes), qa(nttlnodes),
-          rerodya(nttlnodes), lerodya(nttlnodes), delsa(nttlnodes),
-          slopea(nttlnodes), widtha(nttlnodes), deptha(nttlnodes),
-          diama(nttlnodes), deltaxa(nttlnodes), deltaya(nttlnodes),
-          rdeptha(nttlnodes), ldeptha(nttlnodes), lambdaa(nttlnodes);
+      ra.setSize( nrnodes[i], creach->getSize() );
+      const int nttlnodes = ra.nttlnodes;
 
       {
          double xs = 0.0;
@@ -916,16 +965,16 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
          {
             // Set up the coordinate, streamwise length & distance, and Q arrays
             tEdge *fedg = curnode->getFlowEdg();
-            xa[j] = curnode->getX();
-            ya[j] = curnode->getY();
-            xsa[j] = xs;
-            qa[j] = curnode->getQ()/SECPERYEAR;
-            delsa[j] = fedg->getLength();
-            xs += delsa[j];
+            ra.xa[j] = curnode->getX();
+            ra.ya[j] = curnode->getY();
+            ra.xsa[j] = xs;
+            ra.qa[j] = curnode->getQ()/SECPERYEAR;
+            ra.delsa[j] = fedg->getLength();
+            xs += ra.delsa[j];
 
             // For debugging: make sure the next node on the reach is the
             // downstream neighbor of the current node
-            if( j < creach->getSize() - 1 )
+            if( j < nttlnodes - 1 )
             {
                tLNode *nxtnode = rnIter.ReportNextP();
                if( nxtnode != curnode->getDownstrmNbr() )
@@ -938,44 +987,54 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
 
             // Set bank erodibility on left and right banks
             const tArray< double > bankerody = FindBankErody( curnode );
-            lerodya[j] = bankerody[0];
-            rerodya[j] = bankerody[1];
+            ra.lerodya[j] = bankerody[0];
+            ra.rerodya[j] = bankerody[1];
 
             // Set slope, width, depth, grainsize, and roughness arrays
-            slopea[j] = curnode->getHydrSlope();
-            widtha[j] = curnode->getHydrWidth();
-            deptha[j] = curnode->getHydrDepth();
-            if (1) //DEBUG
-                std::cout << "width, depth " << widtha[j] << " " << deptha[j] << std::endl;
-            diama[j] = ( optdiamvar ) ? curnode->getDiam() : meddiam;
-            lambdaa[j] = curnode->getBankRough();
+            ra.slopea[j] = curnode->getHydrSlope();
+            ra.widtha[j] = curnode->getHydrWidth();
+            ra.deptha[j] = curnode->getHydrDepth();
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
+                std::cout << "width, depth " << ra.widtha[j] << " "
+                          << ra.deptha[j] << std::endl;
+            ra.diama[j] = ( optdiamvar ) ? curnode->getDiam() : meddiam;
+            ra.lambdaa[j] = curnode->getBankRough();
          }
       }
-
-      // Now we pass all this information to meander.f
-      if (0) //DEBUG
-          std::cout << "stations, stnserod: " << stations <<" "<< nttlnodes
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
+          std::cout << "stations, stnserod: " << ra.stations <<" "<< nttlnodes
                << std::endl;
-      //this looks horrible, but we need to pass the pointer to the array
-      //itself, not the tArray object, which contains the array pointer.
-      meander_( &stations,
-                &nttlnodes,
-                xa.getArrayPtr(),
-                ya.getArrayPtr(),
-                xsa.getArrayPtr(),
-                delsa.getArrayPtr(),
-                qa.getArrayPtr(),
-                rerodya.getArrayPtr(),
-                lerodya.getArrayPtr(),
-                slopea.getArrayPtr(),
-                widtha.getArrayPtr(),
-                deptha.getArrayPtr(),
-                diama.getArrayPtr(),
-                deltaxa.getArrayPtr(),
-                deltaya.getArrayPtr(),
-                rdeptha.getArrayPtr(),
-                ldeptha.getArrayPtr(),
-                lambdaa.getArrayPtr() );
+   }
+
+   // Now we pass all this information to meander.f. The reaches only
+   // depend on each other through the nodes they share (a reach's tail may
+   // be part of another reach), so meander_ is run on all of them at once,
+   // and the results are put back below in reach order.
+   ThreadPoolOf( meshPtr ).ParallelFor(
+     static_cast<long>( arrays.size() ), tMeanderBody( arrays ), 1 );
+
+   for( creach = rlIter.FirstP(), i=0; !(rlIter.AtEnd());
+        creach = rlIter.NextP(), i++ )
+   {
+      tPtrListIter< tLNode > rnIter;
+      rnIter.Reset( *creach );
+      const tReachArrays &ra = arrays[i];
+      {
+         const int num = nrnodes[i];
+         int j;
+         tLNode *curnode;
+         for( curnode = rnIter.FirstP(), j=0; j<num;
+              curnode = rnIter.NextP(), j++ )
+             //initialize deltax, deltay, newx, newy:
+         {
+            curnode->setLatDisplace( 0.0, 0.0 );
+            curnode->setNew2DCoords( curnode->getX(), curnode->getY() );
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ) {
+               const tArray< double > newxy = curnode->getNew2DCoords();
+               std::cout << "init. new coords to " << newxy[0] << " " << newxy[1] << std::endl;
+            }
+         }
+      }
 
       // Now reset the node values according to the arrays:
       {
@@ -984,10 +1043,10 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
          for( curnode = rnIter.FirstP(), j=0; !(rnIter.AtEnd());
               curnode = rnIter.NextP(), j++ )
          {
-            if(1)
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "add lat displace at " << curnode->getPermID() << ": "
-                << deltaxa[j] << "," << deltaya[j] << std::endl;
-            curnode->addLatDisplace( deltaxa[j], deltaya[j] );
+                << ra.deltaxa[j] << "," << ra.deltaya[j] << std::endl;
+            curnode->addLatDisplace( ra.deltaxa[j], ra.deltaya[j] );
          }
       }
       //arbitrary change for simple debugging:
@@ -1005,22 +1064,22 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
 #if POINTBARFIX
             const double
 			    bankfullDepth = curnode->getChanDepth(),
-                rz = curnode->getZ() + bankfullDepth * (1.0 - rdeptha[j]/deptha[j]),
-                lz = curnode->getZ() + bankfullDepth * (1.0 - ldeptha[j]/deptha[j]);
+                rz = curnode->getZ() + bankfullDepth * (1.0 - ra.rdeptha[j]/ra.deptha[j]),
+                lz = curnode->getZ() + bankfullDepth * (1.0 - ra.ldeptha[j]/ra.deptha[j]);
 #else
             const double
-                rz = curnode->getZ() + deptha[j] - rdeptha[j],
-                lz = curnode->getZ() + deptha[j] - ldeptha[j];
+                rz = curnode->getZ() + ra.deptha[j] - ra.rdeptha[j],
+                lz = curnode->getZ() + ra.deptha[j] - ra.ldeptha[j];
 #endif
 #undef POINTBARFIX
             //rz = curnode->getZ() + deptha[j];
             //lz = rz + deptha[j];
-            dbg2 = dbg2 + (rdeptha[j]-ldeptha[j]);
+            dbg2 = dbg2 + (ra.rdeptha[j]-ra.ldeptha[j]);
             curnode->setZOld( rz, lz );
-			if(0) //DEBUG
-			   std::cout<<"CalcMigration: Flood depth "<<deptha[j]<<" Bank height above chan "<<rz-curnode->getZ()<<" "<<lz-curnode->getZ()<<std::endl;
+			if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
+			   std::cout<<"CalcMigration: Flood depth "<<ra.deptha[j]<<" Bank height above chan "<<rz-curnode->getZ()<<" "<<lz-curnode->getZ()<<std::endl;
          }
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "MEAN rldepth " << dbg2 << std::endl;
       }
    }
@@ -1078,14 +1137,14 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
          newxy[0] += delta[0];
          newxy[1] += delta[1];
          curnode->setNew2DCoords( newxy[0], newxy[1] );
-         if (1) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "new coords set to " << newxy[0] << " " << newxy[1] << std::endl;
       }
    }
    time += dtm;
    cummvmt += maxfrac * dtm;
 
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout<<"done CalcMigration\n";
 
 }
@@ -1120,7 +1179,8 @@ void tStreamMeander::CalcMigration( double &time, double const &duration,
 \**********************************************************************/
 void tStreamMeander::Migrate( double ctime )
 {
-   if (1) //DEBUG
+  tProfileScope scope( "tStreamMeander::Migrate" );
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout<<"Migrate time=" << ctime <<std::endl;
    const double duration = netPtr->getStormPtrNC()->getStormDuration()
        + ctime;
@@ -1135,19 +1195,22 @@ void tStreamMeander::Migrate( double ctime )
       MakeReaches( ctime ); //updates net, makes reachList, interpolates
       if( !(reachList.isEmpty()) )
       {
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout<<"in loop "<<ctime<<" duration is "<<duration<<std::endl;
          CalcMigration( ctime, duration, cummvmt ); //incr time; uses reachList
          MakeChanBorder( ); //uses reachList
          CheckBndyTooClose();  //uses tMesh::nodeList
-         CheckBanksTooClose(); //uses reachList
-         CheckFlowedgCross(); //uses reachList
+         bool deleted = CheckBanksTooClose(); //uses reachList
+         if( CheckFlowedgCross() ) deleted = true; //uses reachList
+         // one update of the mesh geometry for all the deletions (the
+         // checks themselves only look at connectivity and coordinates)
+         if( deleted ) meshPtr->UpdateMesh();
          meshPtr->MoveNodes( ctime ); //uses tMesh::nodeList
          AddChanBorder( ctime ); //uses reachList
       }
       else ctime=duration; // If no reaches, end here (GT added 3/12/99)
    }
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout<<"end migrate"<<std::endl;
 }
 
@@ -1188,7 +1251,7 @@ void tStreamMeander::FindBankCoords( tLNode* cn, tArray< double >& posRef )
       posRef[1] = y0 + ydisp;
       posRef[2] = ( rl[1] > z ) ? rl[1] : z;
       posRef[3] = 1.0;
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << "node " << cn->getID()
                << " old pos set, on left side of channel" << std::endl;
    }
@@ -1198,7 +1261,7 @@ void tStreamMeander::FindBankCoords( tLNode* cn, tArray< double >& posRef )
       posRef[1] = y0 - ydisp;
       posRef[2] = ( rl[0] > z ) ? rl[0] : z;
       posRef[3] = -1.0;
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
           std::cout << "node " << cn->getID()
                << " old pos set, on right side of channel" << std::endl;
    }
@@ -1230,7 +1293,7 @@ void tStreamMeander::FindBankCoords( tLNode* cn, tArray< double >& posRef )
 \*****************************************************************************/
 void tStreamMeander::MakeChanBorder( )
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "MakeChanBorder()" << std::endl;
    tPtrList< tLNode > *cr;
    int i;
@@ -1252,7 +1315,7 @@ void tStreamMeander::MakeChanBorder( )
          // set bank coords for dropping a new node
          if( cn->DistFromOldXY() >= width * ( 0.5 + leavefrac ) )
          {
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "node " << cn->getID()
                      << " >= width from receding bank" << std::endl;
             tArray< double > oldpos = cn->getXYZD();
@@ -1281,7 +1344,7 @@ void tStreamMeander::MakeChanBorder( )
 \***************************************************************************/
 void tStreamMeander::AddChanBorder(double time)
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "AddChanBorder()" << std::endl;
    bool change = false; //haven't added any nodes yet
    const tArray< double > zeroArr(4);
@@ -1301,7 +1364,7 @@ void tStreamMeander::AddChanBorder(double time)
          //select for nodes with old coords set:
          if( oldpos[3] != 0.0 )
          {
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "node " << cn->getID()
                      << " ready to drop new node" << std::endl;
             //just make sure new node will be in a triangle
@@ -1329,7 +1392,7 @@ void tStreamMeander::AddChanBorder(double time)
                //the surface texture of cn.  Use erodep.
                tLNode* nnPtr = meshPtr->AddNode( channode, kNoUpdateMesh, time );
                if( nnPtr != NULL ){
-		          if(0)//DEBUG
+		          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 		             std::cout<<"ACB pt "<<nnPtr->getID()<<" added at "<<xyz[0]<<", "<<xyz[1]<<", "<<xyz[2]<<std::endl;
 		          change = true; //flag to update mesh
                }
@@ -1341,7 +1404,7 @@ void tStreamMeander::AddChanBorder(double time)
    if( change )
    {
       meshPtr->UpdateMesh();
-      if (1){ //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) ) {
          if( time >= kBugTime ) std::cout << "added nodes(s), AddChanBorder finished"
                                      << std::endl;
       }
@@ -1493,7 +1556,7 @@ void tStreamMeander::ResetEffNbrCoords( tLNode *nPtr )
 tArray< double >
 tStreamMeander::FindBankErody( tLNode *nPtr ) const
 {
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "FBE\n";
 
    tArray< double > lrerody(2);
@@ -1577,24 +1640,24 @@ tStreamMeander::FindBankErody( tLNode *nPtr ) const
            else E2 = vegerod;//node2->getVegErody();*/
          double E1 = rockerod, E2 = rockerod; // added 3/99
 
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "E1 " << E1 << "  E2 " << E2 << std::endl;
          //find height dependence:
          //if elev diff > hydraulic depth, ratio of depth to bank height;
          //o.w., keep nominal erody:
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "FBE 4" << H << " " << dz1 << std::endl;
          if( dz1 > H ) E1 *= (Pdz * H / dz1 + (1 - Pdz));
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "FBE 5" << std::endl;
          if( dz2 > H ) E2 *= (Pdz * H / dz2 + (1 - Pdz));
          //now we've found erod'ies at ea. node, find weighted avg:
          assert( D > 0.0 );
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "FBE 6" << std::endl;
          lrerody[j] = (E1 * d2 + E2 * d1) / D;
          j++;
-         if (0) //DEBUG
+         if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
              std::cout << "FBE 7" << std::endl;
       }
       i++;
@@ -1628,7 +1691,7 @@ void tStreamMeander::CheckBndyTooClose()
    int n;
    double width, mindist, d0, d1, d2, d3, xp, yp;
 
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "CBTC\n";
 
    /*cn =*/ nI.LastActiveP();
@@ -1703,17 +1766,22 @@ void tStreamMeander::CheckBndyTooClose()
 **  channel segment defined by the meandering node and its
 **  downstream neighbor.
 **
+**  Nodes are deleted reach by reach (later reaches see the repaired
+**  mesh), but the mesh geometry is not updated; returns true if any
+**  nodes were deleted, in which case the caller must call UpdateMesh.
+**
 **		Parameters:
-**		Called by:
+**		Called by: Migrate
 **		Created: 1/98 SL
 **
 \*****************************************************************************/
-void tStreamMeander::CheckBanksTooClose()
+bool tStreamMeander::CheckBanksTooClose()
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "CheckBanksTooClose()..." << std::endl;
 
 
+   bool deleted = false;
    // For each reach
    int i;
    tPtrList< tLNode > *cr;  // ptr to current reach
@@ -1722,6 +1790,7 @@ void tStreamMeander::CheckBanksTooClose()
    {
       tPtrList< tLNode > delPtrList;
       tPtrListIter< tLNode > dIter( delPtrList );
+      std::set< tLNode* > onDelList;  // the nodes on delPtrList
       tPtrList< tLNode > chanPtrList;
       // For each node on reach
       tPtrListIter< tLNode > rnIter( cr );   // iterator for nodes on reachrnIter.Reset( *cr );
@@ -1742,7 +1811,7 @@ void tStreamMeander::CheckBanksTooClose()
             {
                // If node isn't a boundary and isn't already on the
                // deletion list, put it on the deletion list now
-               if (0) //DEBUG
+               if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                    std::cout<<"too close: cn, cn->hydrwidth "<<cn->getID()<<" "
                        <<cn->getHydrWidth()<<std::endl;
                tLNode* pointtodelete = static_cast<tLNode *>( ce->getDestinationPtrNC() );
@@ -1750,13 +1819,9 @@ void tStreamMeander::CheckBanksTooClose()
                {
                   if ( pointtodelete->getDrArea() < cn->getDrArea() )
                   {
-                     bool onlist = false;
-                     for( tLNode* dn = dIter.FirstP(); !(dIter.AtEnd());
-                          dn = dIter.NextP() )
-                         if( pointtodelete == dn ) onlist = true;
-                     if( !onlist )
+                     if( onDelList.insert( pointtodelete ).second )
                      {
-                        if (0) //DEBUG
+                        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                             std::cout << "add to delete list: "
                                  << pointtodelete->getID() << std::endl;
                         delPtrList.insertAtBack( pointtodelete );
@@ -1775,18 +1840,19 @@ void tStreamMeander::CheckBanksTooClose()
       {
          for( tLNode *dn = dIter.FirstP(); !(dIter.AtEnd()); dn = dIter.FirstP())
          {
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "CBTC: delete node " << dn->getID() << " at "
                      << dn->getX() << ", " << dn->getY() << std::endl;
             meshPtr->DeleteNode( dn, kRepairMesh, kNoUpdateMesh );
             delPtrList.removeFromFront();
             chanPtrList.removeFromFront();
          }
-         meshPtr->UpdateMesh();
+         deleted = true;
       }
    }
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "finished" << std::endl;
+   return deleted;
 }
 
 /*****************************************************************************\
@@ -1818,13 +1884,24 @@ void tStreamMeander::CheckBanksTooClose()
 **    those triangles associated with meandering reach flow edges and their
 **    complements.
 **    TODO: Is repetition necessary?  -SL
+**    Modified: nodes are deleted without updating the mesh geometry, which
+**    the passes do not use; returns true if any nodes were deleted, in
+**    which case the caller must call UpdateMesh.
 \*****************************************************************************/
-void tStreamMeander::CheckFlowedgCross()
+bool tStreamMeander::CheckFlowedgCross()
 {
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "CheckFlowedgCross()..." << std::endl;
+   bool deleted = false;
    tPtrList< tLNode > delPtrList;
    tPtrListIter< tLNode > dIter( delPtrList );
+   std::set< tLNode* > onDelList;  // the nodes on delPtrList
+   // For the rare case below: the reaches, and for each node the first
+   // reach it is on (made when first needed; a node is only taken off a
+   // reach together with its "reachmember" flag, so this stays right for
+   // the nodes that still have the flag)
+   std::vector< tPtrList< tLNode >* > reaches;
+   std::map< tLNode*, int > reachOf;
    //delete node crossed by flowedg:
    //if a new triangle is !CCW and two vtcs. are connected by a flowedg AND
    //  a spoke of the third vtx. intersects the flowedg OR
@@ -1946,13 +2023,9 @@ void tStreamMeander::CheckFlowedgCross()
                      //meshPtr->DeleteNode( pointtodelete );
                      // 6/2003 SL: add to list of nodes to be deleted
                      // rather than delete right away:
-                     bool onlist = false;
-
-                     for( tLNode* dn = dIter.FirstP(); !(dIter.AtEnd()); dn = dIter.NextP() )
-                         if( pointtodelete == dn ) onlist = true;
-                     if( !onlist )
+                     if( onDelList.insert( pointtodelete ).second )
                      {
-                        if (0) //DEBUG
+                        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                             std::cout << "add to delete list: "
                                  << pointtodelete->getID() << std::endl;
                         delPtrList.insertAtBack( pointtodelete );
@@ -1982,47 +2055,60 @@ void tStreamMeander::CheckFlowedgCross()
          // SL, 7/2003: set "crossed" here; otherwise crossed boundary nodes
          // can lead to infinite loops:
          crossed = true;
+         deleted = true;
          for( tLNode* dn = dIter.FirstP(); !(dIter.AtEnd()); dn = dIter.FirstP() )
          {
             // rare case in which deleted nodes are not removed from reaches:
             if( dn->getReachMember() )
             {
                // didn't get deleted from reach, so we need to do it here:
-               tLNode *cn = NULL;
-               tPtrList< tLNode > *cr;
-               int k;
-               for( cr = rlIter.FirstP(), k=0; !(rlIter.AtEnd());
-                    cr = rlIter.NextP(), ++k )
+               if( reaches.empty() )
                {
+                  tPtrList< tLNode > *cr;
+                  for( cr = rlIter.FirstP(); !(rlIter.AtEnd());
+                       cr = rlIter.NextP() )
+                  {
+                     tPtrListIter< tLNode > rnIter( cr );
+                     for( tLNode *rn = rnIter.FirstP(); !(rnIter.AtEnd());
+                          rn = rnIter.NextP() )
+                         reachOf.insert(
+                             std::make_pair( rn, int( reaches.size() ) ) );
+                     reaches.push_back( cr );
+                  }
+               }
+               std::map< tLNode*, int >::const_iterator r = reachOf.find( dn );
+               if( r != reachOf.end() )
+               {
+                  const int k = r->second;
+                  tPtrList< tLNode > *cr = reaches[k];
                   tPtrListIter< tLNode > rnIter( cr );
-                  cn = rnIter.GetP( dn );
-                  if( cn != NULL ){
-                     if( rnIter.Prev() )
-                         cr->removeNext( rnIter.NodePtr() );
-                     else
-                     {
-                        cr->removeFromFront();
-                        rnIter.First();
-                     }
-                     // decrement number of reach nodes:
-                     --nrnodes[k];
-                     // unset "reachmember"
-                     cn->setReachMember(false);
-                     break;
+                  tLNode *cn = rnIter.GetP( dn );
+                  assert( cn != NULL );
+                  if( rnIter.Prev() )
+                      cr->removeNext( rnIter.NodePtr() );
+                  else
+                  {
+                     cr->removeFromFront();
+                     rnIter.First();
                   }
+                  // decrement number of reach nodes:
+                  --nrnodes[k];
+                  // unset "reachmember"
+                  cn->setReachMember(false);
                }
             }
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
                 std::cout << "CFC: delete node " << dn->getID() << " at "
                      << dn->getX() << ", " << dn->getY() << std::endl;
             meshPtr->DeleteNode( dn, kRepairMesh, kNoUpdateMesh, true );
             delPtrList.removeFromFront();
          }
-         meshPtr->UpdateMesh();
+         onDelList.clear();
       }
    } while( crossed );
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
        std::cout << "finished" << std::endl;
+   return deleted;
 }
 
 /****************************************************************\
@@ -2035,7 +2121,7 @@ void tStreamMeander::CheckFlowedgCross()
 **
 **		Parameters:	mnode -- upstream meandering channel node
 **                bnode -- the potential new bank node
-**		Called by:
+**		Called by: CheckBanksTooClose
 **		Created: 1/98 SL
 **    Modified:
 **     - 6/99 GT: changed from hydraulic width to channel,
@@ -2049,15 +2135,19 @@ int tStreamMeander::InChannel( tLNode *mnode, tLNode const *bnode )
    const double b = mnode->getChanWidth();  // GT changed to ChanWidth, 6/99
    if( b == 0. ) return 0;
 
-   tMesh< tLNode >::nodeListIter_t dI( meshPtr->getNodeList() );
-   tMesh< tLNode >::edgeListIter_t eI( meshPtr->getEdgeList() );
    tLNode *dnode = mnode->getDownstrmNbr();
    tEdge *fe = mnode->getFlowEdg();
 
    //if downstrm nbr exists and is still in nodeList; also flowedge:
    if( dnode != 0 && fe != 0 )
    {
-      const double L = mnode->getFlowEdg()->getLength();
+      // Length of the flow edge, worked out as in tEdge::CalcLength rather
+      // than read from the edge, since the bank checks delete nodes
+      // without updating the mesh (a flow edge may then be one that
+      // RepairMesh has just made, whose length is not yet set)
+      const double dx = mnode->getX() - dnode->getX(),
+          dy = mnode->getY() - dnode->getY();
+      const double L = sqrt( dx*dx + dy*dy );
       //mindist = sqrt( L * L + b * b );
       //for perp. distance from mnode > b/2:
       const double mindist = sqrt( L * L + 0.5 * b * b
@@ -2093,12 +2183,12 @@ tLNode *tStreamMeander::getUpstreamMeander(tLNode *cn)
       tLNode *upstreamnode = cn->getUpstrmNbr();
       if( upstreamnode != NULL ){
          if( !upstreamnode->Meanders() ){
-            if (0) //DEBUG
+            if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 	      std::cout<<"upstream node non-meandering for node "<<cn->getID()<<std::endl;
             upstreamnode = NULL;
          }
       }
-      else if (0) //DEBUG
+      else if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kMeander ) )
 	std::cout<<"no upstream node for node "<<cn->getID()<<std::endl;
       return upstreamnode;
    }
@@ -86,9 +86,11 @@ public:
    //for 'violations' peculiar to moving channels.
    int InChannel( tLNode *, tLNode const * ); //called by CheckBanksTooClose()
    tLNode* getUpstreamMeander(tLNode*);
+   //CheckBanksTooClose and CheckFlowedgCross delete nodes without updating
+   //the mesh, and return true if they deleted any:
    void CheckBndyTooClose();
-   void CheckBanksTooClose();
-   void CheckFlowedgCross();
+   bool CheckBanksTooClose();
+   bool CheckFlowedgCross();
    tLNode* FixBrokenFlowedg( tLNode*, tLNode*, double );
    void CheckBrokenFlowedg( double );
    //calls meander_; pass it the running time, storm duration, and cum. mvmt.:
@@ -20,6 +20,9 @@
 //#include <string>
 #include "../errors/errors.h"
 #include "tStreamNet.h"
+#include "../tLog/tLog.h"
+#include "../tProfiler/tProfiler.h"
+#include "../tMesh/tMeshRange.h"
 
 tStreamNet::kChannelType_t tStreamNet::IntToChannelType( int c ){
   switch(c){
@@ -74,7 +77,7 @@ inlet( &meshRef, infile ),
 optSinVarInfilt(false),
 mpParkerChannels(0)
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "tStreamNet(...)...";
   assert( meshPtr != 0 );
   assert( stormPtr != 0 );
@@ -183,7 +186,7 @@ mpParkerChannels(0)
       break;
     case kFinneganChannels:
     {
-      if(0) std::cout << "Finnegan law's chosen for channel width \n";
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "Finnegan law's chosen for channel width \n";
       kwds = infile.ReadItem( kwds, "HYDR_WID_COEFF_DS" );
       assert( kwds > 0 );
       kdds = infile.ReadItem( kdds, "HYDR_DEP_COEFF_DS" );
@@ -212,7 +215,7 @@ mpParkerChannels(0)
   FlowDirs();
   CheckNetConsistency();
   MakeFlow( 0.0 );
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "finished" << std::endl;
 }
 tStreamNet::tStreamNet( const tStreamNet& orig, tStorm* sPtr, tMesh<tLNode>* mPtr )
@@ -285,7 +288,7 @@ tStreamNet::~tStreamNet()
   stormPtr = 0;
   if( mpParkerChannels )
     delete mpParkerChannels;
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "~tStreamNet()" << std::endl;
 }
 
@@ -406,12 +409,13 @@ void tStreamNet::setInletNodePtr( tLNode *Ptr )
  \**************************************************************************/
 void tStreamNet::UpdateNet( double time )
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tStreamNet::UpdateNet" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "UpdateNet()...";
   CalcSlopes();          // TODO: should be in tMesh
   FlowDirs();
   
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( meshPtr->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -429,7 +433,7 @@ void tStreamNet::UpdateNet( double time )
   
   MakeFlow( time );
   
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( meshPtr->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -448,7 +452,7 @@ void tStreamNet::UpdateNet( double time )
   
   CheckNetConsistency();
   
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( meshPtr->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -465,13 +469,13 @@ void tStreamNet::UpdateNet( double time )
     
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "UpdateNet() finished" << std::endl;
 }
 
 void tStreamNet::UpdateNet( double time, tStorm &storm )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "UpdateNet(...)...";
   stormPtr = &storm;
   assert( stormPtr != 0 );
@@ -500,6 +504,7 @@ void tStreamNet::UpdateNet( double time, tStorm &storm )
  \**************************************************************************/
 void tStreamNet::CheckNetConsistency()
 {
+  tProfileScope scope( "tStreamNet::CheckNetConsistency" );
   tLNode *cn, *dn;
   tMesh< tLNode >::nodeListIter_t nI( meshPtr->getNodeList() ),
   tI( meshPtr->getNodeList() );
@@ -552,7 +557,7 @@ void tStreamNet::CheckNetConsistency()
   if (CheckNetConsistencyFlowPath(&cn))
     goto error;
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "NETWORK PASSED\n";
   
   return;
@@ -904,39 +909,49 @@ void tStreamNet::ShowMeanderNeighbours(int debugID) const
  **   - complementary edges on the list are assumed to be organized pairwise;
  **     that is, edges AB and BA are always together, for example.
  **
+ **  The pairs are shared out among the threads of the model's pool (see
+ **  tMesh/tMeshRange.h); with one thread they run in order.
+ **
  **  TODO: should be a member of tMesh!
  **
  \****************************************************************************/
+// Sets the slopes of edge pairs [begin,end) of a snapshot of the edge list
+class tCalcSlopesBody
+{
+public:
+  explicit tCalcSlopesBody( const tMeshRange< tEdge > &edges )
+    : edges_(edges) {}
+  void operator()( long begin, long end ) const
+  {
+    for( long pair=begin; pair<end; ++pair )
+    {
+      tEdge *curedg = edges_[2*pair];
+      assert( curedg->getLength() > 0 );
+      const double slp =
+      ( curedg->getOrgZ() - curedg->getDestZ() )
+      / curedg->getLength();
+      curedg->setSlope( slp );
+      edges_[2*pair+1]->setSlope( -slp );
+    }
+  }
+private:
+  const tMeshRange< tEdge > &edges_;
+};
+
 void tStreamNet::CalcSlopes()
 {
+  tProfileScope scope( "tStreamNet::CalcSlopes" );
   assert( meshPtr != 0 );
-  tEdge *curedg;
-  tMesh< tLNode >::edgeListIter_t i( meshPtr->getEdgeList() );
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "CalcSlopes()...";
   
   // Loop through each pair of edges on the list
-  for( curedg = i.FirstP(); !( i.AtEnd() ); curedg = i.NextP() )
-  {
-    // Make sure edge is valid, and length is nonzero
-    assert( curedg != 0 );
-    assert( curedg->getLength() > 0 );
-    
-    // Compute the slope and assign it to the current edge
-    const double slp =
-    ( curedg->getOrgZ() - curedg->getDestZ() )
-    / curedg->getLength();
-    curedg->setSlope( slp );
-    
-    // Advance to the edge's complement, and assign it -slp
-    curedg = i.NextP();
-    assert( !( i.AtEnd() ) );
-    curedg->setSlope( -slp );
-    //curedg->setLength( length );
-    assert( curedg->getLength() > 0 );
-  }
-  if (0) //DEBUG
+  const tMeshRange< tEdge > edges( meshPtr->getEdgeList(), false );
+  assert( edges.size()%2 == 0 );
+  ThreadPoolOf( meshPtr ).ParallelFor( edges.size()/2,
+                                       tCalcSlopesBody( edges ) );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "CalcSlopes() finished" << std::endl;
 }
 
@@ -963,7 +978,7 @@ void tStreamNet::InitFlowDirs()
   tEdge * flowedg;
   int ctr;
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "InitFlowDirs()...\n";
   
   // For every active (non-boundary) node, initialize it to flow to a
@@ -997,7 +1012,7 @@ void tStreamNet::InitFlowDirs()
     curnode = i.NextP();
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "finished\n";
   
 }
@@ -1021,7 +1036,7 @@ void tStreamNet::InitFlowDirs()
 #define kMaxSpokes 100
 void tStreamNet::ReInitFlowDirs()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "ReInitFlowDirs()...\n";
   // For every active (non-boundary) node, initialize it to flow to a
   // non-boundary node (ie, along a "flowAllowed" edge)
@@ -1059,7 +1074,7 @@ void tStreamNet::ReInitFlowDirs()
     curnode = i.NextP();
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "finished\n";
   
 }
@@ -1166,6 +1181,7 @@ void tStreamNet::ReInitFlowDirs()
 #define kMaxSpokes 100
 void tStreamNet::FlowDirs()
 {
+  tProfileScope scope( "tStreamNet::FlowDirs" );
   tMesh< tLNode >::nodeListIter_t i( meshPtr->getNodeList() );  // gets nodes from the list
   double slp=0;                          // steepest slope found so far
   double meanderslp = 0;		// steepest meander slope found so far
@@ -1193,7 +1209,7 @@ void tStreamNet::FlowDirs()
     }
     slp = firstedg->getSlope();
     nbredg = firstedg;
-	  if(0) //DEBUG
+	  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
 	  {
       if(curnode->getID()==8121 /*|| curnode->getID()==213*/) {
         tLNode * nbr = static_cast<tLNode *>(firstedg->getDestinationPtrNC());
@@ -1226,7 +1242,7 @@ void tStreamNet::FlowDirs()
       	if( NodeAlongEdge->Meanders()) {
           meanderslp = firstedg->getSlope();
           meanderedg = firstedg;
-          if(0) //DEBUG
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
           {
             if(curnode->getID()==8121 /*|| curnode->getID()==213*/)
               std::cout<<"FlowDirs: just set meanderslp+edg = "
@@ -1234,7 +1250,7 @@ void tStreamNet::FlowDirs()
           }
       	}
       }
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
       {
         if(curnode->getID()==8121 /*|| curnode==inlet.innode*/ ) {
           tLNode * nbr = static_cast<tLNode *>(firstedg->getDestinationPtrNC());
@@ -1290,13 +1306,13 @@ void tStreamNet::FlowDirs()
           // the steepest descent one is meandering
           if( SteepestDescentNode->Meanders() ){
             if(slp > meanderslp){
-              if(0) //DEBUG
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                 if( curnode->getID()==8121 || curnode->getID()==8122 ) std::cout << "FlowDirs: steepest desc mnds, change dir\n";
               curnode->setFlowEdg( nbredg);
               selectslope = slp;
             }
             else if(slp <= meanderslp){
-              if(0) //DEBUG
+              if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                 if( curnode->getID()==8121 || curnode->getID()==8122 ) std::cout << "FlowDirs: cur mndr IS steepest\n";
               curnode->setFlowEdg( meanderedg);
               selectslope = meanderslp;
@@ -1317,7 +1333,7 @@ void tStreamNet::FlowDirs()
               else{
                 curnode->setFlowEdg( nbredg);
                 selectslope = slp;
-                if(0) //debug
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                 {
                   std::cout << "Case meand->nonmeand invoked at node " << curnode->getX() << " " << curnode->getY() << std::endl;
                   std::cout << "meanderslp = " << meanderslp << std::endl;
@@ -1329,11 +1345,11 @@ void tStreamNet::FlowDirs()
               if(meanderslp > 0.0 && 
                  nbredg->getDestinationPtr()->getBoundaryFlag() != kOpenBoundary)
               {
-                if(0) //DEBUG
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                   if( curnode->getID()==8121 || curnode->getID()==8122 ) std::cout << "FlowDirs: steepest doesn't mdr, staying w/ current dir\n";
                 curnode->setFlowEdg( meanderedg);
                 selectslope = meanderslp;
-                if(0) //DEBUG
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                 {
                   if(curnode->getID()==8121 || curnode->getID()==8122 ) {
                     tLNode * nbr = static_cast<tLNode *>(meanderedg->getDestinationPtrNC());
@@ -1347,7 +1363,7 @@ void tStreamNet::FlowDirs()
               {
                 curnode->setFlowEdg( nbredg);
                 selectslope = slp;
-                if(0) //debug
+                if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
                 {
                   std::cout << "FlowDirs: Case meand->nonmeand invoked at node " << curnode->getX() << " " << curnode->getY() << " ";
                   std::cout << "meanderslp = " << meanderslp << std::endl;
@@ -1362,7 +1378,7 @@ void tStreamNet::FlowDirs()
           selectslope = slp;
         }
         
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         {
           if(curnode->getID()==8121 || curnode->getID()==8122 ) {
             tEdge * debugedg = curnode->getFlowEdg();
@@ -1430,7 +1446,7 @@ void tStreamNet::FlowDirs()
         
         
         
-        if(0) {
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) {
           if(selectslope <= 0.0 && curnode->Meanders()){
             std::cout<<"WARNING-Type 1, from tStreamNet::CalcSlopes....detected a meander node without positive drainage"<<std::endl;
             std::cout<<"ID= "<<curnode->getID()<<", X= "<<curnode->getX()<<", Y= "<<curnode->getY()<<", Z= "<<curnode->getZ()<<std::endl;
@@ -1457,7 +1473,7 @@ void tStreamNet::FlowDirs()
           
         }
         
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         {
           if(curnode->getID()==8121 || curnode->getID()==8122 ) {
             tEdge * debugedg = curnode->getFlowEdg();
@@ -1472,7 +1488,7 @@ void tStreamNet::FlowDirs()
         
       } // end of node loop
       
-      if (0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         std::cout << "FlowDirs() finished" << std::endl;
     }
 #undef kMaxSpokes
@@ -1501,7 +1517,8 @@ void tStreamNet::FlowDirs()
  \*****************************************************************************/
 void tStreamNet::DrainAreaVoronoi()
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tStreamNet::DrainAreaVoronoi" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "DrainAreaVoronoi()..." << std::endl;
   
   tLNode * curnode;
@@ -1535,7 +1552,7 @@ void tStreamNet::DrainAreaVoronoi()
 #endif
     RouteFlowArea( inlet.innode, inlet.inDrArea );
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "DrainAreaVoronoi() finished" << std::endl;
 }
 
@@ -1682,7 +1699,7 @@ void tStreamNet::RouteFlowHydrographPeak()
 inline
 void tStreamNet::RouteFlowArea( tLNode *curnode, double addedArea )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "RouteFlowArea()..." << std::endl;
   //#if DEBUG
   int niterations=0;  // Safety feature: prevents std::endless loops
@@ -1702,7 +1719,7 @@ void tStreamNet::RouteFlowArea( tLNode *curnode, double addedArea )
       RouteError( curnode );
     //#endif
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "RouteFlowArea() finished" << std::endl;
 }
 
@@ -1779,7 +1796,7 @@ inline
 void tStreamNet::RouteRunoff( tLNode *curnode, double addedArea,
                              double addedRunoff )
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "RouteRunoff()..." << std::endl;
   //#if DEBUG
   int niterations=0;  // Safety feature: prevents std::endless loops
@@ -1800,7 +1817,7 @@ void tStreamNet::RouteRunoff( tLNode *curnode, double addedArea,
       RouteError( curnode );
     //#endif
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "RouteRunoff() finished" << std::endl;
 }
 
@@ -1843,12 +1860,13 @@ void tStreamNet::RouteError( tLNode *curnode )
  \*****************************************************************************/
 void tStreamNet::MakeFlow( double tm )
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tStreamNet::MakeFlow" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "MakeFlow()..."<<std::flush;
   
   if( filllakes ) FillLakes();
   
-  if(0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
   {
     tMesh< tLNode >::nodeListIter_t mli( meshPtr->getNodeList() );  // gets nodes from the list
     tLNode * cn;
@@ -1900,7 +1918,7 @@ void tStreamNet::MakeFlow( double tm )
       break;
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "MakeFlow() finished" << std::endl;
 }
 
@@ -1919,7 +1937,7 @@ void tStreamNet::MakeFlow( double tm )
  \*****************************************************************************/
 void tStreamNet::FlowUniform()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowUniform..." << std::endl;
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   tLNode *curnode;
@@ -1933,7 +1951,7 @@ void tStreamNet::FlowUniform()
     discharge = curnode->getDrArea() * runoff;
     curnode->setDischarge( discharge );
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowUniform finished" << std::endl;
 }
 
@@ -1964,7 +1982,7 @@ void tStreamNet::FlowUniform()
  \*****************************************************************************/
 void tStreamNet::FlowSaturated1()
 {
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowSaturated1...";
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   tLNode *curnode;
@@ -1990,7 +2008,7 @@ void tStreamNet::FlowSaturated1()
     curnode->setDischarge( surface_discharge );
     curnode->setSubSurfaceDischarge( subsurf_discharge );
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "finished" << std::endl;
 }
 
@@ -2029,7 +2047,7 @@ void tStreamNet::FlowSaturated2()
   stormDur = stormPtr->getStormDuration();  // Storm duration
   int nsat=0,nsr=0,nhort=0,nflat=0; // 4dbg
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowSaturated1" << std::endl;
   
   // Reset drainage areas and discharges to zero
@@ -2075,7 +2093,7 @@ void tStreamNet::FlowSaturated2()
     RouteRunoff( curnode, curnode->getVArea(), runoff*curnode->getVArea() );
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << nhort << " generate Horton runoff, " << nsat
     << " pre-saturated, (" << nflat << "flat) "
     << nsr << " saturate during storm.\n";
@@ -2112,7 +2130,7 @@ void tStreamNet::FlowSaturated2()
 void tStreamNet::FlowBucket()
 {
   assert( stormPtr!=0 );
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowBucket..." << std::endl;
   tMesh< tLNode >::nodeListIter_t nodIter( meshPtr->getNodeList() );
   tLNode *curnode;
@@ -2140,7 +2158,7 @@ void tStreamNet::FlowBucket()
     discharge = curnode->getDrArea() * runoff;
     curnode->setDischarge( discharge );
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FlowBucket finished" << std::endl;
 }
 
@@ -2185,7 +2203,8 @@ void tStreamNet::FlowBucket()
  \*****************************************************************************/
 void tStreamNet::FillLakes()
 {
-  if (0) //DEBUG
+  tProfileScope scope( "tStreamNet::FillLakes" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
   {
     std::cout << "FillLakes()..." << std::endl;
   }
@@ -2226,12 +2245,12 @@ void tStreamNet::FillLakes()
       FillLakesFlowDirs(lakeIter, lowestNode);
       
       // Finally, flag all of the nodes in it as "kFlooded"
-      if(0) //DEBUG
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         std::cout<<"FillLakes: " << lakeList.getSize() << " flooded nodes:" <<std::endl;
       for( tLNode *cln = lakeIter.FirstP(); !( lakeIter.AtEnd() ); cln = lakeIter.NextP() )
       {
         cln->setFloodStatus( tLNode::kFlooded );
-        if(0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         {
           std::cout<<cln->getID();
           if( cln->Meanders() ) std::cout<<"*";
@@ -2241,7 +2260,7 @@ void tStreamNet::FillLakes()
     } /* END if Sink */
   } /* END Active Nodes */
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "FillLakes() finished" << std::endl;
   
 } // end of tStreamNet::FillLakes
@@ -2597,7 +2616,7 @@ void tStreamNet::SortNodesByNetOrder( bool optMultiFlow )
   tMesh< tLNode >::nodeList_t *nodeList = meshPtr->getNodeList();
   int nUnsortedNodes = nodeList->getActiveSize();  // Number not yet sorted
   tMesh< tLNode >::nodeListIter_t listIter( nodeList );
-  if(0) std::cout << "SortNodesByNetOrder, optMultiFlow=" << optMultiFlow << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "SortNodesByNetOrder, optMultiFlow=" << optMultiFlow << std::endl;
   
   //test
   /*std::cout << "BEFORE: " << std::endl;
@@ -2628,24 +2647,24 @@ void tStreamNet::SortNodesByNetOrder( bool optMultiFlow )
       }
     }
     
-    if(0) std::cout << "we found " << debug_int << " interior nodes; the list thinks it has " << nUnsortedNodes << " of them\n" << std::flush;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "we found " << debug_int << " interior nodes; the list thinks it has " << nUnsortedNodes << " of them\n" << std::flush;
     
     do
     {
-      if(0) std::cout << "position 1\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "position 1\n" << std::flush;
       
       // Send tracers downstream
       cn = listIter.FirstP();
       for( i=1; i<=nUnsortedNodes; i++ )
       {
         assert( cn!=0 );
-        if(0) std::cout << "position 1a\n" << std::flush;
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "position 1a\n" << std::flush;
         cn->MoveSortTracerDownstream();
-        if(0) std::cout << "position 1b\n" << std::flush;
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "position 1b\n" << std::flush;
         cn = listIter.NextP();
       }
       
-      if(0) std::cout << "position 2\n" << std::flush;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "position 2\n" << std::flush;
       
       // Scan for any nodes that have no tracers, and move them to the
       // bottom of the list.
@@ -2671,7 +2690,7 @@ void tStreamNet::SortNodesByNetOrder( bool optMultiFlow )
       
       nUnsortedNodes -= nThisPass;
       
-      if(0) 
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) 
       {
         std::cout << "NO. UNSORTED: " << nUnsortedNodes << std::endl;
         for( cn=listIter.FirstP(); listIter.IsActive(); cn=listIter.NextP() )
@@ -2783,6 +2802,7 @@ void tStreamNet::SortNodesByNetOrder( bool optMultiFlow )
  \*****************************************************************************/
 void tStreamNet::FindHydrGeom()
 {
+  tProfileScope scope( "tStreamNet::FindHydrGeom" );
   
   double kwdspow, kndspow, kddspow,
   widpow, deppow, npow, qpsec;
@@ -2790,7 +2810,7 @@ void tStreamNet::FindHydrGeom()
   tLNode *cn;
   tMesh< tLNode >::nodeListIter_t nIter( meshPtr->getNodeList() );
   
-  if(0) std::cout << "tStreamNet::FindHydrGeom()\n";
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "tStreamNet::FindHydrGeom()\n";
   
   // If rainfall and hence discharge varies in time, set flow width, depth
   // and roughness using power law functions of their bankfull values
@@ -2883,7 +2903,7 @@ void tStreamNet::FindHydrGeom()
     }
   }
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "done tStreamNet::FindHydrGeom" << std::endl;
 }
 
@@ -2919,7 +2939,8 @@ void tStreamNet::FindHydrGeom()
  \*****************************************************************************/
 void tStreamNet::FindChanGeom()
 {
-  if(0) std::cout << "tStreamNet::FindChanGeom()\n";
+  tProfileScope scope( "tStreamNet::FindChanGeom" );
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) std::cout << "tStreamNet::FindChanGeom()\n";
   
   if( miChannelType==kParkerChannels )
   {
@@ -2973,7 +2994,7 @@ void tStreamNet::FindChanGeom()
     slope = cn->calcSlope();
     cn->setChanSlope( slope );
     
-    if(0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     {
       if( cn->getID()==8121 ) std::cout << "FindChanGeom 1: new slope at " << cn->getID() << " is " << slope << std::endl;
     }
@@ -3000,7 +3021,7 @@ void tStreamNet::FindChanGeom()
     //nmg
 #define TESTFIX 0
     if( cn->Meanders() && slope <= 0.00000001 ){ // added "meanders" clause Gt 12/04
-      if(0) //debug
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
         std::cout << "Meander node de-activation in FindChanGeom, at node " << cn->getID() << " " << cn->getX() << " " << cn->getY() << std::endl;
       if( !TESTFIX ) cn->setMeanderStatus( kNonMeanderNode );
     }
@@ -3017,7 +3038,7 @@ void tStreamNet::FindChanGeom()
       ReportFatalError("negative slope in tStreamNet::FindChanGeom");
     }
   }
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "done tStreamNet::FindChanGeom" << std::endl;
 }
 
@@ -3090,7 +3111,7 @@ void tStreamNet::RouteFlowKinWave( double rainrate_ )
     runoff -= infilt;  // Local runoff rate at node
   if( miOptFlowgen == kSubSurf2DKinematicWave )
     mdKinWaveRough = 1.0 / infilt;
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "RouteFlowKinWave\n";
   
   if( runoff <= 0.0 ) return;
@@ -3429,7 +3450,7 @@ meshPtr(gPtr)
         help = infile.ReadItem( help, tagline );
         inSedLoadm[i] = help;
         inSedLoad += help;
-        if (0) //DEBUG
+        if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
           std::cout<<"insedload of "<<i-1<<" is "<<inSedLoadm[i]<<std::endl;
         //i++;
         //end++;
@@ -3755,7 +3776,7 @@ tParkerChannels::tParkerChannels( const tInputFile &infile )
   secPerYear=SECPERYEAR;  // # of seconds in one year
   char astring[12];   // string var used in reading grain-size classes
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "tParkerChannels::tParkerChannels\n";
   
   // Calculate coefficient and slope exponent for width equation (see above)
@@ -3792,12 +3813,12 @@ tParkerChannels::tParkerChannels( const tInputFile &infile )
   {
     d50 = infile.ReadItem( d50, "GRAINDIAM0" );
     taucrit = thetac*(sigma-rho)*grav*d50;
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
       std::cout << "Tau crit = " << taucrit << std::endl;
     mdPPfac = ( 1.0 / secPerYear )
     * pow( kt / ( taucrit*shearRatio ), 1.0 / alpha );
     mdPPexp2 = 0.0; // Not used in this case
-    if (0) //DEBUG
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
       std::cout << "mdPPfac=" << mdPPfac << "  mdPPexp1=" << mdPPexp1 << std::endl;
   }
   
@@ -3834,7 +3855,7 @@ void tParkerChannels::CalcChanGeom( tMesh<tLNode> *meshPtr )
   tMesh< tLNode >::nodeListIter_t ni( meshPtr->getNodeList() );
   tLNode *cn;
   
-  if (0) //DEBUG
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) )
     std::cout << "tParkerChannels::CalcChanGeom\n";
   
   if( miNumGrainSizeClasses==1 )
@@ -3864,7 +3885,7 @@ void tParkerChannels::CalcChanGeom( tMesh<tLNode> *meshPtr )
       assert( d50>0. );
       cn->setChanWidth( mdPPfac * cn->getQ() * pow(cn->calcSlope(),mdPPexp1 )
                        * pow( d50, mdPPexp2 ) );
-      if(0) { // debug
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ) {
         std::cout << mdPPfac << " " << cn->getQ() << " " << cn->calcSlope()
         << " " << mdPPexp1 << " " << d50 << " " << mdPPexp2 << std::endl;
       }
@@ -3918,7 +3939,7 @@ void tStreamNet::DebugShowNbrs( tLNode *theNode ) const
       std::cout<<"has nbrs itself: "<<std::endl;
       tEdge *cee;
       tSpkIter spokIter2(surnode);
-      if(0){
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kStreamNet ) ){
         for( cee = spokIter2.FirstP(); !( spokIter2.AtEnd() ); cee = spokIter2.NextP() ){
           tLNode* morenode = static_cast<tLNode *>( cee->getDestinationPtrNC() );
           std::cout<<morenode->getID()<<" "
@@ -0,0 +1,206 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tTaskGraph.cpp
+**
+**  @brief Functions for tTaskGraph, the dependency-ordered task runner.
+**  See tTaskGraph.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include <algorithm>
+#include "tTaskGraph.h"
+#include "../errors/errors.h"
+#include "../tProfiler/tProfiler.h"
+
+tTaskGraph::tTaskGraph()
+  : numThreads_(1), numDone_(0), stop_(false)
+{
+  pthread_mutex_init( &mutex_, 0 );
+  pthread_cond_init( &wake_, 0 );
+}
+
+tTaskGraph::~tTaskGraph()
+{
+  StopThreads();
+  pthread_cond_destroy( &wake_ );
+  pthread_mutex_destroy( &mutex_ );
+}
+
+/**************************************************************************/
+/**
+**  tTaskGraph::SetThreads
+**
+**  Starts n-1 worker threads, after stopping any already running. If a
+**  thread cannot be created, the graph makes do with those it has.
+*/
+/**************************************************************************/
+void tTaskGraph::SetThreads( int n )
+{
+  if( n<1 ) n = 1;
+  StopThreads();
+  for( int i=1; i<n; ++i )
+  {
+    pthread_t thread;
+    if( pthread_create( &thread, 0, WorkerMain, this )!=0 )
+    {
+      ReportWarning( "Unable to start a task thread; "
+		     "running with fewer threads." );
+      break;
+    }
+    workers_.push_back( thread );
+  }
+  numThreads_ = static_cast<int>(workers_.size()) + 1;
+}
+
+void tTaskGraph::StopThreads()
+{
+  if( workers_.empty() )
+    return;
+  pthread_mutex_lock( &mutex_ );
+  stop_ = true;
+  pthread_cond_broadcast( &wake_ );
+  pthread_mutex_unlock( &mutex_ );
+  for( size_t i=0; i<workers_.size(); ++i )
+    pthread_join( workers_[i], 0 );
+  workers_.clear();
+  stop_ = false;
+  numThreads_ = 1;
+}
+
+void tTaskGraph::Clear()
+{
+  tasks_.clear();
+}
+
+/**************************************************************************/
+/**
+**  tTaskGraph::Add
+**
+**  Appends a task, making it wait for every earlier task it conflicts
+**  with: one that writes what it reads or writes, or reads what it
+**  writes. Tasks that only read the same fields do not wait for each
+**  other.
+*/
+/**************************************************************************/
+int tTaskGraph::Add( const char *name, tTask *task, tFieldSet reads,
+		     tFieldSet writes )
+{
+  const int i = static_cast<int>(tasks_.size());
+  tEntry entry;
+  entry.name = name;
+  entry.task = task;
+  entry.reads = reads;
+  entry.writes = writes;
+  entry.waiting = 0;
+  for( int j=0; j<i; ++j )
+  {
+    tEntry &earlier = tasks_[j];
+    if( ( writes & ( earlier.reads | earlier.writes ) )
+	|| ( reads & earlier.writes ) )
+    {
+      entry.dependencies.push_back( j );
+      earlier.dependents.push_back( i );
+    }
+  }
+  tasks_.push_back( entry );
+  return i;
+}
+
+/**************************************************************************/
+/**
+**  tTaskGraph::Run
+**
+**  Runs every task once. Without worker threads, the tasks run in order
+**  on the calling thread; otherwise the tasks with no dependencies are
+**  made ready and the calling thread joins the workers until all are
+**  done.
+*/
+/**************************************************************************/
+void tTaskGraph::Run()
+{
+  const int n = getTaskCount();
+  if( workers_.empty() || n<2 )
+  {
+    for( int i=0; i<n; ++i )
+      RunEntry( i );
+    return;
+  }
+
+  pthread_mutex_lock( &mutex_ );
+  numDone_ = 0;
+  ready_.clear();
+  for( int i=0; i<n; ++i )
+  {
+    tasks_[i].waiting = static_cast<int>(tasks_[i].dependencies.size());
+    if( tasks_[i].waiting==0 )
+      ready_.push_back( i );
+  }
+  pthread_cond_broadcast( &wake_ );
+  pthread_mutex_unlock( &mutex_ );
+
+  WorkUntilDone( false );
+}
+
+void tTaskGraph::RunEntry( int i )
+{
+  tProfileScope scope( tasks_[i].name );
+  tasks_[i].task->Run();
+}
+
+/**************************************************************************/
+/**
+**  tTaskGraph::WorkUntilDone
+**
+**  Takes ready tasks (lowest index first) and runs them, releasing their
+**  dependents as they finish. The calling thread of Run returns when
+**  all tasks are done; a worker returns only when the threads are
+**  stopped.
+*/
+/**************************************************************************/
+void tTaskGraph::WorkUntilDone( bool worker )
+{
+  pthread_mutex_lock( &mutex_ );
+  for(;;)
+  {
+    if( worker ? stop_ : numDone_==getTaskCount() )
+      break;
+    if( ready_.empty() )
+    {
+      pthread_cond_wait( &wake_, &mutex_ );
+      continue;
+    }
+    const int i = ready_.front();
+    ready_.erase( ready_.begin() );
+    pthread_mutex_unlock( &mutex_ );
+
+    RunEntry( i );
+
+    pthread_mutex_lock( &mutex_ );
+    ++numDone_;
+    const std::vector<int> &dependents = tasks_[i].dependents;
+    for( size_t k=0; k<dependents.size(); ++k )
+      if( --tasks_[dependents[k]].waiting==0 )
+	ready_.insert( std::lower_bound( ready_.begin(), ready_.end(),
+					 dependents[k] ),
+		       dependents[k] );
+    if( !ready_.empty() || numDone_==getTaskCount() )
+      pthread_cond_broadcast( &wake_ );
+  }
+  pthread_mutex_unlock( &mutex_ );
+}
+
+void *tTaskGraph::WorkerMain( void *graph )
+{
+  static_cast<tTaskGraph *>(graph)->WorkUntilDone( true );
+  return 0;
+}
@@ -0,0 +1,142 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tTaskGraph.h
+**
+**  @brief Header file for tTaskGraph, which runs a list of tasks on a
+**         pool of threads, overlapping those that do not share data.
+**
+**  Each task is added with the set of model fields it reads and the set
+**  it writes (bit masks; the meaning of the bits is up to the caller).
+**  A task depends on every earlier task that writes a field it reads or
+**  writes, or reads a field it writes. Run() executes the tasks so that
+**  each starts only after those it depends on have finished: the results
+**  are the same as running them one after the other in the order they
+**  were added, provided the declared fields are complete.
+**
+**  With one thread (the default) the tasks simply run in order on the
+**  calling thread. With n threads, n-1 worker threads are started once
+**  and kept for the life of the graph; the calling thread also works,
+**  and Run() returns when all tasks are done. When several tasks are
+**  ready, they are started in the order they were added.
+**
+**  Tasks are timed by tProfiler under their names when they run on the
+**  thread that started the profiler.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TTASKGRAPH_H
+#define TTASKGRAPH_H
+
+#include <pthread.h>
+#include <vector>
+
+/**************************************************************************/
+/**
+**  Class tTask
+**
+**  A unit of work for tTaskGraph.
+*/
+/**************************************************************************/
+class tTask
+{
+public:
+  virtual ~tTask() {}
+  virtual void Run() = 0;
+};
+
+/**************************************************************************/
+/**
+**  Class tMemberTask
+**
+**  A task that calls a member function (with no arguments) of an object.
+*/
+/**************************************************************************/
+template< class T >
+class tMemberTask : public tTask
+{
+public:
+  typedef void (T::*tFunction)();
+  tMemberTask( T *object, tFunction function )
+    : object_(object), function_(function) {}
+  void Run() { (object_->*function_)(); }
+
+private:
+  T *object_;
+  tFunction function_;
+};
+
+/**************************************************************************/
+/**
+**  Class tTaskGraph
+**
+**  Holds the tasks, their dependencies, and the worker threads.
+*/
+/**************************************************************************/
+class tTaskGraph
+{
+public:
+  typedef unsigned long tFieldSet;
+
+  tTaskGraph();
+  ~tTaskGraph();
+
+  // Sets the number of threads used by Run (including the caller)
+  void SetThreads( int );
+  int getThreads() const { return numThreads_; }
+
+  // Removes all tasks (the threads are kept)
+  void Clear();
+  // Adds a task (not owned by the graph); returns its index
+  int Add( const char *name, tTask *task, tFieldSet reads,
+	   tFieldSet writes );
+  int getTaskCount() const { return static_cast<int>(tasks_.size()); }
+  // Index of the tasks that task i waits for
+  const std::vector<int> &getDependencies( int i ) const
+  { return tasks_[i].dependencies; }
+
+  // Runs all tasks once
+  void Run();
+
+private:
+  struct tEntry
+  {
+    const char *name;
+    tTask *task;
+    tFieldSet reads, writes;
+    std::vector<int> dependencies;  // earlier tasks it waits for
+    std::vector<int> dependents;    // later tasks that wait for it
+    int waiting;                    // dependencies not yet done (in Run)
+  };
+
+  void RunEntry( int );
+  void WorkUntilDone( bool worker );
+  void StopThreads();
+  static void *WorkerMain( void * );
+
+  std::vector<tEntry> tasks_;
+  int numThreads_;
+  std::vector<pthread_t> workers_;
+
+  // State shared with the workers, guarded by mutex_
+  pthread_mutex_t mutex_;
+  pthread_cond_t wake_;         // a task became ready, all are done,
+                                // or the workers should stop
+  std::vector<int> ready_;      // ready tasks, kept sorted
+  int numDone_;
+  bool stop_;                   // workers should exit
+
+  tTaskGraph( const tTaskGraph & );
+  tTaskGraph &operator=( const tTaskGraph & );
+};
+
+#endif
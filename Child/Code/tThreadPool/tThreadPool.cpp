@@ -0,0 +1,266 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tThreadPool.cpp
+**
+**  @brief Functions for tThreadPool, the chunked, work-stealing loop
+**  runner. See tThreadPool.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#include "tThreadPool.h"
+#include "../errors/errors.h"
+
+tThreadPool::tThreadPool( int numThreads )
+{
+  Init();
+  SetThreads( numThreads );
+}
+
+tThreadPool::tThreadPool( const tThreadPool &orig )
+{
+  Init();
+  SetThreads( orig.numThreads_ );
+}
+
+tThreadPool &tThreadPool::operator=( const tThreadPool &orig )
+{
+  if( this!=&orig && numThreads_!=orig.numThreads_ )
+    SetThreads( orig.numThreads_ );
+  return *this;
+}
+
+void tThreadPool::Init()
+{
+  numThreads_ = 1;
+  body_ = 0;
+  n_ = numChunks_ = chunksDone_ = 0;
+  chunkSize_ = 1;
+  generation_ = 0;
+  busy_ = 0;
+  stop_ = false;
+  nextThread_ = 1;
+  pthread_mutex_init( &loopLock_, 0 );
+  pthread_mutex_init( &mutex_, 0 );
+  pthread_cond_init( &wake_, 0 );
+  pthread_cond_init( &done_, 0 );
+}
+
+tThreadPool::~tThreadPool()
+{
+  StopThreads();
+  for( size_t i=0; i<blocks_.size(); ++i )
+  {
+    pthread_mutex_destroy( &blocks_[i]->lock );
+    delete blocks_[i];
+  }
+  pthread_cond_destroy( &done_ );
+  pthread_cond_destroy( &wake_ );
+  pthread_mutex_destroy( &mutex_ );
+  pthread_mutex_destroy( &loopLock_ );
+}
+
+tThreadPool &tThreadPool::Serial()
+{
+  static tThreadPool serial( 1 );
+  return serial;
+}
+
+/**************************************************************************/
+/**
+**  tThreadPool::SetThreads
+**
+**  Starts n-1 worker threads, after stopping any already running. If a
+**  thread cannot be created, the pool makes do with those it has.
+*/
+/**************************************************************************/
+void tThreadPool::SetThreads( int n )
+{
+  if( n<1 ) n = 1;
+  StopThreads();
+  while( static_cast<int>(blocks_.size())<n )
+  {
+    tBlock *block = new tBlock;
+    pthread_mutex_init( &block->lock, 0 );
+    block->next = block->end = 0;
+    blocks_.push_back( block );
+  }
+  nextThread_ = 1;
+  for( int i=1; i<n; ++i )
+  {
+    pthread_t thread;
+    if( pthread_create( &thread, 0, WorkerMain, this )!=0 )
+    {
+      ReportWarning( "Unable to start a worker thread; "
+		     "running with fewer threads." );
+      break;
+    }
+    workers_.push_back( thread );
+  }
+  numThreads_ = static_cast<int>(workers_.size()) + 1;
+}
+
+void tThreadPool::StopThreads()
+{
+  if( workers_.empty() )
+    return;
+  pthread_mutex_lock( &mutex_ );
+  stop_ = true;
+  pthread_cond_broadcast( &wake_ );
+  pthread_mutex_unlock( &mutex_ );
+  for( size_t i=0; i<workers_.size(); ++i )
+    pthread_join( workers_[i], 0 );
+  workers_.clear();
+  stop_ = false;
+  numThreads_ = 1;
+}
+
+/**************************************************************************/
+/**
+**  tThreadPool::RunChunks
+**
+**  Cuts [0,n) into chunks and runs them, on the calling thread alone if
+**  the pool has no workers, there is only one chunk, or the pool is
+**  busy with another loop. Otherwise each thread is given a contiguous
+**  block of chunks, the workers are woken, and the calling thread works
+**  until every chunk is done and every worker has left the loop (so
+**  that none still refers to the body when we return).
+*/
+/**************************************************************************/
+void tThreadPool::RunChunks( long n, long chunkSize, tChunkBody &body )
+{
+  if( n<=0 )
+    return;
+  if( chunkSize<1 ) chunkSize = 1;
+  const long numChunks = ( n + chunkSize - 1 ) / chunkSize;
+
+  if( workers_.empty() || numChunks==1
+      || pthread_mutex_trylock( &loopLock_ )!=0 )
+  {
+    for( long c=0; c<numChunks; ++c )
+    {
+      const long begin = c*chunkSize;
+      body.Run( c, begin, begin+chunkSize<n ? begin+chunkSize : n );
+    }
+    return;
+  }
+
+  // Share out the chunks (no worker is in a loop at this point)
+  const long numThreads = numThreads_;
+  for( long t=0; t<numThreads; ++t )
+  {
+    blocks_[t]->next = numChunks*t/numThreads;
+    blocks_[t]->end = numChunks*(t+1)/numThreads;
+  }
+
+  pthread_mutex_lock( &mutex_ );
+  body_ = &body;
+  n_ = n;
+  chunkSize_ = chunkSize;
+  numChunks_ = numChunks;
+  chunksDone_ = 0;
+  ++generation_;
+  pthread_cond_broadcast( &wake_ );
+  pthread_mutex_unlock( &mutex_ );
+
+  Work( 0, &body );
+
+  pthread_mutex_lock( &mutex_ );
+  while( chunksDone_<numChunks_ || busy_>0 )
+    pthread_cond_wait( &done_, &mutex_ );
+  body_ = 0;
+  pthread_mutex_unlock( &mutex_ );
+
+  pthread_mutex_unlock( &loopLock_ );
+}
+
+/**************************************************************************/
+/**
+**  tThreadPool::TakeChunk
+**
+**  Returns the next chunk of the thread's own block or, if that is
+**  empty, the last chunk of the first other block that is not, or -1
+**  if no chunks are left.
+*/
+/**************************************************************************/
+long tThreadPool::TakeChunk( int thread )
+{
+  long chunk = -1;
+  tBlock *own = blocks_[thread];
+  pthread_mutex_lock( &own->lock );
+  if( own->next<own->end )
+    chunk = own->next++;
+  pthread_mutex_unlock( &own->lock );
+
+  for( int k=1; chunk<0 && k<numThreads_; ++k )
+  {
+    tBlock *victim = blocks_[( thread + k ) % numThreads_];
+    pthread_mutex_lock( &victim->lock );
+    if( victim->next<victim->end )
+      chunk = --victim->end;
+    pthread_mutex_unlock( &victim->lock );
+  }
+  return chunk;
+}
+
+void tThreadPool::Work( int thread, tChunkBody *body )
+{
+  long chunk;
+  while( ( chunk = TakeChunk( thread ) )>=0 )
+  {
+    const long begin = chunk*chunkSize_;
+    body->Run( chunk, begin, begin+chunkSize_<n_ ? begin+chunkSize_ : n_ );
+
+    pthread_mutex_lock( &mutex_ );
+    if( ++chunksDone_==numChunks_ )
+      pthread_cond_broadcast( &done_ );
+    pthread_mutex_unlock( &mutex_ );
+  }
+}
+
+/**************************************************************************/
+/**
+**  tThreadPool::WorkerMain
+**
+**  A worker waits for a loop to start, joins it, and waits again, until
+**  the pool stops it. A worker that wakes after a loop has finished
+**  (body_ is then 0) just goes back to waiting.
+*/
+/**************************************************************************/
+void *tThreadPool::WorkerMain( void *arg )
+{
+  tThreadPool *pool = static_cast<tThreadPool *>(arg);
+  pthread_mutex_lock( &pool->mutex_ );
+  const int thread = pool->nextThread_++;
+  unsigned long seen = pool->generation_;
+  for(;;)
+  {
+    while( !pool->stop_ && pool->generation_==seen )
+      pthread_cond_wait( &pool->wake_, &pool->mutex_ );
+    if( pool->stop_ )
+      break;
+    seen = pool->generation_;
+    tChunkBody *body = pool->body_;
+    if( body==0 )
+      continue;
+    ++pool->busy_;
+    pthread_mutex_unlock( &pool->mutex_ );
+
+    pool->Work( thread, body );
+
+    pthread_mutex_lock( &pool->mutex_ );
+    if( --pool->busy_==0 )
+      pthread_cond_broadcast( &pool->done_ );
+  }
+  pthread_mutex_unlock( &pool->mutex_ );
+  return 0;
+}
@@ -0,0 +1,177 @@
+//-*-c++-*-
+
+/**************************************************************************/
+/**
+**  @file tThreadPool.h
+**
+**  @brief Header file for tThreadPool, a pool of worker threads for
+**         data-parallel loops over index ranges.
+**
+**  A loop over [0,n) is cut into chunks of a fixed size (the last one
+**  may be shorter), and the chunks are shared out among the threads:
+**  each thread starts with a contiguous block of them and, when it runs
+**  out, steals chunks from the far end of another thread's block. The
+**  calling thread works too.
+**
+**  ParallelFor( n, body ) calls body( begin, end ) for each chunk;
+**  the body must be safe to call on different chunks at the same time.
+**
+**  ParallelReduce( n, body, identity ) gives each chunk its own
+**  accumulator, starting from identity, and calls
+**  body( begin, end, acc ) for the chunk; it then combines the chunk
+**  accumulators with body.Join( total, acc ), in chunk order, on the
+**  calling thread. Because the chunks depend only on n and the chunk
+**  size, the result (including floating-point round-off) is the same
+**  whatever the number of threads, and the same as with one thread.
+**
+**  With one thread (the default), both simply run the chunks in order on
+**  the calling thread. A loop started while the pool is already running
+**  one (e.g., from inside a body, or from another thread) also runs on
+**  the calling thread alone, so loops may be nested freely.
+**
+**  Each model owns a pool through its tModelContext (keyword
+**  NUM_THREADS). Loops over the nodes and edges of a tMesh are written
+**  with the helpers in tMesh/tMeshRange.h.
+**
+**  For information regarding this program, please contact Greg Tucker at:
+**
+**     Cooperative Institute for Research in Environmental Sciences (CIRES)
+**     and Department of Geological Sciences
+**     University of Colorado
+**     2200 Colorado Avenue, Campus Box 399
+**     Boulder, CO 80309-0399
+*/
+/**************************************************************************/
+
+#ifndef TTHREADPOOL_H
+#define TTHREADPOOL_H
+
+#include <pthread.h>
+#include <vector>
+
+/**************************************************************************/
+/**
+**  Class tChunkBody
+**
+**  The work done on one chunk of a loop (see tThreadPool::RunChunks).
+*/
+/**************************************************************************/
+class tChunkBody
+{
+public:
+  virtual ~tChunkBody() {}
+  virtual void Run( long chunk, long begin, long end ) = 0;
+};
+
+/**************************************************************************/
+/**
+**  Class tThreadPool
+*/
+/**************************************************************************/
+class tThreadPool
+{
+public:
+  enum { kDefaultChunkSize = 1024 };
+
+  explicit tThreadPool( int numThreads = 1 );
+  // A copy is a new pool with the same number of threads
+  tThreadPool( const tThreadPool & );
+  tThreadPool &operator=( const tThreadPool & );
+  ~tThreadPool();
+
+  // Sets the number of threads (including the caller of a loop)
+  void SetThreads( int );
+  int getThreads() const { return numThreads_; }
+
+  // Runs body.Run( c, begin, end ) for each chunk c of [0,n)
+  void RunChunks( long n, long chunkSize, tChunkBody &body );
+
+  template< class Body >
+  void ParallelFor( long n, const Body &body,
+		    long chunkSize = kDefaultChunkSize );
+
+  template< class T, class Body >
+  T ParallelReduce( long n, const Body &body, const T &identity,
+		    long chunkSize = kDefaultChunkSize );
+
+  // A pool with one thread, which any number of threads may use at once
+  static tThreadPool &Serial();
+
+private:
+  // Chunks [next,end) not yet taken from one thread's block
+  struct tBlock
+  {
+    pthread_mutex_t lock;
+    long next, end;
+  };
+
+  template< class Body >
+  class tForChunk : public tChunkBody
+  {
+  public:
+    explicit tForChunk( const Body &body ) : body_(body) {}
+    void Run( long, long begin, long end ) { body_( begin, end ); }
+  private:
+    const Body &body_;
+  };
+
+  template< class T, class Body >
+  class tReduceChunk : public tChunkBody
+  {
+  public:
+    tReduceChunk( const Body &body, std::vector<T> &partial )
+      : body_(body), partial_(partial) {}
+    void Run( long chunk, long begin, long end )
+    { body_( begin, end, partial_[chunk] ); }
+  private:
+    const Body &body_;
+    std::vector<T> &partial_;
+  };
+
+  void StopThreads();
+  long TakeChunk( int thread );
+  void Work( int thread, tChunkBody *body );
+  static void *WorkerMain( void * );
+
+  int numThreads_;
+  std::vector<pthread_t> workers_;
+  std::vector<tBlock *> blocks_;   // one per thread; 0 is the caller's
+  pthread_mutex_t loopLock_;       // held while a loop is shared out
+
+  // State shared with the workers, guarded by mutex_
+  pthread_mutex_t mutex_;
+  pthread_cond_t wake_;            // a loop started, or stop
+  pthread_cond_t done_;            // a worker or the last chunk finished
+  tChunkBody *body_;               // current loop, or 0
+  long n_, chunkSize_, numChunks_, chunksDone_;
+  unsigned long generation_;       // number of loops started
+  int busy_;                       // workers inside the current loop
+  bool stop_;
+  int nextThread_;                 // index given to the next new worker
+
+  void Init();
+};
+
+template< class Body >
+void tThreadPool::ParallelFor( long n, const Body &body, long chunkSize )
+{
+  tForChunk< Body > chunks( body );
+  RunChunks( n, chunkSize, chunks );
+}
+
+template< class T, class Body >
+T tThreadPool::ParallelReduce( long n, const Body &body, const T &identity,
+			       long chunkSize )
+{
+  if( chunkSize<1 ) chunkSize = 1;
+  const long numChunks = n>0 ? ( n + chunkSize - 1 ) / chunkSize : 0;
+  std::vector<T> partial( numChunks, identity );
+  tReduceChunk< T, Body > chunks( body, partial );
+  RunChunks( n, chunkSize, chunks );
+  T total = identity;
+  for( long c=0; c<numChunks; ++c )
+    body.Join( total, partial[c] );
+  return total;
+}
+
+#endif
@@ -294,28 +294,53 @@ int tTokList::parse(const char *s)
   return parse(s, default_ws);
 }
 
+/*********************************************************************\
+ * char *nexttok(char **cursor, const char *ws)                        *
+ *                                                                     *
+ * Like strtok(), but keeps its place in 'cursor' rather than in a     *
+ * hidden static, so that several models may read their time series   *
+ * at once. Returns the next token of the string at *cursor, ended     *
+ * with a '\0', or 0 if there is none, and moves *cursor past it.      *
+ *                                                                     *
+\*********************************************************************/
+static
+char *nexttok(char **cursor, const char *ws)
+{
+  char *p = *cursor + strspn(*cursor, ws);
+  if (*p == '\0') {
+    *cursor = p;
+    return 0;
+  }
+  char *end = p + strcspn(p, ws);
+  if (*end != '\0')
+    *end++ = '\0';
+  *cursor = end;
+  return p;
+}
+
 int tTokList::parse(const char *s, const char *ws)
 {
   // parse string 's' into tokens, use whitespace
   // set 'ws'
   int   i;
-  char *buffer, *p;
+  char *buffer, *p, *cursor;
 
   // delete any existing tokens
   for (i=0; i<ntok; i++)
     delete[] tok[i];
   ntok = 0;
 
-  // parse string with help of strtok() lib function
+  // parse string with help of nexttok()
   // and insert tokens in list
   buffer = new char[strlen(s)+1];
   strcpy(buffer,s);
-  p = strtok(buffer, ws);
+  cursor = buffer;
+  p = nexttok(&cursor, ws);
   while (p) {
     tok[ntok] = new char[strlen(p)+1];
     strcpy(tok[ntok], p);
     ntok++;
-    p = strtok(0, ws);
+    p = nexttok(&cursor, ws);
   }
   delete[] buffer;
 
@@ -380,13 +405,14 @@ int tTokList::size() const
 
 
 /*********************************************************************\
- * char *strclean(const char *s)                                       *
+ * char *strclean(const char *s, char *s2)                             *
  *                                                                     *
  * This function cleans string 's'. leading and trailing whitespace is *
  * removed. consecutive whitespace characters are being replaced by    *
  * a single space. whitespace charcacters are: space, tab, return,     *
  * newline, vertical tab, newpage.                                     *
- * The resulting, cleansed string, is returned.                        *
+ * The resulting, cleansed string, is written to 's2' (which must be   *
+ * at least as long as 's') and returned.                              *
  * Examples:                                                           *
  *   "abcd"              -> "abcd"                                     *
  *   "   abc   def   "   -> "abc def"                                  *
@@ -396,9 +422,8 @@ int tTokList::size() const
  *                                                                     *
 \*********************************************************************/
 static
-char *strclean(const char *s)
+char *strclean(const char *s, char *s2)
 {
-  static char s2[1024];     // new cleansed, string
   tTokList  toklist;        // token list
   int       i;              // token interator
 
@@ -468,8 +493,9 @@ void tDataFile::load(const char *filename)
 {
   FILE *fp;                     // pointer to the actual file
   char *p, *pp;                 // pointers, used for string-traversing
-  static char line[1024];       // buffer to hold a single line
-  static char s[1024];          // buffer to hold copy of current line, for destructive processes
+  char line[1024];              // buffer to hold a single line
+  char s[1024];                 // buffer to hold copy of current line, for destructive processes
+  char clean[1024];             // buffer for cleansed strings (see strclean)
   int c;                        // column-iterator
   int check;                    // holds number of items actually read.
   tTokList toklist;             // token list for data record parsing
@@ -496,7 +522,7 @@ void tDataFile::load(const char *filename)
     // no, depending on line contents and context, perform some action:
 
     // case 1: line is empty; skip this line
-    if (strlen(strclean(line))==0) {
+    if (strlen(strclean(line, clean))==0) {
       if (debug) printf("ACTION: skip empty line\n");
       continue;
     }
@@ -504,19 +530,20 @@ void tDataFile::load(const char *filename)
     // case 2: "%info" line; set info field
     if (strstr(line,"%info:")==line) {
       if (debug) printf("ACTION: parsing info field\n");
-      strcpy(info, strclean(line+6));
+      strcpy(info, strclean(line+6, clean));
       continue;
     }
 
     // case 3: %columns line; extract column names
     if (strstr(line,"%columns:")==line) {
       if (debug) printf("ACTION: parsing column def\n");
-      strcpy(s,strclean(line+9));
+      strcpy(s,strclean(line+9, clean));
       ncolname=0;
-      p = strtok(s," \t,;");
+      char *cursor = s;
+      p = nexttok(&cursor," \t,;");
       while (p) {
 	strcpy(colname[ncolname++], p);
-	p = strtok(0," \t,;");
+	p = nexttok(&cursor," \t,;");
       }
       continue;
     }
@@ -528,8 +555,8 @@ void tDataFile::load(const char *filename)
       p = strstr(s,"=");
       pp = p+1;           // points to 'value'
       *p = '\0';          // s points now to 'name'
-      strcpy(parname[nparam], strclean(s));
-      strcpy(parvalue[nparam], strclean(pp));
+      strcpy(parname[nparam], strclean(s, clean));
+      strcpy(parvalue[nparam], strclean(pp, clean));
       nparam++;
       continue;
     }
@@ -537,7 +564,7 @@ void tDataFile::load(const char *filename)
     // case 5: %comment line
     if (strstr(line,"%")==line) {
       if (debug) printf("ACTION: parsing comment\n");
-      strcpy(comment[ncomment++], strclean(line+1));
+      strcpy(comment[ncomment++], strclean(line+1, clean));
       continue;
     }
 
@@ -754,12 +781,11 @@ double *tDataFile::getColumn(const char *colname_) const
 \*********************************************************************/
 const char *tDataFile::getParam(const char *name) const
 {
-  static char result[32];
+  const char *result = "";
 
-  strcpy(result, "");
   for (int i=0; i<nparam; i++)
     if (strcmp(name, parname[i])==0)
-      strcpy(result, parvalue[i]);
+      result = parvalue[i];
   return result;
 }
 
@@ -1129,13 +1155,16 @@ void tInlineTimeSeriesImp::TellAll() const
 \*********************************************************************/
 
 tTimeSeries::tTimeSeries() :
-  ts(0)
+  ts(0), tagImp(-1)
 {}
 
 // copy constructor (SL, 10/10)
 tTimeSeries::tTimeSeries(tTimeSeries const &orig) 
-  : tagImp(orig.tagImp)
+  : ts(0), tagImp(orig.tagImp)
 {
+  // a time series that was never configured copies as such
+  if( orig.ts == 0 )
+    return;
   if( tagImp == 0 )
     ts = new tConstantTimeSeriesImp();
   else if( tagImp == 1 )
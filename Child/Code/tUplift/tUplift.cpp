@@ -22,6 +22,9 @@
 #include "tUplift.h"
 #include "../errors/errors.h"
 #include "../Mathutil/mathutil.h"
+#include "../tLog/tLog.h"
+#include "../tModelContext/tModelContext.h"
+#include "../tProfiler/tProfiler.h"
 
 
 /************************************************************************\
@@ -69,7 +72,9 @@ tUplift::tUplift_t tUplift::DecodeType(int type){
 }
 
 tUplift::tUplift( const tInputFile &infile ) :
-duration(0.)
+duration(0.),
+cumulative_displacement_(0.), elapsed_time_(0.), fbf_elapsed_time_(0.),
+fold_nose_(0.), optLazyUplift_(false), upliftPending_(false)
 {
   int typeCode_;
   
@@ -90,6 +95,7 @@ duration(0.)
   duration = infile.ReadItem( duration, "UPDUR" );
   infile.ReadItem( rate_ts, "UPRATE" );  // Read uplift rate as a time-series variable
   rate = rate_ts.calc( 0.0 );      // For fns that don't use time series, set rate to rate at time zero
+  optLazyUplift_ = infile.ReadBool( "OPT_LAZY_UPLIFT", false );
   switch( typeCode ) {
     case kNoUplift:
     case k1: // Uniform
@@ -202,7 +208,7 @@ duration(0.)
         for( int i=1; i<miNumUpliftMaps; i++ )
         {
           upliftTimeFile >> mUpliftMapTimes[i];
-          if(0) std::cout << "Map time " << i << " is " << mUpliftMapTimes[i] << std::endl;
+          if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "Map time " << i << " is " << mUpliftMapTimes[i] << std::endl;
         }
         upliftTimeFile.close();
       }
@@ -270,6 +276,7 @@ duration(0.)
 \************************************************************************/
 void tUplift::DoUplift( tMesh<tLNode> *mp, double delt, double currentTime )
 {
+  tProfileScope scope( "tUplift::DoUplift" );
   switch( typeCode )
   {
     case kNoUplift:
@@ -348,6 +355,14 @@ void tUplift::DoUplift( tMesh<tLNode> *mp, double delt, double currentTime )
 **  Uniform uplift at a constant rate across the entire domain (but not
 **  including boundaries).
 **
+**  With OPT_LAZY_UPLIFT, the interior is left alone: the boundary nodes
+**  are lowered by the same amount, and the rise is added to the datum
+**  offset of the model context (zDatum). Elevation differences, and so
+**  slopes and flow directions, are the same as with the nodes raised,
+**  but only the boundary nodes are touched. ApplyPendingUplift must be
+**  called before absolute elevations are used (output, floodplain
+**  deposition, stratigraphy, or access from outside the model).
+**
 **  Inputs:  mp -- pointer to the mesh
 **           delt -- duration of uplift
 **
@@ -360,9 +375,21 @@ void tUplift::UpliftUniform( tMesh<tLNode> *mp, double delt, double currentTime
    rate = rate_ts.calc( currentTime );
    const double rise = rate*delt;
 
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
      std::cout << "****UPLIFTUNI: " << rise << std::endl;
 
+   tModelContext *context = mp->getContext();
+   if( optLazyUplift_ && context!=0 )
+   {
+      if( context->freezeElevations )
+         return;
+      for( cn=ni.FirstBoundaryP(); !ni.AtEnd(); cn=ni.NextP() )
+         cn->ChangeZ( -rise );
+      context->zDatum += rise;
+      upliftPending_ = true;
+      return;
+   }
+
    for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
    {
       cn->ChangeZ( rise );
@@ -371,6 +398,38 @@ void tUplift::UpliftUniform( tMesh<tLNode> *mp, double delt, double currentTime
 }
 
 
+/************************************************************************\
+**
+**  tUplift::ApplyPendingUplift
+**
+**  Raises every node by the datum offset left by lazy uniform uplift
+**  (which restores the boundary nodes to their elevations), sets the
+**  uplift rate of the interior nodes, and clears the offset. Does
+**  nothing if no uplift is pending.
+**
+**  Inputs:  mp -- pointer to the mesh
+**
+\************************************************************************/
+void tUplift::ApplyPendingUplift( tMesh<tLNode> *mp )
+{
+   assert( mp!=0 );
+   if( !upliftPending_ )
+      return;
+   tModelContext *context = mp->getContext();
+   const double rise = context->zDatum;
+   tLNode *cn;
+   tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
+   for( cn=ni.FirstP(); !ni.AtEnd(); cn=ni.NextP() )
+   {
+      cn->ChangeZ( rise );
+      if( ni.IsActive() )
+         cn->setUplift( rate );
+   }
+   context->zDatum = 0.0;
+   upliftPending_ = false;
+}
+
+
 /************************************************************************\
 **
 **  tUplift::BlockUplift
@@ -431,14 +490,13 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
   tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
   slipRate = slipRate_ts.calc( currentTime );
   double slip = slipRate*delt;
-  static double cumulative_displacement = 0;
-  
-  cumulative_displacement += slip;
+  cumulative_displacement_ += slip;
   
-  if(1) std::cout << "StrikeSlip by " << slip << "; cum displacement is " 
-    << cumulative_displacement << std::endl;
+  CHILD_LOG( tLog::kDebug, tLog::kUplift,
+             "StrikeSlip by " << slip << "; cum displacement is "
+             << cumulative_displacement_ );
   
-  if ( 1 )
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
   {
     tEdge * anedge;
     tMesh<tLNode>::edgeListIter_t ei( mp->getEdgeList() );
@@ -469,7 +527,7 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
     // If we're not wrapping, we'll convert any nodes "exposed to the edge" by
     // strike-slip motion to open boundaries
     if( !opt_wrap_boundaries_ 
-       && (cn->getX()+slip) > (positionParam1 + cumulative_displacement)
+       && (cn->getX()+slip) > (positionParam1 + cumulative_displacement_)
        && cn->getY() > (faultPosition-buffer_width_) 
        && cn->getY() < (faultPosition+buffer_width_) 
        && cn->getBoundaryFlag()==kNonBoundary )
@@ -571,7 +629,8 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
     // outside of these buffers are flagged as interior nodes.
     for( cn=ni.FirstP(); !(ni.AtEnd()); cn=ni.NextP() )
     {
-      if(1) std::cout << "In StrikeSlip: node id " << cn->getID() << " pid " << cn->getPermID() << std::endl << std::flush;
+      CHILD_LOG( tLog::kDebug, tLog::kUplift,
+                 "In StrikeSlip: node id " << cn->getID() << " pid " << cn->getPermID() );
       // Check whether node is in the left-hand buffer zone
       if( cn->getX() < buffer_width_ )
       {
@@ -661,7 +720,7 @@ void tUplift::StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime )
   }
   
   // Debug
-  if(1) 
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
   {
     std::cout << "Place 7: getActiveSize says " << mp->getNodeList()->getActiveSize() << " interior nodes\n" << std::flush;
     int n_int_nodes = 0;
@@ -732,7 +791,6 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double uprate;
-   static double elapsedTime = 0;
 
    // For each node, the uplift rate is the uplift rate constant ("rate") times
    // the cosine function in the y- and (if lateral y-directed tightening has
@@ -742,7 +800,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
    // by the parameter "foldParam2"; if uplift is positive, the rate is
    // multiplied by this factor. "positionParam1" is used to store the
    // x-location of the anticline.
-   if( elapsedTime >= deformStartTime1 )
+   if( elapsed_time_ >= deformStartTime1 )
    {
       for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
       {
@@ -763,7 +821,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
          cn->ChangeZ( uprate*delt );
       }
    }
-   elapsedTime += delt;
+   elapsed_time_ += delt;
 
    // The "tightening" of the folds through time is simulated by
    // progressively decreasing the fold wavelength. (Here the variable
@@ -801,7 +859,7 @@ void tUplift::CosineWarp2D( tMesh<tLNode> *mp, double delt )
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt ) const
+void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
@@ -809,18 +867,17 @@ void tUplift::PropagatingFold( tMesh<tLNode> *mp, double delt ) const
    double uprate;
    const double northEdge = foldParam2 + 0.5*foldParam;
    const double southEdge = northEdge - foldParam;
-   static double foldNose = 0.0;
    const double twoPiLam = TWOPI/foldParam;
 
    // Advance the fold nose
-   foldNose += slipRate*delt;
+   fold_nose_ += slipRate*delt;
 
    // For each node, the uplift rate is the uplift rate constant ("rate") times
    // the cosine function in y. The variable "foldParam2" is the location
    // of the fold axis in meters relative to y=0.
    for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
    {
-     if( cn->getX()<=foldNose && cn->getY()<=northEdge && cn->getY()>=southEdge )
+     if( cn->getX()<=fold_nose_ && cn->getY()<=northEdge && cn->getY()>=southEdge )
        {
 	 uprate = rate2 * 0.5 * ( cos( twoPiLam*(foldParam2-cn->getY()) )+1.0);
 	 cn->ChangeZ( uprate*delt );
@@ -909,13 +966,13 @@ void tUplift::TwoSideDifferential( tMesh<tLNode> *mp, double delt ) const
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
+void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double slip = slipRate*delt;
-   static double elapsedTime = delt;
+   if( fbf_elapsed_time_==0.0 ) fbf_elapsed_time_ = delt;
 
 
    for( cn=ni.FirstP(); !(ni.AtEnd()); cn=ni.NextP() )
@@ -927,7 +984,7 @@ void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
         surface, which migrates up from the lower end of the ramp, reaches
         the upper end of the ramp.  */
 
-     if( elapsedTime < flatDepth/(sin(PI*rampDip/180))/slipRate )
+     if( fbf_elapsed_time_ < flatDepth/(sin(PI*rampDip/180))/slipRate )
      {
 
        /* For hinterland (lower ramp) hangingwall */
@@ -1018,7 +1075,7 @@ void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
    mp->MoveNodes( 0., false );
 
 
-   /*elapsedTime += delt;*/
+   /*fbf_elapsed_time_ += delt;*/
 }
 
 
@@ -1035,13 +1092,13 @@ void tUplift::FaultBendFold( tMesh<tLNode> *mp, double delt ) const
 **           delt -- duration of uplift
 **
 \************************************************************************/
-void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt ) const
+void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt )
 {
    assert( mp!=0 );
    tLNode *cn;
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    double slip = slipRate*delt;
-   static double elapsedTime = delt;
+   if( elapsed_time_==0.0 ) elapsed_time_ = delt;
    /* Redefinitions so faultPosition and flatDepth are measured with respect
    to where fault intersects z=0 (faultPosition) and depth below z=0. */
    //double faultPosition = faultPosition - meanElevation/tan(rampDip);
@@ -1049,7 +1106,7 @@ void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt ) const
 
    for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
    {
-      if( elapsedTime < flatDepth/(sin(PI*rampDip/180))/slipRate )
+      if( elapsed_time_ < flatDepth/(sin(PI*rampDip/180))/slipRate )
       {
           if( cn->getZ()>=tan(PI*rampDip/180)*cn->getY()-tan(PI*rampDip/180)
           *faultPosition && cn->getZ()>-tan(PI*kinkDip/180)*cn->getY()+
@@ -1078,7 +1135,7 @@ void tUplift::FaultBendFold2( tMesh<tLNode> *mp, double delt ) const
       }
    }
 
-   elapsedTime += delt;
+   elapsed_time_ += delt;
 }
 
 
@@ -1118,7 +1175,7 @@ void tUplift::NormalFaultTiltAccel( tMesh<tLNode> *mp, double delt, double curre
    std::cout << "time " << currentTime << " rateOverPivot " << rateOverPivot << std::endl;
    assert( mp!=0 );
 
-   if (1) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
      std::cout << "****UPLIFTNORMALFAULTTILTACCEL: " << rateOverPivot << std::endl;
 
    for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
@@ -1195,22 +1252,22 @@ void tUplift::LinearUplift( tMesh<tLNode> *mp, double delt )
 \************************************************************************/
 void tUplift::UpliftRateMap( tMesh<tLNode> *mp, double delt, double currentTime )
 {
-  if(0) std::cout << "Greetings from tUplift::UpliftRateMap" << std::endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "Greetings from tUplift::UpliftRateMap" << std::endl;
 
   // Is it time to read in a new uplift rate map? If so, do so.
   if( currentTime>=mdNextUpliftMapTime && miCurUpliftMapNum<miNumUpliftMaps )
   {
-    if(0) std::cout << "It's " << currentTime << " and time for a new rate map" << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "It's " << currentTime << " and time for a new rate map" << std::endl;
     
     // Remember the current map number and time at which we read the next one
     miCurUpliftMapNum++;
     if( miCurUpliftMapNum < miNumUpliftMaps )
     { 
       mdNextUpliftMapTime = mUpliftMapTimes[miCurUpliftMapNum];
-      if(0) std::cout << "The next read will be at " << mdNextUpliftMapTime << std::endl;
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "The next read will be at " << mdNextUpliftMapTime << std::endl;
     }
     else
-      if(0) std::cout << "Reading the last uplift rate map\n";
+      if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "Reading the last uplift rate map\n";
       
     // Put together the name of the file containing the new uplift rate map,
     // and open it for reading. (This operation assumes 3 digit file extn.
@@ -1229,7 +1286,7 @@ void tUplift::UpliftRateMap( tMesh<tLNode> *mp, double delt, double currentTime
       ReportFatalError("Unable to open uplift rate map file.");
 	}
 
-    if(0) std::cout << "The name we want to read is <" << myfilename << ">" << std::endl;
+    if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) ) std::cout << "The name we want to read is <" << myfilename << ">" << std::endl;
 
     // Read the contents of the file and store uplift rate for each node.
     // But first we renumber node IDs "canonically", meaning ordered by 
@@ -1297,7 +1354,7 @@ void tUplift::PropagatingFront( tMesh<tLNode> *mp, double delt, double currentTi
    tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
    const double rise = rate*delt;
 
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
      std::cout << "****Prop_front: " << rise << std::endl;
 
    for( cn=ni.FirstP(); ni.IsActive(); cn=ni.NextP() )
@@ -1331,7 +1388,7 @@ void tUplift::BaselevelFallAtOpenBoundaries( tMesh<tLNode> *mp, double delt, dou
    rate = rate_ts.calc( currentTime );
    const double fall = rate*delt;
 
-   if (0) //DEBUG
+   if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kUplift ) )
      std::cout << "****BASELEVELFALL: " << fall << std::endl;
 
    for( cn=ni.FirstBoundaryP(); !ni.AtEnd(); cn=ni.NextP() )
@@ -1415,9 +1472,9 @@ void tUplift::MovingBlock( tMesh<tLNode> *mp, double delt, double currentTime )
  \************************************************************************/
 void tUplift::MovingSinusoid( tMesh<tLNode> *mp, double delt, double currentTime )
 {
-  static double two_pi_over_lamx = 2.0*3.14159265/blockWidth_x;
-  static double two_pi_over_lamy = 2.0*3.14159265/blockWidth_y;
-  static double three_halves_pi = 1.5*3.14159265;
+  const double two_pi_over_lamx = 2.0*3.14159265/blockWidth_x;
+  const double two_pi_over_lamy = 2.0*3.14159265/blockWidth_y;
+  const double three_halves_pi = 1.5*3.14159265;
 	assert( mp!=0 );
 	tLNode *cn;
 	tMesh<tLNode>::nodeListIter_t ni( mp->getNodeList() );
@@ -1570,3 +1627,25 @@ double tUplift::getRate() const
    return rate;
 }
 
+
+/************************************************************************\
+**
+**  tUplift::MovesNodes, tUplift::ChangesLayers
+**
+**  Tell which parts of the model state DoUplift changes besides node
+**  elevations and uplift rates: node positions and the node list
+**  (strike-slip and fault-bend-fold motion), or the rock layers
+**  (UpliftAndThicken). Used to schedule uplift alongside other
+**  processes (see childInterface::RunOneStorm).
+**
+\************************************************************************/
+
+bool tUplift::MovesNodes() const
+{
+   return typeCode==k3 || typeCode==k8;
+}
+
+bool tUplift::ChangesLayers() const
+{
+   return typeCode==k17;
+}
@@ -29,6 +29,8 @@
 **    - added time series rate variable rate_ts, and implemented it
 **      for two uplift functions (which now take current time as a
 **      parameter)
+**    - added the lazy uniform uplift option (OPT_LAZY_UPLIFT), which
+**      keeps uniform uplift in a datum offset (see UpliftUniform)
 **
 **  $Id: tUplift.h,v 1.26 2008-07-09 16:35:34 childcvs Exp $
 */
@@ -49,16 +51,20 @@ public:
   void DoUplift( tMesh<tLNode> *mp, double delt, double current_time );
   double getDuration() const;
   double getRate() const;
+  bool MovesNodes() const;     // moves or adds/deletes nodes?
+  bool ChangesLayers() const;  // alters the layer stacks?
+  // brings node elevations up to date with lazy uniform uplift
+  void ApplyPendingUplift( tMesh<tLNode> *mp );
 private:
   void UpliftUniform( tMesh<tLNode> *mp, double delt, double currentTime );
   void BlockUplift( tMesh<tLNode> *mp, double delt, double currentTime );
   void StrikeSlip( tMesh<tLNode> *mp, double delt, double currentTime );
   void FoldPropErf( tMesh<tLNode> *mp, double delt );
   void CosineWarp2D( tMesh<tLNode> *mp, double delt );
-  void PropagatingFold( tMesh<tLNode> *mp, double delt ) const;
+  void PropagatingFold( tMesh<tLNode> *mp, double delt );
   void TwoSideDifferential( tMesh<tLNode> *mp, double delt ) const;
-  void FaultBendFold( tMesh<tLNode> *mp, double delt ) const;
-  void FaultBendFold2( tMesh<tLNode> *mp, double delt ) const;
+  void FaultBendFold( tMesh<tLNode> *mp, double delt );
+  void FaultBendFold2( tMesh<tLNode> *mp, double delt );
   void NormalFaultTiltAccel( tMesh<tLNode> *mp, double delt, double currentTime ) const;
   void LinearUplift( tMesh<tLNode> *mp, double delt );
   void PowerLawUplift( tMesh<tLNode> *mp, double delt );
@@ -143,6 +149,12 @@ private:
   double bump_amplitude_;  // Max amplitude of Gaussian bump (m)
   double bump_wavelength_squared_; // Square of wavelength of Gaussian bump (m)
   bool create_initial_bump_;  // Option to create an initial bump in topo
+  double cumulative_displacement_; // Total strike-slip displacement (m)
+  double elapsed_time_;   // Time since start of folding (CosineWarp2D, FBF2)
+  double fbf_elapsed_time_; // Same for FaultBendFold (set once, not advanced)
+  double fold_nose_;      // Position of propagating fold nose (m)
+  bool optLazyUplift_;    // Keep uniform uplift in the datum offset?
+  bool upliftPending_;    // Uniform uplift not yet applied to the nodes?
   
 private:
   tUplift();
@@ -158,7 +170,11 @@ decayParam(orig.decayParam), timeParam1(orig.timeParam1), width(orig.width),
 dupdy(orig.dupdy), optincrease(orig.optincrease), miNumUpliftMaps(orig.miNumUpliftMaps), 
 mUpliftMapTimes(orig.mUpliftMapTimes), miCurUpliftMapNum(orig.miCurUpliftMapNum), 
 mdNextUpliftMapTime(orig.mdNextUpliftMapTime), 
-mdUpliftFrontGradient(orig.mdUpliftFrontGradient)
+mdUpliftFrontGradient(orig.mdUpliftFrontGradient),
+cumulative_displacement_(orig.cumulative_displacement_),
+elapsed_time_(orig.elapsed_time_), fbf_elapsed_time_(orig.fbf_elapsed_time_),
+fold_nose_(orig.fold_nose_),
+optLazyUplift_(orig.optLazyUplift_), upliftPending_(orig.upliftPending_)
 {
   strcat( mUpliftMapFilename, orig.mUpliftMapFilename );
 }
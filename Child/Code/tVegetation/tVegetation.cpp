@@ -24,9 +24,11 @@
 
 #include "tVegetation.h"
 #include "../tMesh/tMesh.h"
+#include "../tModelContext/tModelContext.h"
 #include "../globalFns.h"
 #include "../tRunTimer/tRunTimer.h"
 #include "../tStorm/tStorm.h"
+#include "../tProfiler/tProfiler.h"
 
 /*
 **  Functions for tFire objects.
@@ -762,6 +764,7 @@ tVegetation::tVegetation()
   mdKvd(0),
   mdTVeg(1),
   mdTauCritBare(0), mdTauCritVeg(0),
+  mdClock(0), context_(0),
   fire(0), forest(0)
 {}
 
@@ -772,6 +775,7 @@ tVegetation::tVegetation( tMesh<class tLNode> * meshPtr, const tInputFile &infil
   mdKvd(0),
   mdTVeg(1),
   mdTauCritBare(0), mdTauCritVeg(0),
+  mdClock(0), context_(0),
   fire(0), forest(0)
 {
   optGrassSimple = infile.ReadBool( "OPTGRASS_SIMPLE", true );
@@ -813,7 +817,7 @@ tVegetation::tVegetation( tMesh<class tLNode> * meshPtr, const tInputFile &infil
     for( int id=0; id < nnodes; ++id )
       NodeTable[id]->getVegCover().mdVeg = inputVegData.vegCov[id];
     for( tLNode *cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
-      cn->setTauCrit( mdTauCritBare + mdTauCritVeg );
+      cn->setTauCrit( TauCrit( cn->getVegCover().getVeg() ) );
   } else {
     // Start from scratch
     for( tLNode *cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
@@ -822,11 +826,13 @@ tVegetation::tVegetation( tMesh<class tLNode> * meshPtr, const tInputFile &infil
 	cn->setTauCrit( mdTauCritBare + mdTauCritVeg );
       }
   }
+  AttachToMesh( meshPtr );
 }
 
 tVegetation::tVegetation( const tVegetation& orig )
   : optGrassSimple(orig.optGrassSimple), mdKvd(orig.mdKvd), mdTVeg(orig.mdTVeg), 
     mdTauCritBare(orig.mdTauCritBare), mdTauCritVeg(orig.mdTauCritVeg),
+    mdClock(orig.mdClock), context_(0),
     fire(0), forest(0)
 {
   if( orig.fire )
@@ -837,6 +843,8 @@ tVegetation::tVegetation( const tVegetation& orig )
 
 tVegetation::~tVegetation()
 { 
+  if( context_ && context_->vegetation==this )
+    context_->vegetation = 0;
   if( fire )
     {
       delete fire;
@@ -848,6 +856,27 @@ tVegetation::~tVegetation()
       forest = NULL;
     }
 }
+/**************************************************************************\
+**
+**  tVegetation::AttachToMesh
+**
+**  Makes the nodes of the mesh (through their model context) bring their
+**  simple vegetation cover up to date from this object's regrowth clock
+**  in tLNode::RegrowVegCover. A copy of a tVegetation must be attached to the
+**  mesh it is used with.
+**
+\**************************************************************************/
+void tVegetation::AttachToMesh( tMesh<class tLNode> *meshPtr )
+{
+  if( context_ && context_->vegetation==this )
+    context_->vegetation = 0;
+  context_ = 0;
+  if( !optGrassSimple || meshPtr->getContext()==0 )
+    return;
+  context_ = meshPtr->getContext();
+  context_->vegetation = this;
+}
+
 /**************************************************************************\
 **
 **  tVegetation::UpdateVegetation
@@ -868,7 +897,14 @@ tVegetation::~tVegetation()
 **  Regrowth of vegetation following a storm is computed as:
 **    dV/dt = 1/Tv ( 1 - V )
 **  where Tv is the timescale of vegetation regrowth. An analytical
-**  solution is used to update the vegetation cover.
+**  solution is used to update the vegetation cover. Because it composes
+**  over successive intervals (up to rounding: applying it once over the
+**  sum of several intervals need not give the same last bits as
+**  applying it over each in turn), GrowVegetation only advances the regrowth
+**  clock when the mesh has a model context; each node applies the
+**  regrowth since its cover was last set when the cover or threshold is
+**  next needed (see RegrowCover and tLNode::RegrowVegCover), so that
+**  nodes nobody reads cost nothing.
 **
 **  Finally, the critical shear stress is updated at each node using:
 **    Tc = Tcb + V Tcv
@@ -881,8 +917,9 @@ tVegetation::~tVegetation()
 
 void tVegetation::UpdateVegetation( tMesh<class tLNode> *meshPtr,
 				    double dt,
-                                    double interstormdur ) const
+                                    double interstormdur )
 {
+  tProfileScope scope( "tVegetation::UpdateVegetation" );
   ErodeVegetation( meshPtr, dt );
   GrowVegetation( meshPtr, interstormdur );
 }
@@ -897,6 +934,10 @@ void tVegetation::ErodeVegetation(  tMesh<class tLNode> *meshPtr,
    tLNode * cn;   // Ptr to current node
    double tauex,  // Excess shear stress
        veg;       // Fractional vegetation cover
+   // Regrowth only raises the cover, so when cover raises the threshold,
+   // a node below the threshold it was last given is below its current
+   // one too, and can be left to catch up when next needed
+   const bool skipBelowThreshold = ( mdTauCritVeg>=0.0 );
    
    // Loop on active nodes, computing erosion during the time step of
    // duration dt.
@@ -904,31 +945,38 @@ void tVegetation::ErodeVegetation(  tMesh<class tLNode> *meshPtr,
    // veg cover given its initial value and duration of erosion/regrowth.
    for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
    {
+      if( skipBelowThreshold && cn->getTau()<=cn->getTauCrit() )
+	continue;
+      cn->RegrowVegCover();
+
       // Erosion of vegetation during storm (if any)
       tauex = cn->getTau() - cn->getTauCrit();
-      veg = cn->getVegCover().getVeg();
       if( tauex>0.0 )
       {
+          veg = cn->getVegCover().getVeg();
           veg = veg * exp( -mdKvd * tauex * dt );
           cn->getVegCover().mdVeg = veg;
 	  assert( veg >= 0.0 );
 	  assert( veg <= 1.0 );
           //cout << "veg after erosion: " << veg << endl;
-      }
 
-      // Update critical shear stress
-      cn->setTauCrit( mdTauCritBare + veg*mdTauCritVeg );
-      //cout << "tau crit: " << mdTauCritBare + veg*mdTauCritVeg << endl;
+          // Update critical shear stress
+          cn->setTauCrit( mdTauCritBare + veg*mdTauCritVeg );
+          //cout << "tau crit: " << mdTauCritBare + veg*mdTauCritVeg << endl;
+      }
    }   
 }
 
 
 void tVegetation::GrowVegetation(  tMesh<class tLNode> *meshPtr,
-				    double duration ) const
+				    double duration )
 {
+  tProfileScope scope( "tVegetation::GrowVegetation" );
   tMesh<tLNode>::nodeListIter_t niter( meshPtr->getNodeList() ); // Node iterator
   tLNode * cn;   // Ptr to current node
-  if( optGrassSimple )
+  if( optGrassSimple && context_ )
+    mdClock += duration;  // the nodes catch up when read (see RegrowCover)
+  else if( optGrassSimple )
     {
       double veg;       // Fractional vegetation cover
       // Loop on active nodes, computing regrowth during the interstorm period.
@@ -967,6 +1015,7 @@ void tVegetation::GrowVegetation(  tMesh<class tLNode> *meshPtr,
 	  for( cn=niter.FirstP(); niter.IsActive(); cn=niter.NextP() )
 	    {
 	      cn->getVegCover().mdVeg = 0.0;
+	      cn->getVegCover().mdVegTime = mdClock;
 	      cn->setTauCrit( mdTauCritBare );
 	    }
 	// forest fires kill trees and leave behind the wood and roots,
@@ -22,6 +22,14 @@
 **  methods, so that only the routines in tVegetation can modify the
 **  vegetation properties.
 **
+**  Regrowth of the simple (grass) cover is lazy: GrowVegetation only
+**  advances a regrowth clock, and each node's cover (with its critical
+**  shear stress) is brought up to date from the time it was last set
+**  when it is next needed, through tLNode::RegrowVegCover, which erosion
+**  and output call before reading the cover or the critical shear
+**  stress. The model's tVegetation is found through the node's
+**  tModelContext.
+**
 **  Created January, 2000, GT
 **
 **  STL, 8/2010: Added forest and fires adapted from the OSU version of
@@ -46,6 +54,7 @@
 #include <math.h>
 #include "../tInputFile/tInputFile.h"
 #include "../Mathutil/mathutil.h"
+#include "../tMemoryAccount/tMemoryAccount.h"
 #include <iosfwd>
 //#include "../tMesh/tMesh.h"
 class tLNode;
@@ -54,6 +63,8 @@ class tVegetation;
 class tTrees;
 class tStorm;
 class tRunTimer;
+class tModelContext;
+class tVegCover;
 
 class tFire
 {
@@ -183,11 +194,17 @@ class tVegetation
   tVegetation( tMesh<class tLNode> *meshPtr, const tInputFile &infile, 
 	       bool no_write_mode = false, tRunTimer *tPtr = 0, tStorm *stormPtr = 0 );
   ~tVegetation();
-   void UpdateVegetation( tMesh<class tLNode> *, double, double ) const;
-   void GrowVegetation( tMesh<class tLNode> *, double ) const;
+   void UpdateVegetation( tMesh<class tLNode> *, double, double );
+   void GrowVegetation( tMesh<class tLNode> *, double );
    void ErodeVegetation( tMesh<class tLNode> *, double ) const;
   tFire* FirePtr() {return fire;}
   tForest* ForestPtr() {return forest;}
+  // Makes the nodes of the mesh use this object for lazy regrowth
+  void AttachToMesh( tMesh<class tLNode> * );
+  // Brings a cover up to date with the regrowth clock; true if changed
+  inline bool RegrowCover( tVegCover & ) const;
+  // Critical shear stress for a given cover
+  double TauCrit( double veg ) const {return mdTauCritBare + veg*mdTauCritVeg;}
 
   private:
   bool optGrassSimple; // option for simple grass
@@ -195,13 +212,15 @@ class tVegetation
    double mdTVeg;  // Vegetation regrowth time scale (years)
    double mdTauCritBare;  // Erosion threshold on bare soil
    double mdTauCritVeg;   // Erosion threshold under 100% cover
+   double mdClock;        // Total regrowth time so far (years)
+   tModelContext *context_;  // Context whose nodes regrow lazily, or 0
    // unused
    //double intlVegCover;   // Initial vegetation cover
   tFire *fire; // pointer to fire object
   tForest *forest; // pointer to forest object
 };
 
-class tTrees
+class tTrees : private tCounted< tTrees, tMemoryAccount::kTrees >
 {
 public:
   tTrees() : forest(0), node(0), maxrootstrength(-1.0) {}
@@ -292,6 +311,7 @@ class tVegCover
    
   private:
    double mdVeg;
+   double mdVegTime;  // Regrowth clock (see tVegetation) when mdVeg was set
   tTrees *trees;
 };
 
@@ -332,7 +352,8 @@ inline double tForest::WoodDecayFactor( double evoltime )
 // inline functions for tTrees
 //
 inline tTrees::tTrees( const tTrees& orig )
-  : forest(0),
+  : tCounted< tTrees, tMemoryAccount::kTrees >(),
+    forest(0),
     node(0),
     rootstrength(orig.rootstrength),
     rootstrengthLat(orig.rootstrengthLat),
@@ -414,11 +435,11 @@ inline void tTrees::TreesRemove( double frac )
 // inline functions for tVegCover
 
 inline tVegCover::tVegCover() :
-  mdVeg(1.), trees(0)
+  mdVeg(1.), mdVegTime(0.), trees(0)
 {}
 
 inline tVegCover::tVegCover( const tVegCover &orig ) :
-  mdVeg(orig.mdVeg), trees(0)
+  mdVeg(orig.mdVeg), mdVegTime(orig.mdVegTime), trees(0)
 {
   if( orig.trees )
     trees = new tTrees( *orig.trees );
@@ -426,5 +447,26 @@ inline tVegCover::tVegCover( const tVegCover &orig ) :
 
 inline double tVegCover::getVeg() const {return mdVeg;}
 
+// inline functions for tVegetation
+
+/*
+**  RegrowCover
+**
+**  Applies the regrowth since the cover was last set, using the
+**  analytical solution of dV/dt = 1/Tv ( 1 - V ) over the whole interval
+**  at once (see UpdateVegetation).
+*/
+inline bool tVegetation::RegrowCover( tVegCover &cover ) const
+{
+  if( cover.mdVegTime==mdClock )
+    return false;
+  cover.mdVeg = 1.0 - (1.0 - cover.mdVeg)
+    * exp( -( mdClock - cover.mdVegTime ) / mdTVeg );
+  cover.mdVegTime = mdClock;
+  assert( cover.mdVeg >= 0.0 );
+  assert( cover.mdVeg <= 1.0 );
+  return true;
+}
+
 
 #endif
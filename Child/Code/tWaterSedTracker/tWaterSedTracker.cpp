@@ -34,6 +34,7 @@
 #include <vector>
 #include <sstream>
 #include "tWaterSedTracker.h"
+#include "../tLog/tLog.h"
 
 using namespace std;
 
@@ -48,7 +49,7 @@ tWaterSedTracker::
 tWaterSedTracker()
   : active(false)
 {
-  if(0) cout << "tWaterSedTracker constructor" << endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kTracker ) ) cout << "tWaterSedTracker constructor" << endl;
 }
 
 // copy constructor for copying to new mesh:
@@ -75,7 +76,7 @@ tWaterSedTracker::tWaterSedTracker( const tWaterSedTracker& orig,
 tWaterSedTracker::
 ~tWaterSedTracker()
 {
-  if(0) cout << "tWaterSedTracker destructor" << endl;
+  if( CHILD_LOG_ENABLED( tLog::kDebug, tLog::kTracker ) ) cout << "tWaterSedTracker destructor" << endl;
   
   for( unsigned i=0; i<output_file_list_.size(); i++ )
   {
@@ -103,7 +104,8 @@ InitializeFromInputFile( tInputFile &inputFile, tMesh<tLNode> *mesh /*, tErosion
   string input_string;
   stringstream input_stringstream;
   
-  if(1) cout << "tWaterSedTracker::InitializeFromInputFile" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kTracker,
+             "tWaterSedTracker::InitializeFromInputFile" );
   
   // Read in the number of nodes to track and their approximate (x,y) coordinates
   number_of_nodes_to_track = inputFile.ReadInt( "NUMBER_OF_NODES_TO_TRACK_WATER_AND_SED" );
@@ -168,7 +170,8 @@ void tWaterSedTracker::
 ResetListOfNodesToTrack( vector<tLNode *> list_of_nodes_to_track,
                          double current_time )
 {
-  if(1) cout << "tWaterSedTracker::ResetListOfNodesToTrack" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kTracker,
+             "tWaterSedTracker::ResetListOfNodesToTrack" );
   
   // Store a copy of the tracking list (uses vector's overloaded assignment operator)
   tracking_node_list_ = list_of_nodes_to_track;
@@ -198,7 +201,8 @@ void tWaterSedTracker::
 WriteAndResetWaterSedTimeseriesData( double period_starting_time, 
                                      double period_duration )
 {
-  if(1) cout << "tWaterSedTracker::WriteAndResetWaterSedTimeseriesData" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kTracker,
+             "tWaterSedTracker::WriteAndResetWaterSedTimeseriesData" );
   
   for( unsigned i=0; i<tracking_node_list_.size(); i++ )
   {
@@ -220,7 +224,8 @@ WriteAndResetWaterSedTimeseriesData( double period_starting_time,
 void tWaterSedTracker::
 AddSedVolumesAtTrackingNodes( double flux_duration )
 {
-  if(1) cout << "tWaterSedTracker::AddSedVolumesAtTrackingNodes" << endl;
+  CHILD_LOG( tLog::kDebug, tLog::kTracker,
+             "tWaterSedTracker::AddSedVolumesAtTrackingNodes" );
 
   for( unsigned i=0; i<tracking_node_list_.size(); i++ )
   {
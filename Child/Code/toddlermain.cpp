@@ -45,8 +45,6 @@
 #include "tFloodplain/tFloodplain.h"
 #include "tEolian/tEolian.h"
 
-Predicates predicate;
-
 
 int main( int argc, char **argv )
 {
@@ -97,9 +95,12 @@ int main( int argc, char **argv )
 
    // Create a random number generator for the simulation itself
    tRand rand( inputFile );
+   // Read parameters shared by all nodes of the mesh
+   tModelContext context;
+   context.InitializeFromInputFile( inputFile );
    // Create and initialize objects:
    cout << "Creating mesh...\n";
-   tMesh<tLNode> mesh( inputFile );
+   tMesh<tLNode> mesh( inputFile, false, &context );
    cout << "Creating output files...\n";
    tLOutput<tLNode> output( &mesh, inputFile, &rand );
    tStorm storm( inputFile, &rand );
@@ -221,9 +222,12 @@ OptTSOutput." );
                                time.getCurrentTime(), vegetation );
 
       if( optFloodplainDep )
+      {
+          uplift.ApplyPendingUplift( &mesh );  // overbank deposition uses absolute elevations
           floodplain->DepositOverbank( storm.getRainrate(),
                                        storm.getStormDuration(),
                                        time.getCurrentTime() );
+      }
 
       if( optVegetation )
 	  vegetation->UpdateVegetation( &mesh, storm.getStormDuration(),
@@ -248,10 +252,19 @@ OptTSOutput." );
 
       time.Advance( storm.getStormDuration() + storm.interstormDur() );
 
+      // With OPT_LAZY_UPLIFT, absolute elevations are behind by the datum
+      // offset until the pending uplift is applied (see tUplift)
       if( time.CheckOutputTime() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
           output.WriteOutput( time.getCurrentTime() );
+      }
 
-      if( output.OptTSOutput() ) output.WriteTSOutput();
+      if( output.OptTSOutput() )
+      {
+          uplift.ApplyPendingUplift( &mesh );
+          output.WriteTSOutput();
+      }
 
       /* IN PROGRESS
       switch( optTSOutput ){
@@ -12,7 +12,7 @@ OBJECTS = \
  childLithTestDriver.$(OBJEXT) \
  childInterface.$(OBJEXT) erosion.$(OBJEXT) \
  meshElements.$(OBJEXT) mathutil.$(OBJEXT) tIDGenerator.$(OBJEXT) \
- tInputFile.$(OBJEXT) tLNode.$(OBJEXT) tRunTimer.$(OBJEXT) \
+ tInputFile.$(OBJEXT) tLNode.$(OBJEXT) tModelContext.$(OBJEXT) tRunTimer.$(OBJEXT) \
  tStreamMeander.$(OBJEXT) meander.$(OBJEXT) \
  tStorm.$(OBJEXT) tStreamNet.$(OBJEXT) tUplift.$(OBJEXT) errors.$(OBJEXT) \
  tFloodplain.$(OBJEXT) tEolian.$(OBJEXT) globalFns.$(OBJEXT) \
@@ -46,6 +46,9 @@ tInputFile.$(OBJEXT): $(PT)/tInputFile/tInputFile.cpp
 tLNode.$(OBJEXT): $(PT)/tLNode/tLNode.cpp
 	$(CXX) $(CFLAGS) $(PT)/tLNode/tLNode.cpp
 
+tModelContext.$(OBJEXT): $(PT)/tModelContext/tModelContext.cpp
+	$(CXX) $(CFLAGS) $(PT)/tModelContext/tModelContext.cpp
+
 tListInputData.$(OBJEXT): $(PT)/tListInputData/tListInputData.cpp
 	$(CXX) $(CFLAGS) $(PT)/tListInputData/tListInputData.cpp
 
@@ -154,6 +157,7 @@ HFILES = \
 	$(PT)/tMesh/tMesh.h \
 	$(PT)/tMesh/tMesh2.cpp \
 	$(PT)/tMeshList/tMeshList.h \
+	$(PT)/tModelContext/tModelContext.h \
 	$(PT)/tOption/tOption.h \
 	$(PT)/tOutput/tOutput.cpp \
 	$(PT)/tOutput/tOutput.h \
@@ -186,6 +190,7 @@ tEolian.$(OBJEXT): $(HFILES)
 tFloodplain.$(OBJEXT): $(HFILES)
 tInputFile.$(OBJEXT): $(HFILES)
 tLNode.$(OBJEXT): $(HFILES)
+tModelContext.$(OBJEXT): $(HFILES)
 tListInputData.$(OBJEXT): $(HFILES)
 tOption.$(OBJEXT): $(HFILES)
 tRunTimer.$(OBJEXT): $(HFILES)